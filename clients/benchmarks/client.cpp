@@ -26,23 +26,29 @@
 
 #include "program_options.hpp"
 
+#include "hipsparselt_bench_report.hpp"
 #include "hipsparselt_data.hpp"
 #include "hipsparselt_datatype2string.hpp"
 #include "hipsparselt_parse_data.hpp"
+#include "singletons.hpp"
 #include "type_dispatch.hpp"
 #include "utility.hpp"
 #include <algorithm>
 #include <cctype>
 #include <cstdio>
 #include <cstring>
+#include <fstream>
 #include <hipsparselt/hipsparselt.h>
 #include <iostream>
 #include <map>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "testing_compress.hpp"
+#include "testing_init.hpp"
 #include "testing_prune.hpp"
 #include "testing_spmm.hpp"
 
@@ -117,6 +123,7 @@ struct perf_sparse<
             {"spmm_batched", testing_spmm<Ti, To, Tc, TBias, hipsparselt_batch_type::batched>},
             {"spmm_strided_batched",
              testing_spmm<Ti, To, Tc, TBias, hipsparselt_batch_type::strided_batched>},
+            {"init", testing_init<Ti, To, Tc>},
         };
         run_function(map, arg);
     }
@@ -237,6 +244,315 @@ int hipsparselt_bench_datafile(const std::string& filter, bool any_stride)
     return ret;
 }
 
+int bench_main(int argc, char* argv[], bool replay_entry = false);
+
+// Replay the hipsparselt-bench command lines captured in HIPSPARSELT_LOG_BENCH_FILE.
+// Identical command lines are run once and weighted by the number of logged calls.
+int hipsparselt_bench_replay(const std::string& replay_file)
+{
+    std::ifstream ifs(replay_file);
+    if(!ifs)
+        throw std::invalid_argument("Invalid value for --replay " + replay_file);
+
+    static constexpr char          bench[] = "hipsparselt-bench";
+    std::vector<std::string>       cmds;
+    std::map<std::string, int64_t> weights;
+    for(std::string line; std::getline(ifs, line);)
+    {
+        size_t pos = line.find(bench);
+        if(pos == std::string::npos)
+            continue;
+
+        // normalize the whitespace so that the same call always gives the same key
+        std::istringstream tokens(line.substr(pos + sizeof(bench) - 1));
+        std::string        cmd;
+        for(std::string token; tokens >> token;)
+            cmd += (cmd.empty() ? "" : " ") + token;
+        if(weights[cmd]++ == 0)
+            cmds.push_back(cmd);
+    }
+
+    struct replay_result
+    {
+        double gpu_us;
+        double gflops;
+    };
+    std::vector<replay_result> results;
+
+    int     ret         = 0;
+    int64_t total_calls = 0;
+    double  total_us    = 0;
+    double  total_gflop = 0;
+    for(const auto& cmd : cmds)
+    {
+        hipsparselt_cout << "hipsparselt-bench INFO: replay weight = " << weights[cmd]
+                         << ", hipsparselt-bench " << cmd << std::endl;
+
+        std::vector<std::string> tokens{bench};
+        std::istringstream       iss(cmd);
+        for(std::string token; iss >> token;)
+            tokens.push_back(token);
+        std::vector<char*> argv;
+        for(auto& token : tokens)
+            argv.push_back(&token[0]);
+        argv.push_back(nullptr);
+
+        replay_result r;
+        ArgumentModel_set_last_perf(ArgumentLogging::NA_value, ArgumentLogging::NA_value);
+        ret |= bench_main(int(argv.size()) - 1, argv.data(), true);
+        ArgumentModel_get_last_perf(r.gpu_us, r.gflops);
+        results.push_back(r);
+
+        // a call which did not run does not count in the aggregate
+        if(r.gpu_us <= 0)
+            continue;
+        total_calls += weights[cmd];
+        total_us += weights[cmd] * r.gpu_us;
+        if(r.gflops != ArgumentLogging::NA_value)
+            total_gflop += weights[cmd] * r.gflops * r.gpu_us * 1e-6;
+    }
+
+    hipsparselt_cout << "\nhipsparselt-bench replay of " << replay_file << ": " << cmds.size()
+                     << " unique calls\n"
+                     << "weight,us,hipsparselt-Gflops,time_share,command" << std::endl;
+    for(size_t i = 0; i < cmds.size(); i++)
+    {
+        const auto& r = results[i];
+        if(r.gpu_us <= 0)
+        {
+            hipsparselt_cout << weights[cmds[i]] << ",failed,failed,0," << cmds[i] << std::endl;
+            continue;
+        }
+        hipsparselt_cout << weights[cmds[i]] << "," << r.gpu_us << "," << r.gflops << ","
+                         << weights[cmds[i]] * r.gpu_us / total_us << "," << cmds[i]
+                         << std::endl;
+    }
+    if(total_us > 0)
+        hipsparselt_cout << "weighted calls,us per call,aggregate hipsparselt-Gflops\n"
+                         << total_calls << "," << total_us / total_calls << ","
+                         << total_gflop / total_us * 1e6 << std::endl;
+    return ret;
+}
+
+// Default compute type and bias type of a --precision / --a_type
+hipsparseLtComputetype_t default_compute_type(hipsparseLtDatatype_t type)
+{
+    bool is_f16 = type == HIPSPARSELT_R_16F || type == HIPSPARSELT_R_16BF;
+#ifdef __HIP_PLATFORM_AMD__
+    return is_f16 ? HIPSPARSELT_COMPUTE_32F : HIPSPARSELT_COMPUTE_32I;
+#else
+    bool is_f32 = type == HIPSPARSELT_R_32F;
+    return is_f16   ? HIPSPARSELT_COMPUTE_16F
+           : is_f32 ? HIPSPARSELT_COMPUTE_TF32
+                    : HIPSPARSELT_COMPUTE_32I;
+#endif
+}
+
+hipsparseLtDatatype_t default_bias_type(hipsparseLtDatatype_t type)
+{
+    return (type == HIPSPARSELT_R_16F || type == HIPSPARSELT_R_16BF) ? type : HIPSPARSELT_R_32F;
+}
+
+// Ranges and lists of the shape sweep, an empty string is not swept.
+struct sweep_options
+{
+    std::string m;
+    std::string n;
+    std::string k;
+    std::string batch_count;
+    std::string precision;
+    std::string trans;
+    std::string activation;
+
+    bool any() const
+    {
+        return !(m + n + k + batch_count + precision + trans + activation).empty();
+    }
+};
+
+// Expand first:last[:step] into its values, a step of *f is geometric and of +s or s is linear.
+std::vector<int64_t>
+    parse_sweep_range(const std::string& option, const std::string& range, int64_t value)
+{
+    if(range.empty())
+        return {value};
+
+    int64_t first, last, step = 1;
+    char    op = '+';
+    size_t  c1 = range.find(':'), c2 = range.find(':', c1 == std::string::npos ? c1 : c1 + 1);
+    try
+    {
+        first = std::stoll(range.substr(0, c1));
+        last  = c1 == std::string::npos ? first : std::stoll(range.substr(c1 + 1, c2 - c1 - 1));
+        if(c2 != std::string::npos)
+        {
+            std::string s = range.substr(c2 + 1);
+            if(!s.empty() && (s[0] == '*' || s[0] == '+'))
+            {
+                op = s[0];
+                s  = s.substr(1);
+            }
+            step = std::stoll(s);
+        }
+    }
+    catch(const std::logic_error&)
+    {
+        throw std::invalid_argument("Invalid value for " + option + " " + range);
+    }
+    if(first < 0 || last < first || step < 1 || (op == '*' && step < 2))
+        throw std::invalid_argument("Invalid value for " + option + " " + range);
+
+    std::vector<int64_t> values;
+    for(int64_t v = first; v <= last; v = op == '*' ? v * step : v + step)
+    {
+        values.push_back(v);
+        if(v == 0 && op == '*')
+            break;
+    }
+    return values;
+}
+
+// Split a comma separated list, a list which is not given is a single empty item.
+std::vector<std::string> split_sweep_list(const std::string& list)
+{
+    std::vector<std::string> items;
+    std::istringstream       iss(list);
+    for(std::string item; std::getline(iss, item, ',');)
+        if(!item.empty())
+            items.push_back(item);
+    if(items.empty())
+        items.push_back("");
+    return items;
+}
+
+// Run the cross product of the sweep ranges and lists on top of the other options and print
+// the results as one table. The cases run from the largest to the smallest footprint with the
+// device memory cache on, so the smaller ones reuse the allocations of the largest.
+int hipsparselt_bench_sweep(const Arguments&     base,
+                            const sweep_options& sweep,
+                            const std::string&   filter,
+                            bool                 any_stride)
+{
+    // replace every case by one copy per value of a swept field
+    std::vector<Arguments> cases{base};
+    auto                   expand = [&](const auto& values, auto set) {
+        std::vector<Arguments> expanded;
+        for(const auto& arg : cases)
+            for(const auto& value : values)
+            {
+                expanded.push_back(arg);
+                set(expanded.back(), value);
+            }
+        cases = std::move(expanded);
+    };
+
+    expand(split_sweep_list(sweep.precision), [](Arguments& arg, const std::string& precision) {
+        if(precision.empty())
+            return;
+        auto type = string_to_hipsparselt_datatype(precision);
+        if(type == static_cast<hipsparseLtDatatype_t>(-1))
+            throw std::invalid_argument("Invalid value for --sweep_precision " + precision);
+        arg.a_type = arg.b_type = arg.c_type = arg.d_type = type;
+        arg.compute_type = default_compute_type(type);
+        arg.bias_type    = default_bias_type(type);
+    });
+    expand(split_sweep_list(sweep.trans), [](Arguments& arg, const std::string& trans) {
+        if(trans.empty())
+            return;
+        if(trans.size() != 2 || !strchr("NT", toupper(trans[0]))
+           || !strchr("NT", toupper(trans[1])))
+            throw std::invalid_argument("Invalid value for --sweep_trans " + trans);
+        arg.transA = toupper(trans[0]);
+        arg.transB = toupper(trans[1]);
+    });
+    expand(split_sweep_list(sweep.activation), [](Arguments& arg, const std::string& activation) {
+        if(activation.empty())
+            return;
+        arg.activation_type = string_to_hipsparselt_activation_type(activation);
+        if(arg.activation_type == static_cast<hipsparselt_activation_type>(-1))
+            throw std::invalid_argument("Invalid value for --sweep_activation " + activation);
+        arg.activation_arg1 = arg.activation_type == hipsparselt_activation_type::gelu ? 1.f : 0.f;
+    });
+    expand(parse_sweep_range("--sweep_batch_count", sweep.batch_count, base.batch_count),
+           [](Arguments& arg, int64_t batch_count) { arg.batch_count = batch_count; });
+    expand(parse_sweep_range("--sweep_m", sweep.m, base.M),
+           [](Arguments& arg, int64_t m) { arg.M = m; });
+    expand(parse_sweep_range("--sweep_n", sweep.n, base.N),
+           [](Arguments& arg, int64_t n) { arg.N = n; });
+    expand(parse_sweep_range("--sweep_k", sweep.k, base.K),
+           [](Arguments& arg, int64_t k) { arg.K = k; });
+
+    // the leading dimensions and strides follow the sizes
+    for(auto& arg : cases)
+    {
+        arg.lda = arg.ldb = arg.ldc = arg.ldd = -1;
+        arg.stride_a = arg.stride_b = arg.stride_c = arg.stride_d = -1;
+    }
+
+    auto type_bytes = [](hipsparseLtDatatype_t type) {
+        return type == HIPSPARSELT_R_32F                                ? 4
+               : type == HIPSPARSELT_R_16F || type == HIPSPARSELT_R_16BF ? 2
+                                                                         : 1;
+    };
+    auto footprint = [&](const Arguments& arg) {
+        return double(arg.batch_count)
+               * ((arg.M * arg.K + arg.K * arg.N) * type_bytes(arg.a_type)
+                  + 2 * arg.M * arg.N * type_bytes(arg.c_type));
+    };
+    std::vector<size_t> order(cases.size());
+    for(size_t i = 0; i < order.size(); i++)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return footprint(cases[a]) > footprint(cases[b]);
+    });
+
+    struct sweep_result
+    {
+        double gpu_us;
+        double gflops;
+    };
+    std::vector<sweep_result> results(cases.size());
+
+    int ret = 0;
+    d_vector_set_memory_cache(true);
+    for(size_t i : order)
+    {
+        Arguments arg = cases[i];
+        ArgumentModel_set_last_perf(ArgumentLogging::NA_value, ArgumentLogging::NA_value);
+        try
+        {
+            ret |= run_bench_test(arg, filter, any_stride);
+        }
+        catch(const std::invalid_argument& exp)
+        {
+            // an unsupported combination of the sweep fails its row only
+            hipsparselt_cerr << exp.what() << std::endl;
+            ret = -1;
+        }
+        ArgumentModel_get_last_perf(results[i].gpu_us, results[i].gflops);
+    }
+    d_vector_set_memory_cache(false);
+
+    hipsparselt_cout << "\nhipsparselt-bench sweep of " << cases.size() << " cases\n"
+                     << "function,a_type,transA,transB,activation_type,M,N,K,batch_count,us,"
+                        "hipsparselt-Gflops"
+                     << std::endl;
+    for(size_t i = 0; i < cases.size(); i++)
+    {
+        const auto& arg = cases[i];
+        hipsparselt_cout << arg.function << "," << hipsparselt_datatype_to_string(arg.a_type)
+                         << "," << arg.transA << "," << arg.transB << ","
+                         << hipsparselt_activation_type_to_string(arg.activation_type) << ","
+                         << arg.M << "," << arg.N << "," << arg.K << "," << arg.batch_count
+                         << ",";
+        if(results[i].gpu_us <= 0)
+            hipsparselt_cout << "failed,failed" << std::endl;
+        else
+            hipsparselt_cout << results[i].gpu_us << "," << results[i].gflops << std::endl;
+    }
+    return ret;
+}
+
 // Replace --batch with --batch_count for backward compatibility
 void fix_batch(int argc, char* argv[])
 {
@@ -254,7 +570,8 @@ void fix_batch(int argc, char* argv[])
         }
 }
 
-int main(int argc, char* argv[])
+// replay_entry runs one command line of a replay on the device which is already set
+int bench_main(int argc, char* argv[], bool replay_entry)
 try
 {
     fix_batch(argc, argv);
@@ -270,12 +587,22 @@ try
     std::string initialization;
     std::string filter;
     std::string activation_type;
+    std::string replay;
+    std::string csv_file;
+    std::string json_file;
+    std::string baseline_file;
+    double      tolerance;
+    double      peak_gflops;
+    double      peak_gbps;
     int         device_id;
     int         flags             = 0;
     bool        datafile          = hipsparselt_parse_data(argc, argv);
     bool        log_function_name = false;
     bool        any_stride        = false;
 
+    // ranges and lists of a shape sweep
+    sweep_options sweep;
+
     arg.init(); // set all defaults
 
     options_description desc("hipsparselt-bench command line options");
@@ -432,6 +759,10 @@ try
          value<std::string>(&bias_type), "Precision of bias. (default: f16_r - when input precision is f16_r, bf16_r - when input precision is bf16_r, f32_r - when input precision is i8_r ) "
          "Options: s,f32_r,h,f16_r,b,bf16_r")
 
+        ("output_scale",
+         bool_switch(&arg.output_scale)->default_value(false),
+         "Quantize the output with per row scales and zero points. (i8_r input, i8_r or f16_r output, ignored for other types)")
+
         ("device",
          value<int>(&device_id)->default_value(0),
          "Set default device to be used for subsequent program runs")
@@ -456,6 +787,82 @@ try
          bool_switch(&arg.sparse_b)->default_value(false),
          "Structurted Sparsity Matrix B (A is Dense Matrix)")
 
+        ("launches",
+         value<int32_t>(&arg.launches)->default_value(0),
+         "Run the matmul this many times per hipsparseLtMatmulMultiple call and report the host overhead per launch. (default: 0, use hipsparseLtMatmul)")
+
+        ("config_id",
+         value<int32_t>(&arg.config_id)->default_value(0),
+         "Use this algorithm config instead of the default one, ignored when it does not exist. (default: 0)")
+
+        ("cold_cache",
+         bool_switch(&arg.cold_cache)->default_value(false),
+         "Also time the matmul on rotating copies of the operands, enough to overflow twice the l2CacheSize of hipDeviceProp_t, and report the cold numbers next to the hot ones")
+
+        ("concurrent_threads",
+         value<int32_t>(&arg.concurrent_threads)->default_value(0),
+         "Also run the matmul from 1, 2, 4, ... up to this many host threads, each with its own handle, plan and --concurrent_streams streams, and report the aggregate throughput and the per thread latency. (default: 0, off)")
+
+        ("concurrent_streams",
+         value<int32_t>(&arg.concurrent_streams)->default_value(1),
+         "Number of streams of each host thread of --concurrent_threads. (default: 1)")
+
+        ("sweep_m",
+         value<std::string>(&sweep.m),
+         "Sweep m over first:last:step, a step of *f is geometric and of +s linear, and print one table of all the cases. The leading dimensions and strides follow the sizes")
+
+        ("sweep_n",
+         value<std::string>(&sweep.n),
+         "Sweep n over first:last:step")
+
+        ("sweep_k",
+         value<std::string>(&sweep.k),
+         "Sweep k over first:last:step")
+
+        ("sweep_batch_count",
+         value<std::string>(&sweep.batch_count),
+         "Sweep batch_count over first:last:step")
+
+        ("sweep_precision",
+         value<std::string>(&sweep.precision),
+         "Sweep a comma separated list of precisions, e.g. f16_r,bf16_r,i8_r")
+
+        ("sweep_trans",
+         value<std::string>(&sweep.trans),
+         "Sweep a comma separated list of transA transB pairs, e.g. NN,NT,TN,TT")
+
+        ("sweep_activation",
+         value<std::string>(&sweep.activation),
+         "Sweep a comma separated list of activation types, e.g. none,relu,gelu")
+
+        ("replay",
+         value<std::string>(&replay),
+         "Run the unique hipsparselt-bench command lines of a HIPSPARSELT_LOG_BENCH_FILE and report the throughput weighted by their number of calls")
+
+        ("csv",
+         value<std::string>(&csv_file),
+         "Also write the results to this CSV file, with the per-iteration min/median/p90/p99/stddev us")
+
+        ("json",
+         value<std::string>(&json_file),
+         "Also write the results to this JSON file")
+
+        ("baseline",
+         value<std::string>(&baseline_file),
+         "CSV file written by --csv of a previous run, a time of the same function and arguments (us, median-us, p99-us) above it by more than the tolerance is a regression and fails the run")
+
+        ("tolerance",
+         value<double>(&tolerance)->default_value(5.0),
+         "Regression tolerance in percent, overridden by a tolerance column of the baseline")
+
+        ("peak_gflops",
+         value<double>(&peak_gflops)->default_value(0),
+         "Compute peak of the %peak-Gflops column, 0 derives it from the hipDeviceProp_t of the device and the data type")
+
+        ("peak_gbps",
+         value<double>(&peak_gbps)->default_value(0),
+         "Memory bandwidth peak of the %peak-GB/s column, 0 derives it from the memory clock and bus width of the hipDeviceProp_t")
+
         ("log_function_name",
          bool_switch(&log_function_name)->default_value(false),
          "Function name precedes other itmes.")
@@ -489,20 +896,28 @@ try
         return 0;
     }
 
-    // transfer local variable state
-    ArgumentModel_set_log_function_name(log_function_name);
-
-    // Device Query
-    int64_t device_count = query_device_property();
-
-    hipsparselt_cout << std::endl;
-    if(device_count <= device_id)
-        throw std::invalid_argument("Invalid Device ID");
-    set_device(device_id);
+    if(!replay_entry)
+    {
+        // transfer local variable state
+        ArgumentModel_set_log_function_name(log_function_name);
+        hipsparselt_bench_report_open(csv_file, json_file, baseline_file, tolerance);
+        hipsparselt_bench_set_peaks(peak_gflops, peak_gbps);
+
+        // Device Query
+        int64_t device_count = query_device_property();
+
+        hipsparselt_cout << std::endl;
+        if(device_count <= device_id)
+            throw std::invalid_argument("Invalid Device ID");
+        set_device(device_id);
+    }
 
     if(datafile)
         return hipsparselt_bench_datafile(filter, any_stride);
 
+    if(!replay.empty())
+        return hipsparselt_bench_replay(replay);
+
     // single bench run
 
     // validate arguments
@@ -528,25 +943,14 @@ try
     if(arg.d_type == static_cast<hipsparseLtDatatype_t>(-1))
         throw std::invalid_argument("Invalid value for --d_type " + d_type);
 
-    bool is_f16      = arg.a_type == HIPSPARSELT_R_16F || arg.a_type == HIPSPARSELT_R_16BF;
-    bool is_f32      = arg.a_type == HIPSPARSELT_R_32F;
-    arg.compute_type = compute_type == ""
-#ifdef __HIP_PLATFORM_AMD__
-                           ? (is_f16 ? HIPSPARSELT_COMPUTE_32F : HIPSPARSELT_COMPUTE_32I)
-#else
-                           ? (is_f16   ? HIPSPARSELT_COMPUTE_16F
-                              : is_f32 ? HIPSPARSELT_COMPUTE_TF32
-                                       : HIPSPARSELT_COMPUTE_32I)
-#endif
-                           : string_to_hipsparselt_computetype(compute_type);
+    arg.compute_type = compute_type == "" ? default_compute_type(arg.a_type)
+                                          : string_to_hipsparselt_computetype(compute_type);
     if(arg.compute_type == static_cast<hipsparseLtComputetype_t>(-1))
         throw std::invalid_argument("Invalid value for --compute_type " + compute_type);
 
     if(bias_type == "")
     {
-        arg.bias_type = (arg.a_type == HIPSPARSELT_R_16F || arg.a_type == HIPSPARSELT_R_16BF)
-                            ? arg.a_type
-                            : HIPSPARSELT_R_32F;
+        arg.bias_type = default_bias_type(arg.a_type);
     }
     else
     {
@@ -583,6 +987,9 @@ try
     if(copied <= 0 || copied >= sizeof(arg.function))
         throw std::invalid_argument("Invalid value for --function");
 
+    if(sweep.any())
+        return hipsparselt_bench_sweep(arg, sweep, filter, any_stride);
+
     return run_bench_test(arg, filter, any_stride);
 }
 catch(const std::invalid_argument& exp)
@@ -590,3 +997,12 @@ catch(const std::invalid_argument& exp)
     hipsparselt_cerr << exp.what() << std::endl;
     return -1;
 }
+
+int main(int argc, char* argv[])
+{
+    int ret = bench_main(argc, argv);
+    // a regression against the --baseline fails the run
+    if(hipsparselt_bench_report_close() && ret == 0)
+        ret = 1;
+    return ret;
+}
@@ -39,3 +39,18 @@ bool ArgumentModel_get_log_function_name()
 {
     return log_function_name;
 }
+
+static double last_gpu_us = ArgumentLogging::NA_value;
+static double last_gflops = ArgumentLogging::NA_value;
+
+void ArgumentModel_set_last_perf(double gpu_us, double gflops)
+{
+    last_gpu_us = gpu_us;
+    last_gflops = gflops;
+}
+
+void ArgumentModel_get_last_perf(double& gpu_us, double& gflops)
+{
+    gpu_us = last_gpu_us;
+    gflops = last_gflops;
+}
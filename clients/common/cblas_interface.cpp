@@ -26,8 +26,11 @@
 #include "cblas_interface.hpp"
 #include "hipsparselt_vector.hpp"
 #include "utility.hpp"
+#include <algorithm>
 #include <bitset>
+#include <cmath>
 #include <omp.h>
+#include <vector>
 
 CBLAS_TRANSPOSE HIPOperationToCBLASTanspose(hipsparseOperation_t trans)
 {
@@ -442,3 +445,163 @@ void cblas_gemm<int8_t, __half, float>(hipsparseOperation_t transA,
     for(size_t i = 0; i < sizeC; i++)
         C[i] = __half(C_double[i]);
 }
+
+namespace
+{
+    // tile of C computed by one thread and depth of the packed panels
+    constexpr int64_t blocked_mb = 64;
+    constexpr int64_t blocked_nb = 64;
+    constexpr int64_t blocked_kb = 256;
+
+    // accumulation type of the packed panels and type of alpha * A * B + beta * C, int8_t
+    // products are summed exactly and combined in double like cblas_gemm
+    template <typename Ti>
+    struct blocked_types
+    {
+        using acc = float;
+        using out = float;
+    };
+
+    template <>
+    struct blocked_types<int8_t>
+    {
+        using acc = int32_t;
+        using out = double;
+    };
+
+    template <typename To, typename T>
+    inline To blocked_convert(T val)
+    {
+        if constexpr(std::is_same<To, int8_t>{})
+        {
+            double v = std::nearbyint(double(val));
+            return static_cast<int8_t>(v > 127.f ? 127.f : v < -128.f ? -128.f : v);
+        }
+        else
+            return static_cast<To>(float(val));
+    }
+}
+
+template <typename Ti, typename To>
+void cblas_gemm_blocked(hipsparseOperation_t       transA,
+                        hipsparseOperation_t       transB,
+                        int64_t                    m,
+                        int64_t                    n,
+                        int64_t                    k,
+                        float                      alpha,
+                        const Ti*                  A,
+                        int64_t                    lda,
+                        const Ti*                  B,
+                        int64_t                    ldb,
+                        float                      beta,
+                        To*                        C,
+                        int64_t                    ldc,
+                        const cblas_gemm_epilogue& epilogue)
+{
+    using Tacc = typename blocked_types<Ti>::acc;
+    using Tout = typename blocked_types<Ti>::out;
+
+    const bool    tA      = transA != HIPSPARSE_OPERATION_NON_TRANSPOSE;
+    const bool    tB      = transB != HIPSPARSE_OPERATION_NON_TRANSPOSE;
+    const int64_t m_tiles = (m + blocked_mb - 1) / blocked_mb;
+    const int64_t n_tiles = (n + blocked_nb - 1) / blocked_nb;
+
+#pragma omp parallel
+    {
+        // Ap is k major so that the inner loop runs over the rows of the tile
+        std::vector<Tacc> Ap(blocked_kb * blocked_mb), Bp(blocked_nb * blocked_kb);
+        std::vector<Tacc> acc(blocked_nb * blocked_mb);
+
+#pragma omp for collapse(2) schedule(dynamic)
+        for(int64_t it = 0; it < m_tiles; it++)
+            for(int64_t jt = 0; jt < n_tiles; jt++)
+            {
+                const int64_t i0 = it * blocked_mb, mb = std::min(blocked_mb, m - i0);
+                const int64_t j0 = jt * blocked_nb, nb = std::min(blocked_nb, n - j0);
+                std::fill(acc.begin(), acc.end(), Tacc(0));
+
+                for(int64_t p0 = 0; p0 < k; p0 += blocked_kb)
+                {
+                    const int64_t kb = std::min(blocked_kb, k - p0);
+                    for(int64_t p = 0; p < kb; p++)
+                    {
+                        Tacc* a = &Ap[p * blocked_mb];
+                        if(tA)
+                            for(int64_t i = 0; i < mb; i++)
+                                a[i] = Tacc(float(A[(i0 + i) * lda + p0 + p]));
+                        else
+                        {
+                            const Ti* col = A + (p0 + p) * lda + i0;
+#pragma omp simd
+                            for(int64_t i = 0; i < mb; i++)
+                                a[i] = Tacc(float(col[i]));
+                        }
+                    }
+                    for(int64_t j = 0; j < nb; j++)
+                    {
+                        Tacc* b = &Bp[j * blocked_kb];
+                        if(tB)
+                            for(int64_t p = 0; p < kb; p++)
+                                b[p] = Tacc(float(B[(p0 + p) * ldb + j0 + j]));
+                        else
+                        {
+                            const Ti* col = B + (j0 + j) * ldb + p0;
+#pragma omp simd
+                            for(int64_t p = 0; p < kb; p++)
+                                b[p] = Tacc(float(col[p]));
+                        }
+                    }
+
+                    for(int64_t j = 0; j < nb; j++)
+                    {
+                        Tacc* c = &acc[j * blocked_mb];
+                        for(int64_t p = 0; p < kb; p++)
+                        {
+                            const Tacc  b = Bp[j * blocked_kb + p];
+                            const Tacc* a = &Ap[p * blocked_mb];
+#pragma omp simd
+                            for(int64_t i = 0; i < blocked_mb; i++)
+                                c[i] += a[i] * b;
+                        }
+                    }
+                }
+
+                for(int64_t j = 0; j < nb; j++)
+                    for(int64_t i = 0; i < mb; i++)
+                    {
+                        To&  c = C[(j0 + j) * ldc + i0 + i];
+                        Tout v = Tout(alpha) * Tout(acc[j * blocked_mb + i]);
+                        if(beta != 0)
+                            v += Tout(beta) * Tout(float(c));
+                        c = epilogue ? blocked_convert<To>(epilogue(float(v), i0 + i))
+                                     : blocked_convert<To>(v);
+                    }
+            }
+    }
+}
+
+#define GENERATE_DEFINITIONS(Ti, To)                                                          \
+    template void cblas_gemm_blocked<Ti, To>(hipsparseOperation_t,                            \
+                                             hipsparseOperation_t,                            \
+                                             int64_t,                                         \
+                                             int64_t,                                         \
+                                             int64_t,                                         \
+                                             float,                                           \
+                                             const Ti*,                                       \
+                                             int64_t,                                         \
+                                             const Ti*,                                       \
+                                             int64_t,                                         \
+                                             float,                                           \
+                                             To*,                                             \
+                                             int64_t,                                         \
+                                             const cblas_gemm_epilogue&);
+
+GENERATE_DEFINITIONS(__half, __half)
+GENERATE_DEFINITIONS(__half, float)
+GENERATE_DEFINITIONS(hip_bfloat16, hip_bfloat16)
+GENERATE_DEFINITIONS(hip_bfloat16, float)
+GENERATE_DEFINITIONS(int8_t, int8_t)
+GENERATE_DEFINITIONS(int8_t, float)
+GENERATE_DEFINITIONS(int8_t, __half)
+
+#undef GENERATE_DEFINITIONS
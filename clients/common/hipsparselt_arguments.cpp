@@ -103,6 +103,14 @@ void Arguments::init()
     HMM             = false;
     search          = false;
     search_iters    = 10;
+    launches        = 0;
+    config_id       = 0;
+    cold_cache      = false;
+
+    concurrent_threads = 0;
+    concurrent_streams = 1;
+
+    output_scale = false;
 }
 
 // Function to print Arguments out to stream in YAML format
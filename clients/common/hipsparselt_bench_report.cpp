@@ -0,0 +1,347 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "hipsparselt_bench_report.hpp"
+#include "hipsparselt_ostream.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <hip/hip_runtime.h>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+hipsparselt_timing_stats hipsparselt_compute_timing_stats(std::vector<double>& us)
+{
+    hipsparselt_timing_stats stats{};
+    if(us.empty())
+        return stats;
+
+    std::sort(us.begin(), us.end());
+    // nearest rank percentile
+    auto percentile = [&](double p) {
+        size_t rank = size_t(std::ceil(p / 100 * us.size()));
+        return us[std::min(std::max(rank, size_t(1)), us.size()) - 1];
+    };
+
+    double mean = 0;
+    for(double t : us)
+        mean += t;
+    mean /= us.size();
+    double var = 0;
+    for(double t : us)
+        var += (t - mean) * (t - mean);
+
+    stats.min    = us.front();
+    stats.median = us.size() % 2 ? us[us.size() / 2]
+                                 : (us[us.size() / 2 - 1] + us[us.size() / 2]) / 2;
+    stats.p90    = percentile(90);
+    stats.p99    = percentile(99);
+    stats.stddev = us.size() > 1 ? std::sqrt(var / (us.size() - 1)) : 0;
+    return stats;
+}
+
+// this should have been passed to log_args but the variadic ArgumentModel template has a
+// fixed list of performance values, the same as the log_function_name singleton.
+static std::vector<double> iteration_us;
+
+void hipsparselt_bench_set_iteration_us(std::vector<double> us)
+{
+    iteration_us = std::move(us);
+}
+
+bool hipsparselt_bench_take_timing_stats(hipsparselt_timing_stats& stats)
+{
+    if(iteration_us.empty())
+        return false;
+    stats = hipsparselt_compute_timing_stats(iteration_us);
+    iteration_us.clear();
+    return true;
+}
+
+namespace
+{
+    using baseline_row = std::map<std::string, std::string>;
+
+    struct bench_report
+    {
+        std::ofstream             csv;
+        std::string               csv_header;
+        std::ofstream             json;
+        bool                      json_first = true;
+        std::vector<baseline_row> baseline;
+        double                    tolerance   = 0;
+        int                       regressions = 0;
+    };
+
+    bench_report& report()
+    {
+        static bench_report r;
+        return r;
+    }
+
+    std::vector<std::string> split_csv(const std::string& line)
+    {
+        std::vector<std::string> fields;
+        std::istringstream       iss(line);
+        for(std::string field; std::getline(iss, field, ',');)
+        {
+            // the stdout format has a space after the comma of some columns
+            size_t begin = field.find_first_not_of(' ');
+            fields.push_back(begin == std::string::npos ? "" : field.substr(begin));
+        }
+        return fields;
+    }
+
+    std::string json_string(const std::string& str)
+    {
+        std::string quoted = "\"";
+        for(char c : str)
+        {
+            if(c == '"' || c == '\\')
+                quoted += '\\';
+            quoted += c;
+        }
+        return quoted + "\"";
+    }
+
+    // null keeps the JSON valid for a nan or inf norm error
+    std::string format(double value)
+    {
+        if(!std::isfinite(value))
+            return "null";
+        std::ostringstream oss;
+        oss.precision(7);
+        oss << std::fixed << value;
+        return oss.str();
+    }
+}
+
+void hipsparselt_bench_report_open(const std::string& csv_file,
+                                   const std::string& json_file,
+                                   const std::string& baseline_file,
+                                   double             tolerance)
+{
+    auto& r     = report();
+    r.tolerance = tolerance;
+
+    if(!csv_file.empty())
+    {
+        r.csv.open(csv_file);
+        if(!r.csv)
+            throw std::invalid_argument("Invalid value for --csv " + csv_file);
+    }
+
+    if(!json_file.empty())
+    {
+        r.json.open(json_file);
+        if(!r.json)
+            throw std::invalid_argument("Invalid value for --json " + json_file);
+        r.json << "[";
+    }
+
+    if(!baseline_file.empty())
+    {
+        std::ifstream ifs(baseline_file);
+        if(!ifs)
+            throw std::invalid_argument("Invalid value for --baseline " + baseline_file);
+
+        // a header row starts with the function column, the rows of a header follow it
+        std::vector<std::string> header;
+        for(std::string line; std::getline(ifs, line);)
+        {
+            auto fields = split_csv(line);
+            if(fields.empty())
+                continue;
+            if(fields[0] == "function")
+            {
+                header = std::move(fields);
+                continue;
+            }
+            baseline_row row;
+            for(size_t i = 0; i < std::min(header.size(), fields.size()); i++)
+                row[header[i]] = fields[i];
+            r.baseline.push_back(std::move(row));
+        }
+    }
+}
+
+void hipsparselt_bench_report_result(
+    const std::string&                                      function,
+    const std::vector<std::pair<std::string, std::string>>& args,
+    const std::vector<std::pair<std::string, double>>&      perf)
+{
+    auto& r = report();
+
+    if(r.csv.is_open())
+    {
+        std::string header = "function", values = function;
+        for(auto& a : args)
+        {
+            header += "," + a.first;
+            values += "," + a.second;
+        }
+        for(auto& p : perf)
+        {
+            header += "," + p.first;
+            values += "," + format(p.second);
+        }
+        // a new header whenever the columns change, e.g. between batched and not batched
+        if(header != r.csv_header)
+        {
+            r.csv << header << "\n";
+            r.csv_header = header;
+        }
+        r.csv << values << std::endl;
+    }
+
+    if(r.json.is_open())
+    {
+        r.json << (r.json_first ? "\n" : ",\n") << "{\"function\":" << json_string(function)
+               << ",\"args\":{";
+        const char* delim = "";
+        for(auto& a : args)
+        {
+            r.json << delim << json_string(a.first) << ":" << json_string(a.second);
+            delim = ",";
+        }
+        r.json << "},\"perf\":{";
+        delim = "";
+        for(auto& p : perf)
+        {
+            r.json << delim << json_string(p.first) << ":" << format(p.second);
+            delim = ",";
+        }
+        r.json << "}}" << std::flush;
+        r.json_first = false;
+    }
+
+    // the baseline row of the same function with the same arguments
+    auto match = std::find_if(r.baseline.begin(), r.baseline.end(), [&](const baseline_row& row) {
+        auto f = row.find("function");
+        if(f == row.end() || f->second != function)
+            return false;
+        for(auto& a : args)
+        {
+            auto v = row.find(a.first);
+            if(v == row.end() || v->second != a.second)
+                return false;
+        }
+        return true;
+    });
+    if(match == r.baseline.end())
+        return;
+
+    auto        t         = match->find("tolerance");
+    double      tolerance = t != match->end() ? atof(t->second.c_str()) : r.tolerance;
+    std::string shape     = function;
+    for(auto& a : args)
+        shape += " " + a.first + "=" + a.second;
+    for(auto& p : perf)
+    {
+        if(p.first != "us" && p.first != "median-us" && p.first != "p99-us")
+            continue;
+        auto b = match->find(p.first);
+        if(b == match->end())
+            continue;
+        double base = atof(b->second.c_str());
+        if(base > 0 && p.second > base * (1 + tolerance / 100))
+        {
+            r.regressions++;
+            hipsparselt_cout << "hipsparselt-bench REGRESSION: " << shape << ", " << p.first
+                             << " = " << p.second << ", baseline = " << base << " (+"
+                             << (p.second / base - 1) * 100 << "%, tolerance " << tolerance
+                             << "%)" << std::endl;
+        }
+    }
+}
+
+int hipsparselt_bench_report_close()
+{
+    auto& r = report();
+    if(r.csv.is_open())
+        r.csv.close();
+    if(r.json.is_open())
+    {
+        r.json << "\n]\n";
+        r.json.close();
+    }
+    if(!r.baseline.empty())
+        hipsparselt_cout << "hipsparselt-bench INFO: " << r.regressions
+                         << " regression(s) against the baseline" << std::endl;
+    return r.regressions;
+}
+
+static double peak_gflops = 0;
+static double peak_gbps   = 0;
+
+void hipsparselt_bench_set_peaks(double gflops, double gbps)
+{
+    peak_gflops = gflops;
+    peak_gbps   = gbps;
+}
+
+// dense matrix core flops per compute unit and clock, structured sparse runs at twice of it.
+static double matrix_flops_per_cu_clock(const char* arch, hipsparseLtDatatype_t type)
+{
+    bool int8_or_fp8 = type == HIPSPARSELT_R_8I || type == HIPSPARSELT_R_8F
+                       || type == HIPSPARSELT_R_8BF;
+    if(!strncmp(arch, "gfx940", 6) || !strncmp(arch, "gfx941", 6) || !strncmp(arch, "gfx942", 6))
+        return int8_or_fp8 ? 4096 : 2048;
+    return 0;
+}
+
+void hipsparselt_bench_get_peaks(hipsparseLtDatatype_t type, double& gflops, double& gbps)
+{
+    gflops = peak_gflops;
+    gbps   = peak_gbps;
+    if(gflops > 0 && gbps > 0)
+        return;
+
+    static std::map<int, hipDeviceProp_t> device_props;
+    int                                   device;
+    if(hipGetDevice(&device) != hipSuccess)
+        return;
+    auto it = device_props.find(device);
+    if(it == device_props.end())
+    {
+        hipDeviceProp_t props;
+        if(hipGetDeviceProperties(&props, device) != hipSuccess)
+            return;
+        it = device_props.emplace(device, props).first;
+    }
+    const hipDeviceProp_t& props = it->second;
+
+    // clockRate and memoryClockRate are in kHz, the memory transfers twice per clock
+    if(gflops <= 0)
+        gflops = 2 * matrix_flops_per_cu_clock(props.gcnArchName, type)
+                 * props.multiProcessorCount * props.clockRate / 1e6;
+    if(gbps <= 0)
+        gbps = 2.0 * props.memoryClockRate * (props.memoryBusWidth / 8) / 1e6;
+}
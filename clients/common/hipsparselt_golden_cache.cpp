@@ -0,0 +1,204 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#include "hipsparselt_golden_cache.hpp"
+#include "hipsparselt_random.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    // bump the version when the layout or the meaning of a result changes
+    constexpr char golden_magic[8] = {'H', 'S', 'L', 'T', 'G', 'L', 'D', '2'};
+
+    struct golden_header
+    {
+        char     magic[8];
+        uint64_t key;
+        uint64_t input_hash;
+        uint64_t bytes;
+    };
+
+    // read on every use, so a test can point the cache to a directory of its own
+    std::string golden_dir()
+    {
+        const char* env = getenv("HIPSPARSELT_GOLDEN_CACHE");
+        return env ? env : "";
+    }
+
+    std::string golden_path(uint64_t key)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "/%016llx.bin", (unsigned long long)key);
+        return golden_dir() + name;
+    }
+}
+
+bool hipsparselt_golden_cache_enabled()
+{
+#ifdef WIN32
+    return false;
+#else
+    return !golden_dir().empty();
+#endif
+}
+
+uint64_t hipsparselt_golden_hash(const void* data, size_t bytes, uint64_t hash)
+{
+    constexpr uint64_t prime = 0x100000001b3;
+
+    auto   p     = static_cast<const unsigned char*>(data);
+    size_t words = bytes / sizeof(uint64_t);
+    for(size_t i = 0; i < words; i++)
+    {
+        uint64_t word;
+        memcpy(&word, p + i * sizeof(uint64_t), sizeof(uint64_t));
+        hash = (hash ^ word) * prime;
+    }
+    for(size_t i = words * sizeof(uint64_t); i < bytes; i++)
+        hash = (hash ^ p[i]) * prime;
+    return hash;
+}
+
+uint64_t hipsparselt_golden_key(const Arguments& arg, const char* tag)
+{
+    uint64_t hash = hipsparselt_golden_hash(tag, strlen(tag));
+    auto     mix  = [&](const auto& value) {
+        hash = hipsparselt_golden_hash(&value, sizeof(value), hash);
+    };
+
+    hash = hipsparselt_golden_hash(arg.function, strlen(arg.function), hash);
+
+    // the fields which determine the data and the result, not how the test is run
+    mix(arg.alpha);
+    mix(arg.beta);
+    mix(arg.stride_a);
+    mix(arg.stride_b);
+    mix(arg.stride_c);
+    mix(arg.stride_d);
+    mix(arg.M);
+    mix(arg.N);
+    mix(arg.K);
+    mix(arg.lda);
+    mix(arg.ldb);
+    mix(arg.ldc);
+    mix(arg.ldd);
+    mix(arg.batch_count);
+    mix(arg.prune_algo);
+    mix(arg.a_type);
+    mix(arg.b_type);
+    mix(arg.c_type);
+    mix(arg.d_type);
+    mix(arg.compute_type);
+    mix(arg.initialization);
+    mix(arg.transA);
+    mix(arg.transB);
+    mix(arg.activation_type);
+    mix(arg.activation_arg1);
+    mix(arg.activation_arg2);
+    mix(arg.bias_vector);
+    mix(arg.bias_stride);
+    mix(arg.bias_type);
+    mix(arg.sparse_b);
+    mix(arg.output_scale);
+
+    // the first value of the random sequence of the main thread stands for its seed
+    hipsparselt_rng_t rng(g_hipsparselt_seed);
+    mix(rng());
+    return hash;
+}
+
+bool hipsparselt_golden_load(uint64_t key, uint64_t input_hash, void* dst, size_t bytes)
+{
+#ifdef WIN32
+    return false;
+#else
+    if(!hipsparselt_golden_cache_enabled())
+        return false;
+
+    int fd = open(golden_path(key).c_str(), O_RDONLY);
+    if(fd < 0)
+        return false;
+
+    bool        found = false;
+    struct stat st;
+    size_t      size = sizeof(golden_header) + bytes;
+    if(fstat(fd, &st) == 0 && size_t(st.st_size) == size)
+    {
+        void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(map != MAP_FAILED)
+        {
+            auto header = static_cast<const golden_header*>(map);
+            found       = !memcmp(header->magic, golden_magic, sizeof(golden_magic))
+                    && header->key == key && header->input_hash == input_hash
+                    && header->bytes == bytes;
+            if(found)
+                memcpy(dst, header + 1, bytes);
+            munmap(map, size);
+        }
+    }
+    close(fd);
+    return found;
+#endif
+}
+
+void hipsparselt_golden_store(uint64_t key, uint64_t input_hash, const void* src, size_t bytes)
+{
+#ifndef WIN32
+    if(!hipsparselt_golden_cache_enabled())
+        return;
+
+    // write a private file and rename it, a test in another process sees the old or new result
+    std::string path = golden_path(key);
+    std::string tmp  = path + "." + std::to_string(getpid());
+    FILE*       file = fopen(tmp.c_str(), "wb");
+    if(!file)
+        return;
+
+    golden_header header;
+    memcpy(header.magic, golden_magic, sizeof(golden_magic));
+    header.key        = key;
+    header.input_hash = input_hash;
+    header.bytes      = bytes;
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1
+              && (!bytes || fwrite(src, bytes, 1, file) == 1);
+    ok      = fclose(file) == 0 && ok;
+    if(!ok || rename(tmp.c_str(), path.c_str()))
+        remove(tmp.c_str());
+#endif
+}
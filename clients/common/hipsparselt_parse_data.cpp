@@ -25,14 +25,18 @@
  *******************************************************************************/
 #include "hipsparselt_parse_data.hpp"
 #include "hipsparselt_data.hpp"
+#include "hipsparselt_yaml_expand.hpp"
 #include "utility.hpp"
+#include <cerrno>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <fcntl.h>
+#include <fstream>
 #include <iostream>
 #include <string>
 #include <sys/types.h>
+#include <unistd.h>
 #ifdef WIN32
 #ifdef __cpp_lib_filesystem
 #include <filesystem>
@@ -46,25 +50,64 @@ namespace std
 #endif
 #endif // WIN32
 
-// Parse YAML data
-static std::string hipsparselt_parse_yaml(const std::string& yaml)
+// File of the expanded data in the HIPSPARSELT_DATA_CACHE directory, or "" when it is not set
+static std::string hipsparselt_data_cache_path(const hipsparselt_yaml_source& source)
 {
-    std::string tmp     = hipsparselt_tempname();
-    auto        exepath = hipsparselt_exepath();
-    auto        cmd     = exepath + "hipsparselt_gentest.py --template " + exepath
-               + "hipsparselt_template.yaml -o " + tmp + " " + yaml;
-    hipsparselt_cerr << cmd << std::endl;
+    const char* dir = getenv("HIPSPARSELT_DATA_CACHE");
+    if(!dir || !*dir)
+        return "";
 
-#ifdef WIN32
-    int status = std::system(cmd.c_str());
-    if(status == -1)
+    char     name[32];
+    uint64_t key = hipsparselt_yaml_hash(source);
+    snprintf(name, sizeof(name), "/%016llx.data", (unsigned long long)key);
+    return dir + std::string(name);
+}
+
+static bool hipsparselt_write_data(const std::string& path, const std::string& data)
+{
+    FILE* file = fopen(path.c_str(), "wb");
+    if(!file)
+        return false;
+    bool ok = (data.empty() || fwrite(data.data(), data.size(), 1, file) == 1);
+    return !fclose(file) && ok;
+}
+
+// Parse YAML data, removing the data file at exit unless it is kept in the cache
+static std::string hipsparselt_parse_yaml(const std::string& yaml, bool& remove_atexit)
+{
+    // the template and then the file, with includes also looked for next to the executable
+    auto                    exepath = hipsparselt_exepath();
+    hipsparselt_yaml_source source;
+    if(!hipsparselt_yaml_read(source, exepath + "hipsparselt_template.yaml", {exepath})
+       || !hipsparselt_yaml_read(source, yaml, {exepath}))
         exit(EXIT_FAILURE);
-#else
-    int status = system(cmd.c_str());
-    if(status == -1 || !WIFEXITED(status) || WEXITSTATUS(status))
+
+    // the data of the same YAML text is mapped from the cache instead of expanded again
+    std::string cache = hipsparselt_data_cache_path(source);
+    remove_atexit     = false;
+    if(cache != "" && std::ifstream(cache))
+        return cache;
+
+    std::string data;
+    if(!hipsparselt_yaml_expand(source, data))
         exit(EXIT_FAILURE);
-#endif
 
+    // write a private file and rename it, another process reads the old or the new file
+    if(cache != "")
+    {
+        std::string tmp = cache + "." + std::to_string(getpid());
+        if(hipsparselt_write_data(tmp, data) && !rename(tmp.c_str(), cache.c_str()))
+            return cache;
+        remove(tmp.c_str());
+    }
+
+    std::string tmp = hipsparselt_tempname();
+    if(!hipsparselt_write_data(tmp, data))
+    {
+        hipsparselt_cerr << "Cannot write " << tmp << ": " << strerror(errno) << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    remove_atexit = true;
     return tmp;
 }
 
@@ -73,7 +116,7 @@ bool hipsparselt_parse_data(int& argc, char** argv, const std::string& default_f
 {
     std::string filename;
     char**      argv_p = argv + 1;
-    bool        help = false, yaml = false;
+    bool        help = false, yaml = false, remove_atexit = false;
 
     // Scan, process and remove any --yaml or --data options
     for(int i = 1; argv[i]; ++i)
@@ -123,11 +166,11 @@ bool hipsparselt_parse_data(int& argc, char** argv, const std::string& default_f
         filename = default_file;
 
     if(yaml)
-        filename = hipsparselt_parse_yaml(filename);
+        filename = hipsparselt_parse_yaml(filename, remove_atexit);
 
     if(filename != "")
     {
-        HipSparseLt_TestData::set_filename(filename, yaml);
+        HipSparseLt_TestData::set_filename(filename, remove_atexit);
         return true;
     }
 
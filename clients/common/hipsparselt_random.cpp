@@ -41,6 +41,15 @@ thread_local hipsparselt_rng_t t_hipsparselt_rng = get_seed();
 
 thread_local int t_hipsparselt_rand_idx;
 
+// The key of the counter-based generator follows from the same fixed seed
+uint64_t g_hipsparselt_counter_seed = [] {
+    hipsparselt_rng_t rng(g_hipsparselt_seed);
+    uint64_t          lo = rng();
+    return lo | uint64_t(rng()) << 32;
+}();
+
+thread_local uint32_t t_hipsparselt_rng_stream;
+
 // length to allow use as bitmask to wraparound
 #define RANDLEN 1024
 #define RANDWIN 256
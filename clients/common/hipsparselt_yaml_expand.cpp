@@ -0,0 +1,1964 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#include "hipsparselt_yaml_expand.hpp"
+#include "hipsparselt_golden_cache.hpp"
+#include "hipsparselt_ostream.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace
+{
+    // bump the version when the expansion of the same YAML changes
+    constexpr char yaml_data_version[] = "hipSPARSELt YAML data 1";
+
+    struct yaml_error : std::runtime_error
+    {
+        using std::runtime_error::runtime_error;
+    };
+
+    /**************************************************************************
+     * Values, with the types and the equality and truth of the Python objects
+     * which PyYAML constructs.
+     **************************************************************************/
+    struct yaml_node;
+    using yaml_list = std::vector<yaml_node>;
+
+    // a mapping with string keys, kept sorted by key
+    using yaml_map = std::vector<std::pair<std::string, yaml_node>>;
+
+    struct yaml_node
+    {
+        enum kind_t
+        {
+            null_t,
+            bool_t,
+            int_t,
+            real_t,
+            string_t,
+            list_t,
+            map_t,
+        };
+
+        kind_t                             kind = null_t;
+        int64_t                            i    = 0; // bool_t and int_t
+        double                             r    = 0;
+        std::shared_ptr<const std::string> s;
+        std::shared_ptr<const yaml_list>   l;
+        std::shared_ptr<const yaml_map>    m;
+
+        bool is_int() const
+        {
+            return kind == bool_t || kind == int_t;
+        }
+
+        bool is_number() const
+        {
+            return is_int() || kind == real_t;
+        }
+
+        double real() const
+        {
+            return kind == real_t ? r : double(i);
+        }
+
+        const std::string& str() const
+        {
+            return *s;
+        }
+    };
+
+    yaml_node make_bool(bool b)
+    {
+        yaml_node node;
+        node.kind = yaml_node::bool_t;
+        node.i    = b;
+        return node;
+    }
+
+    yaml_node make_int(int64_t i)
+    {
+        yaml_node node;
+        node.kind = yaml_node::int_t;
+        node.i    = i;
+        return node;
+    }
+
+    yaml_node make_real(double r)
+    {
+        yaml_node node;
+        node.kind = yaml_node::real_t;
+        node.r    = r;
+        return node;
+    }
+
+    yaml_node make_string(std::string s)
+    {
+        yaml_node node;
+        node.kind = yaml_node::string_t;
+        node.s    = std::make_shared<const std::string>(std::move(s));
+        return node;
+    }
+
+    yaml_node make_list(yaml_list l)
+    {
+        yaml_node node;
+        node.kind = yaml_node::list_t;
+        node.l    = std::make_shared<const yaml_list>(std::move(l));
+        return node;
+    }
+
+    yaml_node make_map(yaml_map m)
+    {
+        yaml_node node;
+        node.kind = yaml_node::map_t;
+        node.m    = std::make_shared<const yaml_map>(std::move(m));
+        return node;
+    }
+
+    // name of the Python type of a value, for error messages
+    std::string type_name(const yaml_node& node, bool short_name = false)
+    {
+        static const char* const names[]
+            = {"NoneType", "bool", "int", "float", "str", "list", "dict"};
+        std::string name = names[node.kind];
+        return short_name ? name : "<class '" + name + "'>";
+    }
+
+    bool truth(const yaml_node& node)
+    {
+        switch(node.kind)
+        {
+        case yaml_node::null_t:
+            return false;
+        case yaml_node::bool_t:
+        case yaml_node::int_t:
+            return node.i != 0;
+        case yaml_node::real_t:
+            return node.r != 0;
+        case yaml_node::string_t:
+            return !node.s->empty();
+        case yaml_node::list_t:
+            return !node.l->empty();
+        case yaml_node::map_t:
+            return !node.m->empty();
+        }
+        return false;
+    }
+
+    bool equal(const yaml_node& a, const yaml_node& b);
+
+    bool equal(const yaml_map& a, const yaml_map& b)
+    {
+        if(a.size() != b.size())
+            return false;
+        for(size_t i = 0; i < a.size(); i++)
+            if(a[i].first != b[i].first || !equal(a[i].second, b[i].second))
+                return false;
+        return true;
+    }
+
+    bool equal(const yaml_node& a, const yaml_node& b)
+    {
+        if(a.is_number() && b.is_number())
+            return a.kind == yaml_node::real_t || b.kind == yaml_node::real_t ? a.real() == b.real()
+                                                                              : a.i == b.i;
+        if(a.kind != b.kind)
+            return false;
+        switch(a.kind)
+        {
+        case yaml_node::string_t:
+            return *a.s == *b.s;
+        case yaml_node::list_t:
+            return std::equal(
+                a.l->begin(), a.l->end(), b.l->begin(), b.l->end(), [](auto& x, auto& y) {
+                    return equal(x, y);
+                });
+        case yaml_node::map_t:
+            return equal(*a.m, *b.m);
+        default:
+            return true;
+        }
+    }
+
+    // Python repr of a value, for error messages
+    std::string repr(const yaml_node& node)
+    {
+        switch(node.kind)
+        {
+        case yaml_node::null_t:
+            return "None";
+        case yaml_node::bool_t:
+            return node.i ? "True" : "False";
+        case yaml_node::int_t:
+            return std::to_string(node.i);
+        case yaml_node::real_t:
+        {
+            if(std::isnan(node.r) || std::isinf(node.r))
+                return std::isnan(node.r) ? "nan" : node.r < 0 ? "-inf" : "inf";
+
+            // the shortest digits which read back the same, with a decimal point
+            char buf[32];
+            for(int digits = 1; digits <= 17; digits++)
+            {
+                snprintf(buf, sizeof(buf), "%.*g", digits, node.r);
+                if(strtod(buf, nullptr) == node.r)
+                    break;
+            }
+            std::string str = buf;
+            return str.find_first_of(".e") == std::string::npos ? str + ".0" : str;
+        }
+        case yaml_node::string_t:
+            return "'" + *node.s + "'";
+        case yaml_node::list_t:
+        {
+            std::string str = "[";
+            for(auto& item : *node.l)
+                str += (str.size() > 1 ? ", " : "") + repr(item);
+            return str + "]";
+        }
+        case yaml_node::map_t:
+        {
+            std::string str = "{";
+            for(auto& item : *node.m)
+                str += (str.size() > 1 ? ", '" : "'") + item.first + "': " + repr(item.second);
+            return str + "}";
+        }
+        }
+        return "";
+    }
+
+    const yaml_node* find(const yaml_map& map, const std::string& key)
+    {
+        auto it = std::lower_bound(map.begin(), map.end(), key, [](auto& item, auto& key) {
+            return item.first < key;
+        });
+        return it != map.end() && it->first == key ? &it->second : nullptr;
+    }
+
+    void set(yaml_map& map, const std::string& key, yaml_node value)
+    {
+        auto it = std::lower_bound(map.begin(), map.end(), key, [](auto& item, auto& key) {
+            return item.first < key;
+        });
+        if(it != map.end() && it->first == key)
+            it->second = std::move(value);
+        else
+            map.emplace(it, key, std::move(value));
+    }
+
+    void erase(yaml_map& map, const std::string& key)
+    {
+        auto it = std::lower_bound(map.begin(), map.end(), key, [](auto& item, auto& key) {
+            return item.first < key;
+        });
+        if(it != map.end() && it->first == key)
+            map.erase(it);
+    }
+
+    void update(yaml_map& map, const yaml_map& from)
+    {
+        for(auto& item : from)
+            set(map, item.first, item.second);
+    }
+
+    /**************************************************************************
+     * Parser of the YAML subset used by the test data, with the scalar
+     * resolution of PyYAML (YAML 1.1).
+     **************************************************************************/
+    bool is_space(char c)
+    {
+        return c == ' ' || c == '\t';
+    }
+
+    bool is_flow_indicator(char c)
+    {
+        return c == ',' || c == '[' || c == ']' || c == '{' || c == '}';
+    }
+
+    // digits, possibly separated by underscores, from p, returns the end
+    const char* scan_digits(const char* p, const char* end, const char* digits)
+    {
+        while(p < end && (strchr(digits, *p) || *p == '_'))
+            p++;
+        return p;
+    }
+
+    // (:[0-5]?[0-9])+ from p, returns p if there are none
+    const char* scan_sexagesimal(const char* p, const char* end)
+    {
+        const char* q = p;
+        while(q < end && *q == ':')
+        {
+            const char* r = q + 1;
+            if(r + 1 < end && r[0] >= '0' && r[0] <= '5' && isdigit(r[1]))
+                r += 2;
+            else if(r < end && isdigit(*r))
+                r++;
+            else
+                break;
+            q = r;
+        }
+        return q;
+    }
+
+    bool is_yaml_int(const std::string& s)
+    {
+        const char* p   = s.data();
+        const char* end = p + s.size();
+        if(p < end && (*p == '-' || *p == '+'))
+            p++;
+        if(p == end)
+            return false;
+        if(*p == '0')
+        {
+            if(p + 1 == end)
+                return true;
+            if(p[1] == 'b')
+                return p + 2 < end && scan_digits(p + 2, end, "01") == end;
+            if(p[1] == 'x')
+                return p + 2 < end && scan_digits(p + 2, end, "0123456789abcdefABCDEF") == end;
+            return scan_digits(p + 1, end, "01234567") == end;
+        }
+        if(*p < '1' || *p > '9')
+            return false;
+        p = scan_digits(p + 1, end, "0123456789");
+        return p == end || scan_sexagesimal(p, end) == end;
+    }
+
+    bool is_yaml_float(const std::string& s)
+    {
+        const char* p    = s.data();
+        const char* end  = p + s.size();
+        bool        sign = p < end && (*p == '-' || *p == '+');
+        if(sign)
+            p++;
+        if(p == end)
+            return false;
+
+        auto exponent = [&](const char* q) {
+            if(q < end && (*q == 'e' || *q == 'E'))
+            {
+                if(q + 2 > end || (q[1] != '-' && q[1] != '+'))
+                    return false;
+                q += 2;
+                const char* digits = q;
+                while(q < end && isdigit(*q))
+                    q++;
+                return q > digits && q == end;
+            }
+            return q == end;
+        };
+
+        if(*p == '.')
+        {
+            std::string rest(p + 1, end);
+            if(rest == "inf" || rest == "Inf" || rest == "INF")
+                return true;
+            if(!sign && (rest == "nan" || rest == "NaN" || rest == "NAN"))
+                return true;
+            return !sign && p + 1 < end && isdigit(p[1])
+                   && exponent(scan_digits(p + 2, end, "0123456789"));
+        }
+        if(!isdigit(*p))
+            return false;
+        p = scan_digits(p + 1, end, "0123456789");
+        if(p < end && *p == '.')
+            return exponent(scan_digits(p + 1, end, "0123456789"));
+        const char* q = scan_sexagesimal(p, end);
+        return q > p && q < end && *q == '.' && scan_digits(q + 1, end, "0123456789") == end;
+    }
+
+    // value of a sign and digits, with sexagesimal parts, in base
+    template <typename T>
+    T construct_number(std::string s, int base, T (*convert)(const char*, char**, int))
+    {
+        s.erase(std::remove(s.begin(), s.end(), '_'), s.end());
+        T sign = 1;
+        if(s[0] == '-' || s[0] == '+')
+        {
+            sign = s[0] == '-' ? -1 : 1;
+            s.erase(0, 1);
+        }
+        T value = 0;
+        for(size_t start = 0, colon; start <= s.size(); start = colon + 1)
+        {
+            colon = s.find(':', start);
+            if(colon == std::string::npos)
+                colon = s.size();
+            value = value * 60 + convert(s.substr(start, colon - start).c_str(), nullptr, base);
+        }
+        return sign * value;
+    }
+
+    // resolve and construct a plain scalar
+    yaml_node resolve_plain(const std::string& s)
+    {
+        if(s.empty() || s == "~" || s == "null" || s == "Null" || s == "NULL")
+            return {};
+        static const char* const yes[]
+            = {"yes", "Yes", "YES", "true", "True", "TRUE", "on", "On", "ON"};
+        static const char* const no[]
+            = {"no", "No", "NO", "false", "False", "FALSE", "off", "Off", "OFF"};
+        for(size_t i = 0; i < sizeof(yes) / sizeof(*yes); i++)
+            if(s == yes[i] || s == no[i])
+                return make_bool(s == yes[i]);
+
+        if(is_yaml_int(s))
+        {
+            errno = 0;
+            std::string digits = s;
+            digits.erase(std::remove(digits.begin(), digits.end(), '_'), digits.end());
+            size_t p    = digits[0] == '-' || digits[0] == '+';
+            int    base = 10;
+            if(digits.size() > p + 1 && digits[p] == '0')
+            {
+                base = digits[p + 1] == 'b' ? 2 : digits[p + 1] == 'x' ? 16 : 8;
+                digits.erase(p, base == 8 ? 1 : 2);
+            }
+            auto convert = [](const char* str, char** end, int base) -> long long {
+                return strtoll(str, end, base);
+            };
+            int64_t value = construct_number<long long>(digits, base, convert);
+            if(errno == ERANGE)
+                throw yaml_error("integer out of range: " + s);
+            return make_int(value);
+        }
+
+        if(is_yaml_float(s))
+        {
+            std::string lower = s;
+            lower.erase(std::remove(lower.begin(), lower.end(), '_'), lower.end());
+            std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+            // PyYAML constructs NaN as -inf / inf, which has the sign bit set on x86
+            if(lower == ".nan")
+                return make_real(std::copysign(std::numeric_limits<double>::quiet_NaN(), -1.0));
+            size_t p = lower[0] == '-' || lower[0] == '+';
+            if(lower.compare(p, std::string::npos, ".inf") == 0)
+                return make_real(lower[0] == '-' ? -INFINITY : INFINITY);
+            if(lower.find(':') != std::string::npos)
+            {
+                auto convert = [](const char* str, char** end, int) { return strtod(str, end); };
+                return make_real(construct_number<double>(lower, 10, convert));
+            }
+            return make_real(strtod(lower.c_str(), nullptr));
+        }
+
+        return make_string(s);
+    }
+
+    class yaml_parser
+    {
+        const hipsparselt_yaml_source& m_source;
+        size_t                         m_line = 0;
+        size_t                         m_col  = 0;
+        size_t                         m_end  = 0; // end line of the document
+
+        std::unordered_map<std::string, yaml_node> m_anchors;
+
+        const std::string& text() const
+        {
+            return m_source[m_line].text;
+        }
+
+        char peek(size_t ahead = 0) const
+        {
+            return m_line < m_end && m_col + ahead < text().size() ? text()[m_col + ahead] : 0;
+        }
+
+        [[noreturn]] void error(const std::string& problem) const
+        {
+            size_t line = std::min(m_line, m_source.size() - 1);
+            size_t col  = line == m_line ? m_col : 0;
+            auto&  src  = m_source[line];
+            throw yaml_error("In file " + src.file + ", line " + std::to_string(src.line)
+                             + ", column " + std::to_string(col + 1) + ":\n" + src.text + "\n"
+                             + std::string(col, ' ') + "^\n" + problem + "\n");
+        }
+
+        static bool is_marker(const std::string& line)
+        {
+            return (!line.compare(0, 3, "---") || !line.compare(0, 3, "..."))
+                   && (line.size() == 3 || is_space(line[3]));
+        }
+
+        void skip_spaces()
+        {
+            while(is_space(peek()))
+                m_col++;
+        }
+
+        bool at_line_end()
+        {
+            skip_spaces();
+            return !peek() || peek() == '#';
+        }
+
+        // Skip spaces, comments and line breaks. Returns false at the end of the document.
+        bool skip_blank(bool flow = false)
+        {
+            for(; m_line < m_end; m_line++, m_col = 0)
+                if(!at_line_end())
+                    return true;
+            if(flow)
+                error("found the end of the document in a flow collection");
+            return false;
+        }
+
+        void expect_line_end()
+        {
+            if(!at_line_end())
+                error("expected the end of the line, but found '" + std::string(1, peek()) + "'");
+        }
+
+        bool at_seq_entry()
+        {
+            return peek() == '-' && (!peek(1) || is_space(peek(1)));
+        }
+
+        std::string scan_name()
+        {
+            size_t start = ++m_col;
+            while(peek() && !is_space(peek()) && !is_flow_indicator(peek()))
+                m_col++;
+            if(m_col == start)
+                error("expected an anchor or alias name");
+            return text().substr(start, m_col - start);
+        }
+
+        yaml_node parse_alias()
+        {
+            size_t start = m_col;
+            auto   name  = scan_name();
+            auto   it    = m_anchors.find(name);
+            if(it == m_anchors.end())
+            {
+                m_col = start;
+                error("found undefined alias " + name);
+            }
+            return it->second;
+        }
+
+        // a single or double quoted scalar, which may continue on the following lines
+        std::string scan_quoted()
+        {
+            char        quote = peek();
+            std::string value;
+            m_col++;
+            for(;;)
+            {
+                char c = peek();
+                if(!c)
+                {
+                    // fold the line break into a space
+                    while(!value.empty() && is_space(value.back()))
+                        value.pop_back();
+                    if(++m_line >= m_end || is_marker(text()))
+                        error("found the end of the document in a quoted scalar");
+                    m_col = 0;
+                    skip_spaces();
+                    value += peek() ? ' ' : '\n';
+                    continue;
+                }
+                m_col++;
+                if(c == quote)
+                {
+                    if(quote == '\'' && peek() == '\'')
+                    {
+                        value += '\'';
+                        m_col++;
+                        continue;
+                    }
+                    return value;
+                }
+                if(c != '\\' || quote == '\'')
+                {
+                    value += c;
+                    continue;
+                }
+
+                char e = peek();
+                m_col++;
+                static const std::pair<char, char> escapes[]
+                    = {{'0', '\0'},
+                       {'a', '\a'},
+                       {'b', '\b'},
+                       {'t', '\t'},
+                       {'\t', '\t'},
+                       {'n', '\n'},
+                       {'v', '\v'},
+                       {'f', '\f'},
+                       {'r', '\r'},
+                       {'e', '\x1b'},
+                       {' ', ' '},
+                       {'"', '"'},
+                       {'/', '/'},
+                       {'\\', '\\'}};
+                auto found = std::find_if(std::begin(escapes),
+                                          std::end(escapes),
+                                          [&](auto& escape) { return escape.first == e; });
+                if(e && found != std::end(escapes))
+                    value += found->second;
+                else if(e == 'x' || e == 'u' || e == 'U')
+                {
+                    size_t digits = e == 'x' ? 2 : e == 'u' ? 4 : 8;
+                    if(m_col + digits > text().size())
+                        error("expected escape sequence of hexadecimal numbers");
+                    unsigned long code = strtoul(text().substr(m_col, digits).c_str(), nullptr, 16);
+                    m_col += digits;
+                    // UTF-8 encoding of the code point
+                    if(code < 0x80)
+                        value += char(code);
+                    else if(code < 0x800)
+                    {
+                        value += char(0xc0 | code >> 6);
+                        value += char(0x80 | (code & 0x3f));
+                    }
+                    else if(code < 0x10000)
+                    {
+                        value += char(0xe0 | code >> 12);
+                        value += char(0x80 | (code >> 6 & 0x3f));
+                        value += char(0x80 | (code & 0x3f));
+                    }
+                    else
+                    {
+                        value += char(0xf0 | code >> 18);
+                        value += char(0x80 | (code >> 12 & 0x3f));
+                        value += char(0x80 | (code >> 6 & 0x3f));
+                        value += char(0x80 | (code & 0x3f));
+                    }
+                }
+                else if(!e)
+                {
+                    // escaped line break, the next line continues without a space
+                    if(++m_line >= m_end)
+                        error("found the end of the document in a quoted scalar");
+                    m_col = 0;
+                    skip_spaces();
+                }
+                else
+                {
+                    m_col--;
+                    error("found unknown escape character '" + std::string(1, e) + "'");
+                }
+            }
+        }
+
+        // A plain scalar, which ends at a comment, at ": " and in flow context at flow indicators
+        std::string scan_plain(bool flow)
+        {
+            size_t start = m_col, end = m_col;
+            for(;;)
+            {
+                char c = peek();
+                if(!c)
+                    break;
+                if(is_space(c))
+                {
+                    skip_spaces();
+                    if(!peek() || peek() == '#')
+                        break;
+                    continue;
+                }
+                char n = peek(1);
+                if(c == ':' && (!n || is_space(n) || (flow && is_flow_indicator(n))))
+                    break;
+                if(flow && (is_flow_indicator(c) || c == '?'))
+                    break;
+                end = ++m_col;
+            }
+            m_col = end;
+            return text().substr(start, end - start);
+        }
+
+        void check_plain_start(bool flow)
+        {
+            char c = peek();
+            if(c == '|' || c == '>')
+                error("block scalars are not supported");
+            if(c == '!')
+                error("tags are not supported");
+            if(c == '?' && (!peek(1) || is_space(peek(1))))
+                error("complex mapping keys are not supported");
+            if(c == '%' || c == '@' || c == '`' || (flow && is_flow_indicator(c))
+               || (c == ':' && (!peek(1) || is_space(peek(1)))))
+                error("found character '" + std::string(1, c)
+                      + "' that cannot start any token");
+        }
+
+        // a scalar key or value, quoted scalars are not resolved
+        yaml_node parse_scalar(bool flow, bool& plain, std::string& text)
+        {
+            plain = peek() != '\'' && peek() != '"';
+            if(!plain)
+            {
+                text = scan_quoted();
+                return make_string(text);
+            }
+            check_plain_start(flow);
+            text = scan_plain(flow);
+            return resolve_plain(text);
+        }
+
+        // Apply the << merges and then the explicit keys. Earlier mappings of a merged list
+        // take precedence over later ones, and the explicit keys over all of them.
+        yaml_node
+            build_map(const std::vector<yaml_node>& merges, const yaml_map& explicit_keys) const
+        {
+            yaml_map map;
+            for(auto& merge : merges)
+            {
+                if(merge.kind == yaml_node::map_t)
+                    update(map, *merge.m);
+                else
+                    for(auto it = merge.l->rbegin(); it != merge.l->rend(); ++it)
+                        update(map, *it->m);
+            }
+            update(map, explicit_keys);
+            return make_map(std::move(map));
+        }
+
+        void check_merge(const yaml_node& merge)
+        {
+            bool ok = merge.kind == yaml_node::map_t;
+            if(merge.kind == yaml_node::list_t)
+                ok = std::all_of(merge.l->begin(), merge.l->end(), [](auto& item) {
+                    return item.kind == yaml_node::map_t;
+                });
+            if(!ok)
+                error("expected a mapping or list of mappings for merging");
+        }
+
+        yaml_node parse_flow_node()
+        {
+            skip_blank(true);
+            std::string anchor;
+            if(peek() == '&')
+            {
+                anchor = scan_name();
+                skip_blank(true);
+            }
+
+            yaml_node node;
+            if(peek() == '{')
+                node = parse_flow_map();
+            else if(peek() == '[')
+                node = parse_flow_list();
+            else if(peek() == '*')
+                node = parse_alias();
+            else if(peek() == ',' || peek() == '}' || peek() == ']')
+                node = {};
+            else
+            {
+                bool        plain;
+                std::string text;
+                node = parse_scalar(true, plain, text);
+            }
+            add_anchor(anchor, node);
+            return node;
+        }
+
+        yaml_node parse_flow_map()
+        {
+            yaml_map               map;
+            std::vector<yaml_node> merges;
+            m_col++;
+            for(;;)
+            {
+                skip_blank(true);
+                if(peek() == '}')
+                    break;
+                if(peek() == '{' || peek() == '[' || peek() == '*' || peek() == '&')
+                    error("only scalar mapping keys are supported");
+
+                bool        plain;
+                std::string key;
+                parse_scalar(true, plain, key);
+                skip_blank(true);
+
+                yaml_node value;
+                if(peek() == ':')
+                {
+                    m_col++;
+                    value = parse_flow_node();
+                    skip_blank(true);
+                }
+                if(plain && key == "<<")
+                {
+                    check_merge(value);
+                    merges.push_back(value);
+                }
+                else
+                    set(map, key, value);
+
+                if(peek() == '}')
+                    break;
+                if(peek() != ',')
+                    error("expected ',' or '}', but found '" + std::string(1, peek()) + "'");
+                m_col++;
+            }
+            m_col++;
+            return build_map(merges, map);
+        }
+
+        yaml_node parse_flow_list()
+        {
+            yaml_list list;
+            m_col++;
+            for(;;)
+            {
+                skip_blank(true);
+                if(peek() == ']')
+                    break;
+                list.push_back(parse_flow_node());
+                skip_blank(true);
+                if(peek() == ']')
+                    break;
+                if(peek() != ',')
+                    error("expected ',' or ']', but found '" + std::string(1, peek()) + "'");
+                m_col++;
+            }
+            m_col++;
+            return make_list(std::move(list));
+        }
+
+        void add_anchor(const std::string& anchor, const yaml_node& node)
+        {
+            if(anchor.empty())
+                return;
+            if(!m_anchors.emplace(anchor, node).second)
+                error("found duplicate anchor " + anchor);
+        }
+
+        // the entries of a block sequence whose "-" are in column indent
+        yaml_node parse_block_list(size_t indent)
+        {
+            yaml_list list;
+            for(;;)
+            {
+                m_col = indent + 1;
+                list.push_back(parse_node(indent, false, true));
+                if(!skip_blank() || m_col < indent)
+                    break;
+                if(m_col > indent)
+                    error("expected <block end>, but found '" + std::string(1, peek()) + "'");
+                if(!at_seq_entry())
+                    break;
+            }
+            return make_list(std::move(list));
+        }
+
+        // the entries of a block mapping whose keys start in column indent
+        yaml_node parse_block_map(size_t indent)
+        {
+            yaml_map               map;
+            std::vector<yaml_node> merges;
+            for(;;)
+            {
+                if(peek() == '{' || peek() == '[' || peek() == '*' || peek() == '&'
+                   || at_seq_entry())
+                    error("expected a simple mapping key");
+
+                bool        plain;
+                std::string key;
+                parse_scalar(false, plain, key);
+                skip_spaces();
+                if(peek() != ':')
+                    error("could not find expected ':'");
+                m_col++;
+
+                yaml_node value = parse_node(indent, true, false);
+                if(plain && key == "<<")
+                {
+                    check_merge(value);
+                    merges.push_back(value);
+                }
+                else
+                    set(map, key, value);
+
+                if(!skip_blank() || m_col < indent)
+                    break;
+                if(m_col > indent)
+                    error("expected <block end>, but found '" + std::string(1, peek()) + "'");
+            }
+            return build_map(merges, map);
+        }
+
+        // a node which starts at the current position
+        yaml_node parse_content(bool compact)
+        {
+            size_t start = m_col;
+            if(at_seq_entry())
+            {
+                if(!compact)
+                    error("sequence entries are not allowed here");
+                return parse_block_list(start);
+            }
+
+            yaml_node node;
+            if(peek() == '{')
+                node = parse_flow_map();
+            else if(peek() == '[')
+                node = parse_flow_list();
+            else if(peek() == '*')
+                node = parse_alias();
+            else
+            {
+                bool        plain;
+                std::string text;
+                node = parse_scalar(false, plain, text);
+
+                // a scalar followed by ':' is the first key of a block mapping
+                skip_spaces();
+                if(peek() == ':' && (!peek(1) || is_space(peek(1))))
+                {
+                    if(!compact)
+                        error("mapping values are not allowed here");
+                    m_col = start;
+                    return parse_block_map(start);
+                }
+            }
+            expect_line_end();
+            return node;
+        }
+
+        // The node after "-", "key:" or at the start of a document. Its block content is
+        // indented more than indent, or for the value of a key a sequence may be at indent.
+        yaml_node parse_node(size_t indent, bool list_at_indent, bool compact)
+        {
+            skip_spaces();
+            std::string anchor;
+            if(peek() == '&')
+            {
+                anchor = scan_name();
+                skip_spaces();
+            }
+
+            yaml_node node;
+            if(!at_line_end())
+                node = parse_content(compact);
+            else if(skip_blank())
+            {
+                if(m_col > indent || indent == std::string::npos)
+                    node = parse_content(true);
+                else if(m_col == indent && list_at_indent && at_seq_entry())
+                    node = parse_block_list(indent);
+            }
+            add_anchor(anchor, node);
+            return node;
+        }
+
+    public:
+        explicit yaml_parser(const hipsparselt_yaml_source& source)
+            : m_source(source)
+        {
+        }
+
+        // Parse the next document, returns false at the end of the source
+        bool next_document(yaml_node& doc)
+        {
+            m_end = m_source.size();
+            if(m_line >= m_end)
+                return false;
+
+            // an explicit start or end of a document, which may be followed by its content
+            if(is_marker(text()))
+            {
+                m_col = 3;
+                if(!text().compare(0, 3, "...") && !at_line_end())
+                    error("expected the end of the line after '...'");
+            }
+            else
+                m_col = 0;
+
+            for(size_t line = m_line + 1; line < m_end; line++)
+                if(is_marker(m_source[line].text))
+                    m_end = line;
+
+            m_anchors.clear();
+            doc = {};
+            if(skip_blank())
+                doc = parse_node(std::string::npos, false, true);
+            if(skip_blank())
+                error("expected the end of the document, but found '" + std::string(1, peek())
+                      + "'");
+
+            m_line = m_end;
+            return true;
+        }
+    };
+
+    /**************************************************************************
+     * Expansion of the tests with the rules of hipsparselt_gentest.py
+     **************************************************************************/
+
+    // ctypes scalar types
+    enum ctype_kind
+    {
+        c_bool,
+        c_char,
+        c_int8,
+        c_uint8,
+        c_int16,
+        c_uint16,
+        c_int32,
+        c_uint32,
+        c_int64,
+        c_uint64,
+        c_float,
+        c_double,
+    };
+
+    size_t ctype_size(ctype_kind kind)
+    {
+        static const size_t sizes[] = {1, 1, 1, 1, 2, 2, 4, 4, 8, 8, 4, 8};
+        return sizes[kind];
+    }
+
+    // A name in the Datatypes namespace: a ctypes type, an array of one, a class with a ctypes
+    // base (an enum), a class without one, or a value imported from the attributes of a class
+    struct yaml_datatype
+    {
+        enum
+        {
+            type,
+            array,
+            enum_class,
+            plain_class,
+            value,
+        } what;
+        ctype_kind kind  = c_int32;
+        size_t     count = 0;
+        yaml_node  attr;
+    };
+
+    struct yaml_field
+    {
+        std::string   name;
+        yaml_datatype type;
+        size_t        offset;
+    };
+
+    // TYPE_RE of hipsparselt_gentest.py, a name optionally followed by *count
+    bool parse_type(const std::string& decl, std::string& name, size_t& count)
+    {
+        size_t i = 0;
+        if(decl.empty() || !(isalpha(decl[0]) || decl[0] == '_'))
+            return false;
+        while(i < decl.size() && (isalnum(decl[i]) || decl[i] == '_'))
+            i++;
+        name  = decl.substr(0, i);
+        count = 0;
+        if(i == decl.size())
+            return true;
+
+        while(i < decl.size() && isspace(decl[i]))
+            i++;
+        if(i == decl.size() || decl[i] != '*')
+            return false;
+        i++;
+        while(i < decl.size() && isspace(decl[i]))
+            i++;
+        size_t digits = i;
+        while(i < decl.size() && isdigit(decl[i]))
+            count = count * 10 + (decl[i++] - '0');
+        return i > digits && i == decl.size();
+    }
+
+    // fnmatch.fnmatchcase
+    bool fnmatchcase(const char* name, const char* pattern)
+    {
+        for(; *pattern; pattern++, name++)
+        {
+            if(*pattern == '*')
+            {
+                for(const char* rest = name;; rest++)
+                {
+                    if(fnmatchcase(rest, pattern + 1))
+                        return true;
+                    if(!*rest)
+                        return false;
+                }
+            }
+            if(!*name)
+                return false;
+            if(*pattern == '[')
+            {
+                const char* p      = pattern + 1;
+                bool        negate = *p == '!';
+                p += negate;
+                const char* close = strchr(p + (*p == ']'), ']');
+                if(close)
+                {
+                    bool match = false;
+                    for(const char* q = p; q < close; q++)
+                    {
+                        if(q + 2 < close && q[1] == '-')
+                        {
+                            match |= *name >= q[0] && *name <= q[2];
+                            q += 2;
+                        }
+                        else
+                            match |= *name == *q;
+                    }
+                    if(match == negate)
+                        return false;
+                    pattern = close;
+                    continue;
+                }
+            }
+            if(*pattern != '?' && *pattern != *name)
+                return false;
+        }
+        return !*name;
+    }
+
+    // INT_RANGE_RE of hipsparselt_gentest.py, A..B[..C]
+    bool parse_range(const std::string& str, long long range[3])
+    {
+        const char* p = str.c_str();
+        range[2]      = 1;
+        for(int i = 0; i < 3; i++)
+        {
+            while(isspace(*p))
+                p++;
+            const char* digits = p + (*p == '-');
+            if(!isdigit(*digits))
+                return false;
+            char* end;
+            range[i] = strtoll(p, &end, 10);
+            p        = end;
+            while(isspace(*p))
+                p++;
+            if(!*p)
+                return i > 0;
+            if(p[0] != '.' || p[1] != '.' || i == 2)
+                return false;
+            p += 2;
+        }
+        return false;
+    }
+
+    class yaml_expander
+    {
+        std::string&                    m_data;
+        std::unordered_set<std::string> m_records;
+        bool                            m_signature_written = false;
+
+        std::unordered_map<std::string, yaml_datatype> m_datatypes;
+        std::vector<yaml_field>                        m_fields;
+        size_t                                         m_record_size = 0;
+
+        yaml_list m_dict_lists_to_expand;
+        yaml_list m_lists_to_not_expand;
+        yaml_list m_known_bugs;
+        yaml_map  m_functions;
+
+        static const yaml_node& get(const yaml_map& test, const std::string& key)
+        {
+            auto value = find(test, key);
+            if(!value)
+                throw std::out_of_range(key);
+            return *value;
+        }
+
+        static const yaml_list& list_or_empty(const yaml_map& doc, const char* key)
+        {
+            static const yaml_list empty;
+            auto                   value = find(doc, key);
+            if(!value || !truth(*value))
+                return empty;
+            if(value->kind != yaml_node::list_t)
+                throw yaml_error(std::string(key) + " must be a list");
+            return *value->l;
+        }
+
+        static const std::string& as_string(const yaml_node& node, const std::string& what)
+        {
+            if(node.kind != yaml_node::string_t)
+                throw yaml_error("AttributeError: " + what + " has type " + type_name(node)
+                                 + ", not <class 'str'>");
+            return node.str();
+        }
+
+        yaml_datatype eval_type(const std::string& decl) const
+        {
+            std::string name;
+            size_t      count;
+            if(!parse_type(decl, name, count))
+                throw yaml_error("Invalid type " + decl);
+            auto it = m_datatypes.find(name);
+            if(it == m_datatypes.end())
+                throw yaml_error("NameError: name '" + name + "' is not defined");
+            if(!count)
+                return it->second;
+
+            yaml_datatype array = it->second;
+            if(array.what != yaml_datatype::type && array.what != yaml_datatype::enum_class)
+                throw yaml_error("TypeError: " + decl + " is not an array of a C type");
+            array.what  = yaml_datatype::array;
+            array.count = count;
+            return array;
+        }
+
+        void get_datatypes(const yaml_map& doc)
+        {
+            static const std::pair<const char*, ctype_kind> ctypes[] = {
+                {"c_bool", c_bool},     {"c_char", c_char},       {"c_byte", c_int8},
+                {"c_ubyte", c_uint8},   {"c_short", c_int16},     {"c_ushort", c_uint16},
+                {"c_int", c_int32},     {"c_uint", c_uint32},     {"c_long", c_int64},
+                {"c_ulong", c_uint64},  {"c_longlong", c_int64},  {"c_ulonglong", c_uint64},
+                {"c_int8", c_int8},     {"c_uint8", c_uint8},     {"c_int16", c_int16},
+                {"c_uint16", c_uint16}, {"c_int32", c_int32},     {"c_uint32", c_uint32},
+                {"c_int64", c_int64},   {"c_uint64", c_uint64},   {"c_size_t", c_uint64},
+                {"c_ssize_t", c_int64}, {"c_float", c_float},     {"c_double", c_double},
+            };
+
+            m_datatypes.clear();
+            for(auto& ctype : ctypes)
+            {
+                yaml_datatype type;
+                type.what                = yaml_datatype::type;
+                type.kind                = ctype.second;
+                m_datatypes[ctype.first] = type;
+            }
+
+            for(auto& declaration : list_or_empty(doc, "Datatypes"))
+            {
+                if(declaration.kind != yaml_node::map_t)
+                    throw yaml_error("Unrecognized data type declaration " + repr(declaration));
+                for(auto& item : *declaration.m)
+                {
+                    auto& name = item.first;
+                    auto& decl = item.second;
+                    if(decl.kind == yaml_node::map_t)
+                    {
+                        // a class derived from its bases, with the attributes as values
+                        yaml_datatype type;
+                        type.what = yaml_datatype::plain_class;
+                        if(auto bases = find(*decl.m, "bases"); bases && truth(*bases))
+                        {
+                            if(bases->kind != yaml_node::list_t)
+                                throw yaml_error("The bases of " + name + " must be a list");
+                            for(auto& base : *bases->l)
+                            {
+                                std::string base_name;
+                                size_t      count;
+                                if(!parse_type(as_string(base, "base"), base_name, count))
+                                    continue;
+                                auto base_type = eval_type(base.str());
+                                if(type.what == yaml_datatype::plain_class
+                                   && (base_type.what == yaml_datatype::type
+                                       || base_type.what == yaml_datatype::enum_class))
+                                {
+                                    type.what = yaml_datatype::enum_class;
+                                    type.kind = base_type.kind;
+                                }
+                            }
+                        }
+                        m_datatypes[name] = type;
+
+                        if(auto attr = find(*decl.m, "attr"); attr && truth(*attr))
+                        {
+                            if(attr->kind != yaml_node::map_t)
+                                throw yaml_error("The attr of " + name + " must be a mapping");
+                            for(auto& value : *attr->m)
+                            {
+                                std::string subtype;
+                                size_t      count;
+                                if(parse_type(value.first, subtype, count) && !count)
+                                {
+                                    yaml_datatype attr_value;
+                                    attr_value.what        = yaml_datatype::value;
+                                    attr_value.attr        = value.second;
+                                    m_datatypes[value.first] = attr_value;
+                                }
+                            }
+                        }
+                    }
+                    else if(decl.kind == yaml_node::string_t && m_datatypes.count(decl.str()))
+                    {
+                        // an alias of another type or value
+                        m_datatypes[name] = m_datatypes[decl.str()];
+                    }
+                    else
+                        throw yaml_error("Unrecognized data type " + name + ": " + repr(decl));
+                }
+            }
+        }
+
+        // the Arguments fields, laid out as a ctypes.Structure
+        void get_arguments(const yaml_map& doc)
+        {
+            m_fields.clear();
+            size_t offset = 0, align = 1;
+            for(auto& decl : list_or_empty(doc, "Arguments"))
+            {
+                if(decl.kind != yaml_node::map_t || decl.m->size() != 1
+                   || decl.m->front().second.kind != yaml_node::string_t)
+                    continue;
+                auto&       name = decl.m->front().first;
+                auto&       type = decl.m->front().second.str();
+                std::string type_name;
+                size_t      count;
+                if(!parse_type(type, type_name, count))
+                    continue;
+
+                auto field_type = eval_type(type);
+                if(field_type.what == yaml_datatype::plain_class
+                   || field_type.what == yaml_datatype::value)
+                    throw yaml_error("TypeError: the type " + type + " of " + name
+                                     + " must be a C type");
+
+                size_t size = ctype_size(field_type.kind);
+                offset      = (offset + size - 1) / size * size;
+                align       = std::max(align, size);
+                m_fields.push_back({name, field_type, offset});
+                offset += size * std::max(field_type.count, size_t(1));
+            }
+            m_record_size = (offset + align - 1) / align * align;
+        }
+
+        void write_signature()
+        {
+            if(m_signature_written)
+                return;
+
+            std::string sig("hipSPARSELt", 12);
+            size_t      last_ofs = 0;
+            int         value    = 0;
+            for(auto& field : m_fields)
+            {
+                sig.append(field.offset - last_ofs, 0);
+                size_t size = ctype_size(field.type.kind) * std::max(field.type.count, size_t(1));
+                for(size_t i = 0; i < size; i++)
+                    sig += char(value ^ i);
+                value    = (value + 89) % 256;
+                last_ofs = field.offset + size;
+            }
+            sig.append(m_record_size - last_ofs, 0);
+            sig.append("HIPsparselT", 12);
+            m_data += sig;
+            m_signature_written = true;
+        }
+
+        // Store value in a ctypes scalar the way the ctypes constructor converts it
+        static void store_scalar(char* dst, ctype_kind kind, const yaml_node& value)
+        {
+            switch(kind)
+            {
+            case c_bool:
+                *dst = truth(value);
+                return;
+            case c_char:
+                if(value.kind != yaml_node::string_t || value.s->size() != 1)
+                    throw std::invalid_argument("one character bytes, bytearray or integer "
+                                                "expected");
+                *dst = value.str()[0];
+                return;
+            case c_float:
+            case c_double:
+            {
+                if(!value.is_number())
+                    throw std::invalid_argument("must be real number, not "
+                                                + type_name(value, true));
+                if(kind == c_float)
+                {
+                    float f = float(value.real());
+                    memcpy(dst, &f, sizeof(f));
+                }
+                else
+                {
+                    double d = value.real();
+                    memcpy(dst, &d, sizeof(d));
+                }
+                return;
+            }
+            default:
+                // integers wrap to the width of the type
+                if(!value.is_int())
+                    throw std::invalid_argument("'" + type_name(value, true)
+                                                + "' object cannot be interpreted as an integer");
+                memcpy(dst, &value.i, ctype_size(kind));
+                return;
+            }
+        }
+
+        void write_test(const yaml_map& test)
+        {
+            std::string record(m_record_size, 0);
+            for(auto& field : m_fields)
+            {
+                auto& value = get(test, field.name);
+                char* dst   = &record[field.offset];
+                try
+                {
+                    if(field.type.what != yaml_datatype::array)
+                        store_scalar(dst, field.type.kind, value);
+                    else if(field.type.kind == c_char)
+                    {
+                        if(value.kind != yaml_node::string_t)
+                            throw std::invalid_argument("encoding without a string argument");
+                        if(value.s->size() > field.type.count)
+                            throw yaml_error("ValueError: bytes too long for " + field.name);
+                        memcpy(dst, value.s->data(), value.s->size());
+                    }
+                    else
+                    {
+                        if(value.kind != yaml_node::list_t)
+                            throw std::invalid_argument("array initializer must be a list");
+                        if(value.l->size() > field.type.count)
+                            throw yaml_error("IndexError: too many initializers for "
+                                             + field.name);
+                        size_t size = ctype_size(field.type.kind);
+                        for(size_t i = 0; i < value.l->size(); i++)
+                            store_scalar(dst + i * size, field.type.kind, (*value.l)[i]);
+                    }
+                }
+                catch(const std::invalid_argument& err)
+                {
+                    throw yaml_error("TypeError: " + std::string(err.what()) + " for "
+                                     + field.name + ", which has type " + type_name(value)
+                                     + "\n");
+                }
+            }
+
+            if(m_records.insert(record).second)
+            {
+                write_signature();
+                m_data += record;
+            }
+        }
+
+        static bool greater_than_zero(const yaml_node& value)
+        {
+            if(!value.is_number())
+                throw yaml_error("TypeError: '>' not supported between instances of "
+                                 + type_name(value) + " and <class 'int'>");
+            return value.real() > 0;
+        }
+
+        static yaml_node product(const yaml_node& a, const yaml_node& b)
+        {
+            if(!a.is_number() || !b.is_number())
+                throw yaml_error("TypeError: unsupported operand type(s) for *: "
+                                 + type_name(a) + " and " + type_name(b));
+            if(a.is_int() && b.is_int())
+                return make_int(int64_t(uint64_t(a.i) * uint64_t(b.i)));
+            return make_real(a.real() * b.real());
+        }
+
+        static void setdefault(yaml_map& test, const char* key, const yaml_node& value)
+        {
+            if(!find(test, key))
+                set(test, key, value);
+        }
+
+        // dynamic defaults of hipsparselt_gentest.py
+        static void setdefaults(yaml_map& test)
+        {
+            static const yaml_node zero = make_int(0), one = make_int(1);
+            static const yaml_node star = make_string("*");
+
+            auto upper_is_n = [&](const char* key) {
+                auto& trans = as_string(get(test, key), key);
+                return trans == "N" || trans == "n";
+            };
+            auto nonzero = [&](const char* key) {
+                auto& value = get(test, key);
+                return equal(value, zero) ? one : value;
+            };
+
+            if(equal(get(test, "transA"), star) || equal(get(test, "transB"), star))
+            {
+                setdefault(test, "lda", zero);
+                setdefault(test, "ldb", zero);
+                setdefault(test, "ldc", zero);
+                setdefault(test, "ldd", zero);
+            }
+            else
+            {
+                setdefault(test, "lda", upper_is_n("transA") ? nonzero("M") : nonzero("K"));
+                setdefault(test, "ldb", upper_is_n("transB") ? nonzero("K") : nonzero("N"));
+                setdefault(test, "ldc", nonzero("M"));
+                setdefault(test, "ldd", nonzero("M"));
+                if(greater_than_zero(get(test, "batch_count")))
+                {
+                    setdefault(test,
+                               "stride_a",
+                               product(get(test, "lda"),
+                                       get(test, upper_is_n("transA") ? "K" : "M")));
+                    setdefault(test,
+                               "stride_b",
+                               product(get(test, "ldb"),
+                                       get(test, upper_is_n("transB") ? "N" : "K")));
+                    setdefault(test, "stride_c", product(get(test, "ldc"), get(test, "N")));
+                    setdefault(test, "stride_d", product(get(test, "ldd"), get(test, "N")));
+                    return;
+                }
+            }
+
+            setdefault(test, "stride_a", zero);
+            setdefault(test, "stride_b", zero);
+            setdefault(test, "stride_c", zero);
+            setdefault(test, "stride_d", zero);
+        }
+
+        // The value a name of an enum stands for
+        const yaml_node* enum_value(const yaml_node& name) const
+        {
+            if(name.kind != yaml_node::string_t)
+                return nullptr;
+            auto it = m_datatypes.find(name.str());
+            if(it == m_datatypes.end())
+                return nullptr;
+            if(it->second.what != yaml_datatype::value)
+                throw yaml_error("TypeError: " + name.str() + " is a type, not a value");
+            return &it->second.attr;
+        }
+
+        bool is_enum_field(const std::string& key) const
+        {
+            return std::any_of(m_fields.begin(), m_fields.end(), [&](auto& field) {
+                return field.name == key && field.type.what == yaml_datatype::enum_class;
+            });
+        }
+
+        // category not in ('known_bug'), which is a substring test
+        static bool not_known_bug(const yaml_node& category)
+        {
+            return std::string("known_bug").find(as_string(category, "category"))
+                   == std::string::npos;
+        }
+
+        void instantiate(yaml_map test)
+        {
+            try
+            {
+                setdefaults(test);
+
+                // For enum arguments, replace name with value
+                for(auto& field : m_fields)
+                    if(field.type.what == yaml_datatype::enum_class)
+                        if(auto value = enum_value(get(test, field.name)))
+                            set(test, field.name, *value);
+
+                std::vector<std::string> known_bug_platforms;
+
+                // Match known bugs
+                if(not_known_bug(get(test, "category")))
+                {
+                    for(auto& bug : m_known_bugs)
+                    {
+                        if(bug.kind != yaml_node::map_t)
+                            throw yaml_error("Known bugs must be a list of mappings");
+
+                        bool match = true;
+                        for(auto& item : *bug.m)
+                        {
+                            auto& key   = item.first;
+                            auto& value = item.second;
+                            if(key == "known_bug_platforms" || key == "category")
+                                continue;
+                            auto test_value = find(test, key);
+                            if(!test_value)
+                                match = false;
+                            else if(key == "function")
+                                match = fnmatchcase(as_string(*test_value, key).c_str(),
+                                                    as_string(value, key).c_str());
+                            else
+                            {
+                                auto enum_val = is_enum_field(key) ? enum_value(value) : nullptr;
+                                match         = equal(*test_value, enum_val ? *enum_val : value);
+                            }
+                            if(!match)
+                                break;
+                        }
+                        if(!match)
+                            continue;
+
+                        // All values specified in known bug match the test case
+                        static const yaml_node empty     = make_string("");
+                        auto                   platforms = find(*bug.m, "known_bug_platforms");
+                        auto&                  str
+                            = as_string(platforms ? *platforms : empty, "known_bug_platforms");
+
+                        static const char separators[] = " :,\f\n\r\t\v";
+                        if(str.find_first_not_of(separators) != std::string::npos)
+                        {
+                            // each platform of the list of platforms, as by re.split
+                            for(size_t start = 0;;)
+                            {
+                                size_t end = str.find_first_of(separators, start);
+                                known_bug_platforms.push_back(str.substr(start, end - start));
+                                if(end == std::string::npos)
+                                    break;
+                                start = str.find_first_not_of(separators, end);
+                                if(start == std::string::npos)
+                                {
+                                    known_bug_platforms.push_back("");
+                                    break;
+                                }
+                            }
+                        }
+                        else
+                            set(test, "category", make_string("known_bug"));
+                        break;
+                    }
+                }
+
+                // Unless category is already set to known_bug or disabled, set
+                // known_bug_platforms to a space-separated list of platforms, which is sorted
+                // here to make the data reproducible
+                std::string platforms;
+                if(not_known_bug(get(test, "category")))
+                {
+                    std::sort(known_bug_platforms.begin(), known_bug_platforms.end());
+                    known_bug_platforms.erase(
+                        std::unique(known_bug_platforms.begin(), known_bug_platforms.end()),
+                        known_bug_platforms.end());
+                    for(auto& platform : known_bug_platforms)
+                        platforms += (&platform == &known_bug_platforms[0] ? "" : " ") + platform;
+                }
+                set(test, "known_bug_platforms", make_string(platforms));
+
+                write_test(test);
+            }
+            catch(const std::out_of_range& err)
+            {
+                throw yaml_error("Undefined value '" + std::string(err.what()) + "'\n"
+                                 + repr(make_map(test)));
+            }
+        }
+
+        // Generate test combinations by iterating across lists recursively
+        void generate(yaml_map test)
+        {
+            // For specially named lists, they are expanded and merged into the test argument
+            // list. A dictionary of length 1 pairs the argument named by its key with the
+            // argument named by its value, in the order of the keys.
+            for(auto& argname : m_dict_lists_to_expand)
+            {
+                if(argname.kind == yaml_node::map_t)
+                {
+                    if(argname.m->size() != 1)
+                        continue;
+                    auto& arg    = argname.m->front().first;
+                    auto& target = as_string(argname.m->front().second, "target");
+                    auto  value  = find(test, arg);
+                    if(!value || value->kind != yaml_node::map_t)
+                        continue;
+
+                    auto pairs = value->m;
+                    for(auto& pair : *pairs)
+                    {
+                        set(test, arg, make_string(pair.first));
+                        set(test, target, pair.second);
+                        generate(test);
+                    }
+                    return;
+                }
+
+                if(argname.kind != yaml_node::string_t)
+                    continue;
+                auto value = find(test, argname.str());
+                if(!value || (value->kind != yaml_node::list_t && value->kind != yaml_node::map_t))
+                    continue;
+
+                // Pop the list and iterate across it, a bare dictionary is applied once
+                yaml_node ilist = *value;
+                erase(test, argname.str());
+                auto apply = [&](const yaml_node& item) {
+                    if(item.kind != yaml_node::map_t)
+                        throw yaml_error("TypeError: cannot update a dictionary with "
+                                         + type_name(item) + " for " + argname.str()
+                                         + ", which has type " + type_name(item)
+                                         + "\nA name listed in \"Dictionary lists to expand\" "
+                                           "must be a defined as a dictionary.\n");
+                    yaml_map item_case = test;
+                    update(item_case, *item.m);
+                    generate(std::move(item_case));
+                };
+                if(ilist.kind == yaml_node::map_t)
+                    apply(ilist);
+                else
+                    for(auto& item : *ilist.l)
+                        apply(item);
+                return;
+            }
+
+            for(size_t k = 0; k < test.size(); k++)
+            {
+                auto value = test[k].second;
+
+                // Integer arguments which are ranges (A..B[..C]) are expanded
+                long long range[3];
+                if(value.kind == yaml_node::string_t)
+                {
+                    if(value.str().find("..") == std::string::npos
+                       || !parse_range(value.str(), range))
+                        continue;
+                    if(!range[2])
+                        throw yaml_error("ValueError: range() arg 3 must not be zero");
+                    // range(A, B + 1, C), also when C is negative
+                    long long stop = range[1] + 1;
+                    for(long long i = range[0]; range[2] > 0 ? i < stop : i > stop; i += range[2])
+                    {
+                        test[k].second = make_int(i);
+                        generate(test);
+                    }
+                    return;
+                }
+
+                // For sequence arguments, they are expanded into scalars
+                if(value.kind == yaml_node::list_t
+                   && std::none_of(m_lists_to_not_expand.begin(),
+                                   m_lists_to_not_expand.end(),
+                                   [&](auto& name) {
+                                       return name.kind == yaml_node::string_t
+                                              && name.str() == test[k].first;
+                                   }))
+                {
+                    for(auto& item : *value.l)
+                    {
+                        test[k].second = item;
+                        generate(test);
+                    }
+                    return;
+                }
+            }
+
+            // Replace typed function names with generic functions and types
+            if(auto value = find(test, "hipsparselt_function"))
+            {
+                yaml_node func = *value;
+                erase(test, "hipsparselt_function");
+                auto& name = as_string(func, "hipsparselt_function");
+                if(auto function = find(m_functions, name))
+                {
+                    if(function->kind != yaml_node::map_t)
+                        throw yaml_error("Functions." + name + " must be a mapping");
+                    update(test, *function->m);
+                }
+                else
+                {
+                    size_t pos = name.rfind("hipsparselt_");
+                    set(test,
+                        "function",
+                        make_string(pos == std::string::npos ? name : name.substr(pos + 12)));
+                }
+                generate(std::move(test));
+                return;
+            }
+
+            instantiate(std::move(test));
+        }
+
+    public:
+        explicit yaml_expander(std::string& data)
+            : m_data(data)
+        {
+        }
+
+        // Process one document in the YAML file
+        void process_doc(const yaml_node& doc)
+        {
+            // Ignore empty documents
+            if(!truth(doc))
+                return;
+            if(doc.kind != yaml_node::map_t)
+                throw yaml_error("AttributeError: a document must be a mapping, not "
+                                 + type_name(doc));
+            auto tests = find(*doc.m, "Tests");
+            if(!tests || !truth(*tests))
+                return;
+            if(tests->kind != yaml_node::list_t)
+                throw yaml_error("Tests must be a list");
+
+            get_datatypes(*doc.m);
+            get_arguments(*doc.m);
+
+            m_dict_lists_to_expand = list_or_empty(*doc.m, "Dictionary lists to expand");
+            m_lists_to_not_expand  = list_or_empty(*doc.m, "Lists to not expand");
+            m_known_bugs           = list_or_empty(*doc.m, "Known bugs");
+
+            yaml_map defaults;
+            if(auto value = find(*doc.m, "Defaults"); value && truth(*value))
+            {
+                if(value->kind != yaml_node::map_t)
+                    throw yaml_error("Defaults must be a mapping");
+                defaults = *value->m;
+            }
+
+            m_functions.clear();
+            if(auto value = find(*doc.m, "Functions"); value && truth(*value))
+            {
+                if(value->kind != yaml_node::map_t)
+                    throw yaml_error("Functions must be a mapping");
+                m_functions = *value->m;
+            }
+
+            // Instantiate all of the tests, starting with defaults
+            for(auto& test : *tests->l)
+            {
+                if(test.kind != yaml_node::map_t)
+                    throw yaml_error("TypeError: a test must be a mapping, not " + type_name(test)
+                                     + "\n" + repr(test));
+                yaml_map test_case = defaults;
+                update(test_case, *test.m);
+                generate(std::move(test_case));
+            }
+        }
+    };
+
+    // INCLUDE_RE of hipsparselt_gentest.py, returns the offset of the file name or 0
+    size_t match_include(const std::string& line, std::string& file)
+    {
+        if(line.compare(0, 7, "include"))
+            return 0;
+        size_t p = 7;
+        while(p < line.size() && isspace(line[p]))
+            p++;
+        if(p == line.size() || line[p] != ':')
+            return 0;
+        p++;
+        while(p < line.size() && isspace(line[p]))
+            p++;
+        size_t start = p;
+        while(p < line.size()
+              && (isalnum(line[p]) || line[p] == '_' || line[p] == '-' || line[p] == '.'
+                  || line[p] == '/'))
+            p++;
+        if(p == start)
+            return 0;
+        file = line.substr(start, p - start);
+        return start;
+    }
+}
+
+bool hipsparselt_yaml_read(hipsparselt_yaml_source&        source,
+                           const std::string&              file,
+                           const std::vector<std::string>& include_dirs)
+{
+    std::ifstream ifs(file);
+    if(!ifs)
+    {
+        hipsparselt_cerr << "Cannot open " << file << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    size_t      slash    = file.rfind('/');
+    std::string file_dir = slash == std::string::npos ? "." : file.substr(0, slash);
+
+    std::string line;
+    for(int line_no = 1; std::getline(ifs, line); line_no++)
+    {
+        if(!line.empty() && line.back() == '\r')
+            line.pop_back();
+
+        // Keep track of file names and line numbers for each line of YAML
+        std::string include_file;
+        size_t      column = match_include(line, include_file);
+        if(!column)
+        {
+            source.push_back({line, file, line_no});
+            continue;
+        }
+
+        std::vector<std::string> dirs{file_dir};
+        dirs.insert(dirs.end(), include_dirs.begin(), include_dirs.end());
+        bool found = false;
+        for(auto& dir : dirs)
+        {
+            std::string path = include_file[0] == '/' ? include_file : dir + "/" + include_file;
+            if(std::ifstream(path))
+            {
+                if(!hipsparselt_yaml_read(source, path, include_dirs))
+                    return false;
+                found = true;
+                break;
+            }
+        }
+        if(!found)
+        {
+            hipsparselt_cerr << "In file " << file << ", line " << line_no << ", column "
+                             << column + 1 << ":\n"
+                             << line << "\n"
+                             << std::string(column, ' ') << "^\nCannot open " << include_file
+                             << "\n\nInclude paths:";
+            for(auto& dir : dirs)
+                hipsparselt_cerr << "\n" << dir;
+            hipsparselt_cerr << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t hipsparselt_yaml_hash(const hipsparselt_yaml_source& source)
+{
+    uint64_t hash = hipsparselt_golden_hash(yaml_data_version, sizeof(yaml_data_version));
+    for(auto& line : source)
+        hash = hipsparselt_golden_hash(line.text.c_str(), line.text.size() + 1, hash);
+    return hash;
+}
+
+bool hipsparselt_yaml_expand(const hipsparselt_yaml_source& source, std::string& data)
+{
+    data.clear();
+    try
+    {
+        // All documents are parsed first to diagnose syntax errors before any expansion
+        yaml_parser            parser(source);
+        std::vector<yaml_node> docs;
+        for(yaml_node doc; parser.next_document(doc);)
+            docs.push_back(doc);
+
+        yaml_expander expander(data);
+        for(auto& doc : docs)
+            expander.process_doc(doc);
+        return true;
+    }
+    catch(const yaml_error& err)
+    {
+        hipsparselt_cerr << err.what() << std::endl;
+        return false;
+    }
+}
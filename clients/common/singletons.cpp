@@ -25,6 +25,10 @@
  *******************************************************************************/
 #include "singletons.hpp"
 
+#include <hip/hip_runtime_api.h>
+#include <map>
+#include <mutex>
+
 // global for device memory padding see d_vector.hpp
 size_t g_DVEC_PAD = 4096;
 
@@ -32,3 +36,65 @@ void d_vector_set_pad_length(size_t pad)
 {
     g_DVEC_PAD = pad;
 }
+
+namespace
+{
+    struct memory_cache
+    {
+        std::mutex                   mutex;
+        bool                         enabled = false;
+        std::multimap<size_t, void*> free_blocks; // by size
+        std::map<void*, size_t>      block_size; // of the blocks handed out
+    };
+
+    memory_cache& cache()
+    {
+        static memory_cache c;
+        return c;
+    }
+}
+
+void d_vector_set_memory_cache(bool enable)
+{
+    auto&                       c = cache();
+    std::lock_guard<std::mutex> lock(c.mutex);
+    c.enabled = enable;
+    if(enable)
+        return;
+    for(auto& block : c.free_blocks)
+        (void)(hipFree)(block.second);
+    c.free_blocks.clear();
+}
+
+// the smallest kept block which is large enough, nullptr when there is none
+void* d_vector_cache_take(size_t bytes)
+{
+    auto&                       c = cache();
+    std::lock_guard<std::mutex> lock(c.mutex);
+    if(!c.enabled)
+        return nullptr;
+    auto it = c.free_blocks.lower_bound(bytes);
+    if(it == c.free_blocks.end())
+        return nullptr;
+    void* ptr         = it->second;
+    c.block_size[ptr] = it->first;
+    c.free_blocks.erase(it);
+    return ptr;
+}
+
+// keep a block instead of freeing it, returns false when the cache is disabled
+bool d_vector_cache_give(void* ptr, size_t bytes)
+{
+    auto&                       c = cache();
+    std::lock_guard<std::mutex> lock(c.mutex);
+    if(!c.enabled)
+        return false;
+    auto it = c.block_size.find(ptr);
+    if(it != c.block_size.end())
+    {
+        bytes = it->second;
+        c.block_size.erase(it);
+    }
+    c.free_blocks.emplace(bytes, ptr);
+    return true;
+}
@@ -65,6 +65,12 @@ namespace
                 testing_aux_handle_destroy_bad_arg(arg);
             else if(!strcmp(arg.function, "aux_handle"))
                 testing_aux_handle(arg);
+            else if(!strcmp(arg.function, "aux_workspace_arena"))
+                testing_aux_workspace_arena(arg);
+            else if(!strcmp(arg.function, "aux_matmul_shard_partition"))
+                testing_aux_matmul_shard_partition(arg);
+            else if(!strcmp(arg.function, "aux_matmul_sharded"))
+                testing_aux_matmul_sharded(arg);
             else if(!strcmp(arg.function, "aux_mat_init_dense_bad_arg"))
                 testing_aux_mat_init_dense_bad_arg(arg);
             else if(!strcmp(arg.function, "aux_mat_init_structured_bad_arg"))
@@ -111,6 +117,34 @@ namespace
                 testing_aux_matmul_plan_init_bad_arg(arg);
             else if(!strcmp(arg.function, "aux_matmul_plan_init"))
                 testing_aux_matmul_plan_init(arg);
+            else if(!strcmp(arg.function, "aux_matmul_plan_init_async"))
+                testing_aux_matmul_plan_init_async(arg);
+            else if(!strcmp(arg.function, "aux_timeline"))
+                testing_aux_timeline(arg);
+            else if(!strcmp(arg.function, "aux_matmul_plan_stats"))
+                testing_aux_matmul_plan_stats(arg);
+            else if(!strcmp(arg.function, "aux_log_bench"))
+                testing_aux_log_bench(arg);
+            else if(!strcmp(arg.function, "aux_trace_binary"))
+                testing_aux_trace_binary(arg);
+            else if(!strcmp(arg.function, "aux_ostream_stress"))
+                testing_aux_ostream_stress(arg);
+            else if(!strcmp(arg.function, "aux_init_env_refresh"))
+                testing_aux_init_env_refresh(arg);
+            else if(!strcmp(arg.function, "aux_yaml_expand"))
+                testing_aux_yaml_expand(arg);
+            else if(!strcmp(arg.function, "aux_yaml_gentest"))
+                testing_aux_yaml_gentest(arg);
+            else if(!strcmp(arg.function, "aux_golden_cache"))
+                testing_aux_golden_cache(arg);
+            else if(!strcmp(arg.function, "aux_init_counter_rng"))
+                testing_aux_init_counter_rng(arg);
+            else if(!strcmp(arg.function, "aux_compare_report"))
+                testing_aux_compare_report(arg);
+            else if(!strcmp(arg.function, "aux_memory_usage"))
+                testing_aux_memory_usage(arg);
+            else if(!strcmp(arg.function, "aux_matmul_graph"))
+                testing_aux_matmul_graph(arg);
             else if(!strcmp(arg.function, "aux_get_workspace_size_bad_arg"))
                 testing_aux_get_workspace_size_bad_arg(arg);
             else if(!strcmp(arg.function, "aux_get_workspace_size"))
@@ -134,6 +168,9 @@ namespace
             return !strcmp(arg.function, "aux_handle_init_bad_arg")
                    || !strcmp(arg.function, "aux_handle_destroy_bad_arg")
                    || !strcmp(arg.function, "aux_handle")
+                   || !strcmp(arg.function, "aux_workspace_arena")
+                   || !strcmp(arg.function, "aux_matmul_shard_partition")
+                   || !strcmp(arg.function, "aux_matmul_sharded")
                    || !strcmp(arg.function, "aux_mat_init_dense_bad_arg")
                    || !strcmp(arg.function, "aux_mat_init_structured_bad_arg")
                    || !strcmp(arg.function, "aux_mat_dense_init_arg")
@@ -157,6 +194,20 @@ namespace
                    || !strcmp(arg.function, "aux_matmul_alg_get_attr_bad_arg")
                    || !strcmp(arg.function, "aux_matmul_plan_init_bad_arg")
                    || !strcmp(arg.function, "aux_matmul_plan_init")
+                   || !strcmp(arg.function, "aux_matmul_plan_init_async")
+                   || !strcmp(arg.function, "aux_timeline")
+                   || !strcmp(arg.function, "aux_matmul_plan_stats")
+                   || !strcmp(arg.function, "aux_log_bench")
+                   || !strcmp(arg.function, "aux_trace_binary")
+                   || !strcmp(arg.function, "aux_ostream_stress")
+                   || !strcmp(arg.function, "aux_init_env_refresh")
+                   || !strcmp(arg.function, "aux_yaml_expand")
+                   || !strcmp(arg.function, "aux_yaml_gentest")
+                   || !strcmp(arg.function, "aux_golden_cache")
+                   || !strcmp(arg.function, "aux_init_counter_rng")
+                   || !strcmp(arg.function, "aux_compare_report")
+                   || !strcmp(arg.function, "aux_memory_usage")
+                   || !strcmp(arg.function, "aux_matmul_graph")
                    || !strcmp(arg.function, "aux_get_workspace_size_bad_arg")
                    || !strcmp(arg.function, "aux_get_workspace_size");
         }
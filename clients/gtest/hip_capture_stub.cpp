@@ -0,0 +1,105 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "hip_capture_stub.hpp"
+
+#include <hip/hip_runtime_api.h>
+
+#ifdef __HIP_PLATFORM_AMD__
+
+#include <dlfcn.h>
+
+namespace
+{
+    thread_local bool        t_recording = false;
+    thread_local int         t_calls     = 0;
+    thread_local std::string t_names;
+
+    void record(const char* name)
+    {
+        if(!t_recording)
+            return;
+        t_calls++;
+        t_names += t_names.empty() ? "" : " ";
+        t_names += name;
+    }
+}
+
+// The definitions of the executable take precedence over the ones of the HIP runtime for
+// the library too, each one records the call and forwards it to the next definition.
+#define HIP_CAPTURE_STUB(NAME, PARAMS, ARGS)                                                  \
+    extern "C" hipError_t NAME PARAMS                                                        \
+    {                                                                                        \
+        static auto next = reinterpret_cast<hipError_t(*) PARAMS>(dlsym(RTLD_NEXT, #NAME)); \
+        record(#NAME);                                                                       \
+        return next ARGS;                                                                    \
+    }
+
+HIP_CAPTURE_STUB(hipDeviceSynchronize, (), ())
+HIP_CAPTURE_STUB(hipStreamSynchronize, (hipStream_t stream), (stream))
+HIP_CAPTURE_STUB(hipStreamQuery, (hipStream_t stream), (stream))
+HIP_CAPTURE_STUB(hipEventSynchronize, (hipEvent_t event), (event))
+HIP_CAPTURE_STUB(hipEventQuery, (hipEvent_t event), (event))
+HIP_CAPTURE_STUB(hipEventElapsedTime,
+                 (float* ms, hipEvent_t start, hipEvent_t stop),
+                 (ms, start, stop))
+HIP_CAPTURE_STUB(hipMalloc, (void** ptr, size_t size), (ptr, size))
+HIP_CAPTURE_STUB(hipFree, (void* ptr), (ptr))
+HIP_CAPTURE_STUB(hipMemcpy,
+                 (void* dst, const void* src, size_t sizeBytes, hipMemcpyKind kind),
+                 (dst, src, sizeBytes, kind))
+HIP_CAPTURE_STUB(hipModuleLoadData, (hipModule_t* module, const void* image), (module, image))
+HIP_CAPTURE_STUB(hipModuleUnload, (hipModule_t module), (module))
+
+#undef HIP_CAPTURE_STUB
+
+void hip_capture_stub_begin()
+{
+    t_calls     = 0;
+    t_names     = "";
+    t_recording = true;
+}
+
+int hip_capture_stub_end(std::string* calls)
+{
+    t_recording = false;
+    if(calls)
+        *calls = t_names;
+    return t_calls;
+}
+
+#else
+
+void hip_capture_stub_begin() {}
+
+int hip_capture_stub_end(std::string* calls)
+{
+    if(calls)
+        *calls = "";
+    return 0;
+}
+
+#endif
@@ -135,6 +135,9 @@ namespace
                          << hipsparselt_datatype_to_string(arg.bias_type);
                 }
 
+                if(arg.output_scale)
+                    name << "_oscale";
+
                 name << '_' << (char)std::toupper(arg.transA) << (char)std::toupper(arg.transB);
 
                 name << '_' << arg.M << '_' << arg.N << '_' << arg.K << '_' << arg.alpha << '_'
@@ -27,6 +27,7 @@
 #pragma once
 
 #include "hipsparselt_arguments.hpp"
+#include "hipsparselt_bench_report.hpp"
 
 namespace ArgumentLogging
 {
@@ -36,6 +37,10 @@ namespace ArgumentLogging
 void ArgumentModel_set_log_function_name(bool f);
 bool ArgumentModel_get_log_function_name();
 
+// time and Gflops of the last logged performance result, used by the bench replay.
+void ArgumentModel_set_last_perf(double gpu_us, double gflops);
+void ArgumentModel_get_last_perf(double& gpu_us, double& gflops);
+
 // ArgumentModel template has a variadic list of argument enums
 template <hipsparselt_argument... Args>
 class ArgumentModel
@@ -51,17 +56,19 @@ class ArgumentModel
     }
 
 public:
-    void log_perf(hipsparselt_internal_ostream& name_line,
-                  hipsparselt_internal_ostream& val_line,
-                  const Arguments&              arg,
-                  double                        gpu_us,
-                  double                        gflops,
-                  double                        gbytes,
-                  double                        cpu_us,
-                  double                        norm1,
-                  double                        norm2,
-                  double                        norm3,
-                  double                        norm4)
+    void log_perf(hipsparselt_internal_ostream&                name_line,
+                  hipsparselt_internal_ostream&                val_line,
+                  std::vector<std::pair<std::string, double>>& perf,
+                  const Arguments&                             arg,
+                  double                                       gpu_us,
+                  double                                       gflops,
+                  double                                       gbytes,
+                  double                                       cpu_us,
+                  double                                       norm1,
+                  double                                       norm2,
+                  double                                       norm3,
+                  double                                       norm4,
+                  double                                       cold_us)
     {
         constexpr bool has_batch_count = has(e_batch_count);
         int64_t        batch_count     = has_batch_count ? arg.batch_count : 1;
@@ -70,64 +77,84 @@ public:
         // gpu time is total cumulative over hot calls, cpu is not
         if(hot_calls > 1)
             gpu_us /= hot_calls;
+        if(hot_calls > 1 && cold_us != ArgumentLogging::NA_value)
+            cold_us /= hot_calls;
 
         // per/us to per/sec *10^6
         double hipsparselt_gflops = gflops * batch_count / gpu_us * 1e6;
         double hipsparselt_GBps   = gbytes * batch_count / gpu_us * 1e6;
 
+        // append one performance field to the lines and to the machine readable result
+        auto append = [&](const char* name, double value, const char* delim = ", ") {
+            name_line << "," << name;
+            val_line << delim << value;
+            perf.emplace_back(name, value);
+        };
+
         // append performance fields
         if(gflops != ArgumentLogging::NA_value)
+            append("hipsparselt-Gflops", hipsparselt_gflops);
+
+        // GB/s not usually reported for non-memory bound functions
+        if(gbytes != ArgumentLogging::NA_value)
+            append("hipsparselt-GB/s", hipsparselt_GBps);
+
+        // roofline, a layer far below the compute peak but near the bandwidth peak is bandwidth
+        // bound. Only the matmul runs on the matrix cores the compute peak is for.
+        double peak_gflops, peak_gbps;
+        hipsparselt_bench_get_peaks(arg.a_type, peak_gflops, peak_gbps);
+        if(gflops != ArgumentLogging::NA_value && gbytes != ArgumentLogging::NA_value)
+            append("flop/byte", gflops / gbytes);
+        if(gflops != ArgumentLogging::NA_value && has(e_alpha) && peak_gflops > 0)
+            append("%peak-Gflops", hipsparselt_gflops / peak_gflops * 100);
+        if(gbytes != ArgumentLogging::NA_value && peak_gbps > 0)
+            append("%peak-GB/s", hipsparselt_GBps / peak_gbps * 100);
+
+        append("us", gpu_us);
+
+        // distribution of the per-iteration times of the hot calls
+        hipsparselt_timing_stats stats;
+        if(hipsparselt_bench_take_timing_stats(stats))
         {
-            name_line << ",hipsparselt-Gflops";
-            val_line << ", " << hipsparselt_gflops;
+            append("min-us", stats.min);
+            append("median-us", stats.median);
+            append("p90-us", stats.p90);
+            append("p99-us", stats.p99);
+            append("stddev-us", stats.stddev);
         }
 
-        if(gbytes != ArgumentLogging::NA_value)
+        // the same calls on rotating copies of the operands which are not in the cache
+        if(cold_us != ArgumentLogging::NA_value)
         {
-            // GB/s not usually reported for non-memory bound functions
-            name_line << ",hipsparselt-GB/s";
-            val_line << ", " << hipsparselt_GBps;
+            if(gflops != ArgumentLogging::NA_value)
+                append("hipsparselt-cold-Gflops", gflops * batch_count / cold_us * 1e6);
+            append("cold-us", cold_us);
         }
 
-        name_line << ",us";
-        val_line << ", " << gpu_us;
+        if(gflops != ArgumentLogging::NA_value)
+            ArgumentModel_set_last_perf(gpu_us, hipsparselt_gflops);
+        else
+            ArgumentModel_set_last_perf(gpu_us, ArgumentLogging::NA_value);
 
         if(arg.unit_check || arg.norm_check)
         {
             if(cpu_us != ArgumentLogging::NA_value)
             {
                 if(gflops != ArgumentLogging::NA_value)
-                {
-                    double cblas_gflops = gflops * batch_count / cpu_us * 1e6;
-                    name_line << ",CPU-Gflops";
-                    val_line << "," << cblas_gflops;
-                }
-
-                name_line << ",CPU-us";
-                val_line << "," << cpu_us;
+                    append("CPU-Gflops", gflops * batch_count / cpu_us * 1e6, ",");
+
+                append("CPU-us", cpu_us, ",");
             }
             if(arg.norm_check)
             {
                 if(norm1 != ArgumentLogging::NA_value)
-                {
-                    name_line << ",norm_error_1";
-                    val_line << "," << norm1;
-                }
+                    append("norm_error_1", norm1, ",");
                 if(norm2 != ArgumentLogging::NA_value)
-                {
-                    name_line << ",norm_error_2";
-                    val_line << "," << norm2;
-                }
+                    append("norm_error_2", norm2, ",");
                 if(norm3 != ArgumentLogging::NA_value)
-                {
-                    name_line << ",norm_error_3";
-                    val_line << "," << norm3;
-                }
+                    append("norm_error_3", norm3, ",");
                 if(norm4 != ArgumentLogging::NA_value)
-                {
-                    name_line << ",norm_error_4";
-                    val_line << "," << norm4;
-                }
+                    append("norm_error_4", norm4, ",");
             }
         }
     }
@@ -142,10 +169,13 @@ public:
                   double                        norm1     = ArgumentLogging::NA_value,
                   double                        norm2     = ArgumentLogging::NA_value,
                   double                        norm3     = ArgumentLogging::NA_value,
-                  double                        norm4     = ArgumentLogging::NA_value)
+                  double                        norm4     = ArgumentLogging::NA_value,
+                  double                        cold_us   = ArgumentLogging::NA_value)
     {
-        hipsparselt_internal_ostream name_list;
-        hipsparselt_internal_ostream value_list;
+        hipsparselt_internal_ostream                     name_list;
+        hipsparselt_internal_ostream                     value_list;
+        std::vector<std::pair<std::string, std::string>> args;
+        std::vector<std::pair<std::string, double>>      perf;
 
         if(ArgumentModel_get_log_function_name())
         {
@@ -159,6 +189,10 @@ public:
             name_list << delim << name;
             value_list << delim << value;
             delim = ",";
+
+            hipsparselt_internal_ostream value_str;
+            value_str << value;
+            args.emplace_back(name, value_str.str());
         };
 
 #if __cplusplus >= 201703L
@@ -170,8 +204,10 @@ public:
 #endif
 
         if(arg.timing)
+        {
             log_perf(name_list,
                      value_list,
+                     perf,
                      arg,
                      gpu_us,
                      gflops,
@@ -180,7 +216,10 @@ public:
                      norm1,
                      norm2,
                      norm3,
-                     norm4);
+                     norm4,
+                     cold_us);
+            hipsparselt_bench_report_result(arg.function, args, perf);
+        }
 
         str << name_list << "\n" << value_list << std::endl;
     }
@@ -0,0 +1,67 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+/*!\file
+ * \brief provides the bytes read and written by the hipSPARSELt functions, the roofline model
+ * of hipsparselt-bench relates them to the GFLOP counts of flops.hpp. A structured 2:4 matrix
+ * keeps half of the values of each row and 2 bits of metadata for each of them, which are
+ * rows * k / 8 bytes.
+ */
+
+/* \brief bytes of the compressed values and metadata of a rows x k structured matrix */
+template <typename T>
+constexpr double compressed_gbyte_count(int64_t rows, int64_t k)
+{
+    return (rows * k / 2.0 * sizeof(T) + rows * k / 8.0) / 1e9;
+}
+
+/* \brief bytes of spmm, the compressed structured matrix, the dense matrix, C if it is read
+ * (beta != 0), D and the bias vector */
+template <typename Ti, typename To, typename TBias>
+constexpr double spmm_gbyte_count(
+    int64_t m, int64_t n, int64_t k, bool sparse_b, bool read_c, bool bias_vector)
+{
+    return (sparse_b ? compressed_gbyte_count<Ti>(n, k) + m * k * sizeof(Ti) / 1e9
+                     : compressed_gbyte_count<Ti>(m, k) + k * n * sizeof(Ti) / 1e9)
+           + (read_c ? 2.0 : 1.0) * m * n * sizeof(To) / 1e9
+           + (bias_vector ? m * sizeof(TBias) / 1e9 : 0.0);
+}
+
+/* \brief bytes of prune, the dense matrix is read and the pruned one written */
+template <typename T>
+constexpr double prune_gbyte_count(int64_t m, int64_t n)
+{
+    return 2.0 * m * n * sizeof(T) / 1e9;
+}
+
+/* \brief bytes of compress, the pruned matrix is read and the compressed one written */
+template <typename T>
+constexpr double compress_gbyte_count(int64_t rows, int64_t k)
+{
+    return rows * k * sizeof(T) / 1e9 + compressed_gbyte_count<T>(rows, k);
+}
@@ -27,6 +27,7 @@
 #pragma once
 
 #include "cblas.h"
+#include <functional>
 #include <hipsparselt/hipsparselt.h>
 #include <type_traits>
 
@@ -51,3 +52,30 @@ void cblas_gemm(hipsparseOperation_t   transA,
                 std::add_pointer_t<To> C,
                 int64_t                ldc,
                 bool                   alt = false);
+
+// Epilogue of cblas_gemm_blocked, maps alpha * A * B + beta * C of an element in the given row
+// to the value which is converted to To, e.g. the bias and the activation of a matmul.
+using cblas_gemm_epilogue = std::function<float(float value, int64_t row)>;
+
+/*! \brief Cache blocked gemm for the types cblas does not support.
+ *
+ * Instead of full float copies of A, B and C, each tile of C converts the panels of A and B it
+ * needs while it packs them, to float for __half and hip_bfloat16 and to int32_t for int8_t,
+ * which is exact. The tiles run on OpenMP threads and the epilogue is applied to each tile
+ * before it is converted to To, int8_t is rounded and saturated like cblas_gemm.
+ */
+template <typename Ti, typename To>
+void cblas_gemm_blocked(hipsparseOperation_t       transA,
+                        hipsparseOperation_t       transB,
+                        int64_t                    m,
+                        int64_t                    n,
+                        int64_t                    k,
+                        float                      alpha,
+                        const Ti*                  A,
+                        int64_t                    lda,
+                        const Ti*                  B,
+                        int64_t                    ldb,
+                        float                      beta,
+                        To*                        C,
+                        int64_t                    ldc,
+                        const cblas_gemm_epilogue& epilogue = nullptr);
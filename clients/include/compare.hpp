@@ -0,0 +1,272 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+/* =====================================================================
+    Compare check: compares two results in one parallel pass
+   =================================================================== */
+
+/*!\file
+ * \brief compares two results (usually, CPU and GPU results) in one vectorized and parallel pass,
+ * which counts the mismatches, computes the max absolute and relative error and the norms, and
+ * keeps the coordinates of the first mismatches for the report of a failed check.
+ */
+
+#pragma once
+
+#include "hipsparselt_math.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <hipsparselt/hipsparselt.h>
+#include <limits>
+#include <omp.h>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/* ============================================================================================ */
+/*! \brief  Element predicates of the checks, called with the CPU and the GPU value */
+
+// Same value
+struct compare_eq
+{
+    template <typename Tc, typename Tg>
+    bool operator()(Tc a, Tg b) const
+    {
+        return double(a) == double(b);
+    }
+};
+
+// Within 4 units in the last place, the same as ASSERT_FLOAT_EQ and ASSERT_DOUBLE_EQ
+struct compare_float_eq
+{
+    template <typename T, typename U>
+    static U biased(T x)
+    {
+        U u;
+        memcpy(&u, &x, sizeof(u));
+        const U sign = U(1) << (sizeof(U) * 8 - 1);
+        return u & sign ? ~u + 1 : sign | u;
+    }
+
+    bool operator()(float a, float b) const
+    {
+        uint32_t x = biased<float, uint32_t>(a), y = biased<float, uint32_t>(b);
+        return (x > y ? x - y : y - x) <= 4;
+    }
+
+    bool operator()(double a, double b) const
+    {
+        uint64_t x = biased<double, uint64_t>(a), y = biased<double, uint64_t>(b);
+        return (x > y ? x - y : y - x) <= 4;
+    }
+};
+
+// Relative difference |a - b| / (|a| + |b| + 1) below tolerance, as ASSERT_HALF_EQ (0.01) and
+// ASSERT_BF16_EQ (0.1)
+struct compare_rel_eq
+{
+    float tolerance;
+
+    template <typename Tc, typename Tg>
+    bool operator()(Tc a, Tg b) const
+    {
+        float x = float(a), y = float(b);
+        return std::abs(x - y) / (std::abs(x) + std::abs(y) + 1) < tolerance;
+    }
+};
+
+// hip_bfloat16 result of a float reference, which may be rounded or truncated, as
+// ASSERT_FLOAT_BF16_EQ
+struct compare_float_bf16_eq
+{
+    bool operator()(float a, hip_bfloat16 b) const
+    {
+        return compare_float_eq{}(float(b), float(float_to_bfloat16_truncate(a)))
+               || compare_float_eq{}(float(b), float(hip_bfloat16(a)));
+    }
+};
+
+// Absolute difference within a bound, as ASSERT_NEAR
+struct compare_near
+{
+    double abs_error;
+
+    template <typename Tc, typename Tg>
+    bool operator()(Tc a, Tg b) const
+    {
+        return std::abs(double(a) - double(b)) <= abs_error;
+    }
+};
+
+/* ============================================================================================ */
+/*! \brief  Summary of a comparison */
+struct compare_result
+{
+    struct mismatch
+    {
+        int64_t batch, i, j;
+        double  cpu, gpu;
+    };
+
+    int64_t count         = 0; // compared elements
+    int64_t mismatches    = 0;
+    double  max_abs_error = 0; // of the elements which are not both NaN
+    double  max_rel_error = 0; // relative to the CPU value, or absolute where it is 0
+
+    // squares of the Frobenius norms of CPU - GPU and of CPU, per batch
+    std::vector<double> batch_error2, batch_cpu2;
+
+    // the first mismatches in batch, column, row order
+    std::vector<mismatch> first;
+
+    // ||CPU - GPU||_F / ||CPU||_F of a batch
+    double norm_error(int64_t batch) const
+    {
+        double cpu = std::sqrt(batch_cpu2[batch]), error = std::sqrt(batch_error2[batch]);
+        return cpu ? error / cpu : error;
+    }
+
+    std::string report() const
+    {
+        std::ostringstream out;
+        out << mismatches << " of " << count << " elements differ, max abs error "
+            << max_abs_error << ", max rel error " << max_rel_error;
+        for(const auto& m : first)
+            out << "\n  batch " << m.batch << ", row " << m.i << ", column " << m.j << ": CPU "
+                << m.cpu << ", GPU " << m.gpu;
+        if(mismatches > int64_t(first.size()))
+            out << "\n  ...";
+        return out.str();
+    }
+};
+
+// Number of mismatches a failed check reports
+constexpr size_t compare_max_report = 10;
+
+/*! \brief  Compare the M x N matrices of batch_count batches. A NaN of the CPU must be a NaN of
+ *          the GPU, any other value must satisfy equal(cpu, gpu). The columns are split among
+ *          the threads and the rows of a column are reduced in a SIMD loop, the rows of a column
+ *          with a mismatch are only visited again to record the first max_report of them. */
+template <typename Tc, typename Tg, typename Equal>
+compare_result compare_general(int64_t   M,
+                               int64_t   N,
+                               int64_t   lda,
+                               int64_t   stride,
+                               const Tc* hCPU,
+                               const Tg* hGPU,
+                               int64_t   batch_count,
+                               Equal     equal,
+                               size_t    max_report = compare_max_report)
+{
+    compare_result result;
+    result.count = M * N * batch_count;
+    result.batch_error2.assign(batch_count, 0);
+    result.batch_cpu2.assign(batch_count, 0);
+
+    auto match = [&](Tc a, Tg b) {
+        double x = double(a), y = double(b);
+        return x != x ? y != y : y == y && equal(a, b);
+    };
+
+#pragma omp parallel
+    {
+        compare_result local;
+        local.batch_error2.assign(batch_count, 0);
+        local.batch_cpu2.assign(batch_count, 0);
+
+#pragma omp for schedule(static) nowait
+        for(int64_t col = 0; col < N * batch_count; col++)
+        {
+            const int64_t batch = col / N, j = col % N;
+            const Tc*     cpu   = hCPU + batch * stride + j * lda;
+            const Tg*     gpu   = hGPU + batch * stride + j * lda;
+
+            int64_t bad     = 0;
+            double  max_abs = 0, max_rel = 0, error2 = 0, cpu2 = 0;
+#pragma omp simd reduction(+ : bad, error2, cpu2) reduction(max : max_abs, max_rel)
+            for(int64_t i = 0; i < M; i++)
+            {
+                double x = double(cpu[i]), y = double(gpu[i]);
+                double d = x != x && y != y ? 0 : std::abs(x - y);
+                d        = d == d ? d : std::numeric_limits<double>::infinity();
+                max_abs  = std::max(max_abs, d);
+                max_rel  = std::max(max_rel, x != 0 ? d / std::abs(x) : d);
+                error2 += d * d;
+                cpu2 += x == x ? x * x : 0;
+                bad += !match(cpu[i], gpu[i]);
+            }
+
+            local.mismatches += bad;
+            local.max_abs_error = std::max(local.max_abs_error, max_abs);
+            local.max_rel_error = std::max(local.max_rel_error, max_rel);
+            local.batch_error2[batch] += error2;
+            local.batch_cpu2[batch] += cpu2;
+
+            for(int64_t i = 0; bad && i < M && local.first.size() < max_report; i++)
+                if(!match(cpu[i], gpu[i]))
+                    local.first.push_back({batch, i, j, double(cpu[i]), double(gpu[i])});
+        }
+
+#pragma omp critical
+        {
+            result.mismatches += local.mismatches;
+            result.max_abs_error = std::max(result.max_abs_error, local.max_abs_error);
+            result.max_rel_error = std::max(result.max_rel_error, local.max_rel_error);
+            for(int64_t b = 0; b < batch_count; b++)
+            {
+                result.batch_error2[b] += local.batch_error2[b];
+                result.batch_cpu2[b] += local.batch_cpu2[b];
+            }
+            result.first.insert(result.first.end(), local.first.begin(), local.first.end());
+        }
+    }
+
+    // each thread kept the first mismatches of its columns, which include the first ones overall
+    std::sort(result.first.begin(),
+              result.first.end(),
+              [](const compare_result::mismatch& x, const compare_result::mismatch& y) {
+                  return std::tie(x.batch, x.j, x.i) < std::tie(y.batch, y.j, y.i);
+              });
+    if(result.first.size() > max_report)
+        result.first.resize(max_report);
+
+    return result;
+}
+
+#ifndef GOOGLE_TEST
+#define COMPARE_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, EQUAL)
+#else
+// Fails the test once, with the summary and the first mismatches
+#define COMPARE_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, EQUAL)                    \
+    do                                                                                       \
+    {                                                                                        \
+        auto result__ = compare_general(M, N, lda, strideA, hCPU, hGPU, batch_count, EQUAL); \
+        ASSERT_EQ(result__.mismatches, 0) << result__.report();                              \
+    } while(0)
+#endif
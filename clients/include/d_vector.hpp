@@ -87,8 +87,9 @@ public:
 
     T* device_vector_setup()
     {
-        T* d = nullptr;
-        if(use_HMM ? hipMallocManaged(&d, m_bytes) : (hipMalloc)(&d, m_bytes) != hipSuccess)
+        T* d = use_HMM ? nullptr : static_cast<T*>(d_vector_cache_take(m_bytes));
+        if(d == nullptr
+           && (use_HMM ? hipMallocManaged(&d, m_bytes) : (hipMalloc)(&d, m_bytes) != hipSuccess))
         {
             hipsparselt_cerr << "Error allocating " << m_bytes << " m_bytes (" << (m_bytes >> 30)
                              << " GB)" << std::endl;
@@ -167,7 +168,9 @@ public:
                 EXPECT_EQ(memcmp(host, m_guard, m_guard_len), 0);
             }
 #endif
-            // Free device memory
+            // Free device memory, unless the memory cache keeps it for reuse
+            if(!use_HMM && d_vector_cache_give(d, m_bytes))
+                return;
             if((hipFree)(d) != hipSuccess)
             {
                 hipsparselt_cerr << "free device memory failed" << std::endl;
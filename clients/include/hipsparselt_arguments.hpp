@@ -124,6 +124,17 @@ struct Arguments
     int32_t search_iters;
 
     bool sparse_b;
+
+    int32_t launches;
+
+    int32_t config_id;
+
+    bool cold_cache;
+
+    int32_t concurrent_threads;
+    int32_t concurrent_streams;
+
+    bool output_scale;
     /*************************************************************************
      *                     End Of Arguments                                  *
      *************************************************************************/
@@ -185,7 +196,13 @@ struct Arguments
     OPER(HMM) SEP                    \
     OPER(search) SEP                 \
     OPER(search_iters) SEP            \
-    OPER(sparse_b) SEP
+    OPER(sparse_b) SEP               \
+    OPER(launches) SEP               \
+    OPER(config_id) SEP              \
+    OPER(cold_cache) SEP             \
+    OPER(concurrent_threads) SEP     \
+    OPER(concurrent_streams) SEP     \
+    OPER(output_scale) SEP
 
     // clang-format on
 
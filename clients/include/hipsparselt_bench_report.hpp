@@ -0,0 +1,82 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <hipsparselt/hipsparselt.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*! \brief Statistics of the per-iteration times of a timing loop, in microseconds. */
+struct hipsparselt_timing_stats
+{
+    double min;
+    double median;
+    double p90;
+    double p99;
+    double stddev;
+};
+
+// Compute the statistics of the per-iteration times, us is sorted in place.
+hipsparselt_timing_stats hipsparselt_compute_timing_stats(std::vector<double>& us);
+
+// The per-iteration times of the test which is about to call log_args. log_perf takes them
+// with hipsparselt_bench_take_timing_stats(), which returns false when none were set.
+void hipsparselt_bench_set_iteration_us(std::vector<double> us);
+bool hipsparselt_bench_take_timing_stats(hipsparselt_timing_stats& stats);
+
+/*! \brief Machine readable output and baseline regression gate of hipsparselt-bench.
+ *
+ * Every result logged by ArgumentModel::log_args is appended to the CSV and JSON files, and
+ * compared against the result of the same function and arguments in the baseline CSV file.
+ * A time column (us, median-us, p99-us) which is more than tolerance percent above the
+ * baseline is reported as a regression. A tolerance column in the baseline overrides the
+ * tolerance of its row.
+ */
+void hipsparselt_bench_report_open(const std::string& csv_file,
+                                   const std::string& json_file,
+                                   const std::string& baseline_file,
+                                   double             tolerance);
+
+void hipsparselt_bench_report_result(
+    const std::string&                                      function,
+    const std::vector<std::pair<std::string, std::string>>& args,
+    const std::vector<std::pair<std::string, double>>&      perf);
+
+// Close the output files, returns the number of regressions found.
+int hipsparselt_bench_report_close();
+
+/*! \brief Peaks the roofline columns of hipsparselt-bench are relative to.
+ *
+ * A peak set by hipsparselt_bench_set_peaks is used as it is, a peak of 0 is derived from the
+ * hipDeviceProp_t of the current device: the memory bandwidth from its memory clock and bus
+ * width, the compute peak from its compute units and engine clock times the structured sparse
+ * matrix core rate of the data type on a known architecture. A peak which is still 0 is
+ * unknown and its percent-of-peak column is left out.
+ */
+void hipsparselt_bench_set_peaks(double gflops, double gbps);
+void hipsparselt_bench_get_peaks(hipsparseLtDatatype_t type, double& gflops, double& gbps);
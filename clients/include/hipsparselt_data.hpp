@@ -39,6 +39,13 @@
 #include <string>
 #include <utility>
 
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #if __has_include(<filesystem>)
 #include <filesystem>
 namespace fs = std::filesystem;
@@ -61,6 +68,82 @@ class HipSparseLt_TestData
         return filename;
     }
 
+    // Input stream over the data file mapped into memory, so reading the tests again for each
+    // test suite does not read the file again. Files which cannot be mapped, e.g. pipes, are
+    // read through a filebuf.
+    class data_stream : public std::istream
+    {
+        class mapped_buf : public std::streambuf
+        {
+        public:
+            void set(char* data, size_t size)
+            {
+                setg(data, data, data + size);
+            }
+
+        protected:
+            pos_type seekoff(off_type               off,
+                             std::ios_base::seekdir dir,
+                             std::ios_base::openmode) override
+            {
+                char* base = dir == std::ios_base::beg   ? eback()
+                             : dir == std::ios_base::cur ? gptr()
+                                                         : egptr();
+                if(off < eback() - base || off > egptr() - base)
+                    return pos_type(off_type(-1));
+                setg(eback(), base + off, egptr());
+                return pos_type(gptr() - eback());
+            }
+
+            pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+            {
+                return seekoff(off_type(pos), std::ios_base::beg, which);
+            }
+        };
+
+        mapped_buf   m_mapped;
+        std::filebuf m_file;
+        void*        m_map  = nullptr;
+        size_t       m_size = 0;
+
+    public:
+        explicit data_stream(const std::string& name)
+            : std::istream(nullptr)
+        {
+#ifndef WIN32
+            int         fd = open(name.c_str(), O_RDONLY | O_CLOEXEC);
+            struct stat st;
+            if(fd >= 0 && !fstat(fd, &st) && S_ISREG(st.st_mode) && st.st_size > 0)
+            {
+                void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if(map != MAP_FAILED)
+                {
+                    m_map  = map;
+                    m_size = st.st_size;
+                    m_mapped.set(static_cast<char*>(map), m_size);
+                }
+            }
+            if(fd >= 0)
+                close(fd);
+            if(m_map)
+            {
+                rdbuf(&m_mapped);
+                return;
+            }
+#endif
+            if(m_file.open(name, std::ios_base::in | std::ios_base::binary))
+                rdbuf(&m_file);
+        }
+
+        ~data_stream()
+        {
+#ifndef WIN32
+            if(m_map)
+                munmap(m_map, m_size);
+#endif
+        }
+    };
+
     // filter iterator
     class iterator : public std::istream_iterator<Arguments>
     {
@@ -117,15 +200,14 @@ public:
     // begin() iterator which accepts an optional filter.
     static iterator begin(bool filter(const Arguments&) = nullptr)
     {
-        static std::ifstream* ifs = nullptr;
+        static data_stream* ifs = nullptr;
 
         // If this is the first time, or after test_cleanup::cleanup() has been called
         if(!ifs)
         {
             std::string fileToOpen = filename();
-            // Allocate a std::ifstream and register it to be deleted during cleanup
-            ifs = test_cleanup::allocate(
-                &ifs, fileToOpen, std::ifstream::in | std::ifstream::binary);
+            // Allocate a data_stream and register it to be deleted during cleanup
+            ifs = test_cleanup::allocate(&ifs, fileToOpen);
             if(!ifs || ifs->fail())
             {
                 hipsparselt_cerr << "Cannot open " << fileToOpen << ": " << strerror(errno)
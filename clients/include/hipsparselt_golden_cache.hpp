@@ -0,0 +1,55 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#pragma once
+
+#include "hipsparselt_arguments.hpp"
+#include <cstddef>
+#include <cstdint>
+
+/*! \brief On-disk cache of the host reference results of the tests.
+ *
+ * The cache is enabled by setting HIPSPARSELT_GOLDEN_CACHE to a directory. A result is stored
+ * in one file named after its key, a hash of the arguments which determine it and of the seed
+ * of the random data, and holds a hash of the inputs it was computed from. A load maps the
+ * file and copies the result only when both hashes match, so a result is recomputed whenever
+ * the inputs differ, e.g. the data of a test on another thread.
+ */
+bool hipsparselt_golden_cache_enabled();
+
+// FNV-1a of bytes taken 64 bits at a time, continued from hash.
+uint64_t
+    hipsparselt_golden_hash(const void* data, size_t bytes, uint64_t hash = 0xcbf29ce484222325);
+
+// Key of the result tag of the test with arguments arg.
+uint64_t hipsparselt_golden_key(const Arguments& arg, const char* tag);
+
+// Copy the cached result into dst, returns false when there is none or it does not match.
+bool hipsparselt_golden_load(uint64_t key, uint64_t input_hash, void* dst, size_t bytes);
+
+// Store a result, a file which is replaced is replaced atomically.
+void hipsparselt_golden_store(uint64_t key, uint64_t input_hash, const void* src, size_t bytes);
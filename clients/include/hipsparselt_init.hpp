@@ -39,26 +39,38 @@
 // for vector x (M=1, N=lengthX, lda=incx);
 // for complex number, the real/imag part would be initialized with the same value
 
-// Initialize matrices with random values
-template <typename T>
-void hipsparselt_init(
-    T* A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
+// Initialize matrices with value(r, i, j) of the random bits r of the counter-based generator.
+// Each matrix takes the next stream of the generator and each column is generated from its own
+// counters, so the matrix does not depend on the number of threads.
+template <typename T, typename F>
+void hipsparselt_init_counter(
+    T* A, size_t M, size_t N, size_t lda, size_t stride, size_t batch_count, F value)
 {
+    constexpr size_t block  = hipsparselt_philox::block;
+    const uint32_t   stream = hipsparselt_philox::next_stream();
+#pragma omp parallel for collapse(2)
     for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-    {
-        size_t b_idx = i_batch * stride;
         for(size_t j = 0; j < N; ++j)
         {
-            size_t col_idx = b_idx + j * lda;
-            if(M > 4)
-                random_run_generator<T>(A + col_idx, M);
-            else
+            T* col = A + j * lda + i_batch * stride;
+            for(size_t i = 0; i < M; i += block)
             {
-                for(size_t i = 0; i < M; ++i)
-                    A[col_idx + i] = random_generator<T>();
+                uint32_t r[block];
+                hipsparselt_philox::generate(r, stream, i_batch, j, i);
+                for(size_t k = 0; k < block && i + k < M; k++)
+                    col[i + k] = value(r[k], i + k, j);
             }
         }
-    }
+}
+
+// Initialize matrices with random values
+template <typename T>
+void hipsparselt_init(
+    T* A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
+{
+    hipsparselt_init_counter(A, M, N, lda, stride, batch_count, [](uint32_t r, size_t, size_t) {
+        return random_counter_generator<T>(r);
+    });
 }
 
 // Initialize matrices with random values
@@ -101,17 +113,10 @@ template <typename T>
 void hipsparselt_init_alternating_sign(
     T* A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
 {
-    for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-#pragma omp parallel for
-        for(size_t j = 0; j < N; ++j)
-        {
-            size_t offset = j * lda + i_batch * stride;
-            for(size_t i = 0; i < M; ++i)
-            {
-                auto value    = random_generator<T>();
-                A[i + offset] = (i ^ j) & 1 ? value : negate(value);
-            }
-        }
+    hipsparselt_init_counter(A, M, N, lda, stride, batch_count, [](uint32_t r, size_t i, size_t j) {
+        auto value = random_counter_generator<T>(r);
+        return (i ^ j) & 1 ? value : negate(value);
+    });
 }
 
 template <typename T>
@@ -126,17 +131,10 @@ template <typename T>
 void hipsparselt_init_hpl_alternating_sign(
     T* A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
 {
-    for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-#pragma omp parallel for
-        for(size_t j = 0; j < N; ++j)
-        {
-            size_t offset = j * lda + i_batch * stride;
-            for(size_t i = 0; i < M; ++i)
-            {
-                auto value    = random_hpl_generator<T>();
-                A[i + offset] = (i ^ j) & 1 ? value : negate(value);
-            }
-        }
+    hipsparselt_init_counter(A, M, N, lda, stride, batch_count, [](uint32_t r, size_t i, size_t j) {
+        auto value = random_counter_hpl_generator<T>(r);
+        return (i ^ j) & 1 ? value : negate(value);
+    });
 }
 
 template <typename T>
@@ -170,22 +168,18 @@ inline void hipsparselt_init_cos(
 // Initialize vector with HPL-like random values
 template <typename T>
 void hipsparselt_init_hpl(
-    std::vector<T>& A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
+    T* A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
 {
-    for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-        for(size_t i = 0; i < M; ++i)
-            for(size_t j = 0; j < N; ++j)
-                A[i + j * lda + i_batch * stride] = random_hpl_generator<T>();
+    hipsparselt_init_counter(A, M, N, lda, stride, batch_count, [](uint32_t r, size_t, size_t) {
+        return random_counter_hpl_generator<T>(r);
+    });
 }
 
 template <typename T>
 void hipsparselt_init_hpl(
-    T* A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
+    std::vector<T>& A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
 {
-    for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-        for(size_t i = 0; i < M; ++i)
-            for(size_t j = 0; j < N; ++j)
-                A[i + j * lda + i_batch * stride] = random_hpl_generator<T>();
+    hipsparselt_init_hpl(A.data(), M, N, lda, stride, batch_count);
 }
 
 /* ============================================================================================ */
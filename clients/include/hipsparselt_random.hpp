@@ -43,6 +43,10 @@ extern std::thread::id   g_main_thread_id;
 extern thread_local hipsparselt_rng_t t_hipsparselt_rng;
 extern thread_local int               t_hipsparselt_rand_idx;
 
+// Key of the counter-based generator, and the stream of the next matrix it initializes
+extern uint64_t              g_hipsparselt_counter_seed;
+extern thread_local uint32_t t_hipsparselt_rng_stream;
+
 // optimized helper
 float hipsparselt_uniform_int_1_10();
 
@@ -61,10 +65,77 @@ inline hipsparselt_rng_t get_seed()
 // Reset the seed (mainly to ensure repeatability of failures in a given suite)
 inline void hipsparselt_seedrand()
 {
-    t_hipsparselt_rng      = get_seed();
-    t_hipsparselt_rand_idx = 0;
+    t_hipsparselt_rng        = get_seed();
+    t_hipsparselt_rand_idx   = 0;
+    t_hipsparselt_rng_stream = 0;
 }
 
+/* ============================================================================================ */
+/*! \brief  Counter-based random number generator (Philox4x32-10 of Salmon et al., "Parallel
+ *          Random Numbers: As Easy as 1, 2, 3"). A value only depends on the seed and on its
+ *          counter, which is made of the stream of the matrix, the batch, the column and the
+ *          row, so a matrix is the same whichever thread generates which part of it. */
+struct hipsparselt_philox
+{
+    // values generated per call, 4 per counter
+    static constexpr int counters = 4;
+    static constexpr int block    = counters * 4;
+
+    // Stream of the next matrix, the streams restart at hipsparselt_seedrand()
+    static uint32_t next_stream()
+    {
+        return t_hipsparselt_rng_stream++;
+    }
+
+    // The values of rows row .. row + block - 1 of a column, row must be a multiple of block.
+    // The rounds work on the counters side by side so the compiler can vectorize them.
+    static void generate(
+        uint32_t (&r)[block], uint32_t stream, size_t batch, size_t col, size_t row)
+    {
+        uint32_t x[4][counters];
+        for(int c = 0; c < counters; c++)
+        {
+            x[0][c] = static_cast<uint32_t>(row / 4 + c);
+            x[1][c] = static_cast<uint32_t>(col);
+            x[2][c] = static_cast<uint32_t>(batch);
+            x[3][c] = stream;
+        }
+
+        uint32_t k0 = static_cast<uint32_t>(g_hipsparselt_counter_seed);
+        uint32_t k1 = static_cast<uint32_t>(g_hipsparselt_counter_seed >> 32);
+        for(int round = 0; round < 10; round++)
+        {
+            for(int c = 0; c < counters; c++)
+            {
+                uint64_t p0 = uint64_t(0xD2511F53) * x[0][c];
+                uint64_t p1 = uint64_t(0xCD9E8D57) * x[2][c];
+                x[0][c]     = static_cast<uint32_t>(p1 >> 32) ^ x[1][c] ^ k0;
+                x[1][c]     = static_cast<uint32_t>(p1);
+                x[2][c]     = static_cast<uint32_t>(p0 >> 32) ^ x[3][c] ^ k1;
+                x[3][c]     = static_cast<uint32_t>(p0);
+            }
+            k0 += 0x9E3779B9;
+            k1 += 0xBB67AE85;
+        }
+
+        for(int c = 0; c < counters; c++)
+            for(int i = 0; i < 4; i++)
+                r[c * 4 + i] = x[i][c];
+    }
+
+    // A value in [lo, hi] from 32 random bits
+    static int uniform_int(uint32_t r, int lo, int hi)
+    {
+        return lo + static_cast<int>((uint64_t(r) * uint32_t(hi - lo + 1)) >> 32);
+    }
+
+    // A value in [lo, hi) from 32 random bits
+    static double uniform_real(uint32_t r, double lo, double hi)
+    {
+        return lo + (hi - lo) * (r * (1.0 / 4294967296.0));
+    }
+};
+
 /* ============================================================================================ */
 /*! \brief  Random number generator which generates NaN values */
 class hipsparselt_nan_rng
@@ -269,6 +340,32 @@ inline void random_run_generator<double>(double* ptr, size_t num)
     hipsparselt_uniform_int_1_10_run_double(ptr, num);
 };
 
+/*! \brief  convert random bits of the counter-based generator to a number of the range of
+ *          random_generator<T>() */
+template <typename T>
+inline T random_counter_generator(uint32_t r)
+{
+    return T(hipsparselt_philox::uniform_int(r, 1, 10));
+}
+
+template <>
+inline __half random_counter_generator<__half>(uint32_t r)
+{
+    return __half(CAST(hipsparselt_philox::uniform_int(r, -2, 2)));
+}
+
+template <>
+inline hip_bfloat16 random_counter_generator<hip_bfloat16>(uint32_t r)
+{
+    return hip_bfloat16(CAST(hipsparselt_philox::uniform_int(r, -2, 2)));
+}
+
+template <>
+inline int8_t random_counter_generator<int8_t>(uint32_t r)
+{
+    return static_cast<int8_t>(hipsparselt_philox::uniform_int(r, 1, 3));
+}
+
 // HPL
 
 /*! \brief  generate a random number in HPL-like [-0.5,0.5] doubles  */
@@ -300,6 +397,26 @@ inline hip_bfloat16 random_hpl_generator()
     return hip_bfloat16(std::uniform_real_distribution<float>(-0.5, 0.5)(t_hipsparselt_rng));
 }
 
+/*! \brief  convert random bits of the counter-based generator to a number of the range of
+ *          random_hpl_generator<T>() */
+template <typename T>
+inline T random_counter_hpl_generator(uint32_t r)
+{
+    return T(hipsparselt_philox::uniform_real(r, -0.5, 0.5));
+}
+
+template <>
+inline int8_t random_counter_hpl_generator(uint32_t r)
+{
+    return static_cast<int8_t>(std::nearbyint(hipsparselt_philox::uniform_real(r, -1.0, 1.0)));
+}
+
+template <>
+inline hip_bfloat16 random_counter_hpl_generator(uint32_t r)
+{
+    return hip_bfloat16(float(hipsparselt_philox::uniform_real(r, -0.5, 0.5)));
+}
+
 /*! \brief  generate a random ASCII string of up to length n */
 inline std::string random_string(size_t n)
 {
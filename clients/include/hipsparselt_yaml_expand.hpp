@@ -0,0 +1,64 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*! \brief In-process expansion of YAML test data into binary Arguments records.
+ *
+ * This reads the same YAML as hipsparselt_gentest.py, including its include: extension, and
+ * expands the Tests of each document with the same Datatypes, Arguments, Defaults, Known bugs,
+ * Functions and list and range product rules, so --yaml does not start a Python interpreter.
+ * Only the YAML used by test data is recognized: block and flow collections, plain and quoted
+ * scalars, anchors, aliases and << merges.
+ */
+
+// One line of YAML source, with the file and line number it came from for error messages.
+struct hipsparselt_yaml_line
+{
+    std::string text;
+    std::string file;
+    int         line;
+};
+
+using hipsparselt_yaml_source = std::vector<hipsparselt_yaml_line>;
+
+// Append the lines of file to source. An include: line is replaced by the lines of the file
+// it names, looked for in the directory of the including file and then in include_dirs.
+bool hipsparselt_yaml_read(hipsparselt_yaml_source&        source,
+                           const std::string&              file,
+                           const std::vector<std::string>& include_dirs);
+
+// Hash of the text of source, which determines the data it expands to.
+uint64_t hipsparselt_yaml_hash(const hipsparselt_yaml_source& source);
+
+// Expand the tests of all documents of source into data, the contents of a --data file.
+// Errors are printed in the format of hipsparselt_gentest.py and return false.
+bool hipsparselt_yaml_expand(const hipsparselt_yaml_source& source, std::string& data);
@@ -34,27 +34,16 @@
 
 #pragma once
 
+#include "compare.hpp"
 #include "hipsparselt_math.hpp"
 #include "hipsparselt_test.hpp"
 #include "hipsparselt_vector.hpp"
 #include <hipsparselt/hipsparselt.h>
 
 #ifndef GOOGLE_TEST
-#define NEAR_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, err, NEAR_ASSERT)
 #define NEAR_CHECK_B(M, N, lda, hCPU, hGPU, batch_count, err, NEAR_ASSERT)
 #else
 
-#define NEAR_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, err, NEAR_ASSERT) \
-    do                                                                            \
-    {                                                                             \
-        for(size_t k = 0; k < batch_count; k++)                                   \
-            for(size_t j = 0; j < N; j++)                                         \
-                for(size_t i = 0; i < M; i++)                                     \
-                    NEAR_ASSERT(hCPU[i + j * size_t(lda) + k * strideA],          \
-                                hGPU[i + j * size_t(lda) + k * strideA],          \
-                                err);                                             \
-    } while(0)
-
 #define NEAR_CHECK_B(M, N, lda, hCPU, hGPU, batch_count, err, NEAR_ASSERT)                    \
     do                                                                                        \
     {                                                                                         \
@@ -96,14 +85,14 @@ inline void near_check_general(int64_t                        M,
                                const T*                       hGPU,
                                double                         abs_error)
 {
-    NEAR_CHECK(M, N, lda, 0, hCPU, hGPU, 1, abs_error, ASSERT_NEAR);
+    COMPARE_CHECK(M, N, lda, 0, hCPU, hGPU, 1, compare_near{abs_error});
 }
 
 template <>
 inline void near_check_general(
     int64_t M, int64_t N, int64_t lda, const __half* hCPU, const __half* hGPU, double abs_error)
 {
-    NEAR_CHECK(M, N, lda, 0, hCPU, hGPU, 1, abs_error, NEAR_ASSERT_HALF);
+    COMPARE_CHECK(M, N, lda, 0, hCPU, hGPU, 1, compare_near{abs_error});
 }
 
 template <>
@@ -114,7 +103,7 @@ inline void near_check_general<hip_bfloat16, float>(int64_t             M,
                                                     const hip_bfloat16* hGPU,
                                                     double              abs_error)
 {
-    NEAR_CHECK(M, N, lda, 0, hCPU, hGPU, 1, abs_error, NEAR_ASSERT_BF16);
+    COMPARE_CHECK(M, N, lda, 0, hCPU, hGPU, 1, compare_near{abs_error});
 }
 
 template <typename T, typename T_hpa = T>
@@ -127,7 +116,7 @@ inline void near_check_general(int64_t                        M,
                                int64_t                        batch_count,
                                double                         abs_error)
 {
-    NEAR_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, abs_error, ASSERT_NEAR);
+    COMPARE_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, compare_near{abs_error});
 }
 
 template <>
@@ -140,7 +129,7 @@ inline void near_check_general(int64_t       M,
                                int64_t       batch_count,
                                double        abs_error)
 {
-    NEAR_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, abs_error, NEAR_ASSERT_HALF);
+    COMPARE_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, compare_near{abs_error});
 }
 
 template <>
@@ -153,7 +142,7 @@ inline void near_check_general<hip_bfloat16, float>(int64_t             M,
                                                     int64_t             batch_count,
                                                     double              abs_error)
 {
-    NEAR_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, abs_error, NEAR_ASSERT_BF16);
+    COMPARE_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, compare_near{abs_error});
 }
 
 template <typename T, typename T_hpa = T>
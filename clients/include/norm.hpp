@@ -27,6 +27,7 @@
 #pragma once
 
 #include "cblas.h"
+#include "compare.hpp"
 #include "hipsparselt_vector.hpp"
 #include "norm.hpp"
 #include "utility.hpp"
@@ -203,6 +204,16 @@ double norm_check_general(char        norm_type,
 
     double cumulative_error = 0.0;
 
+    // the Frobenius norms of all batches are computed in one parallel pass
+    if(norm_type == 'F' || norm_type == 'f')
+    {
+        auto result = compare_general(
+            M, N, lda, stride_a, (T_hpa*)hCPU, hGPU, batch_count, compare_eq{}, 0);
+        for(int64_t i = 0; i < batch_count; i++)
+            cumulative_error += result.norm_error(i);
+        return cumulative_error;
+    }
+
     for(size_t i = 0; i < batch_count; i++)
     {
         auto index = i * stride_a;
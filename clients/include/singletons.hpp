@@ -28,3 +28,10 @@
 #include <cstddef>
 extern size_t g_DVEC_PAD;
 void          d_vector_set_pad_length(size_t pad);
+
+// device memory blocks kept for reuse, see d_vector.hpp. The shape sweep of hipsparselt-bench
+// runs its largest case first and the smaller ones reuse its blocks. Disabling the cache frees
+// the blocks it keeps.
+void  d_vector_set_memory_cache(bool enable);
+void* d_vector_cache_take(size_t bytes);
+bool  d_vector_cache_give(void* ptr, size_t bytes);
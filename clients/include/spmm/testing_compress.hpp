@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include "bytes.hpp"
 #include "flops.hpp"
 #include "hipsparselt_datatype2string.hpp"
 #include "hipsparselt_init.hpp"
@@ -314,6 +315,13 @@ void testing_compress(const Arguments& arg)
     int run_version = 1;
     if(strstr(arg.name, "compress2") != nullptr)
         run_version = 2;
+    else if(strstr(arg.name, "compress_tiles") != nullptr)
+        run_version = 3;
+#ifndef __HIP_PLATFORM_AMD__
+    // cusparselt does not support tile granular prune/compress.
+    if(run_version == 3)
+        return;
+#endif
 
     hipsparseOperation_t transA = char_to_hipsparselt_operation(arg.transA);
     hipsparseOperation_t transB = char_to_hipsparselt_operation(arg.transB);
@@ -465,13 +473,41 @@ void testing_compress(const Arguments& arg)
             hipsparseLtSpMMACompressedSize(handle, plan, &compressed_size, &compress_buffer_size),
             HIPSPARSE_STATUS_SUCCESS);
     }
-    else if(run_version == 2)
+    else if(run_version == 2 || run_version == 3)
     {
         EXPECT_HIPSPARSE_STATUS(
             hipsparseLtSpMMACompressedSize2(
                 handle, arg.sparse_b ? matB : matA, &compressed_size, &compress_buffer_size),
             HIPSPARSE_STATUS_SUCCESS);
     }
+
+    // version 3 prunes and compresses the odd tiles first then the even ones, the even tiles must
+    // be untouched by the first pass and the two passes together must match a full prune/compress.
+    int64_t tile_size      = 0;
+    size_t  tile_mask_size = 0;
+    if(run_version == 3)
+    {
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtSpMMATileMaskSize(handle,
+                                                             arg.sparse_b ? matB : matA,
+                                                             &tile_size,
+                                                             &tile_mask_size),
+                                HIPSPARSE_STATUS_SUCCESS);
+    }
+    const size_t           size_mask = run_version == 3 ? tile_mask_size : 0;
+    device_vector<uint8_t> dMask_odd(size_mask, 1, HMM), dMask_even(size_mask, 1, HMM);
+    if(run_version == 3)
+    {
+        host_vector<uint8_t> hMask_odd(size_mask), hMask_even(size_mask);
+        for(size_t i = 0; i < size_mask; i++)
+        {
+            hMask_odd[i]  = 0xAA;
+            hMask_even[i] = 0x55;
+        }
+        CHECK_DEVICE_ALLOCATION(dMask_odd.memcheck());
+        CHECK_DEVICE_ALLOCATION(dMask_even.memcheck());
+        CHECK_HIP_ERROR(dMask_odd.transfer_from(hMask_odd));
+        CHECK_HIP_ERROR(dMask_even.transfer_from(hMask_even));
+    }
     const size_t size_A = stride_a == 0 ? lda * A_col * num_batches : stride_a * num_batches;
     const size_t size_A_pruned_copy     = arg.unit_check || arg.norm_check ? size_A : 0;
     const size_t size_A_compressed_copy = arg.unit_check || arg.norm_check ? compressed_size : 0;
@@ -553,6 +589,44 @@ void testing_compress(const Arguments& arg)
                                                        stream),
                                 HIPSPARSE_STATUS_SUCCESS);
     }
+    else if(run_version == 3)
+    {
+        uint8_t* dMasks[] = {dMask_odd, dMask_even};
+        for(int pass = 0; pass < 2; pass++)
+        {
+            EXPECT_HIPSPARSE_STATUS(hipsparseLtSpMMAPruneTiles(handle,
+                                                               arg.sparse_b ? matB : matA,
+                                                               !arg.sparse_b,
+                                                               arg.sparse_b ? transB : transA,
+                                                               dT,
+                                                               dT,
+                                                               hipsparseLtPruneAlg_t(arg.prune_algo),
+                                                               dMasks[pass],
+                                                               stream),
+                                    HIPSPARSE_STATUS_SUCCESS);
+            if(pass != 0)
+                continue;
+
+            // the even tiles keep their dense values after the odd pass.
+            host_vector<Ti> hT_odd(hT.size());
+            CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+            CHECK_HIP_ERROR(hT_odd.transfer_from(dT));
+            const size_t tiles_row    = (T_row + tile_size - 1) / tile_size;
+            const size_t tiles_col    = (T_col + tile_size - 1) / tile_size;
+            const int    mask_batches = stride_t == 0 ? 1 : num_batches;
+            size_t       changed      = 0;
+            for(int b = 0; b < mask_batches; b++)
+                for(size_t c = 0; c < T_col; c++)
+                    for(size_t r = 0; r < T_row; r++)
+                    {
+                        size_t tile = r / tile_size + (c / tile_size + b * tiles_col) * tiles_row;
+                        size_t pos  = r + c * ldt + b * stride_t;
+                        if(tile % 2 == 0 && memcmp(&hT_odd[pos], &hT[pos], sizeof(Ti)) != 0)
+                            changed++;
+                    }
+            EXPECT_EQ(changed, 0) << "hipsparseLtSpMMAPruneTiles changed tiles outside the mask";
+        }
+    }
 
     if(arg.unit_check || arg.norm_check)
     {
@@ -615,6 +689,18 @@ void testing_compress(const Arguments& arg)
                                                               dT_compressBuffer,
                                                               stream),
                                     HIPSPARSE_STATUS_SUCCESS);
+        else if(run_version == 3)
+            for(uint8_t* dMask : {(uint8_t*)dMask_odd, (uint8_t*)dMask_even})
+                EXPECT_HIPSPARSE_STATUS(hipsparseLtSpMMACompressTiles(handle,
+                                                                      arg.sparse_b ? matB : matA,
+                                                                      !arg.sparse_b,
+                                                                      arg.sparse_b ? transB : transA,
+                                                                      dT,
+                                                                      dT_compressd,
+                                                                      dT_compressBuffer,
+                                                                      dMask,
+                                                                      stream),
+                                        HIPSPARSE_STATUS_SUCCESS);
 
         CHECK_HIP_ERROR(hipStreamSynchronize(stream));
         CHECK_HIP_ERROR(hT_1.transfer_from(dT_compressd));
@@ -758,7 +844,8 @@ void testing_compress(const Arguments& arg)
                              arg,
                              gpu_time_used,
                              ArgumentLogging::NA_value,
-                             ArgumentLogging::NA_value,
+                             arg.sparse_b ? compress_gbyte_count<Ti>(N, K)
+                                          : compress_gbyte_count<Ti>(M, K),
                              cpu_time_used,
                              hipsparselt_error_c,
                              hipsparselt_error_m);
@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include "bytes.hpp"
 #include "flops.hpp"
 #include "hipsparselt_datatype2string.hpp"
 #include "hipsparselt_init.hpp"
@@ -799,7 +800,8 @@ void testing_prune(const Arguments& arg)
                              arg,
                              gpu_time_used,
                              arg.sparse_b ? gflop_count(K, N) : gflop_count(M, K),
-                             ArgumentLogging::NA_value,
+                             arg.sparse_b ? prune_gbyte_count<Ti>(K, N)
+                                          : prune_gbyte_count<Ti>(M, K),
                              cpu_time_used,
                              hipsparselt_error);
     }
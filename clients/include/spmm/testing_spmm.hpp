@@ -26,9 +26,11 @@
 
 #pragma once
 
+#include "bytes.hpp"
 #include "cblas_interface.hpp"
 #include "flops.hpp"
 #include "hipsparselt_datatype2string.hpp"
+#include "hipsparselt_golden_cache.hpp"
 #include "hipsparselt_init.hpp"
 #include "hipsparselt_math.hpp"
 #include "hipsparselt_random.hpp"
@@ -38,9 +40,11 @@
 #include "norm.hpp"
 #include "unit.hpp"
 #include "utility.hpp"
+#include <atomic>
 #include <cstddef>
 #include <hipsparselt/hipsparselt.h>
 #include <omp.h>
+#include <thread>
 
 template <typename T, typename Tb = T, typename To = T>
 void bias(int64_t m, int64_t n, int64_t ld, T* src, To* dest, Tb* bias)
@@ -151,6 +155,189 @@ auto _tanh = [](auto in, auto arg1, auto arg2) -> decltype(in) {
     return static_cast<decltype(in)>(std::tanh(in_Tc * arg1_Tc) * arg2_Tc);
 };
 
+// Set the activation of arg on the matmul descriptor, returns 0 when there is none.
+inline int set_matmul_activation(const hipsparseLtHandle_t*     handle,
+                                 hipsparseLtMatmulDescriptor_t* matmul,
+                                 const Arguments&               arg)
+{
+    int activation_on = 1;
+    switch(arg.activation_type)
+    {
+    case hipsparselt_activation_type::clippedrelu:
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescSetAttribute(handle,
+                                              matmul,
+                                              HIPSPARSELT_MATMUL_ACTIVATION_RELU_UPPERBOUND,
+                                              &arg.activation_arg2,
+                                              sizeof(float)),
+            HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescSetAttribute(handle,
+                                              matmul,
+                                              HIPSPARSELT_MATMUL_ACTIVATION_RELU_THRESHOLD,
+                                              &arg.activation_arg1,
+                                              sizeof(float)),
+            HIPSPARSE_STATUS_SUCCESS);
+    case hipsparselt_activation_type::relu:
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescSetAttribute(handle,
+                                              matmul,
+                                              HIPSPARSELT_MATMUL_ACTIVATION_RELU,
+                                              &activation_on,
+                                              sizeof(activation_on)),
+            HIPSPARSE_STATUS_SUCCESS);
+        break;
+    case hipsparselt_activation_type::gelu:
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescSetAttribute(handle,
+                                              matmul,
+                                              HIPSPARSELT_MATMUL_ACTIVATION_GELU,
+                                              &activation_on,
+                                              sizeof(activation_on)),
+            HIPSPARSE_STATUS_SUCCESS);
+            if(arg.activation_arg1 != 1)
+                EXPECT_HIPSPARSE_STATUS(
+                    hipsparseLtMatmulDescSetAttribute(handle,
+                                                    matmul,
+                                                    HIPSPARSELT_MATMUL_ACTIVATION_GELU_SCALING,
+                                                    &arg.activation_arg1,
+                                                    sizeof(float)),
+                    HIPSPARSE_STATUS_SUCCESS);
+        break;
+    case hipsparselt_activation_type::abs:
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulDescSetAttribute(handle,
+                                                                  matmul,
+                                                                  HIPSPARSELT_MATMUL_ACTIVATION_ABS,
+                                                                  &activation_on,
+                                                                  sizeof(activation_on)),
+                                HIPSPARSE_STATUS_SUCCESS);
+        break;
+    case hipsparselt_activation_type::leakyrelu:
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescSetAttribute(handle,
+                                              matmul,
+                                              HIPSPARSELT_MATMUL_ACTIVATION_LEAKYRELU,
+                                              &activation_on,
+                                              sizeof(activation_on)),
+            HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescSetAttribute(handle,
+                                              matmul,
+                                              HIPSPARSELT_MATMUL_ACTIVATION_LEAKYRELU_ALPHA,
+                                              &arg.activation_arg1,
+                                              sizeof(float)),
+            HIPSPARSE_STATUS_SUCCESS);
+        break;
+    case hipsparselt_activation_type::sigmoid:
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescSetAttribute(handle,
+                                              matmul,
+                                              HIPSPARSELT_MATMUL_ACTIVATION_SIGMOID,
+                                              &activation_on,
+                                              sizeof(activation_on)),
+            HIPSPARSE_STATUS_SUCCESS);
+        break;
+    case hipsparselt_activation_type::tanh:
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescSetAttribute(handle,
+                                              matmul,
+                                              HIPSPARSELT_MATMUL_ACTIVATION_TANH,
+                                              &activation_on,
+                                              sizeof(activation_on)),
+            HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescSetAttribute(handle,
+                                              matmul,
+                                              HIPSPARSELT_MATMUL_ACTIVATION_TANH_ALPHA,
+                                              &arg.activation_arg1,
+                                              sizeof(float)),
+            HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescSetAttribute(handle,
+                                              matmul,
+                                              HIPSPARSELT_MATMUL_ACTIVATION_TANH_BETA,
+                                              &arg.activation_arg2,
+                                              sizeof(float)),
+            HIPSPARSE_STATUS_SUCCESS);
+        break;
+    default:
+        activation_on = 0;
+        break;
+    }
+    return activation_on;
+}
+
+// Sets the per row scales and zero points of the output quantization.
+inline void set_matmul_output_scale(const hipsparseLtHandle_t*     handle,
+                                    hipsparseLtMatmulDescriptor_t* matmul,
+                                    const float*                   scale,
+                                    const float*                   zero_point)
+{
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulDescSetAttribute(
+            handle, matmul, HIPSPARSELT_MATMUL_OUTPUT_SCALE_POINTER, &scale, sizeof(void*)),
+        HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulDescSetAttribute(handle,
+                                          matmul,
+                                          HIPSPARSELT_MATMUL_OUTPUT_ZERO_POINT_POINTER,
+                                          &zero_point,
+                                          sizeof(void*)),
+        HIPSPARSE_STATUS_SUCCESS);
+}
+
+// Bias, activation and output quantization of arg applied by the reference gemm to each element
+// before it is converted to the output type.
+template <typename TBias>
+cblas_gemm_epilogue spmm_epilogue(const Arguments& arg,
+                                  const TBias*     bias,
+                                  const float*     scale      = nullptr,
+                                  const float*     zero_point = nullptr)
+{
+    std::function<float(float)> act;
+    auto                        arg1 = arg.activation_arg1, arg2 = arg.activation_arg2;
+    switch(arg.activation_type)
+    {
+    case hipsparselt_activation_type::clippedrelu:
+        act = [=](float in) { return ::_clippedrelu(in, arg1, arg2); };
+        break;
+    case hipsparselt_activation_type::gelu:
+        act = [=](float in) { return ::_gelu(in, arg1, arg2); };
+        break;
+    case hipsparselt_activation_type::relu:
+        act = [=](float in) { return ::_relu(in, arg1, arg2); };
+        break;
+    case hipsparselt_activation_type::abs:
+        act = [=](float in) { return ::_abs(in, arg1, arg2); };
+        break;
+    case hipsparselt_activation_type::leakyrelu:
+        act = [=](float in) { return ::_leakyrelu(in, arg1, arg2); };
+        break;
+    case hipsparselt_activation_type::sigmoid:
+        act = [=](float in) { return ::_sigmoid(in, arg1, arg2); };
+        break;
+    case hipsparselt_activation_type::tanh:
+        act = [=](float in) { return ::_tanh(in, arg1, arg2); };
+        break;
+    default:
+        break;
+    }
+
+    return [=](float value, int64_t row) {
+        if(bias)
+            value += static_cast<float>(bias[row]);
+        if(act)
+            value = act(value);
+        if(scale)
+        {
+            // the quantization scales the exact result of the matmul and saturates it.
+            value = value * scale[row] + (zero_point ? zero_point[row] : 0.0f);
+            value = std::min(std::max(value, -65504.0f), 65504.0f);
+        }
+        return value;
+    };
+}
+
 template <typename Ti, typename To, typename Tc>
 void testing_spmm_bad_arg(const Arguments& arg)
 {
@@ -256,6 +443,7 @@ void testing_spmm(const Arguments& arg)
 
     double gpu_time_used, cpu_time_used;
     gpu_time_used = cpu_time_used              = 0.0;
+    double                   cold_time_used    = ArgumentLogging::NA_value;
     double                   hipsparselt_error = 0.0;
     bool                     HMM               = arg.HMM;
     hipsparselt_local_handle handle{arg};
@@ -379,110 +567,7 @@ void testing_spmm(const Arguments& arg)
     hipsparselt_local_matmul_descr matmul(
         handle, transA, transB, matA, matB, matC, matD, arg.compute_type);
 
-    int activation_on = 1;
-    switch(arg.activation_type)
-    {
-    case hipsparselt_activation_type::clippedrelu:
-        EXPECT_HIPSPARSE_STATUS(
-            hipsparseLtMatmulDescSetAttribute(handle,
-                                              matmul,
-                                              HIPSPARSELT_MATMUL_ACTIVATION_RELU_UPPERBOUND,
-                                              &arg.activation_arg2,
-                                              sizeof(float)),
-            HIPSPARSE_STATUS_SUCCESS);
-        EXPECT_HIPSPARSE_STATUS(
-            hipsparseLtMatmulDescSetAttribute(handle,
-                                              matmul,
-                                              HIPSPARSELT_MATMUL_ACTIVATION_RELU_THRESHOLD,
-                                              &arg.activation_arg1,
-                                              sizeof(float)),
-            HIPSPARSE_STATUS_SUCCESS);
-    case hipsparselt_activation_type::relu:
-        EXPECT_HIPSPARSE_STATUS(
-            hipsparseLtMatmulDescSetAttribute(handle,
-                                              matmul,
-                                              HIPSPARSELT_MATMUL_ACTIVATION_RELU,
-                                              &activation_on,
-                                              sizeof(activation_on)),
-            HIPSPARSE_STATUS_SUCCESS);
-        break;
-    case hipsparselt_activation_type::gelu:
-        EXPECT_HIPSPARSE_STATUS(
-            hipsparseLtMatmulDescSetAttribute(handle,
-                                              matmul,
-                                              HIPSPARSELT_MATMUL_ACTIVATION_GELU,
-                                              &activation_on,
-                                              sizeof(activation_on)),
-            HIPSPARSE_STATUS_SUCCESS);
-            if(arg.activation_arg1 != 1)
-                EXPECT_HIPSPARSE_STATUS(
-                    hipsparseLtMatmulDescSetAttribute(handle,
-                                                    matmul,
-                                                    HIPSPARSELT_MATMUL_ACTIVATION_GELU_SCALING,
-                                                    &arg.activation_arg1,
-                                                    sizeof(float)),
-                    HIPSPARSE_STATUS_SUCCESS);
-        break;
-    case hipsparselt_activation_type::abs:
-        EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulDescSetAttribute(handle,
-                                                                  matmul,
-                                                                  HIPSPARSELT_MATMUL_ACTIVATION_ABS,
-                                                                  &activation_on,
-                                                                  sizeof(activation_on)),
-                                HIPSPARSE_STATUS_SUCCESS);
-        break;
-    case hipsparselt_activation_type::leakyrelu:
-        EXPECT_HIPSPARSE_STATUS(
-            hipsparseLtMatmulDescSetAttribute(handle,
-                                              matmul,
-                                              HIPSPARSELT_MATMUL_ACTIVATION_LEAKYRELU,
-                                              &activation_on,
-                                              sizeof(activation_on)),
-            HIPSPARSE_STATUS_SUCCESS);
-        EXPECT_HIPSPARSE_STATUS(
-            hipsparseLtMatmulDescSetAttribute(handle,
-                                              matmul,
-                                              HIPSPARSELT_MATMUL_ACTIVATION_LEAKYRELU_ALPHA,
-                                              &arg.activation_arg1,
-                                              sizeof(float)),
-            HIPSPARSE_STATUS_SUCCESS);
-        break;
-    case hipsparselt_activation_type::sigmoid:
-        EXPECT_HIPSPARSE_STATUS(
-            hipsparseLtMatmulDescSetAttribute(handle,
-                                              matmul,
-                                              HIPSPARSELT_MATMUL_ACTIVATION_SIGMOID,
-                                              &activation_on,
-                                              sizeof(activation_on)),
-            HIPSPARSE_STATUS_SUCCESS);
-        break;
-    case hipsparselt_activation_type::tanh:
-        EXPECT_HIPSPARSE_STATUS(
-            hipsparseLtMatmulDescSetAttribute(handle,
-                                              matmul,
-                                              HIPSPARSELT_MATMUL_ACTIVATION_TANH,
-                                              &activation_on,
-                                              sizeof(activation_on)),
-            HIPSPARSE_STATUS_SUCCESS);
-        EXPECT_HIPSPARSE_STATUS(
-            hipsparseLtMatmulDescSetAttribute(handle,
-                                              matmul,
-                                              HIPSPARSELT_MATMUL_ACTIVATION_TANH_ALPHA,
-                                              &arg.activation_arg1,
-                                              sizeof(float)),
-            HIPSPARSE_STATUS_SUCCESS);
-        EXPECT_HIPSPARSE_STATUS(
-            hipsparseLtMatmulDescSetAttribute(handle,
-                                              matmul,
-                                              HIPSPARSELT_MATMUL_ACTIVATION_TANH_BETA,
-                                              &arg.activation_arg2,
-                                              sizeof(float)),
-            HIPSPARSE_STATUS_SUCCESS);
-        break;
-    default:
-        activation_on = 0;
-        break;
-    }
+    int activation_on = set_matmul_activation(handle, matmul, arg);
 
     hipsparselt_seedrand();
 
@@ -515,6 +600,32 @@ void testing_spmm(const Arguments& arg)
 #endif
     }
 
+    // the output quantization is a HIP backend attribute of int8 inputs, others ignore it.
+#ifdef __HIP_PLATFORM_AMD__
+    const bool output_scale = arg.output_scale && arg.a_type == HIPSPARSELT_R_8I;
+#else
+    const bool output_scale = false;
+#endif
+
+    device_vector<float> dScale(output_scale ? M : 0, 1, HMM);
+    device_vector<float> dZeroPoint(output_scale ? M : 0, 1, HMM);
+    CHECK_DEVICE_ALLOCATION(dScale.memcheck());
+    CHECK_DEVICE_ALLOCATION(dZeroPoint.memcheck());
+    host_vector<float> hScale(output_scale ? M : 0);
+    host_vector<float> hZeroPoint(output_scale ? M : 0);
+    if(output_scale)
+    {
+        hipsparselt_init_counter(hScale.data(), M, 1, M, 0, 1, [](uint32_t r, size_t, size_t) {
+            return (1 + r % 128) / 64.0f;
+        });
+        hipsparselt_init_counter(hZeroPoint.data(), M, 1, M, 0, 1, [](uint32_t r, size_t, size_t) {
+            return static_cast<float>(static_cast<int>(r % 17) - 8);
+        });
+        CHECK_HIP_ERROR(dScale.transfer_from(hScale));
+        CHECK_HIP_ERROR(dZeroPoint.transfer_from(hZeroPoint));
+        set_matmul_output_scale(handle, matmul, dScale, dZeroPoint);
+    }
+
     hipsparselt_local_matmul_alg_selection alg_sel(handle, matmul, HIPSPARSELT_MATMUL_ALG_DEFAULT);
 
     size_t workspace_size = 0, compressed_size = 0, compress_buffer_size = 0;
@@ -544,6 +655,27 @@ void testing_spmm(const Arguments& arg)
         }
         else
         {
+            // a config_id replayed from the bench log may not exist in this library.
+            if(arg.config_id > 0)
+            {
+                int config_max_id = 0;
+                hipsparseLtMatmulAlgGetAttribute(handle,
+                                                 alg_sel,
+                                                 HIPSPARSELT_MATMUL_ALG_CONFIG_MAX_ID,
+                                                 &config_max_id,
+                                                 sizeof(int));
+                if(arg.config_id < config_max_id)
+                    EXPECT_HIPSPARSE_STATUS(
+                        hipsparseLtMatmulAlgSetAttribute(handle,
+                                                         alg_sel,
+                                                         HIPSPARSELT_MATMUL_ALG_CONFIG_ID,
+                                                         &arg.config_id,
+                                                         sizeof(int)),
+                        HIPSPARSE_STATUS_SUCCESS);
+                else
+                    hipsparselt_cout << "hipsparselt-bench INFO: config_id >= config_max_id "
+                                     << config_max_id << ", use the default config" << std::endl;
+            }
             hipsparselt_local_matmul_plan plan_tmp(handle, matmul, alg_sel);
             EXPECT_HIPSPARSE_STATUS(
                 hipsparseLtMatmulGetWorkspace(handle, plan_tmp, &workspace_size),
@@ -563,7 +695,6 @@ void testing_spmm(const Arguments& arg)
     const size_t size_C      = stride_c == 0 ? ldc * N * num_batches : stride_c * num_batches;
     const size_t size_D      = stride_d == 0 ? ldd * N * num_batches : stride_d * num_batches;
     const size_t size_D_copy = arg.unit_check || arg.norm_check ? size_D : 0;
-    const size_t size_D_act_copy = activation_on ? size_D_copy : 0;
 
     // allocate memory on device
     device_vector<Ti>            dA(size_A, 1, HMM);
@@ -586,7 +717,6 @@ void testing_spmm(const Arguments& arg)
     host_vector<Ti>     hB(size_B);
     host_vector<To>     hC(size_C);
     host_vector<To>     hD_gold(size_D_copy);
-    host_vector<Talpha> hD_gold_act(size_D_copy);
     host_vector<To>     hD_1(size_D_copy);
 
     // Initial Data on CPU
@@ -641,18 +771,7 @@ void testing_spmm(const Arguments& arg)
     CHECK_HIP_ERROR(dC.transfer_from(hC));
 
     if(size_D_copy)
-    {
-        if(activation_on || arg.bias_vector)
-        {
-            std::transform(hC.begin(), hC.end(), hD_gold_act.begin(), [](To c) -> Talpha {
-                return static_cast<Talpha>(c);
-            });
-        }
-        else
-        {
-            std::copy(hC.begin(), hC.end(), hD_gold.begin());
-        }
-    }
+        std::copy(hC.begin(), hC.end(), hD_gold.begin());
 
     void *dP, *dA_, *dB_;
     Ti *hA_, *hB_;
@@ -686,89 +805,82 @@ void testing_spmm(const Arguments& arg)
             hipsparseLtMatmulSearch(
                 handle, plan, &h_alpha, dA_, dB_, &h_beta, dC, dD, dWorkspace, &stream, 1),
             HIPSPARSE_STATUS_SUCCESS);
+
+    // batched plan execution, run the same matmul arg.launches times in one call.
+    const int32_t                          num_launches = std::max(arg.launches, 0);
+    std::vector<hipsparseLtMatmulLaunch_t> launches(
+        num_launches, {plan, &h_alpha, dA_, dB_, &h_beta, dC, dD, dWorkspace});
+
     if(arg.unit_check || arg.norm_check)
     {
-        CHECK_HIP_ERROR(hipStreamSynchronize(stream));
-        CHECK_HIP_ERROR(h_pruned.transfer_from(arg.sparse_b? dB : dA));
-        EXPECT_HIPSPARSE_STATUS(
-            hipsparseLtMatmul(
-                handle, plan, &h_alpha, dA_, dB_, &h_beta, dC, dD, dWorkspace, &stream, 1),
-            HIPSPARSE_STATUS_SUCCESS);
-        // now we can recycle gold matrix for reference purposes
-        if(arg.timing)
+        // fetch the pruned matrix one batch at a time, so the host reference of a batch starts
+        // as soon as its copy is done while the device copies the next ones and runs the matmul
+        const size_t            pruned_stride = size_pruned_copy / num_batches;
+        const auto              copy_kind     = HMM ? hipMemcpyDefault : hipMemcpyDeviceToHost;
+        std::vector<hipEvent_t> pruned_ready(num_batches);
+        for(int i = 0; i < num_batches; i++)
         {
-            cpu_time_used = get_time_us_no_sync();
+            CHECK_HIP_ERROR(hipEventCreateWithFlags(&pruned_ready[i], hipEventDisableTiming));
+            CHECK_HIP_ERROR(hipMemcpyAsync(h_pruned + pruned_stride * i,
+                                           static_cast<Ti*>(dP) + pruned_stride * i,
+                                           pruned_stride * sizeof(Ti),
+                                           copy_kind,
+                                           stream));
+            CHECK_HIP_ERROR(hipEventRecord(pruned_ready[i], stream));
         }
 
-#define activation_param \
-    M, N, ldd, hD_gold_act + pos, hD_gold + pos, arg.activation_arg1, arg.activation_arg2
+        if(num_launches)
+            EXPECT_HIPSPARSE_STATUS(
+                hipsparseLtMatmulMultiple(handle, launches.data(), num_launches, &stream, 1),
+                HIPSPARSE_STATUS_SUCCESS);
+        else
+            EXPECT_HIPSPARSE_STATUS(
+                hipsparseLtMatmul(
+                    handle, plan, &h_alpha, dA_, dB_, &h_beta, dC, dD, dWorkspace, &stream, 1),
+                HIPSPARSE_STATUS_SUCCESS);
 
-        for(int i = 0; i < num_batches; i++)
-        {
-            if(activation_on || arg.bias_vector)
+        // the host reference runs on a worker thread while this one waits for the device
+        // result, the two are joined before the comparison
+        auto reference = [&]() {
+            double start_us = get_time_us_no_sync();
+
+            // a reference of the same arguments and inputs is reused from the golden cache
+            uint64_t     golden_key    = 0;
+            uint64_t     golden_inputs = hipsparselt_golden_hash(nullptr, 0);
+            const size_t golden_bytes  = size_D_copy * sizeof(To);
+            bool         golden_hit    = false;
+            if(hipsparselt_golden_cache_enabled())
             {
-                cblas_gemm<Ti, Talpha, Talpha>(transA,
-                                               transB,
-                                               M,
-                                               N,
-                                               K,
-                                               h_alpha,
-                                               hA_ + stride_a * i,
-                                               lda,
-                                               hB_ + stride_b * i,
-                                               ldb,
-                                               h_beta,
-                                               hD_gold_act + stride_d * i,
-                                               ldd,
-                                               false);
-                auto pos = stride_d * i;
-                if(arg.bias_vector)
-                {
-                    if(activation_on)
-                        bias<Talpha, TBias>(M,
-                                            N,
-                                            ldd,
-                                            hD_gold_act + pos,
-                                            hD_gold_act + pos,
-                                            hBias + bias_stride * i);
-                    else
-                        bias<Talpha, TBias, To>(
-                            M, N, ldd, hD_gold_act + pos, hD_gold + pos, hBias + bias_stride * i);
-                }
-
-                if(activation_on)
-                {
-                    switch(arg.activation_type)
-                    {
-                    case hipsparselt_activation_type::clippedrelu:
-                        activation(activation_param, ::_clippedrelu);
-                        break;
-                    case hipsparselt_activation_type::gelu:
-                        activation(activation_param, ::_gelu);
-                        break;
-                    case hipsparselt_activation_type::relu:
-                        activation(activation_param, ::_relu);
-                        break;
-                    case hipsparselt_activation_type::abs:
-                        activation(activation_param, ::_abs);
-                        break;
-                    case hipsparselt_activation_type::leakyrelu:
-                        activation(activation_param, ::_leakyrelu);
-                        break;
-                    case hipsparselt_activation_type::sigmoid:
-                        activation(activation_param, ::_sigmoid);
-                        break;
-                    case hipsparselt_activation_type::tanh:
-                        activation(activation_param, ::_tanh);
-                        break;
-                    default:
-                        continue;
-                    }
-                }
+                CHECK_HIP_ERROR(hipEventSynchronize(pruned_ready.back()));
+                auto hash = [&](const auto& h) {
+                    golden_inputs = hipsparselt_golden_hash(
+                        h.data(), h.size() * sizeof(h[0]), golden_inputs);
+                };
+                hash(h_pruned);
+                hash(arg.sparse_b ? hA : hB);
+                hash(hC);
+                hash(hBias);
+                hash(hScale);
+                hash(hZeroPoint);
+                golden_key = hipsparselt_golden_key(arg, "spmm");
+                golden_hit
+                    = hipsparselt_golden_load(golden_key, golden_inputs, hD_gold, golden_bytes);
             }
 
-            else
-                cblas_gemm<Ti, To, Talpha>(transA,
+            for(int i = 0; i < num_batches && !golden_hit; i++)
+            {
+                // now we can recycle gold matrix for reference purposes
+                CHECK_HIP_ERROR(hipEventSynchronize(pruned_ready[i]));
+
+                cblas_gemm_epilogue epilogue;
+                if(activation_on || arg.bias_vector || output_scale)
+                    epilogue = spmm_epilogue<TBias>(arg,
+                                                    arg.bias_vector ? hBias + bias_stride * i
+                                                                    : nullptr,
+                                                    output_scale ? hScale.data() : nullptr,
+                                                    hZeroPoint.data());
+
+                cblas_gemm_blocked<Ti, To>(transA,
                                            transB,
                                            M,
                                            N,
@@ -781,19 +893,24 @@ void testing_spmm(const Arguments& arg)
                                            h_beta,
                                            hD_gold + stride_d * i,
                                            ldd,
-                                           false);
-        }
-#undef activation_param
+                                           epilogue);
+            }
 
-        if(arg.timing)
-        {
-            cpu_time_used = get_time_us_no_sync() - cpu_time_used;
-        }
+            if(!golden_hit && hipsparselt_golden_cache_enabled())
+                hipsparselt_golden_store(golden_key, golden_inputs, hD_gold, golden_bytes);
+
+            cpu_time_used = get_time_us_no_sync() - start_us;
+        };
+        std::thread reference_thread(reference);
 
         // fetch GPU
         CHECK_HIP_ERROR(hipStreamSynchronize(stream));
         CHECK_HIP_ERROR(hD_1.transfer_from(dD));
 
+        reference_thread.join();
+        for(auto event : pruned_ready)
+            CHECK_HIP_ERROR(hipEventDestroy(event));
+
         if(arg.unit_check)
         {
             unit_check_general<To>(M, N, ldd, stride_d, hD_gold, hD_1, num_batches);
@@ -836,24 +953,160 @@ void testing_spmm(const Arguments& arg)
         }
 
         CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+        if(num_launches)
+        {
+            // host time to enqueue the matmuls one by one and in one batched call.
+            double host_single_us = get_time_us_no_sync();
+            for(int i = 0; i < number_hot_calls; i++)
+                for(int j = 0; j < num_launches; j++)
+                    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmul(handle,
+                                                              plan,
+                                                              &h_alpha,
+                                                              dA_,
+                                                              dB_,
+                                                              &h_beta,
+                                                              dC,
+                                                              dD,
+                                                              dWorkspace,
+                                                              &stream,
+                                                              1),
+                                            HIPSPARSE_STATUS_SUCCESS);
+            host_single_us = get_time_us_no_sync() - host_single_us;
+            CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+
+            double host_multiple_us = get_time_us_no_sync();
+            for(int i = 0; i < number_hot_calls; i++)
+                EXPECT_HIPSPARSE_STATUS(
+                    hipsparseLtMatmulMultiple(handle, launches.data(), num_launches, &stream, 1),
+                    HIPSPARSE_STATUS_SUCCESS);
+            host_multiple_us = get_time_us_no_sync() - host_multiple_us;
+            CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+
+            int64_t total_launches = int64_t(std::max(number_hot_calls, 1)) * num_launches;
+            hipsparselt_cout << "hipsparselt-bench INFO: host us per launch, launches = "
+                             << num_launches
+                             << ", hipsparseLtMatmul = " << host_single_us / total_launches
+                             << ", hipsparseLtMatmulMultiple = "
+                             << host_multiple_us / total_launches << std::endl;
+        }
+
+        // an event between the hot calls gives the time of each iteration
+        std::vector<hipEvent_t> events(std::max(number_hot_calls, 0) + 1);
+        for(auto& event : events)
+            CHECK_HIP_ERROR(hipEventCreate(&event));
+
         gpu_time_used = get_time_us_sync(stream); // in microseconds
         for(int i = 0; i < number_hot_calls; i++)
         {
-            EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmul(handle,
-                                                      plan,
-                                                      &h_alpha,
-                                                      dA_,
-                                                      dB_,
-                                                      &h_beta,
-                                                      dC,
-                                                      dD,
-                                                      dWorkspace,
-                                                      &stream,
-                                                      1),
-                                    HIPSPARSE_STATUS_SUCCESS);
+            CHECK_HIP_ERROR(hipEventRecord(events[i], stream));
+            if(num_launches)
+                EXPECT_HIPSPARSE_STATUS(
+                    hipsparseLtMatmulMultiple(handle, launches.data(), num_launches, &stream, 1),
+                    HIPSPARSE_STATUS_SUCCESS);
+            else
+                EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmul(handle,
+                                                          plan,
+                                                          &h_alpha,
+                                                          dA_,
+                                                          dB_,
+                                                          &h_beta,
+                                                          dC,
+                                                          dD,
+                                                          dWorkspace,
+                                                          &stream,
+                                                          1),
+                                        HIPSPARSE_STATUS_SUCCESS);
         }
+        CHECK_HIP_ERROR(hipEventRecord(events.back(), stream));
         CHECK_HIP_ERROR(hipStreamSynchronize(stream));
         gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        // report the time of one matmul.
+        if(num_launches)
+            gpu_time_used /= num_launches;
+
+        std::vector<double> iteration_us(events.size() - 1);
+        for(size_t i = 0; i < iteration_us.size(); i++)
+        {
+            float ms;
+            CHECK_HIP_ERROR(hipEventElapsedTime(&ms, events[i], events[i + 1]));
+            iteration_us[i] = ms * 1000 / std::max(num_launches, 1);
+        }
+        for(auto& event : events)
+            CHECK_HIP_ERROR(hipEventDestroy(event));
+        hipsparselt_bench_set_iteration_us(std::move(iteration_us));
+
+        // cold cache, rotate through enough copies of the operands that a copy has been
+        // evicted from the L2 cache before it is used again.
+        if(arg.cold_cache)
+        {
+            hipDeviceProp_t props;
+            int             device;
+            CHECK_HIP_ERROR(hipGetDevice(&device));
+            CHECK_HIP_ERROR(hipGetDeviceProperties(&props, device));
+
+            auto   align       = [](size_t bytes) { return (bytes + 255) / 256 * 256; };
+            size_t dense_bytes = (arg.sparse_b ? size_A : size_B) * sizeof(Ti);
+            size_t slot_bytes  = align(compressed_size) + align(dense_bytes)
+                                + align(size_C * sizeof(To)) + align(size_D * sizeof(To));
+            size_t num_slots   = 1 + (2 * size_t(props.l2CacheSize) + slot_bytes - 1) / slot_bytes;
+
+            device_vector<unsigned char> d_rotating(num_slots * slot_bytes, 1, HMM);
+            CHECK_DEVICE_ALLOCATION(d_rotating.memcheck());
+
+            struct rotating_operands
+            {
+                void* a;
+                void* b;
+                void* c;
+                void* d;
+            };
+            std::vector<rotating_operands> slots(num_slots);
+            unsigned char*                 rotating = d_rotating;
+            for(size_t i = 0; i < num_slots; i++)
+            {
+                unsigned char* compressed = rotating + i * slot_bytes;
+                unsigned char* dense      = compressed + align(compressed_size);
+                unsigned char* c          = dense + align(dense_bytes);
+                unsigned char* d          = c + align(size_C * sizeof(To));
+                CHECK_HIP_ERROR(hipMemcpyAsync(compressed,
+                                               d_compressed,
+                                               compressed_size,
+                                               hipMemcpyDeviceToDevice,
+                                               stream));
+                CHECK_HIP_ERROR(hipMemcpyAsync(dense,
+                                               arg.sparse_b ? dA_ : dB_,
+                                               dense_bytes,
+                                               hipMemcpyDeviceToDevice,
+                                               stream));
+                CHECK_HIP_ERROR(hipMemcpyAsync(
+                    c, dC, size_C * sizeof(To), hipMemcpyDeviceToDevice, stream));
+                slots[i] = arg.sparse_b ? rotating_operands{dense, compressed, c, d}
+                                        : rotating_operands{compressed, dense, c, d};
+            }
+            hipsparselt_cout << "hipsparselt-bench INFO: cold cache, l2CacheSize = "
+                             << props.l2CacheSize << ", rotating copies = " << num_slots
+                             << std::endl;
+
+            cold_time_used = get_time_us_sync(stream);
+            for(int i = 0; i < number_hot_calls; i++)
+            {
+                auto& slot = slots[i % num_slots];
+                EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmul(handle,
+                                                          plan,
+                                                          &h_alpha,
+                                                          slot.a,
+                                                          slot.b,
+                                                          &h_beta,
+                                                          slot.c,
+                                                          slot.d,
+                                                          dWorkspace,
+                                                          &stream,
+                                                          1),
+                                        HIPSPARSE_STATUS_SUCCESS);
+            }
+            CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+            cold_time_used = get_time_us_sync(stream) - cold_time_used;
+        }
         auto flops    = gemm_gflop_count<float>(M, N, K);
         switch(arg.activation_type)
         {
@@ -881,6 +1134,8 @@ void testing_spmm(const Arguments& arg)
         default:
             break;
         }
+        auto bytes = spmm_gbyte_count<Ti, To, TBias>(
+            M, N, K, arg.sparse_b, h_beta != 0, arg.bias_vector);
 #define argument_param_nb                                                                     \
     e_transA, e_transB, e_M, e_N, e_K, e_alpha, e_lda, e_stride_a, e_beta, e_ldb, e_stride_b, \
         e_ldc, e_stride_c, e_ldd, e_stride_d
@@ -891,17 +1146,290 @@ void testing_spmm(const Arguments& arg)
                                                             arg,
                                                             gpu_time_used,
                                                             flops,
-                                                            ArgumentLogging::NA_value,
+                                                            bytes,
                                                             cpu_time_used,
-                                                            hipsparselt_error);
+                                                            hipsparselt_error,
+                                                            ArgumentLogging::NA_value,
+                                                            ArgumentLogging::NA_value,
+                                                            ArgumentLogging::NA_value,
+                                                            cold_time_used);
         else
             ArgumentModel<argument_param_nb>{}.log_args<float>(hipsparselt_cout,
                                                                arg,
                                                                gpu_time_used,
                                                                flops,
-                                                               ArgumentLogging::NA_value,
+                                                               bytes,
                                                                cpu_time_used,
-                                                               hipsparselt_error);
+                                                               hipsparselt_error,
+                                                               ArgumentLogging::NA_value,
+                                                               ArgumentLogging::NA_value,
+                                                               ArgumentLogging::NA_value,
+                                                               cold_time_used);
+
+        // host side scaling, the same matmul from 1, 2, 4, ... arg.concurrent_threads host
+        // threads which each have their own handle, descriptors, plan and
+        // arg.concurrent_streams streams with a D and a workspace per stream. A, B, C and the
+        // bias are shared and only read.
+        if(arg.concurrent_threads > 0)
+        {
+            int config_id = 0;
+            EXPECT_HIPSPARSE_STATUS(
+                hipsparseLtMatmulAlgGetAttribute(
+                    handle, alg_sel, HIPSPARSELT_MATMUL_ALG_CONFIG_ID, &config_id, sizeof(int)),
+                HIPSPARSE_STATUS_SUCCESS);
+            const int    num_streams = std::max(arg.concurrent_streams, 1);
+            const size_t d_bytes     = (size_D * sizeof(To) + 255) / 256 * 256;
+            const size_t ws_bytes    = (workspace_size + 255) / 256 * 256;
+            void*        _dBias      = dBias;
+
+            // the device of the run, a new thread starts on device 0.
+            int device = 0;
+            CHECK_HIP_ERROR(hipGetDevice(&device));
+
+            struct thread_result
+            {
+                double start_us, end_us, api_us;
+            };
+
+            // spin until all threads of the run are here, keeps the setup out of the timing.
+            // false when a thread left the run through a failed check and will never arrive.
+            auto barrier = [](std::atomic<int>& count, int num_threads, std::atomic<bool>& failed) {
+                count++;
+                while(count.load() < num_threads && !failed.load())
+                    std::this_thread::yield();
+                return !failed.load();
+            };
+
+            // marks the run failed unless the thread got to the end of run_thread.
+            struct failed_on_exit
+            {
+                std::atomic<bool>& failed;
+                bool               done = false;
+                ~failed_on_exit()
+                {
+                    if(!done)
+                        failed = true;
+                }
+            };
+
+            auto run_thread = [&](int                num_threads,
+                                  std::atomic<int>&  ready,
+                                  std::atomic<int>&  warm,
+                                  std::atomic<bool>& failed,
+                                  thread_result&     result) {
+                failed_on_exit guard{failed};
+                CHECK_HIP_ERROR(hipSetDevice(device));
+
+                hipsparselt_local_handle    t_handle{arg};
+                hipsparselt_local_mat_descr t_matA(
+                    arg.sparse_b ? hipsparselt_matrix_type_dense
+                                 : hipsparselt_matrix_type_structured,
+                    t_handle,
+                    A_row,
+                    A_col,
+                    lda,
+                    arg.a_type,
+                    HIPSPARSE_ORDER_COL);
+                hipsparselt_local_mat_descr t_matB(
+                    arg.sparse_b ? hipsparselt_matrix_type_structured
+                                 : hipsparselt_matrix_type_dense,
+                    t_handle,
+                    B_row,
+                    B_col,
+                    ldb,
+                    arg.b_type,
+                    HIPSPARSE_ORDER_COL);
+                hipsparselt_local_mat_descr t_matC(hipsparselt_matrix_type_dense,
+                                                   t_handle,
+                                                   M,
+                                                   N,
+                                                   ldc,
+                                                   arg.c_type,
+                                                   HIPSPARSE_ORDER_COL);
+                hipsparselt_local_mat_descr t_matD(hipsparselt_matrix_type_dense,
+                                                   t_handle,
+                                                   M,
+                                                   N,
+                                                   ldd,
+                                                   arg.d_type,
+                                                   HIPSPARSE_ORDER_COL);
+
+                hipsparseLtMatDescriptor_t* t_mats[]  = {t_matA, t_matB, t_matC, t_matD};
+                int64_t                     strides[] = {stride_a, stride_b, stride_c, stride_d};
+                for(int i = 0; i < 4 && (do_batched || do_strided_batched); i++)
+                {
+                    EXPECT_HIPSPARSE_STATUS(
+                        hipsparseLtMatDescSetAttribute(t_handle,
+                                                       t_mats[i],
+                                                       HIPSPARSELT_MAT_NUM_BATCHES,
+                                                       &num_batches,
+                                                       sizeof(int)),
+                        HIPSPARSE_STATUS_SUCCESS);
+                    if(do_strided_batched)
+                        EXPECT_HIPSPARSE_STATUS(
+                            hipsparseLtMatDescSetAttribute(t_handle,
+                                                           t_mats[i],
+                                                           HIPSPARSELT_MAT_BATCH_STRIDE,
+                                                           &strides[i],
+                                                           sizeof(int64_t)),
+                            HIPSPARSE_STATUS_SUCCESS);
+                }
+
+                hipsparselt_local_matmul_descr t_matmul(
+                    t_handle, transA, transB, t_matA, t_matB, t_matC, t_matD, arg.compute_type);
+                set_matmul_activation(t_handle, t_matmul, arg);
+                if(arg.bias_vector)
+                {
+                    EXPECT_HIPSPARSE_STATUS(
+                        hipsparseLtMatmulDescSetAttribute(t_handle,
+                                                          t_matmul,
+                                                          HIPSPARSELT_MATMUL_BIAS_POINTER,
+                                                          &_dBias,
+                                                          sizeof(void*)),
+                        HIPSPARSE_STATUS_SUCCESS);
+                    EXPECT_HIPSPARSE_STATUS(
+                        hipsparseLtMatmulDescSetAttribute(t_handle,
+                                                          t_matmul,
+                                                          HIPSPARSELT_MATMUL_BIAS_STRIDE,
+                                                          &bias_stride,
+                                                          sizeof(int64_t)),
+                        HIPSPARSE_STATUS_SUCCESS);
+#ifdef __HIP_PLATFORM_AMD__
+                    EXPECT_HIPSPARSE_STATUS(
+                        hipsparseLtMatmulDescSetAttribute(t_handle,
+                                                          t_matmul,
+                                                          HIPSPARSELT_MATMUL_BIAS_TYPE,
+                                                          &bias_type,
+                                                          sizeof(hipsparseLtDatatype_t)),
+                        HIPSPARSE_STATUS_SUCCESS);
+#endif
+                }
+                if(output_scale)
+                    set_matmul_output_scale(t_handle, t_matmul, dScale, dZeroPoint);
+
+                hipsparselt_local_matmul_alg_selection t_alg_sel(
+                    t_handle, t_matmul, HIPSPARSELT_MATMUL_ALG_DEFAULT);
+                EXPECT_HIPSPARSE_STATUS(
+                    hipsparseLtMatmulAlgSetAttribute(t_handle,
+                                                     t_alg_sel,
+                                                     HIPSPARSELT_MATMUL_ALG_CONFIG_ID,
+                                                     &config_id,
+                                                     sizeof(int)),
+                    HIPSPARSE_STATUS_SUCCESS);
+                hipsparselt_local_matmul_plan t_plan(t_handle, t_matmul, t_alg_sel);
+
+                device_vector<unsigned char> t_buffer(num_streams * (d_bytes + ws_bytes), 1, HMM);
+                CHECK_DEVICE_ALLOCATION(t_buffer.memcheck());
+                unsigned char*           buffer = t_buffer;
+                std::vector<hipStream_t> t_streams(num_streams);
+                for(auto& s : t_streams)
+                    CHECK_HIP_ERROR(hipStreamCreate(&s));
+
+                auto matmul_on = [&](int i) {
+                    int            s  = i % num_streams;
+                    unsigned char* d  = buffer + s * (d_bytes + ws_bytes);
+                    unsigned char* ws = d + d_bytes;
+                    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmul(t_handle,
+                                                              t_plan,
+                                                              &h_alpha,
+                                                              dA_,
+                                                              dB_,
+                                                              &h_beta,
+                                                              dC,
+                                                              d,
+                                                              ws,
+                                                              &t_streams[s],
+                                                              1),
+                                            HIPSPARSE_STATUS_SUCCESS);
+                };
+
+                auto destroy_streams = [&]() {
+                    for(auto& s : t_streams)
+                        CHECK_HIP_ERROR(hipStreamDestroy(s));
+                };
+
+                if(!barrier(ready, num_threads, failed))
+                {
+                    destroy_streams();
+                    return;
+                }
+                for(int i = 0; i < number_cold_calls; i++)
+                    matmul_on(i);
+                for(auto& s : t_streams)
+                    CHECK_HIP_ERROR(hipStreamSynchronize(s));
+                if(!barrier(warm, num_threads, failed))
+                {
+                    destroy_streams();
+                    return;
+                }
+
+                result.api_us   = 0;
+                result.start_us = get_time_us_no_sync();
+                for(int i = 0; i < number_hot_calls; i++)
+                {
+                    double api_us = get_time_us_no_sync();
+                    matmul_on(i);
+                    result.api_us += get_time_us_no_sync() - api_us;
+                }
+                for(auto& s : t_streams)
+                    CHECK_HIP_ERROR(hipStreamSynchronize(s));
+                result.end_us = get_time_us_no_sync();
+
+                destroy_streams();
+                guard.done = true;
+            };
+
+            hipsparselt_cout << "threads,streams,calls,wall-us,hipsparselt-Gflops,speedup,"
+                                "thread-us,max-thread-us,api-us"
+                             << std::endl;
+            double gflops_1 = 0;
+            for(int num_threads = 1;;
+                num_threads     = std::min(num_threads * 2, arg.concurrent_threads))
+            {
+                std::vector<thread_result> results(num_threads);
+                std::vector<std::thread>   pool;
+                std::atomic<int>           ready{0}, warm{0};
+                std::atomic<bool>          failed{false};
+                for(int t = 0; t < num_threads; t++)
+                    pool.emplace_back(run_thread,
+                                      num_threads,
+                                      std::ref(ready),
+                                      std::ref(warm),
+                                      std::ref(failed),
+                                      std::ref(results[t]));
+                for(auto& t : pool)
+                    t.join();
+
+                // the failed check has been reported, the timings of the run are incomplete.
+                if(failed)
+                    break;
+
+                double start_us = results[0].start_us, end_us = results[0].end_us;
+                double thread_us = 0, max_thread_us = 0, api_us = 0;
+                for(auto& r : results)
+                {
+                    start_us      = std::min(start_us, r.start_us);
+                    end_us        = std::max(end_us, r.end_us);
+                    thread_us     += r.end_us - r.start_us;
+                    max_thread_us = std::max(max_thread_us, r.end_us - r.start_us);
+                    api_us        += r.api_us;
+                }
+                int64_t calls   = int64_t(num_threads) * number_hot_calls;
+                double  wall_us = end_us - start_us;
+                double  gflops  = flops * num_batches * calls / wall_us * 1e6;
+                if(num_threads == 1)
+                    gflops_1 = gflops;
+
+                // per call latency seen by a thread, and the host time spent in hipsparseLtMatmul
+                hipsparselt_cout << num_threads << "," << num_streams << "," << calls << ","
+                                 << wall_us << "," << gflops << "," << gflops / gflops_1 << ","
+                                 << thread_us / calls << "," << max_thread_us / number_hot_calls
+                                 << "," << api_us / calls << std::endl;
+
+                if(num_threads == arg.concurrent_threads)
+                    break;
+            }
+        }
     }
     CHECK_HIP_ERROR(hipStreamDestroy(stream));
 }
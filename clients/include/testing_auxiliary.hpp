@@ -27,15 +27,119 @@
 #pragma once
 
 #include "flops.hpp"
+#include "hip_capture_stub.hpp"
 #include "hipsparselt_datatype2string.hpp"
+#include "hipsparselt_golden_cache.hpp"
 #include "hipsparselt_init.hpp"
 #include "hipsparselt_math.hpp"
 #include "hipsparselt_random.hpp"
 #include "hipsparselt_test.hpp"
 #include "hipsparselt_vector.hpp"
+#include "hipsparselt_yaml_expand.hpp"
 #include "unit.hpp"
 #include "utility.hpp"
+#include <cstdio>
+#include <fstream>
 #include <hipsparselt/hipsparselt.h>
+#include <iterator>
+#include <numeric>
+#include <omp.h>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Bytes of an element of type.
+inline size_t aux_datatype_bytes(hipsparseLtDatatype_t type)
+{
+    switch(type)
+    {
+    case HIPSPARSELT_R_32F:
+        return 4;
+    case HIPSPARSELT_R_16F:
+    case HIPSPARSELT_R_16BF:
+        return 2;
+    default:
+        return 1;
+    }
+}
+
+// The descriptors, plan and operands of an m x n x k matmul (A transposed) of the types of arg.
+// The operands hold fixed bytes, the tests using it compare matmuls with each other.
+struct aux_matmul
+{
+    aux_matmul(const hipsparseLtHandle_t* handle,
+               const Arguments&           arg,
+               int64_t                    m,
+               int64_t                    n,
+               int64_t                    k)
+        : matA(hipsparselt_matrix_type_structured, handle, k, m, k, arg.a_type, HIPSPARSE_ORDER_COL)
+        , matB(hipsparselt_matrix_type_dense, handle, k, n, k, arg.b_type, HIPSPARSE_ORDER_COL)
+        , matC(hipsparselt_matrix_type_dense, handle, m, n, m, arg.c_type, HIPSPARSE_ORDER_COL)
+        , matD(hipsparselt_matrix_type_dense, handle, m, n, m, arg.d_type, HIPSPARSE_ORDER_COL)
+        , matmul(handle,
+                 HIPSPARSE_OPERATION_TRANSPOSE,
+                 HIPSPARSE_OPERATION_NON_TRANSPOSE,
+                 matA,
+                 matB,
+                 matC,
+                 matD,
+                 arg.compute_type)
+        , alg_sel(handle, matmul, HIPSPARSELT_MATMUL_ALG_DEFAULT)
+        , plan(handle, matmul, alg_sel)
+        , workspace_size(get_workspace_size(handle, plan))
+        , d_size(m * n * sizeof(float))
+        , dA(get_compressed_size(handle, plan))
+        , dB(k * n * sizeof(float))
+        , dC(d_size)
+        , dD(d_size)
+    {
+        EXPECT_HIPSPARSE_STATUS(plan.status(), HIPSPARSE_STATUS_SUCCESS);
+        CHECK_DEVICE_ALLOCATION(dA.memcheck());
+        CHECK_DEVICE_ALLOCATION(dB.memcheck());
+        CHECK_DEVICE_ALLOCATION(dC.memcheck());
+        CHECK_DEVICE_ALLOCATION(dD.memcheck());
+        CHECK_HIP_ERROR(hipMemset(dA, 0x11, dA.n()));
+        CHECK_HIP_ERROR(hipMemset(dB, 0x11, k * n * sizeof(float)));
+        CHECK_HIP_ERROR(hipMemset(dC, 0x11, d_size));
+    }
+
+    static size_t get_workspace_size(const hipsparseLtHandle_t*     handle,
+                                     const hipsparseLtMatmulPlan_t* plan)
+    {
+        size_t size = 0;
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulGetWorkspace(handle, plan, &size),
+                                HIPSPARSE_STATUS_SUCCESS);
+        return size;
+    }
+
+    static size_t get_compressed_size(const hipsparseLtHandle_t*     handle,
+                                      const hipsparseLtMatmulPlan_t* plan)
+    {
+        size_t size = 0, buffer_size = 0;
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtSpMMACompressedSize(handle, plan, &size, &buffer_size),
+                                HIPSPARSE_STATUS_SUCCESS);
+        return size;
+    }
+
+    // D of a matmul with alpha = beta = 1 on stream, workspace NULL takes the handle's arena.
+    hipsparseStatus_t run(const hipsparseLtHandle_t* handle,
+                          void*                      d_D,
+                          void*                      workspace,
+                          hipStream_t                stream)
+    {
+        float alpha = 1, beta = 1;
+        return hipsparseLtMatmul(
+            handle, plan, &alpha, dA, dB, &beta, dC, d_D, workspace, &stream, 1);
+    }
+
+    hipsparselt_local_mat_descr            matA, matB, matC, matD;
+    hipsparselt_local_matmul_descr         matmul;
+    hipsparselt_local_matmul_alg_selection alg_sel;
+    hipsparselt_local_matmul_plan          plan;
+    size_t                                 workspace_size;
+    size_t                                 d_size;
+    device_vector<unsigned char>           dA, dB, dC, dD;
+};
 
 void testing_aux_handle_init_bad_arg(const Arguments& arg)
 {
@@ -56,6 +160,288 @@ void testing_aux_handle(const Arguments& arg)
     EXPECT_HIPSPARSE_STATUS(hipsparseLtDestroy(&handle), HIPSPARSE_STATUS_SUCCESS);
 }
 
+void testing_aux_workspace_arena(const Arguments& arg)
+{
+#ifndef __HIP_PLATFORM_AMD__
+    return;
+#endif
+    hipsparseLtWorkspaceArenaStats_t stats;
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtWorkspaceArenaSetEnabled(nullptr, 1),
+                            HIPSPARSE_STATUS_INVALID_VALUE);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtWorkspaceArenaGetStats(nullptr, &stats),
+                            HIPSPARSE_STATUS_INVALID_VALUE);
+
+    hipsparselt_local_handle handle{arg};
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtWorkspaceArenaGetStats(handle, nullptr),
+                            HIPSPARSE_STATUS_INVALID_VALUE);
+
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtWorkspaceArenaSetEnabled(handle, 1),
+                            HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtWorkspaceArenaGetStats(handle, &stats),
+                            HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_EQ(stats.currentBytes, 0);
+    EXPECT_EQ(stats.highWaterBytes, 0);
+    EXPECT_EQ(stats.growEvents, 0);
+    EXPECT_EQ(stats.numStreams, 0);
+
+    // the streams are checked before the arena is used.
+    aux_matmul small(handle, arg, 128, 128, 128), large(handle, arg, 128, 1024, 128);
+    float      alpha = 1, beta = 1;
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmul(handle,
+                                              small.plan,
+                                              &alpha,
+                                              small.dA,
+                                              small.dB,
+                                              &beta,
+                                              small.dC,
+                                              small.dD,
+                                              nullptr,
+                                              nullptr,
+                                              1),
+                            HIPSPARSE_STATUS_INVALID_VALUE);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtWorkspaceArenaGetStats(handle, &stats),
+                            HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_EQ(stats.requests, 0);
+
+    hipStream_t stream;
+    CHECK_HIP_ERROR(hipStreamCreate(&stream));
+
+    // references with workspaces of the caller.
+    device_vector<unsigned char> dWorkspace(std::max(small.workspace_size, large.workspace_size));
+    CHECK_DEVICE_ALLOCATION(dWorkspace.memcheck());
+    std::vector<unsigned char> hRefSmall(small.d_size), hRefLarge(large.d_size);
+    EXPECT_HIPSPARSE_STATUS(small.run(handle, small.dD, dWorkspace, stream),
+                            HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(large.run(handle, large.dD, dWorkspace, stream),
+                            HIPSPARSE_STATUS_SUCCESS);
+    CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+    CHECK_HIP_ERROR(hipMemcpy(hRefSmall.data(), small.dD, small.d_size, hipMemcpyDeviceToHost));
+    CHECK_HIP_ERROR(hipMemcpy(hRefLarge.data(), large.dD, large.d_size, hipMemcpyDeviceToHost));
+
+    // small, large then small again without a sync, the large one grows the buffer of the
+    // stream while the first small one may still use it and the last one reuses it.
+    device_vector<unsigned char> dD2(small.d_size);
+    CHECK_DEVICE_ALLOCATION(dD2.memcheck());
+    CHECK_HIP_ERROR(hipMemset(small.dD, 0, small.d_size));
+    CHECK_HIP_ERROR(hipMemset(large.dD, 0, large.d_size));
+    EXPECT_HIPSPARSE_STATUS(small.run(handle, small.dD, nullptr, stream),
+                            HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(large.run(handle, large.dD, nullptr, stream),
+                            HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(small.run(handle, dD2, nullptr, stream), HIPSPARSE_STATUS_SUCCESS);
+    CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+
+    std::vector<unsigned char> hD(small.d_size);
+    CHECK_HIP_ERROR(hipMemcpy(hD.data(), small.dD, small.d_size, hipMemcpyDeviceToHost));
+    EXPECT_EQ(hD, hRefSmall);
+    CHECK_HIP_ERROR(hipMemcpy(hD.data(), dD2, small.d_size, hipMemcpyDeviceToHost));
+    EXPECT_EQ(hD, hRefSmall);
+    hD.resize(large.d_size);
+    CHECK_HIP_ERROR(hipMemcpy(hD.data(), large.dD, large.d_size, hipMemcpyDeviceToHost));
+    EXPECT_EQ(hD, hRefLarge);
+
+    // plans without workspace do not ask the arena, a buffer at least doubles when it grows.
+    size_t  expected_bytes = 0;
+    int64_t expected_grows = 0, expected_requests = 0;
+    for(size_t size : {small.workspace_size, large.workspace_size, small.workspace_size})
+    {
+        if(size == 0)
+            continue;
+        expected_requests++;
+        if(size > expected_bytes)
+        {
+            expected_bytes = std::max(size, expected_bytes * 2);
+            expected_grows++;
+        }
+    }
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtWorkspaceArenaGetStats(handle, &stats),
+                            HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_EQ(stats.currentBytes, expected_bytes);
+    EXPECT_EQ(stats.highWaterBytes, expected_bytes);
+    EXPECT_EQ(stats.growEvents, expected_grows);
+    EXPECT_EQ(stats.requests, expected_requests);
+    EXPECT_EQ(stats.numStreams, expected_requests > 0 ? 1 : 0);
+
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtWorkspaceArenaSetEnabled(handle, 0),
+                            HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtWorkspaceArenaGetStats(handle, &stats),
+                            HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_EQ(stats.currentBytes, 0);
+    EXPECT_EQ(stats.requests, 0);
+
+    // without the arena a NULL workspace is only valid for plans which need none.
+    EXPECT_HIPSPARSE_STATUS(large.run(handle, large.dD, nullptr, stream),
+                            large.workspace_size == 0 ? HIPSPARSE_STATUS_SUCCESS
+                                                      : HIPSPARSE_STATUS_INVALID_VALUE);
+    CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+    CHECK_HIP_ERROR(hipStreamDestroy(stream));
+}
+
+void testing_aux_matmul_shard_partition(const Arguments& arg)
+{
+#ifndef __HIP_PLATFORM_AMD__
+    return;
+#endif
+    // mock device sets, the weights stand for the CU count of each device.
+    const std::vector<std::vector<int>> devices
+        = {{1}, {1, 1, 1, 1}, {120, 104, 60}, {304, 0, 228}};
+    const int64_t granularity = 16;
+    const int64_t extents[]   = {0, 5, 1000, 4096, 65535};
+
+    for(auto& weights : devices)
+    {
+        int     num_shards   = weights.size();
+        int64_t total_weight = std::accumulate(weights.begin(), weights.end(), int64_t(0));
+        for(auto extent : extents)
+        {
+            std::vector<int64_t> offsets(num_shards), sizes(num_shards);
+            EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulShardPartition(num_shards,
+                                                                    weights.data(),
+                                                                    extent,
+                                                                    granularity,
+                                                                    offsets.data(),
+                                                                    sizes.data()),
+                                    HIPSPARSE_STATUS_SUCCESS);
+            int64_t units = (extent + granularity - 1) / granularity;
+            int64_t next  = 0;
+            for(int i = 0; i < num_shards; i++)
+            {
+                // contiguous, aligned and balanced within one granule.
+                EXPECT_EQ(offsets[i], next);
+                EXPECT_EQ(offsets[i] % granularity, 0);
+                EXPECT_GE(sizes[i], 0);
+                if(weights[i] == 0)
+                    EXPECT_EQ(sizes[i], 0);
+                int64_t shard_units = (sizes[i] + granularity - 1) / granularity;
+                EXPECT_LE(std::abs(shard_units * total_weight - units * weights[i]),
+                          total_weight);
+                next += sizes[i];
+            }
+            EXPECT_EQ(next, extent);
+        }
+    }
+
+    int     weights[2] = {1, 1};
+    int64_t offsets[2], sizes[2];
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulShardPartition(0, weights, 64, granularity, offsets, sizes),
+        HIPSPARSE_STATUS_INVALID_VALUE);
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulShardPartition(2, nullptr, 64, granularity, offsets, sizes),
+        HIPSPARSE_STATUS_INVALID_VALUE);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulShardPartition(2, weights, 64, 0, offsets, sizes),
+                            HIPSPARSE_STATUS_INVALID_VALUE);
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulShardPartition(2, weights, 64, granularity, nullptr, sizes),
+        HIPSPARSE_STATUS_INVALID_VALUE);
+    weights[0] = weights[1] = 0;
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulShardPartition(2, weights, 64, granularity, offsets, sizes),
+        HIPSPARSE_STATUS_INVALID_VALUE);
+}
+
+void testing_aux_matmul_sharded(const Arguments& arg)
+{
+#ifndef __HIP_PLATFORM_AMD__
+    return;
+#endif
+    // two handles on the current device compute the column halves of D, the gathered D must
+    // match the unsharded matmul. The halves of C differ so a misplaced shard shows.
+    const int64_t M = 128;
+    const int64_t N = 256;
+    const int64_t K = 128;
+
+    hipsparselt_local_handle handle0{arg}, handle1{arg};
+    aux_matmul               full(handle0, arg, M, N, K);
+    aux_matmul               shard0(handle0, arg, M, N / 2, K), shard1(handle1, arg, M, N / 2, K);
+
+    const size_t half_c  = M * (N / 2) * aux_datatype_bytes(arg.c_type);
+    const size_t d_bytes = M * N * aux_datatype_bytes(arg.d_type);
+    CHECK_HIP_ERROR(hipMemset(static_cast<unsigned char*>(full.dC) + half_c, 0x22, half_c));
+    CHECK_HIP_ERROR(hipMemset(shard1.dC, 0x22, half_c));
+
+    hipStream_t streams[2];
+    CHECK_HIP_ERROR(hipStreamCreate(&streams[0]));
+    CHECK_HIP_ERROR(hipStreamCreate(&streams[1]));
+    device_vector<unsigned char> dWorkspace0(std::max(full.workspace_size, shard0.workspace_size));
+    device_vector<unsigned char> dWorkspace1(shard1.workspace_size);
+    device_vector<unsigned char> dGather(d_bytes);
+    CHECK_DEVICE_ALLOCATION(dWorkspace0.memcheck());
+    CHECK_DEVICE_ALLOCATION(dWorkspace1.memcheck());
+    CHECK_DEVICE_ALLOCATION(dGather.memcheck());
+
+    std::vector<unsigned char> hRef(d_bytes), hGather(d_bytes);
+    EXPECT_HIPSPARSE_STATUS(full.run(handle0, full.dD, dWorkspace0, streams[0]),
+                            HIPSPARSE_STATUS_SUCCESS);
+    CHECK_HIP_ERROR(hipStreamSynchronize(streams[0]));
+    CHECK_HIP_ERROR(hipMemcpy(hRef.data(), full.dD, d_bytes, hipMemcpyDeviceToHost));
+
+    hipsparselt_local_mat_descr gather(
+        hipsparselt_matrix_type_dense, handle0, M, N, M, arg.d_type, HIPSPARSE_ORDER_COL);
+    hipsparselt_local_mat_descr half_gather(
+        hipsparselt_matrix_type_dense, handle0, M, N / 2, M, arg.d_type, HIPSPARSE_ORDER_COL);
+
+    const hipsparseLtHandle_t*     handles[2]    = {handle0, handle1};
+    const hipsparseLtMatmulPlan_t* plans[2]      = {shard0.plan, shard1.plan};
+    const void*                    dA[2]         = {shard0.dA, shard1.dA};
+    const void*                    dB[2]         = {shard0.dB, shard1.dB};
+    const void*                    dC[2]         = {shard0.dC, shard1.dC};
+    void*                          dD[2]         = {shard0.dD, shard1.dD};
+    void*                          workspaces[2] = {dWorkspace0, dWorkspace1};
+
+    float alpha = 1, beta = 1;
+
+    // the shards must cover the gathered matrix.
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulSharded(handles,
+                                                     plans,
+                                                     2,
+                                                     HIPSPARSELT_SHARD_DIM_N,
+                                                     &alpha,
+                                                     dA,
+                                                     dB,
+                                                     &beta,
+                                                     dC,
+                                                     dD,
+                                                     workspaces,
+                                                     streams,
+                                                     half_gather,
+                                                     dGather),
+                            HIPSPARSE_STATUS_INVALID_VALUE);
+
+    CHECK_HIP_ERROR(hipMemset(dGather, 0, d_bytes));
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulSharded(handles,
+                                                     plans,
+                                                     2,
+                                                     HIPSPARSELT_SHARD_DIM_N,
+                                                     &alpha,
+                                                     dA,
+                                                     dB,
+                                                     &beta,
+                                                     dC,
+                                                     dD,
+                                                     workspaces,
+                                                     streams,
+                                                     gather,
+                                                     dGather),
+                            HIPSPARSE_STATUS_SUCCESS);
+    CHECK_HIP_ERROR(hipStreamSynchronize(streams[0]));
+    CHECK_HIP_ERROR(hipStreamSynchronize(streams[1]));
+    CHECK_HIP_ERROR(hipMemcpy(hGather.data(), dGather, d_bytes, hipMemcpyDeviceToHost));
+    EXPECT_EQ(hGather, hRef);
+
+    // a plan only runs on the handle it was created on.
+    EXPECT_HIPSPARSE_STATUS(shard1.run(handle0, shard1.dD, dWorkspace1, streams[0]),
+                            HIPSPARSE_STATUS_INVALID_VALUE);
+    hipsparseLtMatmulLaunch_t launches[2]
+        = {{shard0.plan, &alpha, dA[0], dB[0], &beta, dC[0], dD[0], dWorkspace0},
+           {shard1.plan, &alpha, dA[1], dB[1], &beta, dC[1], dD[1], dWorkspace1}};
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulMultiple(handle0, launches, 2, &streams[0], 1),
+                            HIPSPARSE_STATUS_INVALID_VALUE);
+
+    CHECK_HIP_ERROR(hipStreamDestroy(streams[0]));
+    CHECK_HIP_ERROR(hipStreamDestroy(streams[1]));
+}
+
 void testing_aux_mat_init_dense_bad_arg(const Arguments& arg)
 {
     const int64_t row = 128;
@@ -1510,6 +1896,1156 @@ void testing_aux_matmul_plan_init(const Arguments& arg)
     EXPECT_HIPSPARSE_STATUS(plan.status(), HIPSPARSE_STATUS_SUCCESS);
 }
 
+void testing_aux_matmul_plan_init_async(const Arguments& arg)
+{
+#ifndef __HIP_PLATFORM_AMD__
+    return;
+#endif
+    const int64_t M = 128;
+    const int64_t N = 128;
+    const int64_t K = 128;
+
+    const int64_t lda = 128;
+    const int64_t ldb = 128;
+    const int64_t ldc = 128;
+
+    const hipsparseOperation_t opA = HIPSPARSE_OPERATION_TRANSPOSE;
+    const hipsparseOperation_t opB = HIPSPARSE_OPERATION_NON_TRANSPOSE;
+
+    constexpr int num_plans = 8;
+
+    hipsparselt_local_handle handle{arg};
+
+    hipsparselt_local_mat_descr matA(
+        hipsparselt_matrix_type_structured, handle, K, M, lda, arg.a_type, HIPSPARSE_ORDER_COL);
+    EXPECT_HIPSPARSE_STATUS(matA.status(), HIPSPARSE_STATUS_SUCCESS);
+
+    hipsparselt_local_mat_descr matB(
+        hipsparselt_matrix_type_dense, handle, K, N, ldb, arg.b_type, HIPSPARSE_ORDER_COL);
+    EXPECT_HIPSPARSE_STATUS(matB.status(), HIPSPARSE_STATUS_SUCCESS);
+
+    hipsparselt_local_mat_descr matC(
+        hipsparselt_matrix_type_dense, handle, M, N, ldc, arg.c_type, HIPSPARSE_ORDER_COL);
+    EXPECT_HIPSPARSE_STATUS(matC.status(), HIPSPARSE_STATUS_SUCCESS);
+
+    hipsparselt_local_mat_descr matD(
+        hipsparselt_matrix_type_dense, handle, M, N, ldc, arg.d_type, HIPSPARSE_ORDER_COL);
+    EXPECT_HIPSPARSE_STATUS(matD.status(), HIPSPARSE_STATUS_SUCCESS);
+
+    hipsparselt_local_matmul_descr matmul(
+        handle, opA, opB, matA, matB, matC, matD, arg.compute_type);
+    EXPECT_HIPSPARSE_STATUS(matmul.status(), HIPSPARSE_STATUS_SUCCESS);
+
+    hipsparseLtAsyncToken_t token;
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtAsyncTokenWait(nullptr), HIPSPARSE_STATUS_INVALID_VALUE);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulAlgSelectionInitAsync(
+                                handle, nullptr, matmul, HIPSPARSELT_MATMUL_ALG_DEFAULT, nullptr),
+                            HIPSPARSE_STATUS_INVALID_VALUE);
+
+    // errors of the queued call are returned by the wait.
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulAlgSelectionInitAsync(
+                                handle, nullptr, matmul, HIPSPARSELT_MATMUL_ALG_DEFAULT, &token),
+                            HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtAsyncTokenWait(&token), HIPSPARSE_STATUS_INVALID_VALUE);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtAsyncTokenWait(&token), HIPSPARSE_STATUS_INVALID_VALUE);
+
+    hipsparseLtMatmulAlgSelection_t alg_sel[num_plans];
+    hipsparseLtMatmulPlan_t         plan[num_plans];
+    hipsparseLtAsyncToken_t         alg_sel_token[num_plans], plan_token[num_plans];
+    for(int i = 0; i < num_plans; i++)
+    {
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulAlgSelectionInitAsync(
+                handle, &alg_sel[i], matmul, HIPSPARSELT_MATMUL_ALG_DEFAULT, &alg_sel_token[i]),
+            HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulPlanInitAsync(handle,
+                                                               &plan[i],
+                                                               matmul,
+                                                               &alg_sel[i],
+                                                               &alg_sel_token[i],
+                                                               &plan_token[i]),
+                                HIPSPARSE_STATUS_SUCCESS);
+    }
+
+    for(int i = 0; i < num_plans; i++)
+    {
+        int done = 0;
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtAsyncTokenQuery(&plan_token[i], &done),
+                                HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtAsyncTokenWait(&plan_token[i]),
+                                HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtAsyncTokenQuery(&alg_sel_token[i], &done),
+                                HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_EQ(done, 1);
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtAsyncTokenWait(&alg_sel_token[i]),
+                                HIPSPARSE_STATUS_SUCCESS);
+
+        int config_max_id = 0;
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulAlgGetAttribute(handle,
+                                             &alg_sel[i],
+                                             HIPSPARSELT_MATMUL_ALG_CONFIG_MAX_ID,
+                                             &config_max_id,
+                                             sizeof(int)),
+            HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_GT(config_max_id, 0);
+    }
+
+    // the plans were initialized on the pool threads, their code objects must be loaded on the
+    // device of the handle to run.
+    aux_matmul ops(handle, arg, M, N, K);
+    float      alpha = 1, beta = 1;
+
+    hipStream_t stream;
+    CHECK_HIP_ERROR(hipStreamCreate(&stream));
+    for(int i = 0; i < num_plans; i++)
+    {
+        size_t workspace_size;
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulGetWorkspace(handle, &plan[i], &workspace_size),
+                                HIPSPARSE_STATUS_SUCCESS);
+        device_vector<unsigned char> dWorkspace(workspace_size);
+        CHECK_DEVICE_ALLOCATION(dWorkspace.memcheck());
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmul(handle,
+                                                  &plan[i],
+                                                  &alpha,
+                                                  ops.dA,
+                                                  ops.dB,
+                                                  &beta,
+                                                  ops.dC,
+                                                  ops.dD,
+                                                  dWorkspace,
+                                                  &stream,
+                                                  1),
+                                HIPSPARSE_STATUS_SUCCESS);
+        CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulPlanDestroy(&plan[i]), HIPSPARSE_STATUS_SUCCESS);
+    }
+    CHECK_HIP_ERROR(hipStreamDestroy(stream));
+}
+
+void testing_aux_timeline(const Arguments& arg)
+{
+#ifndef __HIP_PLATFORM_AMD__
+    return;
+#endif
+    const int64_t M = 128;
+    const int64_t N = 128;
+    const int64_t K = 128;
+
+    // the timeline layer is enabled by the layer mask when the handle is created.
+    const std::string path     = "hipsparselt_timeline_test_" + std::to_string(getpid()) + ".json";
+    const char*       mask     = getenv("HIPSPARSELT_LOG_MASK");
+    const std::string old_mask = mask ? mask : "";
+    setenv("HIPSPARSELT_LOG_MASK", "32", 1);
+    setenv("HIPSPARSELT_TIMELINE_FILE", path.c_str(), 1);
+    {
+        hipsparselt_local_handle handle{arg};
+        aux_matmul               ops(handle, arg, M, N, K);
+
+        device_vector<unsigned char> dWorkspace(std::max(ops.workspace_size, size_t(1)));
+        CHECK_DEVICE_ALLOCATION(dWorkspace.memcheck());
+        hipStream_t stream = nullptr;
+
+        EXPECT_HIPSPARSE_STATUS(ops.run(handle, ops.dD, dWorkspace, stream),
+                                HIPSPARSE_STATUS_SUCCESS);
+
+        float alpha = 1, beta = 1;
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulSearch(handle,
+                                                        ops.plan,
+                                                        &alpha,
+                                                        ops.dA,
+                                                        ops.dB,
+                                                        &beta,
+                                                        ops.dC,
+                                                        ops.dD,
+                                                        dWorkspace,
+                                                        &stream,
+                                                        1),
+                                HIPSPARSE_STATUS_SUCCESS);
+        CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+    }
+    unsetenv("HIPSPARSELT_TIMELINE_FILE");
+    if(mask)
+        setenv("HIPSPARSELT_LOG_MASK", old_mask.c_str(), 1);
+    else
+        unsetenv("HIPSPARSELT_LOG_MASK");
+
+    // the trace is written when the handle is destroyed.
+    std::ifstream ifs(path);
+    ASSERT_TRUE(ifs.is_open());
+    std::stringstream trace;
+    trace << ifs.rdbuf();
+    ifs.close();
+    std::remove(path.c_str());
+
+    EXPECT_EQ(trace.str().rfind("{\"traceEvents\":[", 0), 0);
+    EXPECT_NE(trace.str().find("\"name\":\"rocsparselt_matmul_alg_selection_init\""),
+              std::string::npos);
+    EXPECT_NE(trace.str().find("\"cat\":\"plan_init\""), std::string::npos);
+
+    // the matmul and the search, their kernels on both the Tensile and the built-in path.
+    EXPECT_NE(trace.str().find("\"name\":\"rocsparselt_matmul\",\"cat\":\"api\""),
+              std::string::npos);
+    EXPECT_NE(trace.str().find("\"name\":\"rocsparselt_matmul_search\",\"cat\":\"api\""),
+              std::string::npos);
+    EXPECT_NE(trace.str().find("\"cat\":\"kernel_launch\""), std::string::npos);
+    EXPECT_NE(trace.str().find("\"cat\":\"search\""), std::string::npos);
+    EXPECT_NE(trace.str().find("\"dropped_events\":0}"), std::string::npos);
+}
+
+void testing_aux_matmul_plan_stats(const Arguments& arg)
+{
+#ifndef __HIP_PLATFORM_AMD__
+    return;
+#endif
+    const int64_t M = 128;
+    const int64_t N = 128;
+    const int64_t K = 128;
+
+    const hipsparseOperation_t opA = HIPSPARSE_OPERATION_TRANSPOSE;
+    const hipsparseOperation_t opB = HIPSPARSE_OPERATION_NON_TRANSPOSE;
+
+    hipsparselt_local_handle handle{arg};
+
+    hipsparselt_local_mat_descr matA(
+        hipsparselt_matrix_type_structured, handle, K, M, K, arg.a_type, HIPSPARSE_ORDER_COL);
+    hipsparselt_local_mat_descr matB(
+        hipsparselt_matrix_type_dense, handle, K, N, K, arg.b_type, HIPSPARSE_ORDER_COL);
+    hipsparselt_local_mat_descr matC(
+        hipsparselt_matrix_type_dense, handle, M, N, M, arg.c_type, HIPSPARSE_ORDER_COL);
+    hipsparselt_local_mat_descr matD(
+        hipsparselt_matrix_type_dense, handle, M, N, M, arg.d_type, HIPSPARSE_ORDER_COL);
+    hipsparselt_local_matmul_descr matmul(
+        handle, opA, opB, matA, matB, matC, matD, arg.compute_type);
+    EXPECT_HIPSPARSE_STATUS(matmul.status(), HIPSPARSE_STATUS_SUCCESS);
+
+    hipsparselt_local_matmul_alg_selection alg_sel(handle, matmul, HIPSPARSELT_MATMUL_ALG_DEFAULT);
+    EXPECT_HIPSPARSE_STATUS(alg_sel.status(), HIPSPARSE_STATUS_SUCCESS);
+
+    hipsparselt_local_matmul_plan plan(handle, matmul, alg_sel);
+    EXPECT_HIPSPARSE_STATUS(plan.status(), HIPSPARSE_STATUS_SUCCESS);
+
+    size_t workspace_size = 0, compressed_size = 0, compress_buffer_size = 0;
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulGetWorkspace(handle, plan, &workspace_size),
+                            HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtSpMMACompressedSize(handle, plan, &compressed_size, &compress_buffer_size),
+        HIPSPARSE_STATUS_SUCCESS);
+
+    // the values do not matter, only the calls are counted.
+    device_vector<unsigned char> dA(compressed_size);
+    device_vector<unsigned char> dB(K * N * sizeof(float));
+    device_vector<unsigned char> dC(M * N * sizeof(float));
+    device_vector<unsigned char> dD(M * N * sizeof(float));
+    device_vector<unsigned char> dWorkspace(workspace_size);
+    CHECK_DEVICE_ALLOCATION(dA.memcheck());
+    CHECK_DEVICE_ALLOCATION(dB.memcheck());
+    CHECK_DEVICE_ALLOCATION(dC.memcheck());
+    CHECK_DEVICE_ALLOCATION(dD.memcheck());
+    CHECK_DEVICE_ALLOCATION(dWorkspace.memcheck());
+
+    hipStream_t stream;
+    CHECK_HIP_ERROR(hipStreamCreate(&stream));
+    float alpha = 1, beta = 0;
+
+    hipsparseLtMatmulPlanStats_t stats;
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulPlanGetStats(nullptr, plan, &stats),
+                            HIPSPARSE_STATUS_INVALID_VALUE);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulPlanGetStats(handle, nullptr, &stats),
+                            HIPSPARSE_STATUS_INVALID_VALUE);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulPlanGetStats(handle, plan, nullptr),
+                            HIPSPARSE_STATUS_INVALID_VALUE);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulPlanSetStatsSampling(handle, plan, -1),
+                            HIPSPARSE_STATUS_INVALID_VALUE);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulPlanResetStats(handle, nullptr),
+                            HIPSPARSE_STATUS_INVALID_VALUE);
+
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulPlanGetStats(handle, plan, &stats),
+                            HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_EQ(stats.calls, 0);
+    EXPECT_EQ(stats.gpuSamples, 0);
+
+    // time the calls 0, 2 and 4 on the GPU, each one is done before the next sample.
+    constexpr int num_calls = 5;
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulPlanSetStatsSampling(handle, plan, 2),
+                            HIPSPARSE_STATUS_SUCCESS);
+    for(int i = 0; i < num_calls; i++)
+    {
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmul(
+                handle, plan, &alpha, dA, dB, &beta, dC, dD, dWorkspace, &stream, 1),
+            HIPSPARSE_STATUS_SUCCESS);
+        CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+    }
+
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulPlanGetStats(handle, plan, &stats),
+                            HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_EQ(stats.calls, num_calls);
+    EXPECT_GT(stats.hostTimeNs, 0);
+    EXPECT_EQ(std::accumulate(stats.hostHistogram, stats.hostHistogram + 32, int64_t(0)),
+              num_calls);
+    EXPECT_EQ(stats.gpuSamples, 3);
+    EXPECT_EQ(std::accumulate(stats.gpuHistogram, stats.gpuHistogram + 32, int64_t(0)), 3);
+
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulPlanResetStats(handle, plan),
+                            HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulPlanGetStats(handle, plan, &stats),
+                            HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_EQ(stats.calls, 0);
+    EXPECT_EQ(stats.hostTimeNs, 0);
+    EXPECT_EQ(stats.gpuSamples, 0);
+
+    CHECK_HIP_ERROR(hipStreamDestroy(stream));
+}
+
+void testing_aux_log_bench(const Arguments& arg)
+{
+#ifndef __HIP_PLATFORM_AMD__
+    return;
+#endif
+    const int64_t M = 128;
+    const int64_t N = 128;
+    const int64_t K = 128;
+
+    const hipsparseOperation_t opA = HIPSPARSE_OPERATION_TRANSPOSE;
+    const hipsparseOperation_t opB = HIPSPARSE_OPERATION_NON_TRANSPOSE;
+
+    // the bench log is opened when the handle is created.
+    const std::string path = "hipsparselt_log_bench_test_" + std::to_string(getpid()) + ".log";
+    setenv("HIPSPARSELT_LOG_BENCH", "1", 1);
+    setenv("HIPSPARSELT_LOG_BENCH_FILE", path.c_str(), 1);
+    {
+        hipsparselt_local_handle handle{arg};
+
+        hipsparselt_local_mat_descr matA(
+            hipsparselt_matrix_type_structured, handle, K, M, K, arg.a_type, HIPSPARSE_ORDER_COL);
+        hipsparselt_local_mat_descr matB(
+            hipsparselt_matrix_type_dense, handle, K, N, K, arg.b_type, HIPSPARSE_ORDER_COL);
+        hipsparselt_local_mat_descr matC(
+            hipsparselt_matrix_type_dense, handle, M, N, M, arg.c_type, HIPSPARSE_ORDER_COL);
+        hipsparselt_local_mat_descr matD(
+            hipsparselt_matrix_type_dense, handle, M, N, M, arg.d_type, HIPSPARSE_ORDER_COL);
+        hipsparselt_local_matmul_descr matmul(
+            handle, opA, opB, matA, matB, matC, matD, arg.compute_type);
+        EXPECT_HIPSPARSE_STATUS(matmul.status(), HIPSPARSE_STATUS_SUCCESS);
+
+        hipsparselt_local_matmul_alg_selection alg_sel(
+            handle, matmul, HIPSPARSELT_MATMUL_ALG_DEFAULT);
+        EXPECT_HIPSPARSE_STATUS(alg_sel.status(), HIPSPARSE_STATUS_SUCCESS);
+
+        hipsparselt_local_matmul_plan plan(handle, matmul, alg_sel);
+        EXPECT_HIPSPARSE_STATUS(plan.status(), HIPSPARSE_STATUS_SUCCESS);
+
+        size_t workspace_size = 0, compressed_size = 0, compress_buffer_size = 0;
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulGetWorkspace(handle, plan, &workspace_size),
+                                HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtSpMMACompressedSize(handle, plan, &compressed_size, &compress_buffer_size),
+            HIPSPARSE_STATUS_SUCCESS);
+
+        device_vector<unsigned char> dA(compressed_size);
+        device_vector<unsigned char> dB(K * N * sizeof(float));
+        device_vector<unsigned char> dC(M * N * sizeof(float));
+        device_vector<unsigned char> dD(M * N * sizeof(float));
+        device_vector<unsigned char> dWorkspace(workspace_size);
+        CHECK_DEVICE_ALLOCATION(dA.memcheck());
+        CHECK_DEVICE_ALLOCATION(dB.memcheck());
+        CHECK_DEVICE_ALLOCATION(dC.memcheck());
+        CHECK_DEVICE_ALLOCATION(dD.memcheck());
+        CHECK_DEVICE_ALLOCATION(dWorkspace.memcheck());
+
+        hipStream_t stream;
+        CHECK_HIP_ERROR(hipStreamCreate(&stream));
+        float alpha = 1, beta = 0;
+        for(int i = 0; i < 2; i++)
+            EXPECT_HIPSPARSE_STATUS(
+                hipsparseLtMatmul(
+                    handle, plan, &alpha, dA, dB, &beta, dC, dD, dWorkspace, &stream, 1),
+                HIPSPARSE_STATUS_SUCCESS);
+        CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+        CHECK_HIP_ERROR(hipStreamDestroy(stream));
+    }
+    unsetenv("HIPSPARSELT_LOG_BENCH_FILE");
+    unsetenv("HIPSPARSELT_LOG_BENCH");
+
+    std::ifstream ifs(path);
+    ASSERT_TRUE(ifs.is_open());
+    std::vector<std::string> cmds;
+    for(std::string line; std::getline(ifs, line);)
+    {
+        size_t pos = line.find("hipsparselt-bench ");
+        if(pos != std::string::npos)
+            cmds.push_back(line.substr(pos));
+    }
+    ifs.close();
+    std::remove(path.c_str());
+
+    // one complete command line per call, which hipsparselt-bench --replay runs once.
+    ASSERT_EQ(cmds.size(), 2);
+    EXPECT_EQ(cmds[0], cmds[1]);
+    EXPECT_EQ(cmds[0].rfind(std::string("hipsparselt-bench -f spmm --a_type ")
+                                + hipsparselt_datatype_to_string(arg.a_type),
+                            0),
+              0);
+    EXPECT_NE(cmds[0].find("--transposeA T --transposeB N -m 128 -n 128 -k 128 --lda 128 "
+                           "--ldb 128 --ldc 128 --ldd 128 --alpha 1 --beta 0"),
+              std::string::npos);
+    EXPECT_NE(cmds[0].find("--c_noalias_d --config_id 0"), std::string::npos);
+}
+
+void testing_aux_trace_binary(const Arguments& arg)
+{
+#ifndef __HIP_PLATFORM_AMD__
+    return;
+#endif
+    const int64_t M = 128;
+    const int64_t N = 128;
+    const int64_t K = 128;
+
+    const hipsparseOperation_t opA = HIPSPARSE_OPERATION_TRANSPOSE;
+    const hipsparseOperation_t opB = HIPSPARSE_OPERATION_NON_TRANSPOSE;
+
+    // the binary trace layer is enabled by the layer mask when the handle is created.
+    const std::string path     = "hipsparselt_trace_test_" + std::to_string(getpid()) + ".bin";
+    const char*       mask     = getenv("HIPSPARSELT_LOG_MASK");
+    const std::string old_mask = mask ? mask : "";
+    setenv("HIPSPARSELT_LOG_MASK", "64", 1);
+    setenv("HIPSPARSELT_TRACE_FILE", path.c_str(), 1);
+    {
+        hipsparselt_local_handle handle{arg};
+
+        hipsparselt_local_mat_descr matA(
+            hipsparselt_matrix_type_structured, handle, K, M, K, arg.a_type, HIPSPARSE_ORDER_COL);
+        hipsparselt_local_mat_descr matB(
+            hipsparselt_matrix_type_dense, handle, K, N, K, arg.b_type, HIPSPARSE_ORDER_COL);
+        hipsparselt_local_mat_descr matC(
+            hipsparselt_matrix_type_dense, handle, M, N, M, arg.c_type, HIPSPARSE_ORDER_COL);
+        hipsparselt_local_mat_descr matD(
+            hipsparselt_matrix_type_dense, handle, M, N, M, arg.d_type, HIPSPARSE_ORDER_COL);
+        hipsparselt_local_matmul_descr matmul(
+            handle, opA, opB, matA, matB, matC, matD, arg.compute_type);
+        EXPECT_HIPSPARSE_STATUS(matmul.status(), HIPSPARSE_STATUS_SUCCESS);
+
+        hipsparselt_local_matmul_alg_selection alg_sel(
+            handle, matmul, HIPSPARSELT_MATMUL_ALG_DEFAULT);
+        EXPECT_HIPSPARSE_STATUS(alg_sel.status(), HIPSPARSE_STATUS_SUCCESS);
+
+        hipsparselt_local_matmul_plan plan(handle, matmul, alg_sel);
+        EXPECT_HIPSPARSE_STATUS(plan.status(), HIPSPARSE_STATUS_SUCCESS);
+
+        size_t workspace_size = 0, compressed_size = 0, compress_buffer_size = 0;
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulGetWorkspace(handle, plan, &workspace_size),
+                                HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtSpMMACompressedSize(handle, plan, &compressed_size, &compress_buffer_size),
+            HIPSPARSE_STATUS_SUCCESS);
+
+        device_vector<unsigned char> dA(compressed_size);
+        device_vector<unsigned char> dB(K * N * sizeof(float));
+        device_vector<unsigned char> dC(M * N * sizeof(float));
+        device_vector<unsigned char> dD(M * N * sizeof(float));
+        device_vector<unsigned char> dWorkspace(workspace_size);
+        CHECK_DEVICE_ALLOCATION(dA.memcheck());
+        CHECK_DEVICE_ALLOCATION(dB.memcheck());
+        CHECK_DEVICE_ALLOCATION(dC.memcheck());
+        CHECK_DEVICE_ALLOCATION(dD.memcheck());
+        CHECK_DEVICE_ALLOCATION(dWorkspace.memcheck());
+
+        hipStream_t stream;
+        CHECK_HIP_ERROR(hipStreamCreate(&stream));
+        float alpha = 1, beta = 0;
+        for(int i = 0; i < 3; i++)
+            EXPECT_HIPSPARSE_STATUS(
+                hipsparseLtMatmul(
+                    handle, plan, &alpha, dA, dB, &beta, dC, dD, dWorkspace, &stream, 1),
+                HIPSPARSE_STATUS_SUCCESS);
+        CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+        CHECK_HIP_ERROR(hipStreamDestroy(stream));
+    }
+    unsetenv("HIPSPARSELT_TRACE_FILE");
+    if(mask)
+        setenv("HIPSPARSELT_LOG_MASK", old_mask.c_str(), 1);
+    else
+        unsetenv("HIPSPARSELT_LOG_MASK");
+
+    // the trace is written when the handle is destroyed.
+    std::ifstream ifs(path, std::ios::binary);
+    ASSERT_TRUE(ifs.is_open());
+    std::vector<unsigned char> trace((std::istreambuf_iterator<char>(ifs)),
+                                     std::istreambuf_iterator<char>());
+    ifs.close();
+    std::remove(path.c_str());
+
+    // a 32 byte file header, then 64 byte records which start with the type, a reserved byte and
+    // the 16 bit count of the payload records which follow.
+    constexpr size_t header_size = 32, record_size = 64;
+    ASSERT_GE(trace.size(), header_size);
+    EXPECT_EQ(std::string(trace.begin(), trace.begin() + 8), "RSLTTRC1");
+    EXPECT_EQ((trace.size() - header_size) % record_size, 0);
+
+    int launches = 0, strings = 0, layouts = 0;
+    for(size_t pos = header_size; pos + record_size <= trace.size();)
+    {
+        uint16_t chunks;
+        memcpy(&chunks, &trace[pos + 2], sizeof(chunks));
+        launches += trace[pos] == 1;
+        strings += trace[pos] == 2;
+        layouts += trace[pos] == 3;
+        pos += (1 + chunks) * record_size;
+    }
+    // the kernel names and argument layouts are defined once, not per launch.
+    EXPECT_GE(launches, 3);
+    EXPECT_GE(strings, 2);
+    EXPECT_GE(layouts, 1);
+    EXPECT_LE(layouts, launches / 3);
+}
+
+void testing_aux_ostream_stress(const Arguments& arg)
+{
+    const int threads  = 8;
+    const int messages = 2000;
+
+    // every thread writes numbered lines of a length and letter derived from the thread and the
+    // number through its own duplicate of one stream, with one or two lines per flush.
+    auto line = [](int t, int i) {
+        return "t" + std::to_string(t) + " " + std::to_string(i) + " "
+               + std::string(1 + (i * 7 + t) % 300, 'a' + t) + "\n";
+    };
+
+    const std::string path = "hipsparselt_ostream_test_" + std::to_string(getpid()) + ".log";
+    {
+        hipsparselt_internal_ostream os(path);
+        std::vector<std::thread>     workers;
+        for(int t = 0; t < threads; t++)
+            workers.emplace_back([&, t] {
+                hipsparselt_internal_ostream str = os.dup();
+                for(int i = 0; i < messages; i++)
+                {
+                    str << line(t, i);
+                    if(i % 3 == 0 && ++i < messages)
+                        str << line(t, i);
+                    str.flush();
+                }
+            });
+        for(auto& worker : workers)
+            worker.join();
+    }
+
+    // flush returns when the message is written, so the file is complete here. No line may be
+    // lost or cut by another and the lines of each thread must be in order.
+    std::ifstream ifs(path);
+    ASSERT_TRUE(ifs.is_open());
+    std::vector<int> next(threads, 0);
+    int              lines = 0;
+    for(std::string text; std::getline(ifs, text); lines++)
+    {
+        int t = -1, i = -1;
+        ASSERT_EQ(sscanf(text.c_str(), "t%d %d", &t, &i), 2) << text;
+        ASSERT_TRUE(t >= 0 && t < threads) << text;
+        ASSERT_EQ(i, next[t]) << text;
+        ASSERT_EQ(text + "\n", line(t, i));
+        next[t]++;
+    }
+    ifs.close();
+    std::remove(path.c_str());
+
+    EXPECT_EQ(lines, threads * messages);
+}
+
+void testing_aux_init_env_refresh(const Arguments& arg)
+{
+#ifndef __HIP_PLATFORM_AMD__
+    return;
+#endif
+    // the log level overrides the log mask this test changes.
+    if(getenv("HIPSPARSELT_LOG_LEVEL"))
+        return;
+
+    const std::string path     = "hipsparselt_init_test_" + std::to_string(getpid()) + ".log";
+    const char*       mask     = getenv("HIPSPARSELT_LOG_MASK");
+    const std::string old_mask = mask ? mask : "";
+
+    // the environment configuration is cached by the first handle without logging, and
+    // parsed again for the second handle once the log mask changed.
+    hipsparseLtHandle_t handle;
+    unsetenv("HIPSPARSELT_LOG_MASK");
+    for(int i = 0; i < 3; i++)
+    {
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtInit(&handle), HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtDestroy(&handle), HIPSPARSE_STATUS_SUCCESS);
+    }
+
+    setenv("HIPSPARSELT_LOG_MASK", "16", 1);
+    setenv("HIPSPARSELT_LOG_FILE", path.c_str(), 1);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtInit(&handle), HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtDestroy(&handle), HIPSPARSE_STATUS_SUCCESS);
+
+    unsetenv("HIPSPARSELT_LOG_FILE");
+    if(mask)
+        setenv("HIPSPARSELT_LOG_MASK", old_mask.c_str(), 1);
+    else
+        unsetenv("HIPSPARSELT_LOG_MASK");
+
+    std::ifstream ifs(path);
+    ASSERT_TRUE(ifs.is_open());
+    std::stringstream log;
+    log << ifs.rdbuf();
+    ifs.close();
+    std::remove(path.c_str());
+
+    EXPECT_NE(log.str().find("rocsparselt_init"), std::string::npos);
+}
+
+void testing_aux_yaml_expand(const Arguments& arg)
+{
+    const std::string path = "hipsparselt_yaml_test_" + std::to_string(getpid()) + ".yaml";
+
+    // tests in the format of a --yaml file, which follows the template. The last test is the
+    // same as the one before it and is not repeated.
+    {
+        std::ofstream ofs(path);
+        ofs << "- { hipsparselt_function: hipsparselt_hprune, M: 8..24..8, N: [ 16, 32 ],\n"
+               "    transA: N, transB: T }\n"
+               "- { function: spmm, precision: *hpa_bf16_precision, transA: T, transB: N,\n"
+               "    M: 64, K: 32, alpha: .NaN, category: 'quick' }\n"
+               "- { function: spmm, precision: *hpa_bf16_precision, transA: T, transB: N,\n"
+               "    M: 64, K: 32, alpha: .NaN, category: 'quick' }\n";
+    }
+
+    auto                    exepath = hipsparselt_exepath();
+    hipsparselt_yaml_source source;
+    std::string             data;
+    bool                    read = hipsparselt_yaml_read(
+                           source, exepath + "hipsparselt_template.yaml", {exepath})
+                       && hipsparselt_yaml_read(source, path, {exepath});
+    std::remove(path.c_str());
+    ASSERT_TRUE(read);
+    ASSERT_TRUE(hipsparselt_yaml_expand(source, data));
+
+    std::istringstream iss(data);
+    Arguments::validate(iss);
+    std::vector<Arguments> tests{std::istream_iterator<Arguments>(iss),
+                                 std::istream_iterator<Arguments>()};
+    ASSERT_EQ(tests.size(), 7);
+
+    // the range and the list are expanded in the order of their names
+    for(size_t i = 0; i < 6; i++)
+    {
+        EXPECT_STREQ(tests[i].function, "prune");
+        EXPECT_EQ(tests[i].a_type, HIPSPARSELT_R_16F);
+        EXPECT_EQ(tests[i].M, 8 * int64_t(i / 2 + 1));
+        EXPECT_EQ(tests[i].N, i % 2 ? 32 : 16);
+        EXPECT_EQ(tests[i].lda, tests[i].M);
+        EXPECT_EQ(tests[i].ldb, tests[i].N);
+    }
+
+    EXPECT_STREQ(tests[6].function, "spmm");
+    EXPECT_STREQ(tests[6].category, "quick");
+    EXPECT_EQ(tests[6].a_type, HIPSPARSELT_R_16BF);
+    EXPECT_EQ(tests[6].lda, 32);
+    EXPECT_EQ(tests[6].ldb, 32);
+    EXPECT_EQ(tests[6].ldc, 64);
+    EXPECT_EQ(tests[6].stride_c, 64 * 128);
+    EXPECT_TRUE(std::isnan(tests[6].alpha));
+
+    // the cached data of a YAML file is found by the hash of its text, so the text read again
+    // has the same key and an edit of a value gives another key and other data.
+    hipsparselt_yaml_source reread, edited;
+    ASSERT_TRUE(hipsparselt_yaml_read(reread, exepath + "hipsparselt_template.yaml", {exepath}));
+    for(size_t i = reread.size(); i < source.size(); i++)
+        reread.push_back(source[i]);
+    EXPECT_EQ(hipsparselt_yaml_hash(reread), hipsparselt_yaml_hash(source));
+
+    edited         = source;
+    auto& line     = edited.back().text;
+    auto  position = line.find("M: 64");
+    ASSERT_NE(position, std::string::npos);
+    line.replace(position, 5, "M: 96");
+    EXPECT_NE(hipsparselt_yaml_hash(edited), hipsparselt_yaml_hash(source));
+
+    std::string edited_data;
+    ASSERT_TRUE(hipsparselt_yaml_expand(edited, edited_data));
+    EXPECT_NE(edited_data, data);
+}
+
+void testing_aux_yaml_gentest(const Arguments& arg)
+{
+#ifdef HIPSPARSELT_CLIENTS_SOURCE_DIR
+    // the YAML of the tests is in the source tree, which is not installed with them
+    const std::string clients = HIPSPARSELT_CLIENTS_SOURCE_DIR;
+    const std::string yaml    = clients + "/gtest/hipsparselt_gtest.yaml";
+    if(!std::ifstream(yaml))
+        return;
+
+    // the data hipsparselt_gentest.py expanded the same YAML into when the tests were built
+    std::ifstream ifs(hipsparselt_exepath() + "hipsparselt_gtest.data", std::ios::binary);
+    ASSERT_TRUE(ifs.is_open());
+    std::string expected{std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+
+    hipsparselt_yaml_source source;
+    std::string             data;
+    ASSERT_TRUE(hipsparselt_yaml_read(source, yaml, {clients + "/include"}));
+    ASSERT_TRUE(hipsparselt_yaml_expand(source, data));
+
+    // the offset of the first different byte instead of the whole data on a failure
+    EXPECT_EQ(data.size(), expected.size());
+    size_t size   = std::min(data.size(), expected.size());
+    auto   differ = std::mismatch(data.begin(), data.begin() + size, expected.begin());
+    EXPECT_EQ(size_t(differ.first - data.begin()), size);
+#endif
+}
+
+void testing_aux_golden_cache(const Arguments& arg)
+{
+#ifdef WIN32
+    return;
+#endif
+    // a cache directory of the test, the cache of the run is restored at the end.
+    char dir[] = "/tmp/hipsparselt_golden_XXXXXX";
+    ASSERT_NE(mkdtemp(dir), nullptr);
+    const char*       env     = getenv("HIPSPARSELT_GOLDEN_CACHE");
+    const std::string old_dir = env ? env : "";
+    setenv("HIPSPARSELT_GOLDEN_CACHE", dir, 1);
+    EXPECT_TRUE(hipsparselt_golden_cache_enabled());
+
+    std::vector<float> result(1001), loaded(result.size());
+    std::iota(result.begin(), result.end(), 0.5f);
+    const size_t   bytes      = result.size() * sizeof(float);
+    const uint64_t key        = hipsparselt_golden_key(arg, "aux_golden_cache");
+    const uint64_t input_hash = hipsparselt_golden_hash(result.data(), bytes);
+
+    Arguments other_arg = arg;
+    other_arg.M++;
+    const uint64_t other_key = hipsparselt_golden_key(arg, "aux_golden_cache_other");
+    EXPECT_NE(other_key, key);
+    EXPECT_NE(hipsparselt_golden_key(other_arg, "aux_golden_cache"), key);
+
+    auto path = [&](uint64_t k) {
+        char name[32];
+        snprintf(name, sizeof(name), "/%016llx.bin", (unsigned long long)k);
+        return std::string(dir) + name;
+    };
+
+    // nothing is loaded before the store, the stored result is loaded back
+    EXPECT_FALSE(hipsparselt_golden_load(key, input_hash, loaded.data(), bytes));
+    hipsparselt_golden_store(key, input_hash, result.data(), bytes);
+    EXPECT_TRUE(hipsparselt_golden_load(key, input_hash, loaded.data(), bytes));
+    EXPECT_EQ(loaded, result);
+
+    // a result of other inputs or of another size is not loaded and leaves dst as it is
+    std::fill(loaded.begin(), loaded.end(), 0.0f);
+    EXPECT_FALSE(hipsparselt_golden_load(key, input_hash + 1, loaded.data(), bytes));
+    EXPECT_FALSE(hipsparselt_golden_load(key, input_hash, loaded.data(), bytes - sizeof(float)));
+    EXPECT_EQ(loaded, std::vector<float>(loaded.size(), 0.0f));
+
+    // the key in the file has to match the key of its name
+    ASSERT_EQ(rename(path(key).c_str(), path(other_key).c_str()), 0);
+    EXPECT_FALSE(hipsparselt_golden_load(other_key, input_hash, loaded.data(), bytes));
+    ASSERT_EQ(rename(path(other_key).c_str(), path(key).c_str()), 0);
+
+    // a truncated file, e.g. of a full disk, is not loaded
+    struct stat st;
+    ASSERT_EQ(stat(path(key).c_str(), &st), 0);
+    ASSERT_EQ(truncate(path(key).c_str(), st.st_size - 1), 0);
+    EXPECT_FALSE(hipsparselt_golden_load(key, input_hash, loaded.data(), bytes));
+    EXPECT_EQ(loaded, std::vector<float>(loaded.size(), 0.0f));
+
+    // a store replaces the file
+    hipsparselt_golden_store(key, input_hash, result.data(), bytes);
+    EXPECT_TRUE(hipsparselt_golden_load(key, input_hash, loaded.data(), bytes));
+    EXPECT_EQ(loaded, result);
+
+    std::remove(path(key).c_str());
+    EXPECT_EQ(rmdir(dir), 0);
+    if(env)
+        setenv("HIPSPARSELT_GOLDEN_CACHE", old_dir.c_str(), 1);
+    else
+        unsetenv("HIPSPARSELT_GOLDEN_CACHE");
+}
+
+void testing_aux_init_counter_rng(const Arguments& arg)
+{
+    // known answer of Philox4x32-10 for a zero key and counter
+    uint32_t       r[hipsparselt_philox::block];
+    const uint64_t seed        = g_hipsparselt_counter_seed;
+    g_hipsparselt_counter_seed = 0;
+    hipsparselt_philox::generate(r, 0, 0, 0, 0);
+    g_hipsparselt_counter_seed = seed;
+    EXPECT_EQ(r[0], 0x6627e8d5u);
+    EXPECT_EQ(r[1], 0xe169c58du);
+    EXPECT_EQ(r[2], 0xbc57ac4cu);
+    EXPECT_EQ(r[3], 0x9b00dbd8u);
+
+    // the matrices do not depend on the number of threads, and repeat after a reseed
+    const size_t M           = 37;
+    const size_t N           = 29;
+    const size_t lda         = 40;
+    const size_t stride      = lda * N;
+    const size_t batch_count = 3;
+    const size_t size        = stride * batch_count;
+    const int    max_threads = omp_get_max_threads();
+
+    auto init = [&](int threads, host_vector<float>& A, host_vector<float>& B) {
+        omp_set_num_threads(threads);
+        hipsparselt_seedrand();
+        hipsparselt_init<float>(A, M, N, lda, stride, batch_count);
+        hipsparselt_init_alternating_sign<float>(B, M, N, lda, stride, batch_count);
+    };
+
+    host_vector<float> hA_1(size), hB_1(size), hA_n(size), hB_n(size);
+    init(1, hA_1, hB_1);
+    init(std::max(max_threads, 4), hA_n, hB_n);
+    omp_set_num_threads(max_threads);
+
+    EXPECT_EQ(hA_1, hA_n);
+    EXPECT_EQ(hB_1, hB_n);
+
+    // the values are in the range of random_generator, and each matrix is a new stream
+    bool in_range = true, same = true;
+    for(size_t b = 0; b < batch_count; b++)
+        for(size_t j = 0; j < N; j++)
+            for(size_t i = 0; i < M; i++)
+            {
+                float a  = hA_1[i + j * lda + b * stride];
+                in_range = in_range && a >= 1 && a <= 10 && a == std::trunc(a);
+                same     = same && std::abs(hB_1[i + j * lda + b * stride]) == a;
+            }
+    EXPECT_TRUE(in_range);
+    EXPECT_FALSE(same);
+}
+
+void testing_aux_compare_report(const Arguments& arg)
+{
+    const int64_t M           = 67;
+    const int64_t N           = 33;
+    const int64_t lda         = 70;
+    const int64_t stride      = lda * N;
+    const int64_t batch_count = 3;
+
+    host_vector<float> hCPU(stride * batch_count), hGPU;
+    for(size_t i = 0; i < hCPU.size(); i++)
+        hCPU[i] = float(i % 13) - 6;
+    hGPU = hCPU;
+
+    auto result = compare_general<float, float>(
+        M, N, lda, stride, hCPU, hGPU, batch_count, compare_float_eq{});
+    EXPECT_EQ(result.count, M * N * batch_count);
+    EXPECT_EQ(result.mismatches, 0);
+    EXPECT_EQ(result.max_abs_error, 0);
+    EXPECT_TRUE(result.first.empty());
+
+    // mismatches in reverse order, a NaN on both sides and a difference in the padding
+    hGPU[5 + 7 * lda + 2 * stride] += 1;
+    hGPU[3 + 7 * lda + 2 * stride] += 2;
+    hGPU[1 + 2 * lda + stride] = std::numeric_limits<float>::quiet_NaN();
+    hCPU[9 + 4 * lda]          = std::numeric_limits<float>::quiet_NaN();
+    hGPU[9 + 4 * lda]          = std::numeric_limits<float>::quiet_NaN();
+    hGPU[M + lda]              = 100;
+
+    result = compare_general<float, float>(
+        M, N, lda, stride, hCPU, hGPU, batch_count, compare_float_eq{}, 2);
+    EXPECT_EQ(result.mismatches, 3);
+    EXPECT_EQ(result.max_abs_error, std::numeric_limits<double>::infinity());
+    ASSERT_EQ(result.first.size(), 2u);
+    EXPECT_EQ(result.first[0].batch, 1);
+    EXPECT_EQ(result.first[0].i, 1);
+    EXPECT_EQ(result.first[0].j, 2);
+    EXPECT_EQ(result.first[1].batch, 2);
+    EXPECT_EQ(result.first[1].i, 3);
+    EXPECT_EQ(result.first[1].j, 7);
+    EXPECT_NE(result.report().find("3 of"), std::string::npos);
+
+    // the norm of batch 2 only sees the two differences
+    double cpu2 = 0;
+    for(int64_t j = 0; j < N; j++)
+        for(int64_t i = 0; i < M; i++)
+            cpu2 += double(hCPU[i + j * lda + 2 * stride]) * hCPU[i + j * lda + 2 * stride];
+    EXPECT_EQ(result.norm_error(0), 0);
+    EXPECT_NEAR(result.norm_error(2), std::sqrt(5 / cpu2), 1e-12);
+    EXPECT_EQ(unit_check_diff<float>(M, N, lda, stride, hCPU, hGPU, batch_count), 3);
+}
+
+void testing_aux_memory_usage(const Arguments& arg)
+{
+#ifndef __HIP_PLATFORM_AMD__
+    return;
+#endif
+    const int64_t M = 128;
+    const int64_t N = 128;
+    const int64_t K = 128;
+
+    const hipsparseOperation_t opA = HIPSPARSE_OPERATION_TRANSPOSE;
+    const hipsparseOperation_t opB = HIPSPARSE_OPERATION_NON_TRANSPOSE;
+
+    hipsparseLtDeviceMemoryUsage_t usage, before, after;
+    size_t                         freed;
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtGetDeviceMemoryUsage(nullptr, &usage),
+                            HIPSPARSE_STATUS_INVALID_VALUE);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtUnloadUnusedModules(nullptr, &freed),
+                            HIPSPARSE_STATUS_INVALID_VALUE);
+
+    hipsparselt_local_handle handle{arg};
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtGetDeviceMemoryUsage(handle, nullptr),
+                            HIPSPARSE_STATUS_INVALID_VALUE);
+
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtGetDeviceMemoryUsage(handle, &before),
+                            HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_EQ(before.totalBytes, before.moduleBytes + before.workspaceArenaBytes);
+
+    // the workspace arena is accounted with every backend.
+    {
+        hipsparseLtWorkspaceArenaStats_t stats;
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtWorkspaceArenaSetEnabled(handle, 1),
+                                HIPSPARSE_STATUS_SUCCESS);
+        aux_matmul large(handle, arg, M, 1024, K);
+        EXPECT_HIPSPARSE_STATUS(large.run(handle, large.dD, nullptr, nullptr),
+                                HIPSPARSE_STATUS_SUCCESS);
+        CHECK_HIP_ERROR(hipDeviceSynchronize());
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtWorkspaceArenaGetStats(handle, &stats),
+                                HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtGetDeviceMemoryUsage(handle, &usage),
+                                HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_EQ(usage.workspaceArenaBytes, stats.currentBytes);
+        EXPECT_GE(usage.workspaceArenaBytes, large.workspace_size);
+        EXPECT_EQ(usage.totalBytes, usage.moduleBytes + usage.workspaceArenaBytes);
+        EXPECT_EQ(usage.modulesAccounted, before.modulesAccounted);
+
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtWorkspaceArenaSetEnabled(handle, 0),
+                                HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtGetDeviceMemoryUsage(handle, &usage),
+                                HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_EQ(usage.workspaceArenaBytes, 0);
+        EXPECT_EQ(usage.totalBytes, usage.moduleBytes);
+    }
+
+    // the Tensile backend neither accounts nor unloads its code objects
+    if(!before.modulesAccounted)
+    {
+        EXPECT_EQ(before.moduleBytes, 0);
+        EXPECT_EQ(before.modules, 0);
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtUnloadUnusedModules(handle, &freed),
+                                HIPSPARSE_STATUS_NOT_SUPPORTED);
+        return;
+    }
+
+    hipsparselt_local_mat_descr matA(
+        hipsparselt_matrix_type_structured, handle, K, M, K, arg.a_type, HIPSPARSE_ORDER_COL);
+    hipsparselt_local_mat_descr matB(
+        hipsparselt_matrix_type_dense, handle, K, N, K, arg.b_type, HIPSPARSE_ORDER_COL);
+    hipsparselt_local_mat_descr matC(
+        hipsparselt_matrix_type_dense, handle, M, N, M, arg.c_type, HIPSPARSE_ORDER_COL);
+    hipsparselt_local_mat_descr matD(
+        hipsparselt_matrix_type_dense, handle, M, N, M, arg.d_type, HIPSPARSE_ORDER_COL);
+    hipsparselt_local_matmul_descr matmul(
+        handle, opA, opB, matA, matB, matC, matD, arg.compute_type);
+    EXPECT_HIPSPARSE_STATUS(matmul.status(), HIPSPARSE_STATUS_SUCCESS);
+
+    {
+        hipsparselt_local_matmul_alg_selection alg_sel(
+            handle, matmul, HIPSPARSELT_MATMUL_ALG_DEFAULT);
+        hipsparselt_local_matmul_plan plan(handle, matmul, alg_sel);
+        EXPECT_HIPSPARSE_STATUS(plan.status(), HIPSPARSE_STATUS_SUCCESS);
+
+        // the code objects of the plan stay loaded
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtGetDeviceMemoryUsage(handle, &usage),
+                                HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_EQ(usage.livePlans, before.livePlans + 1);
+        EXPECT_GT(usage.modules, 0);
+        EXPECT_GT(usage.moduleBytes, 0);
+        EXPECT_EQ(usage.totalBytes, usage.moduleBytes + usage.workspaceArenaBytes);
+
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtUnloadUnusedModules(handle, &freed),
+                                HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtGetDeviceMemoryUsage(handle, &after),
+                                HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_GT(after.modules, 0);
+        EXPECT_EQ(after.moduleBytes, usage.moduleBytes - freed);
+    }
+
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtGetDeviceMemoryUsage(handle, &usage),
+                            HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_EQ(usage.livePlans, before.livePlans);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtUnloadUnusedModules(handle, nullptr),
+                            HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtGetDeviceMemoryUsage(handle, &usage),
+                            HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_LE(usage.moduleBytes, after.moduleBytes);
+    if(usage.livePlans == 0)
+        EXPECT_EQ(usage.modules, 0);
+
+    // the next algorithm selection loads them again
+    hipsparselt_local_matmul_alg_selection alg_sel(handle, matmul, HIPSPARSELT_MATMUL_ALG_DEFAULT);
+    EXPECT_HIPSPARSE_STATUS(alg_sel.status(), HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtGetDeviceMemoryUsage(handle, &usage),
+                            HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_GT(usage.modules, 0);
+}
+
+void testing_aux_matmul_graph(const Arguments& arg)
+{
+#ifndef __HIP_PLATFORM_AMD__
+    return;
+#endif
+    const int64_t M = 128;
+    const int64_t N = 128;
+    const int64_t K = 128;
+
+    const hipsparseOperation_t opA = HIPSPARSE_OPERATION_TRANSPOSE;
+    const hipsparseOperation_t opB = HIPSPARSE_OPERATION_NON_TRANSPOSE;
+
+    hipsparselt_local_handle handle{arg};
+
+    hipsparselt_local_mat_descr matA(
+        hipsparselt_matrix_type_structured, handle, K, M, K, arg.a_type, HIPSPARSE_ORDER_COL);
+    hipsparselt_local_mat_descr matB(
+        hipsparselt_matrix_type_dense, handle, K, N, K, arg.b_type, HIPSPARSE_ORDER_COL);
+    hipsparselt_local_mat_descr matC(
+        hipsparselt_matrix_type_dense, handle, M, N, M, arg.c_type, HIPSPARSE_ORDER_COL);
+    hipsparselt_local_mat_descr matD(
+        hipsparselt_matrix_type_dense, handle, M, N, M, arg.d_type, HIPSPARSE_ORDER_COL);
+    hipsparselt_local_matmul_descr matmul(
+        handle, opA, opB, matA, matB, matC, matD, arg.compute_type);
+    EXPECT_HIPSPARSE_STATUS(matmul.status(), HIPSPARSE_STATUS_SUCCESS);
+
+    hipsparselt_local_matmul_alg_selection alg_sel(handle, matmul, HIPSPARSELT_MATMUL_ALG_DEFAULT);
+    EXPECT_HIPSPARSE_STATUS(alg_sel.status(), HIPSPARSE_STATUS_SUCCESS);
+
+    hipsparselt_local_matmul_plan plan(handle, matmul, alg_sel);
+    EXPECT_HIPSPARSE_STATUS(plan.status(), HIPSPARSE_STATUS_SUCCESS);
+
+    size_t workspace_size = 0, compressed_size = 0, compress_buffer_size = 0;
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulGetWorkspace(handle, plan, &workspace_size),
+                            HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtSpMMACompressedSize(handle, plan, &compressed_size, &compress_buffer_size),
+        HIPSPARSE_STATUS_SUCCESS);
+
+    // any fixed bytes will do, the graph must write the same D as a plain matmul.
+    const size_t                 d_size = M * N * sizeof(float);
+    device_vector<unsigned char> dA(compressed_size);
+    device_vector<unsigned char> dB(K * N * sizeof(float));
+    device_vector<unsigned char> dC(d_size);
+    device_vector<unsigned char> dD(d_size);
+    device_vector<unsigned char> dRef(d_size);
+    device_vector<unsigned char> dWorkspace(workspace_size);
+    CHECK_DEVICE_ALLOCATION(dA.memcheck());
+    CHECK_DEVICE_ALLOCATION(dB.memcheck());
+    CHECK_DEVICE_ALLOCATION(dC.memcheck());
+    CHECK_DEVICE_ALLOCATION(dD.memcheck());
+    CHECK_DEVICE_ALLOCATION(dRef.memcheck());
+    CHECK_DEVICE_ALLOCATION(dWorkspace.memcheck());
+    CHECK_HIP_ERROR(hipMemset(dA, 0x11, compressed_size));
+    CHECK_HIP_ERROR(hipMemset(dB, 0x11, K * N * sizeof(float)));
+    CHECK_HIP_ERROR(hipMemset(dC, 0x11, d_size));
+
+    hipStream_t stream;
+    CHECK_HIP_ERROR(hipStreamCreate(&stream));
+    float alpha = 1, beta = 1;
+
+    std::vector<unsigned char> hRef(d_size), hD(d_size);
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmul(handle, plan, &alpha, dA, dB, &beta, dC, dRef, dWorkspace, &stream, 1),
+        HIPSPARSE_STATUS_SUCCESS);
+    CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+    CHECK_HIP_ERROR(hipMemcpy(hRef.data(), dRef, d_size, hipMemcpyDeviceToHost));
+
+    // a matmul captured by the caller makes none of the calls a capture does not allow, not
+    // even to sample the GPU time of the call, and a search is refused.
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulPlanSetStatsSampling(handle, plan, 1),
+                            HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulPlanResetStats(handle, plan),
+                            HIPSPARSE_STATUS_SUCCESS);
+
+    hipGraph_t     graph;
+    hipGraphExec_t graphExec;
+    std::string    calls;
+    CHECK_HIP_ERROR(hipMemset(dD, 0, d_size));
+    CHECK_HIP_ERROR(hipStreamBeginCapture(stream, hipStreamCaptureModeGlobal));
+    hip_capture_stub_begin();
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmul(handle, plan, &alpha, dA, dB, &beta, dC, dD, dWorkspace, &stream, 1),
+        HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulSearch(
+            handle, plan, &alpha, dA, dB, &beta, dC, dD, dWorkspace, &stream, 1),
+        HIPSPARSE_STATUS_NOT_SUPPORTED);
+    EXPECT_EQ(hip_capture_stub_end(&calls), 0) << calls;
+    CHECK_HIP_ERROR(hipStreamEndCapture(stream, &graph));
+    CHECK_HIP_ERROR(hipGraphInstantiate(&graphExec, graph, nullptr, nullptr, 0));
+    CHECK_HIP_ERROR(hipGraphLaunch(graphExec, stream));
+    CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+    CHECK_HIP_ERROR(hipMemcpy(hD.data(), dD, d_size, hipMemcpyDeviceToHost));
+    EXPECT_EQ(hD, hRef);
+    CHECK_HIP_ERROR(hipGraphExecDestroy(graphExec));
+    CHECK_HIP_ERROR(hipGraphDestroy(graph));
+
+    hipsparseLtMatmulPlanStats_t stats;
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulPlanGetStats(handle, plan, &stats),
+                            HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_EQ(stats.calls, 1);
+    EXPECT_EQ(stats.gpuSamples, 0);
+
+    // the graph of the library, then its D pointer updated in place
+    hipsparseLtMatmulLaunch_t launch = {plan, &alpha, dA, dB, &beta, dC, dRef, dWorkspace};
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulGraphCreate(handle, &launch, 1, stream, nullptr),
+                            HIPSPARSE_STATUS_INVALID_VALUE);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulGraphCreate(handle, &launch, 1, stream, &graphExec),
+                            HIPSPARSE_STATUS_SUCCESS);
+    CHECK_HIP_ERROR(hipMemset(dRef, 0, d_size));
+    CHECK_HIP_ERROR(hipGraphLaunch(graphExec, stream));
+    CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+    CHECK_HIP_ERROR(hipMemcpy(hD.data(), dRef, d_size, hipMemcpyDeviceToHost));
+    EXPECT_EQ(hD, hRef);
+
+    launch.d_D = dD;
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulGraphUpdate(handle, &launch, 1, nullptr, graphExec),
+                            HIPSPARSE_STATUS_SUCCESS);
+    CHECK_HIP_ERROR(hipMemset(dD, 0, d_size));
+    CHECK_HIP_ERROR(hipGraphLaunch(graphExec, stream));
+    CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+    CHECK_HIP_ERROR(hipMemcpy(hD.data(), dD, d_size, hipMemcpyDeviceToHost));
+    EXPECT_EQ(hD, hRef);
+
+    // two launches do not match a graph of one
+    hipsparseLtMatmulLaunch_t launches[2] = {launch, launch};
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulGraphUpdate(handle, launches, 2, stream, graphExec),
+                            HIPSPARSE_STATUS_INVALID_VALUE);
+
+    CHECK_HIP_ERROR(hipGraphExecDestroy(graphExec));
+
+    // a graph would keep a buffer of the arena which a later matmul may free, so a captured
+    // matmul which needs a workspace is refused one from the arena, also on the internal stream.
+    if(workspace_size != 0)
+    {
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtWorkspaceArenaSetEnabled(handle, 1),
+                                HIPSPARSE_STATUS_SUCCESS);
+        launch.workspace = nullptr;
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulGraphCreate(handle, &launch, 1, stream, &graphExec),
+            HIPSPARSE_STATUS_INVALID_VALUE);
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulGraphCreate(handle, &launch, 1, nullptr, &graphExec),
+            HIPSPARSE_STATUS_INVALID_VALUE);
+
+        CHECK_HIP_ERROR(hipStreamBeginCapture(stream, hipStreamCaptureModeGlobal));
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmul(handle, plan, &alpha, dA, dB, &beta, dC, dD, nullptr, &stream, 1),
+            HIPSPARSE_STATUS_INVALID_VALUE);
+        CHECK_HIP_ERROR(hipStreamEndCapture(stream, &graph));
+        CHECK_HIP_ERROR(hipGraphDestroy(graph));
+
+        // the same matmul outside of a capture takes the arena
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmul(handle, plan, &alpha, dA, dB, &beta, dC, dD, nullptr, &stream, 1),
+            HIPSPARSE_STATUS_SUCCESS);
+        CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtWorkspaceArenaSetEnabled(handle, 0),
+                                HIPSPARSE_STATUS_SUCCESS);
+    }
+
+    CHECK_HIP_ERROR(hipStreamDestroy(stream));
+}
+
 void testing_aux_get_workspace_size_bad_arg(const Arguments& arg)
 {
     const int64_t M = 128;
@@ -0,0 +1,75 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include "hipsparselt_bench_report.hpp"
+#include "hipsparselt_test.hpp"
+#include "utility.hpp"
+#include <hipsparselt/hipsparselt.h>
+#include <vector>
+
+/* ============================================================================================ */
+/*! \brief  Latency of creating and destroying a handle with hipsparseLtInit and
+ *          hipsparseLtDestroy. The first handle of the process queries the device, the
+ *          following ones take the cached device properties and environment configuration.
+ */
+template <typename Ti, typename To, typename Tc>
+void testing_init(const Arguments& arg)
+{
+    hipsparseLtHandle_t handle;
+
+    // the first handle of the process is not part of the hot calls
+    CHECK_HIPSPARSELT_ERROR(hipsparseLtInit(&handle));
+    CHECK_HIPSPARSELT_ERROR(hipsparseLtDestroy(&handle));
+
+    if(arg.timing)
+    {
+        int number_cold_calls = arg.cold_iters;
+        int number_hot_calls  = arg.iters < 1 ? 1 : arg.iters;
+
+        for(int i = 0; i < number_cold_calls; i++)
+        {
+            CHECK_HIPSPARSELT_ERROR(hipsparseLtInit(&handle));
+            CHECK_HIPSPARSELT_ERROR(hipsparseLtDestroy(&handle));
+        }
+
+        std::vector<double> iteration_us(number_hot_calls);
+        double              cpu_time_used = get_time_us_no_sync(); // in microseconds
+        for(int i = 0; i < number_hot_calls; i++)
+        {
+            iteration_us[i] = get_time_us_no_sync();
+            CHECK_HIPSPARSELT_ERROR(hipsparseLtInit(&handle));
+            CHECK_HIPSPARSELT_ERROR(hipsparseLtDestroy(&handle));
+            iteration_us[i] = get_time_us_no_sync() - iteration_us[i];
+        }
+        cpu_time_used = get_time_us_no_sync() - cpu_time_used;
+
+        hipsparselt_bench_set_iteration_us(std::move(iteration_us));
+        ArgumentModel<e_iters>{}.log_args<float>(
+            hipsparselt_cout, arg, cpu_time_used, ArgumentLogging::NA_value);
+    }
+}
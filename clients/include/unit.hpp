@@ -31,32 +31,15 @@
 
 #pragma once
 
+#include "compare.hpp"
 #include "hipsparselt_math.hpp"
 #include "hipsparselt_test.hpp"
 #include "hipsparselt_vector.hpp"
 #include <hipsparselt/hipsparselt.h>
 
 #ifndef GOOGLE_TEST
-#define UNIT_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, UNIT_ASSERT_EQ)
 #define UNIT_CHECK_B(M, N, lda, hCPU, hGPU, batch_count, UNIT_ASSERT_EQ)
 #else
-#define UNIT_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, UNIT_ASSERT_EQ)                  \
-    do                                                                                           \
-    {                                                                                            \
-        for(size_t k = 0; k < batch_count; k++)                                                  \
-            for(size_t j = 0; j < N; j++)                                                        \
-                for(size_t i = 0; i < M; i++)                                                    \
-                    if(hipsparselt_isnan(hCPU[i + j * size_t(lda) + k * strideA]))               \
-                    {                                                                            \
-                        ASSERT_TRUE(hipsparselt_isnan(hGPU[i + j * size_t(lda) + k * strideA])); \
-                    }                                                                            \
-                    else                                                                         \
-                    {                                                                            \
-                        UNIT_ASSERT_EQ(hCPU[i + j * size_t(lda) + k * strideA],                  \
-                                       hGPU[i + j * size_t(lda) + k * strideA]);                 \
-                    }                                                                            \
-    } while(0)
-
 #define UNIT_CHECK_B(M, N, lda, hCPU, hGPU, batch_count, UNIT_ASSERT_EQ)              \
     do                                                                                \
     {                                                                                 \
@@ -159,49 +142,49 @@ template <>
 inline void unit_check_general(
     int64_t M, int64_t N, int64_t lda, const hip_bfloat16* hCPU, const hip_bfloat16* hGPU)
 {
-    UNIT_CHECK(M, N, lda, 0, hCPU, hGPU, 1, ASSERT_BF16_EQ);
+    COMPARE_CHECK(M, N, lda, 0, hCPU, hGPU, 1, compare_rel_eq{0.1f});
 }
 
 template <>
 inline void unit_check_general<hip_bfloat16, float>(
     int64_t M, int64_t N, int64_t lda, const float* hCPU, const hip_bfloat16* hGPU)
 {
-    UNIT_CHECK(M, N, lda, 0, hCPU, hGPU, 1, ASSERT_FLOAT_BF16_EQ);
+    COMPARE_CHECK(M, N, lda, 0, hCPU, hGPU, 1, compare_float_bf16_eq{});
 }
 
 template <>
 inline void
     unit_check_general(int64_t M, int64_t N, int64_t lda, const __half* hCPU, const __half* hGPU)
 {
-    UNIT_CHECK(M, N, lda, 0, hCPU, hGPU, 1, ASSERT_HALF_EQ);
+    COMPARE_CHECK(M, N, lda, 0, hCPU, hGPU, 1, compare_rel_eq{0.01f});
 }
 
 template <>
 inline void
     unit_check_general(int64_t M, int64_t N, int64_t lda, const float* hCPU, const float* hGPU)
 {
-    UNIT_CHECK(M, N, lda, 0, hCPU, hGPU, 1, ASSERT_FLOAT_EQ);
+    COMPARE_CHECK(M, N, lda, 0, hCPU, hGPU, 1, compare_float_eq{});
 }
 
 template <>
 inline void
     unit_check_general(int64_t M, int64_t N, int64_t lda, const double* hCPU, const double* hGPU)
 {
-    UNIT_CHECK(M, N, lda, 0, hCPU, hGPU, 1, ASSERT_DOUBLE_EQ);
+    COMPARE_CHECK(M, N, lda, 0, hCPU, hGPU, 1, compare_float_eq{});
 }
 
 template <>
 inline void
     unit_check_general(int64_t M, int64_t N, int64_t lda, const int64_t* hCPU, const int64_t* hGPU)
 {
-    UNIT_CHECK(M, N, lda, 0, hCPU, hGPU, 1, ASSERT_EQ);
+    COMPARE_CHECK(M, N, lda, 0, hCPU, hGPU, 1, compare_eq{});
 }
 
 template <>
 inline void
     unit_check_general(int64_t M, int64_t N, int64_t lda, const int8_t* hCPU, const int8_t* hGPU)
 {
-    UNIT_CHECK(M, N, lda, 0, hCPU, hGPU, 1, ASSERT_EQ);
+    COMPARE_CHECK(M, N, lda, 0, hCPU, hGPU, 1, compare_eq{});
 }
 
 template <typename T, typename T_hpa = T>
@@ -222,7 +205,7 @@ inline void unit_check_general(int64_t             M,
                                const hip_bfloat16* hGPU,
                                int64_t             batch_count)
 {
-    UNIT_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, ASSERT_BF16_EQ);
+    COMPARE_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, compare_rel_eq{0.1f});
 }
 
 template <>
@@ -234,7 +217,7 @@ inline void unit_check_general<hip_bfloat16, float>(int64_t             M,
                                                     const hip_bfloat16* hGPU,
                                                     int64_t             batch_count)
 {
-    UNIT_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, ASSERT_FLOAT_BF16_EQ);
+    COMPARE_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, compare_float_bf16_eq{});
 }
 
 template <>
@@ -246,7 +229,7 @@ inline void unit_check_general(int64_t       M,
                                const __half* hGPU,
                                int64_t       batch_count)
 {
-    UNIT_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, ASSERT_HALF_EQ);
+    COMPARE_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, compare_rel_eq{0.01f});
 }
 
 template <>
@@ -258,7 +241,7 @@ inline void unit_check_general(int64_t      M,
                                const float* hGPU,
                                int64_t      batch_count)
 {
-    UNIT_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, ASSERT_FLOAT_EQ);
+    COMPARE_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, compare_float_eq{});
 }
 
 template <>
@@ -270,7 +253,7 @@ inline void unit_check_general(int64_t       M,
                                const double* hGPU,
                                int64_t       batch_count)
 {
-    UNIT_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, ASSERT_DOUBLE_EQ);
+    COMPARE_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, compare_float_eq{});
 }
 
 template <>
@@ -282,7 +265,7 @@ inline void unit_check_general(int64_t        M,
                                const int64_t* hGPU,
                                int64_t        batch_count)
 {
-    UNIT_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, ASSERT_EQ);
+    COMPARE_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, compare_eq{});
 }
 
 template <>
@@ -294,7 +277,7 @@ inline void unit_check_general(int64_t       M,
                                const int8_t* hGPU,
                                int64_t       batch_count)
 {
-    UNIT_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, ASSERT_EQ);
+    COMPARE_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, compare_eq{});
 }
 
 template <typename T, typename T_hpa = T>
@@ -485,25 +468,5 @@ template <typename T>
 inline int64_t unit_check_diff(
     int64_t M, int64_t N, int64_t lda, int64_t stride, T* hCPU, T* hGPU, int64_t batch_count)
 {
-    using c_type  = std::conditional_t<std::is_same<__half, T>::value, float, T>;
-    int64_t error = 0;
-    do
-    {
-        for(size_t k = 0; k < batch_count; k++)
-            for(size_t j = 0; j < N; j++)
-                for(size_t i = 0; i < M; i++)
-                    if(hipsparselt_isnan(hCPU[i + j * size_t(lda) + k * stride]))
-                    {
-                        error += hipsparselt_isnan(hGPU[i + j * size_t(lda) + k * stride]) ? 0 : 1;
-                    }
-                    else
-                    {
-                        error += static_cast<c_type>(hCPU[i + j * size_t(lda) + k * stride])
-                                         == static_cast<c_type>(
-                                             hGPU[i + j * size_t(lda) + k * stride])
-                                     ? 0
-                                     : 1;
-                    }
-    } while(0);
-    return error;
+    return compare_general(M, N, lda, stride, hCPU, hGPU, batch_count, compare_eq{}, 0).mismatches;
 }
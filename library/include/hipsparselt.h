@@ -139,6 +139,15 @@ typedef struct hipsparseLtMatmulAlgSelection_t {uint8_t data[11024];} hipsparseL
  *  and \ref hipsparseLtMatmulPlanDestroy functions respectively.
  */
 typedef struct hipsparseLtMatmulPlan_t {uint8_t data[11024];} hipsparseLtMatmulPlan_t;
+
+/*! \ingroup types_module
+ *  \brief Token of an asynchronous call.
+ *
+ *  \details
+ *  The hipSPARSELt asynchronous token tracks a call queued by \ref hipsparseLtMatmulAlgSelectionInitAsync
+ *  or \ref hipsparseLtMatmulPlanInitAsync. It must be released with \ref hipsparseLtAsyncTokenWait.
+ */
+typedef struct hipsparseLtAsyncToken_t {uint8_t data[64];} hipsparseLtAsyncToken_t;
 #elif defined(__HIP_PLATFORM_NVIDIA__)
 typedef __nv_bfloat16 hip_bfloat16;
 typedef struct {uint8_t data[11024];} hipsparseLtHandle_t;
@@ -146,6 +155,7 @@ typedef struct {uint8_t data[11024];} hipsparseLtMatDescriptor_t;
 typedef struct {uint8_t data[11024];} hipsparseLtMatmulDescriptor_t;
 typedef struct {uint8_t data[11024];} hipsparseLtMatmulAlgSelection_t;
 typedef struct {uint8_t data[11024];} hipsparseLtMatmulPlan_t;
+typedef struct {uint8_t data[64];} hipsparseLtAsyncToken_t;
 #endif
 
 
@@ -235,6 +245,13 @@ typedef enum {
                                                             When Input's datatype is FP16 - Bias type can be FP16 or FP32. (default FP16)
                                                             When Input's datatype is BF16 - Bias type can be BF16 or FP32. (default BF16)
                                                             In other cases - Bias type is FP32.*/
+   HIPSPARSELT_MATMUL_OUTPUT_SCALE_POINTER = 17,       /**< Per row (output channel) scales of the output quantization. HIP backend only,
+                                                            a device vector of m floats, D = saturate(scale * result + zero point) per row.
+                                                            It needs an INT8 input and an INT8 or FP16 output. The scales apply to the FP32
+                                                            result of the matmul, which is computed by a single kernel without workspace,
+                                                            so it must be set before hipsparseLtMatmulAlgSelectionInit.*/
+   HIPSPARSELT_MATMUL_OUTPUT_ZERO_POINT_POINTER = 18,  /**< Per row zero points of the output quantization. HIP backend only,
+                                                            a device vector of m floats, NULL means 0.*/
 } hipsparseLtMatmulDescAttribute_t;
 
 /*! \ingroup types_module
@@ -285,6 +302,84 @@ typedef enum {
    HIPSPARSELT_SPLIT_K_MODE_TWO_KERNELS = 1, /**< Use another kernel to do the final reduction */
 } hipsparseLtSplitKMode_t;
 
+/*! \ingroup types_module
+ *  \brief Specify the dimension along which a matrix multiplication is split into shards.
+ *
+ *  \details
+ *  The \ref hipsparseLtShardDim_t is used in the \ref hipsparseLtMatmulSharded function.
+ */
+typedef enum {
+   HIPSPARSELT_SHARD_DIM_N     = 0, /**< Each shard computes a block of columns of D. */
+   HIPSPARSELT_SHARD_DIM_BATCH = 1, /**< Each shard computes a range of batches of D. */
+} hipsparseLtShardDim_t;
+
+/*! \ingroup types_module
+ *  \brief Statistics of the workspace arena owned by a handle.
+ *
+ *  \details
+ *  The \ref hipsparseLtWorkspaceArenaStats_t is used in the \ref hipsparseLtWorkspaceArenaGetStats function.
+ */
+typedef struct {
+   size_t  currentBytes;   /**< bytes of device memory currently held by the arena. */
+   size_t  highWaterBytes; /**< largest value of currentBytes. */
+   int64_t growEvents;     /**< number of times a per-stream buffer was allocated or grown. */
+   int64_t requests;       /**< number of workspaces handed out by the arena. */
+   int     numStreams;     /**< number of streams owning a buffer. */
+} hipsparseLtWorkspaceArenaStats_t;
+
+/*! \ingroup types_module
+ *  \brief Device memory held by the library for a handle.
+ *
+ *  \details
+ *  The code objects are loaded once per device and shared by all handles on that device.
+ *  They are not accounted with the Tensile backend, moduleBytes, modules and livePlans are then 0
+ *  and modulesAccounted is 0.
+ *  The \ref hipsparseLtDeviceMemoryUsage_t is used in the \ref hipsparseLtGetDeviceMemoryUsage function.
+ */
+typedef struct {
+   size_t moduleBytes;         /**< bytes of the code objects loaded on the device of the handle. */
+   size_t workspaceArenaBytes; /**< bytes held by the workspace arena of the handle. */
+   size_t totalBytes;          /**< moduleBytes + workspaceArenaBytes. */
+   int    modules;             /**< number of code objects loaded on the device of the handle. */
+   int    livePlans;           /**< number of plans on the device which keep their code objects loaded. */
+   int    modulesAccounted;    /**< 1 when the code objects are accounted, 0 otherwise. */
+} hipsparseLtDeviceMemoryUsage_t;
+
+/*! \ingroup types_module
+ *  \brief One matrix multiplication of a batched plan execution.
+ *
+ *  \details
+ *  The \ref hipsparseLtMatmulLaunch_t is used in the \ref hipsparseLtMatmulMultiple function.
+ *  The fields are the arguments of the same name of \ref hipsparseLtMatmul.
+ */
+typedef struct {
+   const hipsparseLtMatmulPlan_t* plan;
+   const void*                    alpha;
+   const void*                    d_A;
+   const void*                    d_B;
+   const void*                    beta;
+   const void*                    d_C;
+   void*                          d_D;
+   void*                          workspace;
+} hipsparseLtMatmulLaunch_t;
+
+/*! \ingroup types_module
+ *  \brief Runtime statistics of a matrix multiplication plan.
+ *
+ *  \details
+ *  The \ref hipsparseLtMatmulPlanStats_t is used in the \ref hipsparseLtMatmulPlanGetStats function.
+ *  Bucket 0 of a histogram counts the calls shorter than 1 us, bucket i > 0 counts the calls in
+ *  [2^(i-1), 2^i) us and the last bucket also counts all longer calls.
+ */
+typedef struct {
+   int64_t calls;              /**< number of matmuls run with the plan. */
+   int64_t hostTimeNs;         /**< total host time of the calls. */
+   int64_t hostHistogram[32];  /**< histogram of the host time of the calls. */
+   int64_t gpuSamples;         /**< number of calls timed on the GPU. */
+   int64_t gpuTimeNs;          /**< total GPU time of the sampled calls. */
+   int64_t gpuHistogram[32];   /**< histogram of the GPU time of the sampled calls. */
+} hipsparseLtMatmulPlanStats_t;
+
 // clang-format on
 
 #ifdef __cplusplus
@@ -376,6 +471,90 @@ hipsparseStatus_t hipsparseLtInit(hipsparseLtHandle_t* handle);
 HIPSPARSELT_EXPORT
 hipsparseStatus_t hipsparseLtDestroy(const hipsparseLtHandle_t* handle);
 
+/*! \ingroup library_module
+ *  \brief Enable or disable the workspace arena of a hipsparselt handle
+ *
+ *  \details
+ *  When the arena is enabled, \ref hipsparseLtMatmul and \ref hipsparseLtMatmulSearch
+ *  called with a NULL workspace take the workspace from device memory owned by the
+ *  handle. The handle keeps one buffer per stream, reuses it for every plan executed
+ *  on that stream and grows it geometrically, so no allocation happens once the
+ *  largest workspace has been seen. Disabling the arena or \ref hipsparseLtDestroy
+ *  releases the buffers, matmuls running on other threads keep the arena they took
+ *  until they return. A matmul on a captured stream does not use the arena, see
+ *  \ref hipsparseLtMatmulGraphCreate. Setting the environment variable
+ *  HIPSPARSELT_WORKSPACE_ARENA=1 enables the arena of every new handle. HIP backend only.
+ *
+ *  @param[in]
+ *  handle  hipsparselt library handle
+ *  @param[in]
+ *  enable  1 to enable the arena, 0 to disable it.
+ *
+ *  \retval HIPSPARSE_STATUS_SUCCESS the operation completed successfully.
+ *  \retval HIPSPARSE_STATUS_INVALID_VALUE \p handle is invalid.
+ *  \retval HIPSPARSE_STATUS_NOT_SUPPORTED the backend does not support the arena.
+ */
+HIPSPARSELT_EXPORT
+hipsparseStatus_t hipsparseLtWorkspaceArenaSetEnabled(const hipsparseLtHandle_t* handle,
+                                                      int                        enable);
+
+/*! \ingroup library_module
+ *  \brief Retrieve the statistics of the workspace arena of a hipsparselt handle
+ *
+ *  @param[in]
+ *  handle  hipsparselt library handle
+ *  @param[out]
+ *  stats   arena statistics, all zero when the arena is disabled.
+ *
+ *  \retval HIPSPARSE_STATUS_SUCCESS the operation completed successfully.
+ *  \retval HIPSPARSE_STATUS_INVALID_VALUE \p handle or \p stats is invalid.
+ *  \retval HIPSPARSE_STATUS_NOT_SUPPORTED the backend does not support the arena.
+ */
+HIPSPARSELT_EXPORT
+hipsparseStatus_t hipsparseLtWorkspaceArenaGetStats(const hipsparseLtHandle_t*        handle,
+                                                    hipsparseLtWorkspaceArenaStats_t* stats);
+
+/*! \ingroup library_module
+ *  \brief Retrieve the device memory held by the library for a hipsparselt handle
+ *
+ *  \details
+ *  The module bytes count the code objects loaded on the device of the handle, which
+ *  all handles on that device share, and the arena bytes the workspace arena of the handle.
+ *  The code objects of the Tensile backend are not accounted, see modulesAccounted.
+ *
+ *  @param[in]
+ *  handle  hipsparselt library handle
+ *  @param[out]
+ *  usage   bytes held by the code objects and the workspace arena.
+ *
+ *  \retval HIPSPARSE_STATUS_SUCCESS the operation completed successfully.
+ *  \retval HIPSPARSE_STATUS_INVALID_VALUE \p handle or \p usage is invalid.
+ */
+HIPSPARSELT_EXPORT
+hipsparseStatus_t hipsparseLtGetDeviceMemoryUsage(const hipsparseLtHandle_t*      handle,
+                                                  hipsparseLtDeviceMemoryUsage_t* usage);
+
+/*! \ingroup library_module
+ *  \brief Unload the code objects which are not used by any live plan
+ *
+ *  \details
+ *  The code objects of the device of the handle whose kernels are not used by an
+ *  initialized plan are unloaded, after a synchronization of the device. They are
+ *  loaded again by the next hipsparseLtMatmul which needs them.
+ *
+ *  @param[in]
+ *  handle      hipsparselt library handle
+ *  @param[out]
+ *  freedBytes  bytes of the unloaded code objects, may be NULL.
+ *
+ *  \retval HIPSPARSE_STATUS_SUCCESS the operation completed successfully.
+ *  \retval HIPSPARSE_STATUS_INVALID_VALUE \p handle is invalid.
+ *  \retval HIPSPARSE_STATUS_NOT_SUPPORTED the backend, e.g. Tensile, does not support the unload.
+ */
+HIPSPARSELT_EXPORT
+hipsparseStatus_t hipsparseLtUnloadUnusedModules(const hipsparseLtHandle_t* handle,
+                                                 size_t*                    freedBytes);
+
 /* matrix descriptor */
 /*! \ingroup matrix_desc_module
  *  \brief Create a descriptor for dense matrix
@@ -775,6 +954,165 @@ hipsparseStatus_t hipsparseLtMatmulPlanInit(const hipsparseLtHandle_t*
 HIPSPARSELT_EXPORT
 hipsparseStatus_t hipsparseLtMatmulPlanDestroy(const hipsparseLtMatmulPlan_t* plan);
 
+/*! \ingroup matmul_module
+ *  \brief Set the GPU time sampling interval of a matrix multiplication plan
+ *  \details
+ *  Every \ref hipsparseLtMatmul call with \p plan is counted and its host time is added to
+ *  the statistics of the plan. When \p interval is greater than 0, every \p interval-th call
+ *  is also timed on the GPU with a pair of events. The events are read back by a later sample
+ *  or by \ref hipsparseLtMatmulPlanGetStats, a call is never blocked on them.
+ *  The initial interval is HIPSPARSELT_PLAN_STATS_SAMPLING (default 0).
+ *
+ *  @param[in]
+ *  handle      hipsparselt library handle
+ *  @param[in]
+ *  plan        the matrix multiplication plan descriptor
+ *  @param[in]
+ *  interval    sampling interval, 0 disables the GPU timing.
+ *
+ *  \retval HIPSPARSE_STATUS_SUCCESS the operation completed successfully.
+ *  \retval HIPSPARSE_STATUS_INVALID_VALUE \p handle, \p plan or \p interval is invalid.
+ *  \retval HIPSPARSE_STATUS_NOT_SUPPORTED the backend does not support plan statistics.
+ */
+HIPSPARSELT_EXPORT
+hipsparseStatus_t hipsparseLtMatmulPlanSetStatsSampling(const hipsparseLtHandle_t*     handle,
+                                                        const hipsparseLtMatmulPlan_t* plan,
+                                                        int32_t                        interval);
+
+/*! \ingroup matmul_module
+ *  \brief Retrieve the runtime statistics of a matrix multiplication plan
+ *
+ *  @param[in]
+ *  handle  hipsparselt library handle
+ *  @param[in]
+ *  plan    the matrix multiplication plan descriptor
+ *  @param[out]
+ *  stats   statistics of \p plan.
+ *
+ *  \retval HIPSPARSE_STATUS_SUCCESS the operation completed successfully.
+ *  \retval HIPSPARSE_STATUS_INVALID_VALUE \p handle, \p plan or \p stats is invalid.
+ *  \retval HIPSPARSE_STATUS_NOT_SUPPORTED the backend does not support plan statistics.
+ */
+HIPSPARSELT_EXPORT
+hipsparseStatus_t hipsparseLtMatmulPlanGetStats(const hipsparseLtHandle_t*     handle,
+                                                const hipsparseLtMatmulPlan_t* plan,
+                                                hipsparseLtMatmulPlanStats_t*  stats);
+
+/*! \ingroup matmul_module
+ *  \brief Reset the runtime statistics of a matrix multiplication plan
+ *
+ *  @param[in]
+ *  handle  hipsparselt library handle
+ *  @param[in]
+ *  plan    the matrix multiplication plan descriptor
+ *
+ *  \retval HIPSPARSE_STATUS_SUCCESS the operation completed successfully.
+ *  \retval HIPSPARSE_STATUS_INVALID_VALUE \p handle or \p plan is invalid.
+ *  \retval HIPSPARSE_STATUS_NOT_SUPPORTED the backend does not support plan statistics.
+ */
+HIPSPARSELT_EXPORT
+hipsparseStatus_t hipsparseLtMatmulPlanResetStats(const hipsparseLtHandle_t*     handle,
+                                                  const hipsparseLtMatmulPlan_t* plan);
+
+/*! \ingroup matmul_module
+ *  \brief Initializes the algorithm selection descriptor asynchronously
+ *  \details
+ *  \p hipsparseLtMatmulAlgSelectionInitAsync queues \ref hipsparseLtMatmulAlgSelectionInit
+ *  on an internal thread pool and returns immediately, so that creating the descriptors
+ *  of many layers, including their code object loading, overlaps with other work such as
+ *  weight upload. The number of worker threads is set by HIPSPARSELT_ASYNC_THREADS.
+ *  \p handle, \p algSelection and \p matmulDescr must stay valid until \p token is waited.
+ *
+ *  @param[in]
+ *  handle           the hipsparselt handle
+ *  @param[out]
+ *  algSelection     the pointer to the algorithm selection descriptor
+ *  @param[in]
+ *  matmulDescr      the matrix multiplication descriptor
+ *  @param[in]
+ *  alg              the algorithm used to do the matrix multiplication.
+ *  @param[out]
+ *  token            the token of the queued call, see \ref hipsparseLtAsyncTokenWait.
+ *
+ *  \retval HIPSPARSE_STATUS_SUCCESS the call was queued.
+ *  \retval HIPSPARSE_STATUS_INVALID_VALUE \p handle or \p token is invalid.
+ *  \retval HIPSPARSE_STATUS_NOT_SUPPORTED the function is not supported on this platform.
+ */
+HIPSPARSELT_EXPORT
+hipsparseStatus_t
+    hipsparseLtMatmulAlgSelectionInitAsync(const hipsparseLtHandle_t*           handle,
+                                           hipsparseLtMatmulAlgSelection_t*     algSelection,
+                                           const hipsparseLtMatmulDescriptor_t* matmulDescr,
+                                           hipsparseLtMatmulAlg_t               alg,
+                                           hipsparseLtAsyncToken_t*             token);
+
+/*! \ingroup matmul_module
+ *  \brief Initializes the matrix multiplication plan descriptor asynchronously
+ *  \details
+ *  \p hipsparseLtMatmulPlanInitAsync queues \ref hipsparseLtMatmulPlanInit on the
+ *  internal thread pool. When \p algSelectionToken is not NULL, the plan is initialized
+ *  after the call tracked by \p algSelectionToken has completed, so that the whole chain
+ *  of a layer can be queued at once. \p algSelectionToken still has to be waited.
+ *
+ *  @param[in]
+ *  handle             hipsparselt library handle
+ *  @param[out]
+ *  plan               the matrix multiplication plan descriptor
+ *  @param[in]
+ *  matmulDescr        the matrix multiplication descriptor
+ *  @param[in]
+ *  algSelection       the algorithm selection descriptor
+ *  @param[in]
+ *  algSelectionToken  token of \ref hipsparseLtMatmulAlgSelectionInitAsync, can be NULL.
+ *  @param[out]
+ *  token              the token of the queued call, see \ref hipsparseLtAsyncTokenWait.
+ *
+ *  \retval HIPSPARSE_STATUS_SUCCESS the call was queued.
+ *  \retval HIPSPARSE_STATUS_INVALID_VALUE \p handle, \p algSelectionToken or \p token is invalid.
+ *  \retval HIPSPARSE_STATUS_NOT_SUPPORTED the function is not supported on this platform.
+ */
+HIPSPARSELT_EXPORT
+hipsparseStatus_t
+    hipsparseLtMatmulPlanInitAsync(const hipsparseLtHandle_t*             handle,
+                                   hipsparseLtMatmulPlan_t*               plan,
+                                   const hipsparseLtMatmulDescriptor_t*   matmulDescr,
+                                   const hipsparseLtMatmulAlgSelection_t* algSelection,
+                                   const hipsparseLtAsyncToken_t*         algSelectionToken,
+                                   hipsparseLtAsyncToken_t*               token);
+
+/*! \ingroup matmul_module
+ *  \brief Query an asynchronous call
+ *  \details
+ *  \p hipsparseLtAsyncTokenQuery checks without blocking whether the call tracked by
+ *  \p token has completed.
+ *
+ *  @param[in]
+ *  token   the token of the asynchronous call.
+ *  @param[out]
+ *  done    1 if the call has completed, 0 otherwise.
+ *
+ *  \retval HIPSPARSE_STATUS_SUCCESS the operation completed successfully.
+ *  \retval HIPSPARSE_STATUS_INVALID_VALUE \p token or \p done is invalid.
+ *  \retval HIPSPARSE_STATUS_NOT_SUPPORTED the function is not supported on this platform.
+ */
+HIPSPARSELT_EXPORT
+hipsparseStatus_t hipsparseLtAsyncTokenQuery(const hipsparseLtAsyncToken_t* token, int* done);
+
+/*! \ingroup matmul_module
+ *  \brief Wait an asynchronous call
+ *  \details
+ *  \p hipsparseLtAsyncTokenWait blocks until the call tracked by \p token has completed,
+ *  releases \p token and returns the status of that call.
+ *
+ *  @param[in]
+ *  token   the token of the asynchronous call.
+ *
+ *  \retval HIPSPARSE_STATUS_INVALID_VALUE \p token is invalid.
+ *  \retval other the status returned by the asynchronous call.
+ */
+HIPSPARSELT_EXPORT
+hipsparseStatus_t hipsparseLtAsyncTokenWait(hipsparseLtAsyncToken_t* token);
+
 /* matmul execution */
 /*! \ingroup matmul_module
  *  \brief Sparse matrix dense matrix multiplication
@@ -901,6 +1239,220 @@ hipsparseStatus_t hipsparseLtMatmulSearch(const hipsparseLtHandle_t* handle,
                                           hipStream_t*               streams,
                                           int32_t                    numStreams);
 
+/*! \ingroup matmul_module
+ *  \brief Execute a list of sparse matrix dense matrix multiplications
+ *
+ *  \details
+ *  \p hipsparseLtMatmulMultiple runs the matrix multiplications of \p launches in order,
+ *  like a sequence of hipsparseLtMatmul() calls. All arguments are validated before the
+ *  first kernel is launched, then the kernels are launched back to back, which reduces
+ *  the host overhead of a chain of small matmuls.
+ *  The i-th matmul runs on \p streams[i % numStreams]; only the matmuls on the same
+ *  stream are ordered.
+ *
+ *  \note
+ *  This function is non blocking and executed asynchronously with respect to the host.
+ *
+ *  @param[in]
+ *  handle      hipsparselt library handle
+ *  @param[in]
+ *  launches    array of \p numLaunches matmuls.
+ *  @param[in]
+ *  numLaunches number of matmuls in \p launches.
+ *  @param[in]
+ *  streams     Pointer to HIP stream array for the computation
+ *  @param[in]
+ *  numStreams  Number of HIP streams in \p streams
+ *
+ *  \retval     HIPSPARSE_STATUS_SUCCESS the operation completed successfully.
+ *  \retval     HIPSPARSE_STATUS_INVALID_VALUE \p handle, \p launches, \p numLaunches, \p streams, \p numStreams or a field of a launch is invalid.
+ *  \retval     HIPSPARSE_STATUS_NOT_SUPPORTED the problme is not supported.
+ */
+HIPSPARSELT_EXPORT
+hipsparseStatus_t hipsparseLtMatmulMultiple(const hipsparseLtHandle_t*       handle,
+                                            const hipsparseLtMatmulLaunch_t* launches,
+                                            int32_t                          numLaunches,
+                                            hipStream_t*                     streams,
+                                            int32_t                          numStreams);
+
+/*! \ingroup matmul_module
+ *  \brief Record a list of sparse matrix dense matrix multiplications into a HIP graph
+ *
+ *  \details
+ *  \p hipsparseLtMatmulGraphCreate captures hipsparseLtMatmulMultiple() of \p launches on
+ *  \p stream and instantiates the graph, which replays the matmuls with hipGraphLaunch()
+ *  for the host cost of a single launch. The kernels are recorded, not run.
+ *  hipsparseLtMatmul() does not synchronize, load a module or allocate while its stream
+ *  is captured, so it may also be called inside a capture of the caller. The code objects
+ *  of a plan are loaded before its first matmul: by the plan init with the built-in
+ *  kernels, and all at once by the first algorithm selection of a device with Tensile.
+ *  A graph keeps the workspace pointers it was captured with, while a buffer of the
+ *  workspace arena is freed when it grows. A captured matmul therefore never takes its
+ *  workspace from the arena: when the plan needs a workspace, each launch must pass its
+ *  own, which the caller keeps alive as long as the graph, or the call fails with
+ *  HIPSPARSE_STATUS_INVALID_VALUE.
+ *
+ *  @param[in]
+ *  handle      hipsparselt library handle
+ *  @param[in]
+ *  launches    array of \p numLaunches matmuls.
+ *  @param[in]
+ *  numLaunches number of matmuls in \p launches.
+ *  @param[in]
+ *  stream      HIP stream of the capture, or NULL to capture on an internal stream.
+ *  @param[out]
+ *  graphExec   the executable graph, destroyed with hipGraphExecDestroy().
+ *
+ *  \retval     HIPSPARSE_STATUS_SUCCESS the operation completed successfully.
+ *  \retval     HIPSPARSE_STATUS_INVALID_VALUE \p handle, \p launches, \p numLaunches, \p graphExec or a field of a launch is invalid, or a launch which needs a workspace passes NULL.
+ *  \retval     HIPSPARSE_STATUS_NOT_SUPPORTED the problme is not supported.
+ */
+HIPSPARSELT_EXPORT
+hipsparseStatus_t hipsparseLtMatmulGraphCreate(const hipsparseLtHandle_t*       handle,
+                                               const hipsparseLtMatmulLaunch_t* launches,
+                                               int32_t                          numLaunches,
+                                               hipStream_t                      stream,
+                                               hipGraphExec_t*                  graphExec);
+
+/*! \ingroup matmul_module
+ *  \brief Update the pointers of a graph of sparse matrix dense matrix multiplications
+ *
+ *  \details
+ *  \p hipsparseLtMatmulGraphUpdate captures \p launches again and updates the kernel
+ *  arguments of \p graphExec in place. The launches must use the same plans, in the same
+ *  order, as the ones the graph was created with; the pointers and the values of alpha
+ *  and beta may change.
+ *
+ *  @param[in]
+ *  handle      hipsparselt library handle
+ *  @param[in]
+ *  launches    array of \p numLaunches matmuls.
+ *  @param[in]
+ *  numLaunches number of matmuls in \p launches.
+ *  @param[in]
+ *  stream      HIP stream of the capture, or NULL to capture on an internal stream.
+ *  @param[in]
+ *  graphExec   graph created by hipsparseLtMatmulGraphCreate().
+ *
+ *  \retval     HIPSPARSE_STATUS_SUCCESS the operation completed successfully.
+ *  \retval     HIPSPARSE_STATUS_INVALID_VALUE an argument is invalid or the launches do not match the graph.
+ */
+HIPSPARSELT_EXPORT
+hipsparseStatus_t hipsparseLtMatmulGraphUpdate(const hipsparseLtHandle_t*       handle,
+                                               const hipsparseLtMatmulLaunch_t* launches,
+                                               int32_t                          numLaunches,
+                                               hipStream_t                      stream,
+                                               hipGraphExec_t                   graphExec);
+
+/*! \ingroup matmul_module
+ *  \brief Partition a matrix multiplication into shards.
+ *
+ *  \details
+ *  \p hipsparseLtMatmulShardPartition splits \p extent (the number of columns or batches
+ *  of D) into \p numShards contiguous ranges whose sizes are proportional to \p weights,
+ *  e.g. the multiProcessorCount of the device running each shard. Every range starts at
+ *  a multiple of \p granularity. A shard with weight 0 gets an empty range.
+ *  The ranges are used to create one plan per shard for \ref hipsparseLtMatmulSharded.
+ *
+ *  \note
+ *  This function only runs on the host.
+ *
+ *  @param[in]
+ *  numShards   number of shards.
+ *  @param[in]
+ *  weights     array of \p numShards non-negative weights, not all 0.
+ *  @param[in]
+ *  extent      total extent to be split.
+ *  @param[in]
+ *  granularity size that every shard offset is a multiple of.
+ *  @param[out]
+ *  offsets     array of \p numShards first index of each shard.
+ *  @param[out]
+ *  sizes       array of \p numShards extent of each shard.
+ *
+ *  \retval     HIPSPARSE_STATUS_SUCCESS the operation completed successfully.
+ *  \retval     HIPSPARSE_STATUS_INVALID_VALUE \p numShards, \p weights, \p extent, \p granularity, \p offsets or \p sizes is invalid.
+ *  \retval     HIPSPARSE_STATUS_NOT_SUPPORTED the function is not supported on this platform.
+ */
+HIPSPARSELT_EXPORT
+hipsparseStatus_t hipsparseLtMatmulShardPartition(int        numShards,
+                                                  const int* weights,
+                                                  int64_t    extent,
+                                                  int64_t    granularity,
+                                                  int64_t*   offsets,
+                                                  int64_t*   sizes);
+
+/*! \ingroup matmul_module
+ *  \brief Sparse matrix dense matrix multiplication split across handles
+ *
+ *  \details
+ *  \p hipsparseLtMatmulSharded runs one \ref hipsparseLtMatmul per shard, each one on the
+ *  device of its handle and on its own stream, so that the shards execute concurrently.
+ *  The plan of shard i must be created on \p handles[i] and describe only that shard,
+ *  i.e. a block of columns (\ref HIPSPARSELT_SHARD_DIM_N) or a range of batches
+ *  (\ref HIPSPARSELT_SHARD_DIM_BATCH) of D. A shard whose plan is NULL is skipped.
+ *
+ *  When \p d_gather is not NULL, D of every shard is copied into \p d_gather, which is
+ *  described by \p gatherDescr and lives on the device of \p handles[0]. The copies are
+ *  ordered after each shard and are issued on \p streams[0]. The device of \p handles[0]
+ *  is given peer access to the devices of the other shards before any shard runs, and
+ *  HIPSPARSE_STATUS_NOT_SUPPORTED is returned when one of them is not a peer.
+ *
+ *  \note
+ *  This function is non blocking and executed asynchronously with respect to the host.
+ *
+ *  \note
+ *  \p alpha and \p beta must be host pointers.
+ *
+ *  @param[in]
+ *  handles     array of \p numShards hipsparselt library handles
+ *  @param[in]
+ *  plans       array of \p numShards matrix multiplication plans
+ *  @param[in]
+ *  numShards   number of shards
+ *  @param[in]
+ *  dim         dimension along which the shards are split
+ *  @param[in]
+ *  alpha       scalar \f$\alpha\f$. (float)
+ *  @param[in]
+ *  d_A         array of \p numShards pointers to the matrix A of each shard
+ *  @param[in]
+ *  d_B         array of \p numShards pointers to the matrix B of each shard
+ *  @param[in]
+ *  beta        scalar \f$\beta\f$. (float)
+ *  @param[in]
+ *  d_C         array of \p numShards pointers to the matrix C of each shard
+ *  @param[out]
+ *  d_D         array of \p numShards pointers to the matrix D of each shard
+ *  @param[in]
+ *  workspaces  array of \p numShards workspaces, can be NULL
+ *  @param[in]
+ *  streams     array of \p numShards HIP streams, can be NULL
+ *  @param[in]
+ *  gatherDescr matrix descriptor of \p d_gather created on \p handles[0]
+ *  @param[out]
+ *  d_gather    Pointer to the gathered matrix D, can be NULL
+ *
+ *  \retval     HIPSPARSE_STATUS_SUCCESS the operation completed successfully.
+ *  \retval     HIPSPARSE_STATUS_INVALID_VALUE \p handles, \p plans, \p numShards, \p dim, the matrix pointers or \p gatherDescr is invalid.
+ *  \retval     HIPSPARSE_STATUS_NOT_SUPPORTED the problme is not supported.
+ */
+HIPSPARSELT_EXPORT
+hipsparseStatus_t hipsparseLtMatmulSharded(const hipsparseLtHandle_t* const*     handles,
+                                           const hipsparseLtMatmulPlan_t* const* plans,
+                                           int                                   numShards,
+                                           hipsparseLtShardDim_t                 dim,
+                                           const void*                           alpha,
+                                           const void* const*                    d_A,
+                                           const void* const*                    d_B,
+                                           const void*                           beta,
+                                           const void* const*                    d_C,
+                                           void* const*                          d_D,
+                                           void* const*                          workspaces,
+                                           hipStream_t*                          streams,
+                                           const hipsparseLtMatDescriptor_t*     gatherDescr,
+                                           void*                                 d_gather);
+
 /* helper */
 // prune
 /*! \ingroup helper_module
@@ -1013,6 +1565,52 @@ hipsparseStatus_t hipsparseLtSpMMAPrune2(const hipsparseLtHandle_t*        handl
                                          hipsparseLtPruneAlg_t             pruneAlg,
                                          hipStream_t                       stream);
 
+/*! \ingroup helper_module
+ *  \brief Purnes the dirty tiles of a dense matrix.
+ *
+ *  \details
+ *  \p hipsparseLtSpMMAPruneTiles works like \ref hipsparseLtSpMMAPrune2 but only
+ *  the tiles whose bit is set in \p d_tileMask are pruned, the other tiles of d_out
+ *  are left untouched. Use \ref hipsparseLtSpMMATileMaskSize to get the tile size
+ *  and the size of the bitmap.
+ *
+ *  \note
+ *  This function supports asynchronous execution with respect to stream.
+ *
+ *  @param[in]
+ *  handle         hipsparselt library handle
+ *  @param[in]
+ *  sparseMatDescr structured(sparse) matrix descriptor.
+ *  @param[in]
+ *  isSparseA      specify if the structured (sparse) matrix is in the first position (matA or matB) (Currently, only support matA)
+ *  @param[in]
+ *  op             operation that will be applied to the structured (sparse) matrix in the multiplication
+ *  @param[in]
+ *  d_in           pointer to the dense matrix.
+ *  @param[out]
+ *  d_out          pointer to the pruned matrix.
+ *  @param[in]
+ *  pruneAlg       pruning algorithm.
+ *  @param[in]
+ *  d_tileMask     device pointer to the dirty tile bitmap.
+ *  @param[in]
+ *  stream         HIP stream for the computation.
+ *
+ *  \retval     HIPSPARSE_STATUS_SUCCESS the operation completed successfully.
+ *  \retval     HIPSPARSE_STATUS_INVALID_VALUE \p handle , \p sparseMatDescr , \p op , \p d_in , \p d_out or \p d_tileMask is invalid.
+ *  \retval     HIPSPARSE_STATUS_NOT_SUPPORTED the problem is not support
+ */
+HIPSPARSELT_EXPORT
+hipsparseStatus_t hipsparseLtSpMMAPruneTiles(const hipsparseLtHandle_t*        handle,
+                                             const hipsparseLtMatDescriptor_t* sparseMatDescr,
+                                             int                               isSparseA,
+                                             hipsparseOperation_t              op,
+                                             const void*                       d_in,
+                                             void*                             d_out,
+                                             hipsparseLtPruneAlg_t             pruneAlg,
+                                             const void*                       d_tileMask,
+                                             hipStream_t                       stream);
+
 /*! \ingroup helper_module
  *  \brief checks the correctness of the pruning structure for a given matrix.
  *
@@ -1172,6 +1770,79 @@ hipsparseStatus_t hipsparseLtSpMMACompress2(const hipsparseLtHandle_t*        ha
                                             void*                             d_compressBuffer,
                                             hipStream_t                       stream);
 
+/*! \ingroup helper_module
+ *  \brief provide the size of the dirty tile bitmap.
+ *
+ *  \details
+ *  \p hipsparseLtSpMMATileMaskSize provides the tile size and the size of the bitmap
+ *  to be allocated before calling \ref hipsparseLtSpMMAPruneTiles or
+ *  \ref hipsparseLtSpMMACompressTiles. One bit covers a tileSize x tileSize tile of
+ *  the column major matrix described by \p sparseMatDescr, the tiles are numbered
+ *  row_tile + col_tile * tiles_row + batch * tiles_row * tiles_col, where
+ *  tiles_row = ceil(rows / tileSize) and tiles_col = ceil(cols / tileSize), and
+ *  bit i lives in byte i / 8 at position i % 8.
+ *
+ *  @param[in]
+ *  handle         hipsparselt library handle
+ *  @param[in]
+ *  sparseMatDescr structured(sparse) matrix descriptor.
+ *  @param[out]
+ *  tileSize       number of rows and columns covered by one bit.
+ *  @param[out]
+ *  tileMaskSize   size in bytes of the bitmap.
+ *
+ *  \retval     HIPSPARSE_STATUS_SUCCESS the operation completed successfully.
+ *  \retval     HIPSPARSE_STATUS_INVALID_VALUE \p handle , \p sparseMatDescr , \p tileSize or \p tileMaskSize is invalid.
+ */
+HIPSPARSELT_EXPORT
+hipsparseStatus_t hipsparseLtSpMMATileMaskSize(const hipsparseLtHandle_t*        handle,
+                                               const hipsparseLtMatDescriptor_t* sparseMatDescr,
+                                               int64_t*                          tileSize,
+                                               size_t*                           tileMaskSize);
+
+/*! \ingroup helper_module
+ *  \brief compresses the dirty tiles of a dense matrix.
+ *
+ *  \details
+ *  \p hipsparseLtSpMMACompressTiles works like \ref hipsparseLtSpMMACompress2 but only
+ *  rewrites the compressed values and metadata of the tiles whose bit is set in
+ *  \p d_tileMask, so the cost scales with the number of modified tiles.
+ *  \p d_compressed must already hold the result of a full compression of the matrix.
+ *
+ *  @param[in]
+ *  handle             handle to the hipsparselt library context queue.
+ *  @param[in]
+ *  sparseMatDescr     structured(sparse) matrix descriptor.
+ *  @param[in]
+ *  isSparseA          specify if the structured (sparse) matrix is in the first position (matA or matB) (HIP backend only support matA)
+ *  @param[in]
+ *  op                 operation that will be applied to the structured (sparse) matrix in the multiplication
+ *  @param[in]
+ *  d_dense            pointer to the dense matrix.
+ *  @param[out]
+ *  d_compressed       compressed matrix and metadata
+ *  @param[out]
+ *  d_compressBuffer   temporary buffer for the compression.
+ *  @param[in]
+ *  d_tileMask         device pointer to the dirty tile bitmap.
+ *  @param[in]
+ *  stream             HIP stream for the computation.
+ *
+ *  \retval     HIPSPARSE_STATUS_SUCCESS the operation completed successfully.
+ *  \retval     HIPSPARSE_STATUS_INVALID_VALUE \p handle , \p sparseMatDescr , \p op , \p d_dense , \p d_compressed or \p d_tileMask is invalid.
+ *  \retval     HIPSPARSE_STATUS_NOT_SUPPORTED the problem is not support
+ */
+HIPSPARSELT_EXPORT
+hipsparseStatus_t hipsparseLtSpMMACompressTiles(const hipsparseLtHandle_t*        handle,
+                                                const hipsparseLtMatDescriptor_t* sparseMatDescr,
+                                                int                               isSparseA,
+                                                hipsparseOperation_t              op,
+                                                const void*                       d_dense,
+                                                void*                             d_compressed,
+                                                void*                             d_compressBuffer,
+                                                const void*                       d_tileMask,
+                                                hipStream_t                       stream);
+
 #ifdef __cplusplus
 }
 #endif
@@ -307,6 +307,10 @@ rocsparselt_matmul_descr_attribute_
         return rocsparselt_matmul_activation_tanh_beta;
     case HIPSPARSELT_MATMUL_BIAS_TYPE:
         return rocsparselt_matmul_bias_type;
+    case HIPSPARSELT_MATMUL_OUTPUT_SCALE_POINTER:
+        return rocsparselt_matmul_output_scale_pointer;
+    case HIPSPARSELT_MATMUL_OUTPUT_ZERO_POINT_POINTER:
+        return rocsparselt_matmul_output_zero_point_pointer;
     default:
         throw HIPSPARSE_STATUS_NOT_SUPPORTED;
     }
@@ -351,6 +355,10 @@ hipsparseLtMatmulDescAttribute_t
         return HIPSPARSELT_MATMUL_ACTIVATION_TANH_BETA;
     case rocsparselt_matmul_bias_type:
         return HIPSPARSELT_MATMUL_BIAS_TYPE;
+    case rocsparselt_matmul_output_scale_pointer:
+        return HIPSPARSELT_MATMUL_OUTPUT_SCALE_POINTER;
+    case rocsparselt_matmul_output_zero_point_pointer:
+        return HIPSPARSELT_MATMUL_OUTPUT_ZERO_POINT_POINTER;
     default:
         throw HIPSPARSE_STATUS_NOT_SUPPORTED;
     }
@@ -502,6 +510,19 @@ hipsparseLtSplitKMode_t RocSparseLtSplitKModeToHIPSplitKMode(rocsparselt_split_k
     }
 }
 
+rocsparselt_shard_dim HIPShardDimToRocSparseLtShardDim(hipsparseLtShardDim_t dim)
+{
+    switch(dim)
+    {
+    case HIPSPARSELT_SHARD_DIM_N:
+        return rocsparselt_shard_dim_n;
+    case HIPSPARSELT_SHARD_DIM_BATCH:
+        return rocsparselt_shard_dim_batch;
+    default:
+        throw HIPSPARSE_STATUS_NOT_SUPPORTED;
+    }
+}
+
 hipsparseStatus_t hipsparseLtInit(hipsparseLtHandle_t* handle)
 try
 {
@@ -537,6 +558,81 @@ catch(...)
     return exception_to_hipsparselt_status();
 }
 
+hipsparseStatus_t hipsparseLtWorkspaceArenaSetEnabled(const hipsparseLtHandle_t* handle,
+                                                      int                        enable)
+try
+{
+    return RocSparseLtStatusToHIPStatus(
+        rocsparselt_workspace_arena_set_enabled((const rocsparselt_handle*)handle, enable));
+}
+catch(...)
+{
+    return exception_to_hipsparselt_status();
+}
+
+hipsparseStatus_t hipsparseLtWorkspaceArenaGetStats(const hipsparseLtHandle_t*        handle,
+                                                    hipsparseLtWorkspaceArenaStats_t* stats)
+try
+{
+    if(stats == nullptr)
+        return HIPSPARSE_STATUS_INVALID_VALUE;
+
+    rocsparselt_workspace_arena_stats _stats;
+    auto                              status = RocSparseLtStatusToHIPStatus(
+        rocsparselt_workspace_arena_get_stats((const rocsparselt_handle*)handle, &_stats));
+    if(status == HIPSPARSE_STATUS_SUCCESS)
+    {
+        stats->currentBytes   = _stats.current_bytes;
+        stats->highWaterBytes = _stats.high_water_bytes;
+        stats->growEvents     = _stats.grow_events;
+        stats->requests       = _stats.requests;
+        stats->numStreams     = _stats.num_streams;
+    }
+    return status;
+}
+catch(...)
+{
+    return exception_to_hipsparselt_status();
+}
+
+hipsparseStatus_t hipsparseLtGetDeviceMemoryUsage(const hipsparseLtHandle_t*      handle,
+                                                  hipsparseLtDeviceMemoryUsage_t* usage)
+try
+{
+    if(usage == nullptr)
+        return HIPSPARSE_STATUS_INVALID_VALUE;
+
+    rocsparselt_device_memory_usage _usage;
+    auto                            status = RocSparseLtStatusToHIPStatus(
+        rocsparselt_get_device_memory_usage((const rocsparselt_handle*)handle, &_usage));
+    if(status == HIPSPARSE_STATUS_SUCCESS)
+    {
+        usage->moduleBytes         = _usage.module_bytes;
+        usage->workspaceArenaBytes = _usage.workspace_arena_bytes;
+        usage->totalBytes          = _usage.total_bytes;
+        usage->modules             = _usage.modules;
+        usage->livePlans           = _usage.live_plans;
+        usage->modulesAccounted    = _usage.modules_accounted;
+    }
+    return status;
+}
+catch(...)
+{
+    return exception_to_hipsparselt_status();
+}
+
+hipsparseStatus_t hipsparseLtUnloadUnusedModules(const hipsparseLtHandle_t* handle,
+                                                 size_t*                    freedBytes)
+try
+{
+    return RocSparseLtStatusToHIPStatus(
+        rocsparselt_unload_unused_modules((const rocsparselt_handle*)handle, freedBytes));
+}
+catch(...)
+{
+    return exception_to_hipsparselt_status();
+}
+
 /* matrix descriptor */
 // dense matrix
 hipsparseStatus_t hipsparseLtDenseDescriptorInit(const hipsparseLtHandle_t*  handle,
@@ -809,6 +905,126 @@ catch(...)
     return exception_to_hipsparselt_status();
 }
 
+hipsparseStatus_t hipsparseLtMatmulPlanSetStatsSampling(const hipsparseLtHandle_t*     handle,
+                                                        const hipsparseLtMatmulPlan_t* plan,
+                                                        int32_t                        interval)
+try
+{
+    return RocSparseLtStatusToHIPStatus(rocsparselt_matmul_plan_set_stats_sampling(
+        (const rocsparselt_handle*)handle, (const rocsparselt_matmul_plan*)plan, interval));
+}
+catch(...)
+{
+    return exception_to_hipsparselt_status();
+}
+
+hipsparseStatus_t hipsparseLtMatmulPlanGetStats(const hipsparseLtHandle_t*     handle,
+                                                const hipsparseLtMatmulPlan_t* plan,
+                                                hipsparseLtMatmulPlanStats_t*  stats)
+try
+{
+    if(stats == nullptr)
+        return HIPSPARSE_STATUS_INVALID_VALUE;
+
+    rocsparselt_matmul_plan_stats _stats;
+    auto                          status = RocSparseLtStatusToHIPStatus(
+        rocsparselt_matmul_plan_get_stats(
+            (const rocsparselt_handle*)handle, (const rocsparselt_matmul_plan*)plan, &_stats));
+    if(status == HIPSPARSE_STATUS_SUCCESS)
+    {
+        stats->calls      = _stats.calls;
+        stats->hostTimeNs = _stats.host_time_ns;
+        stats->gpuSamples = _stats.gpu_samples;
+        stats->gpuTimeNs  = _stats.gpu_time_ns;
+        for(int i = 0; i < 32; i++)
+        {
+            stats->hostHistogram[i] = _stats.host_histogram[i];
+            stats->gpuHistogram[i]  = _stats.gpu_histogram[i];
+        }
+    }
+    return status;
+}
+catch(...)
+{
+    return exception_to_hipsparselt_status();
+}
+
+hipsparseStatus_t hipsparseLtMatmulPlanResetStats(const hipsparseLtHandle_t*     handle,
+                                                  const hipsparseLtMatmulPlan_t* plan)
+try
+{
+    return RocSparseLtStatusToHIPStatus(rocsparselt_matmul_plan_reset_stats(
+        (const rocsparselt_handle*)handle, (const rocsparselt_matmul_plan*)plan));
+}
+catch(...)
+{
+    return exception_to_hipsparselt_status();
+}
+
+hipsparseStatus_t
+    hipsparseLtMatmulAlgSelectionInitAsync(const hipsparseLtHandle_t*           handle,
+                                           hipsparseLtMatmulAlgSelection_t*     algSelection,
+                                           const hipsparseLtMatmulDescriptor_t* matmulDescr,
+                                           hipsparseLtMatmulAlg_t               alg,
+                                           hipsparseLtAsyncToken_t*             token)
+try
+{
+    return RocSparseLtStatusToHIPStatus(rocsparselt_matmul_alg_selection_init_async(
+        (const rocsparselt_handle*)handle,
+        (rocsparselt_matmul_alg_selection*)algSelection,
+        (const rocsparselt_matmul_descr*)matmulDescr,
+        HIPMatmulAlgToRocSparseLtMatmulAlg(alg),
+        (rocsparselt_async_token*)token));
+}
+catch(...)
+{
+    return exception_to_hipsparselt_status();
+}
+
+hipsparseStatus_t
+    hipsparseLtMatmulPlanInitAsync(const hipsparseLtHandle_t*             handle,
+                                   hipsparseLtMatmulPlan_t*               plan,
+                                   const hipsparseLtMatmulDescriptor_t*   matmulDescr,
+                                   const hipsparseLtMatmulAlgSelection_t* algSelection,
+                                   const hipsparseLtAsyncToken_t*         algSelectionToken,
+                                   hipsparseLtAsyncToken_t*               token)
+try
+{
+    return RocSparseLtStatusToHIPStatus(rocsparselt_matmul_plan_init_async(
+        (const rocsparselt_handle*)handle,
+        (rocsparselt_matmul_plan*)plan,
+        (const rocsparselt_matmul_descr*)matmulDescr,
+        (const rocsparselt_matmul_alg_selection*)algSelection,
+        (const rocsparselt_async_token*)algSelectionToken,
+        (rocsparselt_async_token*)token));
+}
+catch(...)
+{
+    return exception_to_hipsparselt_status();
+}
+
+hipsparseStatus_t hipsparseLtAsyncTokenQuery(const hipsparseLtAsyncToken_t* token, int* done)
+try
+{
+    return RocSparseLtStatusToHIPStatus(
+        rocsparselt_async_token_query((const rocsparselt_async_token*)token, done));
+}
+catch(...)
+{
+    return exception_to_hipsparselt_status();
+}
+
+hipsparseStatus_t hipsparseLtAsyncTokenWait(hipsparseLtAsyncToken_t* token)
+try
+{
+    return RocSparseLtStatusToHIPStatus(
+        rocsparselt_async_token_wait((rocsparselt_async_token*)token));
+}
+catch(...)
+{
+    return exception_to_hipsparselt_status();
+}
+
 /* matmul execution */
 hipsparseStatus_t hipsparseLtMatmul(const hipsparseLtHandle_t*     handle,
                                     const hipsparseLtMatmulPlan_t* plan,
@@ -870,6 +1086,118 @@ catch(...)
     return exception_to_hipsparselt_status();
 }
 
+hipsparseStatus_t hipsparseLtMatmulMultiple(const hipsparseLtHandle_t*       handle,
+                                            const hipsparseLtMatmulLaunch_t* launches,
+                                            int32_t                          numLaunches,
+                                            hipStream_t*                     streams,
+                                            int32_t                          numStreams)
+try
+{
+    static_assert(sizeof(hipsparseLtMatmulLaunch_t) == sizeof(rocsparselt_matmul_launch),
+                  "hipsparseLtMatmulLaunch_t and rocsparselt_matmul_launch should match");
+    return RocSparseLtStatusToHIPStatus(
+        rocsparselt_matmul_multiple((const rocsparselt_handle*)handle,
+                                    (const rocsparselt_matmul_launch*)launches,
+                                    numLaunches,
+                                    streams,
+                                    numStreams));
+}
+catch(...)
+{
+    return exception_to_hipsparselt_status();
+}
+
+hipsparseStatus_t hipsparseLtMatmulGraphCreate(const hipsparseLtHandle_t*       handle,
+                                               const hipsparseLtMatmulLaunch_t* launches,
+                                               int32_t                          numLaunches,
+                                               hipStream_t                      stream,
+                                               hipGraphExec_t*                  graphExec)
+try
+{
+    return RocSparseLtStatusToHIPStatus(
+        rocsparselt_matmul_graph_create((const rocsparselt_handle*)handle,
+                                        (const rocsparselt_matmul_launch*)launches,
+                                        numLaunches,
+                                        stream,
+                                        graphExec));
+}
+catch(...)
+{
+    return exception_to_hipsparselt_status();
+}
+
+hipsparseStatus_t hipsparseLtMatmulGraphUpdate(const hipsparseLtHandle_t*       handle,
+                                               const hipsparseLtMatmulLaunch_t* launches,
+                                               int32_t                          numLaunches,
+                                               hipStream_t                      stream,
+                                               hipGraphExec_t                   graphExec)
+try
+{
+    return RocSparseLtStatusToHIPStatus(
+        rocsparselt_matmul_graph_update((const rocsparselt_handle*)handle,
+                                        (const rocsparselt_matmul_launch*)launches,
+                                        numLaunches,
+                                        stream,
+                                        graphExec));
+}
+catch(...)
+{
+    return exception_to_hipsparselt_status();
+}
+
+hipsparseStatus_t hipsparseLtMatmulShardPartition(int        numShards,
+                                                  const int* weights,
+                                                  int64_t    extent,
+                                                  int64_t    granularity,
+                                                  int64_t*   offsets,
+                                                  int64_t*   sizes)
+try
+{
+    return RocSparseLtStatusToHIPStatus(rocsparselt_matmul_shard_partition(
+        numShards, weights, extent, granularity, offsets, sizes));
+}
+catch(...)
+{
+    return exception_to_hipsparselt_status();
+}
+
+hipsparseStatus_t hipsparseLtMatmulSharded(const hipsparseLtHandle_t* const*     handles,
+                                           const hipsparseLtMatmulPlan_t* const* plans,
+                                           int                                   numShards,
+                                           hipsparseLtShardDim_t                 dim,
+                                           const void*                           alpha,
+                                           const void* const*                    d_A,
+                                           const void* const*                    d_B,
+                                           const void*                           beta,
+                                           const void* const*                    d_C,
+                                           void* const*                          d_D,
+                                           void* const*                          workspaces,
+                                           hipStream_t*                          streams,
+                                           const hipsparseLtMatDescriptor_t*     gatherDescr,
+                                           void*                                 d_gather)
+try
+{
+    return RocSparseLtStatusToHIPStatus(
+        rocsparselt_matmul_sharded((const rocsparselt_handle* const*)handles,
+                                   (const rocsparselt_matmul_plan* const*)plans,
+                                   numShards,
+                                   HIPShardDimToRocSparseLtShardDim(dim),
+                                   alpha,
+                                   d_A,
+                                   d_B,
+                                   beta,
+                                   d_C,
+                                   d_D,
+                                   workspaces,
+                                   streams,
+                                   (const rocsparselt_mat_descr*)gatherDescr,
+                                   d_gather));
+}
+catch(...)
+{
+    return exception_to_hipsparselt_status();
+}
+
 /* helper */
 // prune
 hipsparseStatus_t hipsparseLtSpMMAPrune(const hipsparseLtHandle_t*           handle,
@@ -937,6 +1265,33 @@ catch(...)
     return exception_to_hipsparselt_status();
 }
 
+hipsparseStatus_t hipsparseLtSpMMAPruneTiles(const hipsparseLtHandle_t*        handle,
+                                             const hipsparseLtMatDescriptor_t* sparseMatDescr,
+                                             int                               isSparseA,
+                                             hipsparseOperation_t              op,
+                                             const void*                       d_in,
+                                             void*                             d_out,
+                                             hipsparseLtPruneAlg_t             pruneAlg,
+                                             const void*                       d_tileMask,
+                                             hipStream_t                       stream)
+try
+{
+    return RocSparseLtStatusToHIPStatus(
+        rocsparselt_smfmac_prune_tiles((const rocsparselt_handle*)handle,
+                                       (const rocsparselt_mat_descr*)sparseMatDescr,
+                                       isSparseA,
+                                       HIPOperationToHCCOperation(op),
+                                       d_in,
+                                       d_out,
+                                       HIPPruneAlgToRocSparseLtPruneAlg(pruneAlg),
+                                       d_tileMask,
+                                       stream));
+}
+catch(...)
+{
+    return exception_to_hipsparselt_status();
+}
+
 hipsparseStatus_t hipsparseLtSpMMAPruneCheck2(const hipsparseLtHandle_t*        handle,
                                               const hipsparseLtMatDescriptor_t* sparseMatDescr,
                                               int                               isSparseA,
@@ -1041,6 +1396,50 @@ catch(...)
     return exception_to_hipsparselt_status();
 }
 
+hipsparseStatus_t hipsparseLtSpMMATileMaskSize(const hipsparseLtHandle_t*        handle,
+                                               const hipsparseLtMatDescriptor_t* sparseMatDescr,
+                                               int64_t*                          tileSize,
+                                               size_t*                           tileMaskSize)
+try
+{
+    return RocSparseLtStatusToHIPStatus(
+        rocsparselt_smfmac_tile_mask_size((const rocsparselt_handle*)handle,
+                                          (const rocsparselt_mat_descr*)sparseMatDescr,
+                                          tileSize,
+                                          tileMaskSize));
+}
+catch(...)
+{
+    return exception_to_hipsparselt_status();
+}
+
+hipsparseStatus_t hipsparseLtSpMMACompressTiles(const hipsparseLtHandle_t*        handle,
+                                                const hipsparseLtMatDescriptor_t* sparseMatDescr,
+                                                int                               isSparseA,
+                                                hipsparseOperation_t              op,
+                                                const void*                       d_dense,
+                                                void*                             d_compressed,
+                                                void*                             d_compressBuffer,
+                                                const void*                       d_tileMask,
+                                                hipStream_t                       stream)
+try
+{
+    return RocSparseLtStatusToHIPStatus(
+        rocsparselt_smfmac_compress_tiles((const rocsparselt_handle*)handle,
+                                          (const rocsparselt_mat_descr*)sparseMatDescr,
+                                          isSparseA,
+                                          HIPOperationToHCCOperation(op),
+                                          d_dense,
+                                          d_compressed,
+                                          d_compressBuffer,
+                                          d_tileMask,
+                                          stream));
+}
+catch(...)
+{
+    return exception_to_hipsparselt_status();
+}
+
 void hipsparseLtInitialize()
 {
     rocsparselt_initialize();
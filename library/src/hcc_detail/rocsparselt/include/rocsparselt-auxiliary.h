@@ -71,6 +71,85 @@ rocsparselt_status rocsparselt_init(rocsparselt_handle* handle);
  */
 rocsparselt_status rocsparselt_destroy(const rocsparselt_handle* handle);
 
+/*! \ingroup aux_module
+ *  \brief Enable or disable the workspace arena of a handle
+ *
+ *  \details
+ *  When the arena is enabled, rocsparselt_matmul() and rocsparselt_matmul_search()
+ *  called with a NULL workspace take the workspace from a device buffer owned by
+ *  the handle. There is one buffer per stream, it is reused by all plans on that
+ *  stream and grows geometrically when a larger workspace is needed.
+ *  Disabling the arena, or destroying the handle, releases the buffers.
+ *  The arena can also be enabled by setting HIPSPARSELT_WORKSPACE_ARENA=1.
+ *
+ *  @param[in]
+ *  handle  rocsparselt library handle
+ *  enable  1 to enable, 0 to disable.
+ *
+ *  \retval rocsparselt_status_success the operation completed successfully.
+ *  \retval rocsparselt_status_invalid_handle \p handle is invalid.
+ */
+rocsparselt_status rocsparselt_workspace_arena_set_enabled(const rocsparselt_handle* handle,
+                                                           int                       enable);
+
+/*! \ingroup aux_module
+ *  \brief Retrieve the statistics of the workspace arena of a handle
+ *
+ *  @param[in]
+ *  handle  rocsparselt library handle
+ *
+ *  @param[out]
+ *  stats   statistics of the arena, all zero when the arena is disabled.
+ *
+ *  \retval rocsparselt_status_success the operation completed successfully.
+ *  \retval rocsparselt_status_invalid_handle \p handle is invalid.
+ *  \retval rocsparselt_status_invalid_pointer \p stats pointer is invalid.
+ */
+rocsparselt_status rocsparselt_workspace_arena_get_stats(const rocsparselt_handle*          handle,
+                                                         rocsparselt_workspace_arena_stats* stats);
+
+/*! \ingroup aux_module
+ *  \brief Retrieve the device memory held by the library for a handle
+ *
+ *  \details
+ *  The bytes of a code object are the span of its loadable segments. The code
+ *  objects of the Tensile backend are not accounted, the workspace arena is.
+ *
+ *  @param[in]
+ *  handle  rocsparselt library handle
+ *
+ *  @param[out]
+ *  usage   bytes held by the code objects and the workspace arena.
+ *
+ *  \retval rocsparselt_status_success the operation completed successfully.
+ *  \retval rocsparselt_status_invalid_handle \p handle is invalid.
+ *  \retval rocsparselt_status_invalid_pointer \p usage pointer is invalid.
+ */
+rocsparselt_status rocsparselt_get_device_memory_usage(const rocsparselt_handle*        handle,
+                                                       rocsparselt_device_memory_usage* usage);
+
+/*! \ingroup aux_module
+ *  \brief Unload the code objects which are not used by any live plan
+ *
+ *  \details
+ *  The code objects of the device of the handle whose kernels are not used by an
+ *  initialized plan are unloaded. The device is synchronized first, so kernels
+ *  already queued may finish. An unloaded code object is loaded again by the next
+ *  matmul which needs it.
+ *
+ *  @param[in]
+ *  handle  rocsparselt library handle
+ *
+ *  @param[out]
+ *  freedBytes  bytes of the unloaded code objects, may be NULL.
+ *
+ *  \retval rocsparselt_status_success the operation completed successfully.
+ *  \retval rocsparselt_status_invalid_handle \p handle is invalid.
+ *  \retval rocsparselt_status_not_implemented the library is built with the Tensile backend.
+ */
+rocsparselt_status rocsparselt_unload_unused_modules(const rocsparselt_handle* handle,
+                                                     size_t*                   freedBytes);
+
 /*! \ingroup aux_module
  *  \brief Create a descriptor for dense matrix
  *  \details
@@ -399,6 +478,141 @@ rocsparselt_status
  */
 rocsparselt_status rocsparselt_matmul_plan_destroy(const rocsparselt_matmul_plan* plan);
 
+/*! \ingroup aux_module
+ *  \brief Set the GPU time sampling interval of a matrix multiplication plan
+ *
+ *  \details
+ *  Every call of rocsparselt_matmul() with \p plan is counted and its host time is added
+ *  to the statistics of the plan. When \p interval is greater than 0, every
+ *  \p interval-th call is also timed on the GPU with a pair of events. The events are
+ *  read back by a later sample or by rocsparselt_matmul_plan_get_stats(), a call is never
+ *  blocked on them. The initial interval is HIPSPARSELT_PLAN_STATS_SAMPLING (default 0).
+ *
+ *  @param[in]
+ *  handle      rocsparselt library handle
+ *  plan        the matrix multiplication plan
+ *  interval    sampling interval, 0 disables the GPU timing.
+ *
+ *  \retval rocsparselt_status_success the operation completed successfully.
+ *  \retval rocsparselt_status_invalid_handle \p handle or \p plan is invalid.
+ *  \retval rocsparselt_status_invalid_value \p interval is negative.
+ */
+rocsparselt_status
+    rocsparselt_matmul_plan_set_stats_sampling(const rocsparselt_handle*      handle,
+                                               const rocsparselt_matmul_plan* plan,
+                                               int32_t                        interval);
+
+/*! \ingroup aux_module
+ *  \brief Retrieve the runtime statistics of a matrix multiplication plan
+ *
+ *  @param[in]
+ *  handle  rocsparselt library handle
+ *  plan    the matrix multiplication plan
+ *
+ *  @param[out]
+ *  stats   statistics of \p plan.
+ *
+ *  \retval rocsparselt_status_success the operation completed successfully.
+ *  \retval rocsparselt_status_invalid_handle \p handle or \p plan is invalid.
+ *  \retval rocsparselt_status_invalid_pointer \p stats pointer is invalid.
+ */
+rocsparselt_status rocsparselt_matmul_plan_get_stats(const rocsparselt_handle*      handle,
+                                                     const rocsparselt_matmul_plan* plan,
+                                                     rocsparselt_matmul_plan_stats* stats);
+
+/*! \ingroup aux_module
+ *  \brief Reset the runtime statistics of a matrix multiplication plan
+ *
+ *  @param[in]
+ *  handle  rocsparselt library handle
+ *  plan    the matrix multiplication plan
+ *
+ *  \retval rocsparselt_status_success the operation completed successfully.
+ *  \retval rocsparselt_status_invalid_handle \p handle or \p plan is invalid.
+ */
+rocsparselt_status rocsparselt_matmul_plan_reset_stats(const rocsparselt_handle*      handle,
+                                                       const rocsparselt_matmul_plan* plan);
+
+/*! \ingroup aux_module
+ *  \brief Initializes the algorithm selection descriptor asynchronously
+ *  \details
+ *  \p rocsparselt_matmul_alg_selection_init_async queues
+ *  rocsparselt_matmul_alg_selection_init() on an internal thread pool and returns
+ *  immediately, so that the code object loading of many descriptors can overlap
+ *  with other work. The number of worker threads is set by HIPSPARSELT_ASYNC_THREADS.
+ *  \p handle, \p algSelection and \p matmulDescr must stay valid until \p token
+ *  is waited with rocsparselt_async_token_wait().
+ *
+ *  @param[out]
+ *  token        the token of the queued call.
+ *
+ *  \retval rocsparselt_status_success the call was queued.
+ *  \retval rocsparselt_status_invalid_handle \p handle is invalid.
+ *  \retval rocsparselt_status_invalid_pointer \p token pointer is invalid.
+ */
+rocsparselt_status
+    rocsparselt_matmul_alg_selection_init_async(const rocsparselt_handle*         handle,
+                                                rocsparselt_matmul_alg_selection* algSelection,
+                                                const rocsparselt_matmul_descr*   matmulDescr,
+                                                rocsparselt_matmul_alg            alg,
+                                                rocsparselt_async_token*          token);
+
+/*! \ingroup aux_module
+ *  \brief Initializes the matrix multiplication plan descriptor asynchronously
+ *  \details
+ *  \p rocsparselt_matmul_plan_init_async queues rocsparselt_matmul_plan_init() on
+ *  the internal thread pool. When \p algSelectionToken is not NULL, the plan is
+ *  initialized after the call tracked by \p algSelectionToken has completed, so
+ *  a whole chain can be queued at once. \p algSelectionToken still has to be
+ *  waited by the caller.
+ *
+ *  @param[out]
+ *  token              the token of the queued call.
+ *
+ *  @param[in]
+ *  algSelectionToken  token returned by rocsparselt_matmul_alg_selection_init_async(), can be NULL.
+ *
+ *  \retval rocsparselt_status_success the call was queued.
+ *  \retval rocsparselt_status_invalid_handle \p handle or \p algSelectionToken is invalid.
+ *  \retval rocsparselt_status_invalid_pointer \p token pointer is invalid.
+ */
+rocsparselt_status
+    rocsparselt_matmul_plan_init_async(const rocsparselt_handle*               handle,
+                                       rocsparselt_matmul_plan*                plan,
+                                       const rocsparselt_matmul_descr*         matmulDescr,
+                                       const rocsparselt_matmul_alg_selection* algSelection,
+                                       const rocsparselt_async_token*          algSelectionToken,
+                                       rocsparselt_async_token*                token);
+
+/*! \ingroup aux_module
+ *  \brief Query an asynchronous call
+ *  \details
+ *  \p rocsparselt_async_token_query checks without blocking whether the call tracked
+ *  by \p token has completed.
+ *
+ *  @param[out]
+ *  done   1 if the call has completed, 0 otherwise.
+ *
+ *  \retval rocsparselt_status_success the operation completed successfully.
+ *  \retval rocsparselt_status_invalid_handle \p token is invalid.
+ *  \retval rocsparselt_status_invalid_pointer \p done pointer is invalid.
+ */
+rocsparselt_status rocsparselt_async_token_query(const rocsparselt_async_token* token, int* done);
+
+/*! \ingroup aux_module
+ *  \brief Wait an asynchronous call
+ *  \details
+ *  \p rocsparselt_async_token_wait blocks until the call tracked by \p token has
+ *  completed, releases \p token and returns the status of that call.
+ *
+ *  @param[in]
+ *  token   the token of the asynchronous call.
+ *
+ *  \retval rocsparselt_status_invalid_handle \p token is invalid.
+ *  \retval other the status returned by the asynchronous call.
+ */
+rocsparselt_status rocsparselt_async_token_wait(rocsparselt_async_token* token);
+
 #ifdef __cplusplus
 }
 #endif
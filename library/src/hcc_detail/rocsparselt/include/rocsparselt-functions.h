@@ -183,6 +183,189 @@ rocsparselt_status rocsparselt_matmul_search(const rocsparselt_handle* handle,
                                              hipStream_t*              streams,
                                              int32_t                   numStreams);
 
+/*! \ingroup spmm_module
+ *  \brief Execute a list of sparse matrix dense matrix multiplications
+ *
+ *  \details
+ *  \p rocsparselt_matmul_multiple runs the matrix multiplications of \p launches in order,
+ *  like a sequence of rocsparselt_matmul() calls. All arguments are validated before the
+ *  first kernel is launched, then the kernels are launched back to back, which reduces
+ *  the host overhead of a chain of small matmuls (e.g. the layers of a transformer block).
+ *  The i-th matmul runs on \p streams[i % numStreams], so matmuls that do not depend on
+ *  each other can be spread over several streams; use a single stream to keep them ordered.
+ *
+ *  \note
+ *  This function is non blocking and executed asynchronously with respect to the host.
+ *
+ *  @param[in]
+ *  handle      rocsparselt library handle
+ *  launches    array of \p numLaunches matmuls.
+ *  numLaunches number of matmuls in \p launches.
+ *  streams     Pointer to HIP stream array for the computation
+ *  numStreams  Number of HIP streams in \p streams
+ *
+ *  \retval     rocsparselt_status_success the operation completed successfully.
+ *  \retval     rocsparselt_status_invalid_handle \p handle or a plan is invalid.
+ *  \retval     rocsparselt_status_invalid_pointer \p launches or a pointer of a matmul is invalid.
+ *  \retval     rocsparselt_status_invalid_value a workspace, \p numLaunches, \p streams or \p numStreams is invalid.
+ *  \retval     rocsparselt_status_not_implemented the problme is not supported
+ */
+rocsparselt_status rocsparselt_matmul_multiple(const rocsparselt_handle*        handle,
+                                               const rocsparselt_matmul_launch* launches,
+                                               int32_t                          numLaunches,
+                                               hipStream_t*                     streams,
+                                               int32_t                          numStreams);
+
+/*! \ingroup spmm_module
+ *  \brief Record a list of sparse matrix dense matrix multiplications into a HIP graph
+ *
+ *  \details
+ *  \p rocsparselt_matmul_graph_create captures rocsparselt_matmul_multiple() of \p launches
+ *  on \p stream and instantiates the graph, which replays the matmuls with
+ *  hipGraphLaunch() for the host cost of a single launch. The kernels are recorded, not
+ *  run. A matmul is capture safe: it does not synchronize, load a module or allocate
+ *  while its stream is captured, so rocsparselt_matmul() may also be called inside a
+ *  capture of the caller. A workspace taken from the workspace arena is recorded in the
+ *  graph and must already be large enough, the arena cannot grow during a capture.
+ *
+ *  @param[in]
+ *  handle      rocsparselt library handle
+ *  launches    array of \p numLaunches matmuls.
+ *  numLaunches number of matmuls in \p launches.
+ *  stream      HIP stream of the capture, or NULL to capture on an internal stream.
+ *
+ *  @param[out]
+ *  graphExec   the executable graph, destroyed with hipGraphExecDestroy().
+ *
+ *  \retval     rocsparselt_status_success the operation completed successfully.
+ *  \retval     rocsparselt_status_invalid_handle \p handle or a plan is invalid.
+ *  \retval     rocsparselt_status_invalid_pointer \p launches, \p graphExec or a pointer of a matmul is invalid.
+ *  \retval     rocsparselt_status_invalid_value a workspace or \p numLaunches is invalid.
+ *  \retval     rocsparselt_status_not_implemented the problme is not supported
+ */
+rocsparselt_status rocsparselt_matmul_graph_create(const rocsparselt_handle*        handle,
+                                                   const rocsparselt_matmul_launch* launches,
+                                                   int32_t                          numLaunches,
+                                                   hipStream_t                      stream,
+                                                   hipGraphExec_t*                  graphExec);
+
+/*! \ingroup spmm_module
+ *  \brief Update the pointers of a graph of sparse matrix dense matrix multiplications
+ *
+ *  \details
+ *  \p rocsparselt_matmul_graph_update captures \p launches again and updates the kernel
+ *  arguments of \p graphExec in place with hipGraphExecUpdate(). The launches must use
+ *  the same plans, in the same order, as the ones the graph was created with; the
+ *  pointers (and the values of alpha and beta) may change.
+ *
+ *  @param[in]
+ *  handle      rocsparselt library handle
+ *  launches    array of \p numLaunches matmuls.
+ *  numLaunches number of matmuls in \p launches.
+ *  stream      HIP stream of the capture, or NULL to capture on an internal stream.
+ *  graphExec   graph created by rocsparselt_matmul_graph_create().
+ *
+ *  \retval     rocsparselt_status_success the operation completed successfully.
+ *  \retval     rocsparselt_status_invalid_handle \p handle or a plan is invalid.
+ *  \retval     rocsparselt_status_invalid_pointer \p launches, \p graphExec or a pointer of a matmul is invalid.
+ *  \retval     rocsparselt_status_invalid_value the launches do not match the graph.
+ */
+rocsparselt_status rocsparselt_matmul_graph_update(const rocsparselt_handle*        handle,
+                                                   const rocsparselt_matmul_launch* launches,
+                                                   int32_t                          numLaunches,
+                                                   hipStream_t                      stream,
+                                                   hipGraphExec_t                   graphExec);
+
+/*! \ingroup spmm_module
+ *  \brief Partition a matrix multiplication into shards.
+ *
+ *  \details
+ *  \p rocsparselt_matmul_shard_partition splits \p extent (the number of columns or
+ *  batches of D) into \p numShards contiguous ranges whose sizes are proportional to
+ *  \p weights, e.g. the number of compute units of the device running each shard.
+ *  Every range starts at a multiple of \p granularity. A shard with weight 0 gets an
+ *  empty range. This function only runs on the host.
+ *
+ *  @param[out]
+ *  offsets     array of \p numShards first index of each shard.
+ *  sizes       array of \p numShards extent of each shard.
+ *
+ *  @param[in]
+ *  numShards   number of shards.
+ *  weights     array of \p numShards non-negative weights.
+ *  extent      total extent to be split.
+ *  granularity size that every shard offset is a multiple of.
+ *
+ *  \retval     rocsparselt_status_success the operation completed successfully.
+ *  \retval     rocsparselt_status_invalid_pointer \p weights, \p offsets or \p sizes pointer is invalid.
+ *  \retval     rocsparselt_status_invalid_value \p numShards, \p extent, \p granularity or \p weights is invalid.
+ */
+rocsparselt_status rocsparselt_matmul_shard_partition(int        numShards,
+                                                      const int* weights,
+                                                      int64_t    extent,
+                                                      int64_t    granularity,
+                                                      int64_t*   offsets,
+                                                      int64_t*   sizes);
+
+/*! \ingroup spmm_module
+ *  \brief Sparse matrix dense matrix multiplication split across handles.
+ *
+ *  \details
+ *  \p rocsparselt_matmul_sharded runs one rocsparselt_matmul() per shard, each one on
+ *  the device of its handle and on its own stream, so the shards execute concurrently.
+ *  The plan of shard i must be created on \p handles[i] and describe that shard only,
+ *  see rocsparselt_matmul_shard_partition(). A shard whose plan is NULL is skipped.
+ *
+ *  When \p d_gather is not NULL, the D of every shard is copied into \p d_gather, which
+ *  is described by \p gatherDescr and lives on the device of \p handles[0]. The copies
+ *  are ordered after each shard and are issued on the stream of shard 0.
+ *
+ *  \note
+ *  This function is non blocking and executed asynchronously with respect to the host.
+ *
+ *  \note
+ *  \p alpha and \p beta must be host pointers.
+ *
+ *  @param[out]
+ *  d_D         array of \p numShards pointers to the dense matrix D of each shard.
+ *  d_gather    pointer to the gathered matrix D, can be NULL.
+ *
+ *  @param[in]
+ *  handles     array of \p numShards rocsparselt library handles.
+ *  plans       array of \p numShards matrix multiplication plans.
+ *  numShards   number of shards.
+ *  dim         dimension along which the shards are split.
+ *  alpha       scalar \f$\alpha\f$. (float)
+ *  d_A         array of \p numShards pointers to the matrix A of each shard.
+ *  d_B         array of \p numShards pointers to the matrix B of each shard.
+ *  beta        scalar \f$\beta\f$. (float)
+ *  d_C         array of \p numShards pointers to the matrix C of each shard.
+ *  workspaces  array of \p numShards workspaces, can be NULL.
+ *  streams     array of \p numShards HIP streams, can be NULL.
+ *  gatherDescr matrix descriptor of \p d_gather created on \p handles[0].
+ *
+ *  \retval     rocsparselt_status_success the operation completed successfully.
+ *  \retval     rocsparselt_status_invalid_handle \p handles, \p plans or \p gatherDescr is invalid.
+ *  \retval     rocsparselt_status_invalid_pointer \p alpha, \p A, \p B, \p beta, \p C or \p D
+ *              pointer is invalid.
+ *  \retval     rocsparselt_status_invalid_value \p numShards is invalid or the shards do not match \p gatherDescr.
+ *  \retval     rocsparselt_status_not_implemented the problme is not supported
+ */
+rocsparselt_status rocsparselt_matmul_sharded(const rocsparselt_handle* const*      handles,
+                                              const rocsparselt_matmul_plan* const* plans,
+                                              int                                   numShards,
+                                              rocsparselt_shard_dim                 dim,
+                                              const void*                           alpha,
+                                              const void* const*                    d_A,
+                                              const void* const*                    d_B,
+                                              const void*                           beta,
+                                              const void* const*                    d_C,
+                                              void* const*                          d_D,
+                                              void* const*                          workspaces,
+                                              hipStream_t*                          streams,
+                                              const rocsparselt_mat_descr*          gatherDescr,
+                                              void*                                 d_gather);
+
 /*! \ingroup spmm_module
  *  \brief Purnes a dense matrix.
  *
@@ -258,6 +441,47 @@ rocsparselt_status rocsparselt_smfmac_prune2(const rocsparselt_handle*    handle
                                              rocsparselt_prune_alg        pruneAlg,
                                              hipStream_t                  stream);
 
+/*! \ingroup spmm_module
+ *  \brief Purnes the dirty tiles of a dense matrix.
+ *
+ *  \details
+ *  \p rocsparselt_smfmac_prune_tiles works like \ref rocsparselt_smfmac_prune2 but
+ *  only the tiles whose bit is set in \p d_tileMask are read and written, the other
+ *  tiles of d_out are left untouched. The bitmap layout is described in
+ *  \ref rocsparselt_smfmac_tile_mask_size.
+ *
+ *  \note
+ *  This function supports asynchronous execution with respect to stream.
+ *
+ *  @param[out]
+ *  d_out       pointer to the pruned matrix.
+ *
+ *  @param[in]
+ *  handle         rocsparselt library handle
+ *  sparseMatDescr structured(sparse) matrix descriptor.
+ *  isSparseA      specify if the structured (sparse) matrix is in the first position (matA or matB) (Currently, only support matA)
+ *  op             operation that will be applied to the structured (sparse) matrix in the multiplication
+ *  d_in           pointer to the dense matrix.
+ *  pruneAlg       pruning algorithm.
+ *  d_tileMask     device pointer to the dirty tile bitmap.
+ *  stream         HIP stream for the computation.
+ *
+ *  \retval     rocsparselt_status_success the operation completed successfully.
+ *  \retval     rocsparselt_status_invalid_handle \p handle or \p sparseMatDescr is invalid.
+ *  \retval     rocsparselt_status_invalid_pointer \p d_in, \p d_out or \p d_tileMask pointer is invalid.
+ *  \retval     rocsparselt_status_invalid_value \p op is invalid.
+ *  \retval     rocsparselt_status_not_implemented the problem or \p pruneAlg is not support
+ */
+rocsparselt_status rocsparselt_smfmac_prune_tiles(const rocsparselt_handle*    handle,
+                                                  const rocsparselt_mat_descr* sparseMatDescr,
+                                                  int                          isSparseA,
+                                                  rocsparselt_operation        op,
+                                                  const void*                  d_in,
+                                                  void*                        d_out,
+                                                  rocsparselt_prune_alg        pruneAlg,
+                                                  const void*                  d_tileMask,
+                                                  hipStream_t                  stream);
+
 /*! \ingroup spmm_module
  *  \brief checks the correctness of the pruning structure for a given matrix.
  *
@@ -439,6 +663,72 @@ rocsparselt_status rocsparselt_smfmac_compress2(const rocsparselt_handle*    han
                                                 void*                        d_compressBuffer,
                                                 hipStream_t                  stream);
 
+/*! \ingroup spmm_module
+ *  \brief provide the size of the dirty tile bitmap.
+ *
+ *  \details
+ *  \p rocsparselt_smfmac_tile_mask_size provides the tile size and the size of the
+ *  dirty tile bitmap used by \ref rocsparselt_smfmac_prune_tiles and
+ *  \ref rocsparselt_smfmac_compress_tiles. One bit covers one tileSize x tileSize
+ *  tile of the (column major) matrix described by \p sparseMatDescr, bit
+ *  row_tile + col_tile * tiles_row + batch * tiles_row * tiles_col is stored at
+ *  byte (bit / 8), position (bit % 8).
+ *
+ *  @param[out]
+ *  tileSize       number of rows (and columns) covered by one bit.
+ *  tileMaskSize   size in bytes of the bitmap.
+ *
+ *  @param[in]
+ *  handle         rocsparselt library handle
+ *  sparseMatDescr structured(sparse) matrix descriptor.
+ *
+ *  \retval     rocsparselt_status_success the operation completed successfully.
+ *  \retval     rocsparselt_status_invalid_handle \p handle or \p sparseMatDescr is invalid.
+ *  \retval     rocsparselt_status_invalid_pointer \p tileSize or \p tileMaskSize pointer is invalid.
+ */
+rocsparselt_status rocsparselt_smfmac_tile_mask_size(const rocsparselt_handle*    handle,
+                                                     const rocsparselt_mat_descr* sparseMatDescr,
+                                                     int64_t*                     tileSize,
+                                                     size_t*                      tileMaskSize);
+
+/*! \ingroup spmm_module
+ *  \brief compresses the dirty tiles of a dense matrix.
+ *
+ *  \details
+ *  \p rocsparselt_smfmac_compress_tiles works like \ref rocsparselt_smfmac_compress2 but
+ *  only rewrites the compressed values and metadata of the tiles whose bit is set in
+ *  \p d_tileMask. d_compressed must hold the result of a previous full compression.
+ *
+ *  @param[out]
+ *  d_compressed       compressed matrix and metadata
+ *  @param[out]
+ *  d_compressBuffer   temporary buffer for the compression
+ *
+ *  @param[in]
+ *  handle         handle to the rocsparselt library context queue.
+ *  sparseMatDescr structured(sparse) matrix descriptor.
+ *  isSparseA      specify if the structured (sparse) matrix is in the first position (matA or matB) (Currently, only support matA)
+ *  op             operation that will be applied to the structured (sparse) matrix in the multiplication
+ *  d_dense        pointer to the dense matrix.
+ *  d_tileMask     device pointer to the dirty tile bitmap.
+ *  stream         HIP stream for the computation.
+ *
+ *  \retval     rocsparselt_status_success the operation completed successfully.
+ *  \retval     rocsparselt_status_invalid_handle \p handle or \p sparseMatDescr is invalid.
+ *  \retval     rocsparselt_status_invalid_pointer \p d_dense, \p d_compressed or \p d_tileMask pointer is invalid.
+ *  \retval     rocsparselt_status_invalid_value \p op is invalid.
+ *  \retval     rocsparselt_status_not_implemented the problem is not support
+ */
+rocsparselt_status rocsparselt_smfmac_compress_tiles(const rocsparselt_handle*    handle,
+                                                     const rocsparselt_mat_descr* sparseMatDescr,
+                                                     int                          isSparseA,
+                                                     rocsparselt_operation        op,
+                                                     const void*                  d_dense,
+                                                     void*                        d_compressed,
+                                                     void*                        d_compressBuffer,
+                                                     const void*                  d_tileMask,
+                                                     hipStream_t                  stream);
+
 #ifdef __cplusplus
 }
 #endif
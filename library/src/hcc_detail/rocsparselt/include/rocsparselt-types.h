@@ -102,6 +102,37 @@ typedef struct
     uint8_t data[11024];
 } rocsparselt_matmul_plan;
 
+/*! \ingroup types_module
+ *  \brief Token of an asynchronous call.
+ *
+ *  \details
+ *  The rocSPARSELt asynchronous token tracks a call queued by
+ *  \ref rocsparselt_matmul_alg_selection_init_async or \ref rocsparselt_matmul_plan_init_async.
+ *  It must be released with \ref rocsparselt_async_token_wait.
+ */
+typedef struct
+{
+    uint8_t data[64];
+} rocsparselt_async_token;
+
+/*! \ingroup types_module
+ *  \brief One matrix multiplication of \ref rocsparselt_matmul_multiple.
+ *
+ *  \details
+ *  The fields are the arguments of the same name of \ref rocsparselt_matmul.
+ */
+typedef struct
+{
+    const rocsparselt_matmul_plan* plan;
+    const void*                    alpha;
+    const void*                    d_A;
+    const void*                    d_B;
+    const void*                    beta;
+    const void*                    d_C;
+    void*                          d_D;
+    void*                          workspace;
+} rocsparselt_matmul_launch;
+
 // Generic API
 
 #ifdef __cplusplus
@@ -181,12 +212,14 @@ typedef enum rocsparselt_pointer_mode_
  */
 typedef enum rocsparselt_layer_mode
 {
-    rocsparselt_layer_mode_none      = 0, /**< layer is not active. */
-    rocsparselt_layer_mode_log_error = 1, /**< layer is in error mode. */
-    rocsparselt_layer_mode_log_trace = 2, /**< layer is in trace mode. */
-    rocsparselt_layer_mode_log_hints = 4, /**< layer is in hints mode. */
-    rocsparselt_layer_mode_log_info  = 8, /**< layer is in info mode. */
-    rocsparselt_layer_mode_log_api   = 16, /**< layer is in api mode. */
+    rocsparselt_layer_mode_none             = 0, /**< layer is not active. */
+    rocsparselt_layer_mode_log_error        = 1, /**< layer is in error mode. */
+    rocsparselt_layer_mode_log_trace        = 2, /**< layer is in trace mode. */
+    rocsparselt_layer_mode_log_hints        = 4, /**< layer is in hints mode. */
+    rocsparselt_layer_mode_log_info         = 8, /**< layer is in info mode. */
+    rocsparselt_layer_mode_log_api          = 16, /**< layer is in api mode. */
+    rocsparselt_layer_mode_log_timeline     = 32, /**< layer records a Chrome trace timeline. */
+    rocsparselt_layer_mode_log_trace_binary = 64, /**< layer records kernel launches in binary. */
 } rocsparselt_layer_mode;
 
 /*! \ingroup types_module
@@ -309,6 +342,10 @@ typedef enum rocsparselt_matmul_descr_attribute_
     = 15, /**< Beta value of the Tanh activation function. */
     rocsparselt_matmul_bias_type = 16, /**< Precision of bias >*/
     rocsparselt_matmul_activation_none, /**< activation function is disabled. */
+    rocsparselt_matmul_output_scale_pointer
+    = 18, /**< Per row (output channel) scales of the output quantization, a device vector of m floats. It needs an int8 input and an int8 or fp16 output. */
+    rocsparselt_matmul_output_zero_point_pointer
+    = 19, /**< Per row zero points of the output quantization, a device vector of m floats, nullptr means 0. */
 } rocsparselt_matmul_descr_attribute;
 
 /*! \ingroup types_module
@@ -374,6 +411,73 @@ typedef enum rocsparselt_split_k_mode_
     rocsparselt_split_k_mode_two_kernels = 1, /**< Use anoghter kernel to do the final reduction */
 } rocsparselt_split_k_mode;
 
+/*! \ingroup types_module
+ *  \brief Specify the dimension along which a matrix multiplication is split into shards.
+ *
+ *  \details
+ *  The \ref rocsparselt_shard_dim is used in the \ref rocsparselt_matmul_sharded function.
+ */
+typedef enum rocsparselt_shard_dim_
+{
+    rocsparselt_shard_dim_n     = 0, /**< Each shard computes a block of columns of D. */
+    rocsparselt_shard_dim_batch = 1, /**< Each shard computes a range of batches of D. */
+} rocsparselt_shard_dim;
+
+/*! \ingroup types_module
+ *  \brief Statistics of the workspace arena owned by a handle.
+ *
+ *  \details
+ *  The \ref rocsparselt_workspace_arena_stats is used in the
+ *  \ref rocsparselt_workspace_arena_get_stats function.
+ */
+typedef struct rocsparselt_workspace_arena_stats_
+{
+    size_t  current_bytes; /**< bytes of device memory currently held by the arena. */
+    size_t  high_water_bytes; /**< largest value of current_bytes. */
+    int64_t grow_events; /**< number of times a per-stream buffer was allocated or grown. */
+    int64_t requests; /**< number of workspaces handed out by the arena. */
+    int     num_streams; /**< number of streams owning a buffer. */
+} rocsparselt_workspace_arena_stats;
+
+/*! \ingroup types_module
+ *  \brief Device memory held by the library for a handle.
+ *
+ *  \details
+ *  The code objects are loaded once per device and shared by all handles on that
+ *  device. They are not accounted with the Tensile backend, module_bytes, modules
+ *  and live_plans are then 0 and modules_accounted is 0. The
+ *  \ref rocsparselt_device_memory_usage is used in the
+ *  \ref rocsparselt_get_device_memory_usage function.
+ */
+typedef struct rocsparselt_device_memory_usage_
+{
+    size_t module_bytes; /**< bytes of the code objects loaded on the device of the handle. */
+    size_t workspace_arena_bytes; /**< bytes held by the workspace arena of the handle. */
+    size_t total_bytes; /**< module_bytes + workspace_arena_bytes. */
+    int    modules; /**< number of code objects loaded on the device of the handle. */
+    int    live_plans; /**< number of plans on the device which keep their code objects loaded. */
+    int    modules_accounted; /**< 1 when the code objects are accounted, 0 otherwise. */
+} rocsparselt_device_memory_usage;
+
+/*! \ingroup types_module
+ *  \brief Runtime statistics of a matrix multiplication plan.
+ *
+ *  \details
+ *  The \ref rocsparselt_matmul_plan_stats is used in the
+ *  \ref rocsparselt_matmul_plan_get_stats function. Bucket 0 of a histogram counts the
+ *  calls shorter than 1 us, bucket i > 0 counts the calls in [2^(i-1), 2^i) us and the
+ *  last bucket also counts all longer calls.
+ */
+typedef struct rocsparselt_matmul_plan_stats_
+{
+    int64_t calls; /**< number of matmuls run with the plan. */
+    int64_t host_time_ns; /**< total host time of the calls. */
+    int64_t host_histogram[32]; /**< histogram of the host time of the calls. */
+    int64_t gpu_samples; /**< number of calls timed on the GPU. */
+    int64_t gpu_time_ns; /**< total GPU time of the sampled calls. */
+    int64_t gpu_histogram[32]; /**< histogram of the GPU time of the sampled calls. */
+} rocsparselt_matmul_plan_stats;
+
 #ifdef __cplusplus
 }
 #endif
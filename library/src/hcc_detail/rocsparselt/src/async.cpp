@@ -0,0 +1,124 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "async.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+void _rocsparselt_async_state::set(rocsparselt_status s)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        status = s;
+        done   = true;
+    }
+    cv.notify_all();
+}
+
+rocsparselt_status _rocsparselt_async_state::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [this] { return done; });
+    return status;
+}
+
+bool _rocsparselt_async_state::ready()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return done;
+}
+
+_rocsparselt_thread_pool& _rocsparselt_thread_pool::instance()
+{
+    static _rocsparselt_thread_pool pool([] {
+        char* str_threads;
+        if((str_threads = getenv("HIPSPARSELT_ASYNC_THREADS")) != NULL && atoi(str_threads) > 0)
+            return atoi(str_threads);
+        return std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 1, 8);
+    }());
+    return pool;
+}
+
+_rocsparselt_thread_pool::_rocsparselt_thread_pool(int num_threads)
+{
+    for(int i = 0; i < num_threads; i++)
+        threads.emplace_back(&_rocsparselt_thread_pool::worker, this);
+}
+
+_rocsparselt_thread_pool::~_rocsparselt_thread_pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    cv.notify_all();
+    for(auto& t : threads)
+        t.join();
+}
+
+void _rocsparselt_thread_pool::submit(std::shared_ptr<_rocsparselt_async_state> state,
+                                      std::function<rocsparselt_status()>       task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.emplace_back([state, task] {
+            rocsparselt_status status;
+            try
+            {
+                status = task();
+            }
+            catch(const rocsparselt_status& s)
+            {
+                status = s;
+            }
+            catch(...)
+            {
+                status = rocsparselt_status_internal_error;
+            }
+            state->set(status);
+        });
+    }
+    cv.notify_one();
+}
+
+void _rocsparselt_thread_pool::worker()
+{
+    while(true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [this] { return stop || !tasks.empty(); });
+            // drain the queue before exiting so that no token is left pending.
+            if(tasks.empty())
+                return;
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
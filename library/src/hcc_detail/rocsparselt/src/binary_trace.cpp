@@ -0,0 +1,323 @@
+/*! \file */
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "binary_trace.hpp"
+#include "hipsparselt_ostream.hpp"
+#include "kernel_arguments.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+namespace
+{
+    std::atomic<uint64_t> binary_trace_count{0};
+
+    int64_t system_ns()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    }
+
+    // the argument count of a launch whose arguments are only known as bytes.
+    constexpr size_t bytes_only = SIZE_MAX;
+
+    uint64_t chunks_of(size_t bytes)
+    {
+        return (bytes + sizeof(rocsparselt_trace_record) - 1) / sizeof(rocsparselt_trace_record);
+    }
+}
+
+_rocsparselt_binary_trace::_rocsparselt_binary_trace()
+    : id(binary_trace_count++)
+{
+    // records per thread, large enough for the longest launch and definition.
+    capacity = 65536;
+    char* str_records;
+    if((str_records = getenv("HIPSPARSELT_TRACE_RECORDS")) != NULL && atoll(str_records) > 0)
+        capacity = std::max<uint64_t>(atoll(str_records), 1024);
+
+    // %i is replaced by the process id and %h by the trace number.
+    std::string path = "hipsparselt_trace_%i_%h.bin";
+    char*       str_path;
+    if((str_path = getenv("HIPSPARSELT_TRACE_FILE")) != NULL)
+        path = str_path;
+    size_t pos;
+    if((pos = path.find("%i")) != std::string::npos)
+        path.replace(pos, 2, std::to_string(getpid()));
+    if((pos = path.find("%h")) != std::string::npos)
+        path.replace(pos, 2, std::to_string(id));
+
+    ofs.open(path, std::ios::binary);
+    if(!ofs.is_open())
+    {
+        hipsparselt_cerr << "failed to open trace file: " << path << std::endl;
+        return;
+    }
+
+    rocsparselt_trace_file_header header = {};
+    memcpy(header.magic, ROCSPARSELT_TRACE_MAGIC, sizeof(header.magic));
+    header.version     = ROCSPARSELT_TRACE_VERSION;
+    header.record_size = sizeof(rocsparselt_trace_record);
+    header.pid         = getpid();
+    header.handle_id   = id;
+    ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+_rocsparselt_binary_trace::~_rocsparselt_binary_trace()
+{
+    flush();
+}
+
+_rocsparselt_binary_trace::buffer* _rocsparselt_binary_trace::get_buffer()
+{
+    // the buffer of the last trace used by this thread, ids are never reused.
+    thread_local struct
+    {
+        uint64_t id = UINT64_MAX;
+        buffer*  b  = nullptr;
+    } cache;
+
+    if(cache.id == id)
+        return cache.b;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto                        thread = std::this_thread::get_id();
+    buffer*                     b      = nullptr;
+    for(auto& it : buffers)
+        if(it->thread == thread)
+            b = it.get();
+    if(b == nullptr)
+    {
+        buffers.push_back(std::make_unique<buffer>());
+        b         = buffers.back().get();
+        b->thread = thread;
+        b->tid    = buffers.size();
+        b->records.reset(new rocsparselt_trace_record[capacity]);
+    }
+    cache.id = id;
+    cache.b  = b;
+    return b;
+}
+
+void _rocsparselt_binary_trace::write(buffer* b)
+{
+    if(ofs.is_open())
+        ofs.write(reinterpret_cast<const char*>(b->records.get()),
+                  b->used * sizeof(rocsparselt_trace_record));
+    b->used = 0;
+}
+
+rocsparselt_trace_record* _rocsparselt_binary_trace::reserve(buffer* b, uint64_t count)
+{
+    if(count > capacity)
+        return nullptr;
+    if(b->used + count > capacity)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        write(b);
+    }
+    rocsparselt_trace_record* r = &b->records[b->used];
+    b->used += count;
+    return r;
+}
+
+void _rocsparselt_binary_trace::define(
+    buffer* b, uint8_t type, uint32_t id, const void* data, size_t bytes)
+{
+    uint64_t                  chunks = chunks_of(bytes);
+    rocsparselt_trace_record* r      = reserve(b, 1 + chunks);
+    if(r == nullptr)
+        return;
+
+    memset(r, 0, (1 + chunks) * sizeof(rocsparselt_trace_record));
+    r->type    = type;
+    r->chunks  = chunks;
+    r->tid     = b->tid;
+    r->time_ns = system_ns();
+    r->id      = id;
+    r->bytes   = bytes;
+    memcpy(r + 1, data, bytes);
+}
+
+uint32_t _rocsparselt_binary_trace::intern_name(buffer* b, const std::string& name)
+{
+    auto it = b->names.find(name);
+    if(it != b->names.end())
+        return it->second;
+
+    uint32_t name_id;
+    bool     added;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto                        res = strings.emplace(name, strings.size());
+        name_id                         = res.first->second;
+        added                           = res.second;
+    }
+    // the definition may end up in the file after records of other threads which use it.
+    if(added)
+        define(b, rocsparselt_trace_record_string, name_id, name.data(), name.size());
+    b->names.emplace(name, name_id);
+    return name_id;
+}
+
+uint32_t _rocsparselt_binary_trace::intern_layout(buffer*                 b,
+                                                  uint32_t                name,
+                                                  size_t                  bytes,
+                                                  const KernelInvocation* kernel)
+{
+    auto key = std::make_tuple(name, bytes, kernel ? kernel->args.count() : bytes_only);
+    auto it  = b->layouts.find(key);
+    if(it != b->layouts.end())
+        return it->second;
+
+    uint32_t layout_id;
+    bool     added;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto                        res = layouts.emplace(key, layouts.size());
+        layout_id                       = res.first->second;
+        added                           = res.second;
+    }
+    if(added)
+    {
+        std::vector<rocsparselt_trace_arg> args;
+        if(kernel)
+        {
+            for(auto const& arg : kernel->args.layout())
+                args.push_back({intern_name(b, *arg.name),
+                                uint32_t(arg.offset),
+                                uint32_t(arg.size),
+                                uint32_t(arg.kind)});
+        }
+        else if(bytes)
+            args.push_back({intern_name(b, "args"), 0, uint32_t(bytes), uint32_t('x')});
+        define(b,
+               rocsparselt_trace_record_layout,
+               layout_id,
+               args.data(),
+               args.size() * sizeof(rocsparselt_trace_arg));
+    }
+    b->layouts.emplace(key, layout_id);
+    return layout_id;
+}
+
+void _rocsparselt_binary_trace::append_launch(buffer*     b,
+                                              const dim3& workgroup,
+                                              const dim3& grid,
+                                              const dim3& items,
+                                              const void* args,
+                                              size_t      bytes)
+{
+    uint64_t                  chunks = chunks_of(bytes);
+    rocsparselt_trace_record* r      = reserve(b, 1 + chunks);
+    if(r == nullptr)
+        return;
+
+    r->type         = rocsparselt_trace_record_launch;
+    r->reserved     = 0;
+    r->chunks       = chunks;
+    r->tid          = b->tid;
+    r->time_ns      = system_ns();
+    r->id           = b->last_name;
+    r->layout       = b->last_layout;
+    r->bytes        = bytes;
+    r->workgroup[0] = workgroup.x;
+    r->workgroup[1] = workgroup.y;
+    r->workgroup[2] = workgroup.z;
+    r->grid[0]      = grid.x;
+    r->grid[1]      = grid.y;
+    r->grid[2]      = grid.z;
+    r->items[0]     = items.x;
+    r->items[1]     = items.y;
+    r->items[2]     = items.z;
+    if(chunks)
+    {
+        // zero the tail of the last chunk so that no uninitialized bytes are written
+        memset(&r[chunks], 0, sizeof(rocsparselt_trace_record));
+        memcpy(r + 1, args, bytes);
+    }
+}
+
+void _rocsparselt_binary_trace::record_launch(const KernelInvocation& kernel, const void* args)
+{
+    buffer* b = get_buffer();
+
+    // a launch mostly repeats the kernel of the last one, which saves hashing the name.
+    size_t bytes = kernel.args.size();
+    size_t count = kernel.args.count();
+    if(!b->has_last || b->last_size != bytes || b->last_count != count
+       || b->last_kernel != kernel.kernelName)
+    {
+        b->has_last    = true;
+        b->last_kernel = kernel.kernelName;
+        b->last_size   = bytes;
+        b->last_count  = count;
+        b->last_name   = intern_name(b, kernel.kernelName);
+        b->last_layout = intern_layout(b, b->last_name, bytes, &kernel);
+    }
+
+    append_launch(
+        b, kernel.workGroupSize, kernel.numWorkGroups, kernel.numWorkItems, args, bytes);
+}
+
+void _rocsparselt_binary_trace::record_launch(const std::string& kernel_name,
+                                              const dim3&        workgroup,
+                                              const dim3&        grid,
+                                              const dim3&        items,
+                                              const void*        args,
+                                              size_t             bytes)
+{
+    buffer* b = get_buffer();
+
+    if(!b->has_last || b->last_size != bytes || b->last_count != bytes_only
+       || b->last_kernel != kernel_name)
+    {
+        b->has_last    = true;
+        b->last_kernel = kernel_name;
+        b->last_size   = bytes;
+        b->last_count  = bytes_only;
+        b->last_name   = intern_name(b, kernel_name);
+        b->last_layout = intern_layout(b, b->last_name, bytes, nullptr);
+    }
+
+    append_launch(b, workgroup, grid, items, args, bytes);
+}
+
+void _rocsparselt_binary_trace::flush()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for(auto& b : buffers)
+        write(b.get());
+    if(ofs.is_open())
+        ofs.flush();
+}
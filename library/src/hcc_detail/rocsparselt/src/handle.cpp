@@ -28,28 +28,98 @@
 #include "definitions.h"
 #include "logging.h"
 #include "status.h"
+#include "binary_trace.hpp"
+#include "timeline.hpp"
 #include "utility.hpp"
 
+#include <algorithm>
 #include <hip/hip_runtime.h>
 
 ROCSPARSELT_KERNEL void init_kernel(){};
 
-void _rocsparselt_handle::init()
+const _rocsparselt_device_info& rocsparselt_get_device_info(int device)
+{
+    struct entry
+    {
+        std::atomic<_rocsparselt_device_info*> info{nullptr};
+        std::mutex                             mutex;
+    };
+
+    // One entry per device, the information is kept until the process exits
+    static std::unique_ptr<entry[]> entries;
+    static int                      count = [] {
+        int n = 0;
+        THROW_IF_HIP_ERROR(hipGetDeviceCount(&n));
+        entries.reset(new entry[n]);
+        return n;
+    }();
+
+    if(device < 0 || device >= count)
+        THROW_IF_HIP_ERROR(hipErrorInvalidDevice);
+
+    auto& e    = entries[device];
+    auto* info = e.info.load(std::memory_order_acquire);
+    if(!info)
+    {
+        // Lock so that only one thread queries the device
+        std::lock_guard<std::mutex> lock(e.mutex);
+
+        info = e.info.load(std::memory_order_relaxed);
+        if(!info)
+        {
+            auto new_info = std::make_unique<_rocsparselt_device_info>();
+            THROW_IF_HIP_ERROR(hipGetDeviceProperties(&new_info->properties, device));
+
+            // strip out xnack/ecc from name
+            std::string gcnArchName(new_info->properties.gcnArchName);
+            new_info->arch_name = gcnArchName.substr(0, gcnArchName.find(":"));
+
+            info = new_info.release();
+            e.info.store(info, std::memory_order_release);
+        }
+    }
+    return *info;
+}
+
+std::shared_ptr<const _rocsparselt_env_config> rocsparselt_get_env_config()
 {
+    static const char* const variables[] = {"HIPSPARSELT_LOG_LEVEL",
+                                            "HIPSPARSELT_LOG_MASK",
+                                            "HIPSPARSELT_LOG_BENCH",
+                                            "HIPSPARSELT_WORKSPACE_ARENA"};
+    constexpr size_t         n           = sizeof(variables) / sizeof(variables[0]);
+
+    // The last configuration and the values it was parsed from, nullptr when unset
+    static std::mutex                                     mutex;
+    static std::shared_ptr<const _rocsparselt_env_config> config;
+    static std::unique_ptr<std::string>                   values[n];
+
+    const char* current[n];
+    for(size_t i = 0; i < n; i++)
+        current[i] = getenv(variables[i]);
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    bool changed = !config;
+    for(size_t i = 0; i < n && !changed; i++)
+        changed = current[i] ? !values[i] || *values[i] != current[i] : values[i] != nullptr;
+    if(!changed)
+        return config;
+
+    auto new_config = std::make_shared<_rocsparselt_env_config>();
+
     // Layer mode
-    log_bench = false;
-    char* str_layer_mode;
-    if((str_layer_mode = getenv("HIPSPARSELT_LOG_LEVEL")) == NULL)
+    const char* str_layer_mode;
+    if((str_layer_mode = current[0]) == NULL)
     {
-        layer_mode = rocsparselt_layer_mode_none;
-        if((str_layer_mode = getenv("HIPSPARSELT_LOG_MASK")) != NULL)
+        if((str_layer_mode = current[1]) != NULL)
         {
-            layer_mode = strtol(str_layer_mode, nullptr, 0);
+            new_config->layer_mode = strtol(str_layer_mode, nullptr, 0);
         }
     }
     else
     {
-        layer_mode = rocsparselt_layer_mode_none;
+        int& layer_mode = new_config->layer_mode;
         switch(atoi(str_layer_mode))
         {
         case rocsparselt_layer_level_log_api:
@@ -69,13 +139,28 @@ void _rocsparselt_handle::init()
         }
     }
 
-    if((str_layer_mode = getenv("HIPSPARSELT_LOG_BENCH")) != NULL)
-    {
-        log_bench = (atoi(str_layer_mode) > 0);
-    }
+    if(current[2] != NULL)
+        new_config->log_bench = (atoi(current[2]) > 0);
+
+    if(current[3] != NULL)
+        new_config->workspace_arena = (atoi(current[3]) > 0);
+
+    for(size_t i = 0; i < n; i++)
+        values[i].reset(current[i] ? new std::string(current[i]) : nullptr);
+    config = std::move(new_config);
+    return config;
+}
 
-    // Open log file
-    if(layer_mode & 0xff)
+void _rocsparselt_handle::init()
+{
+    // Layer mode, the environment is parsed again only when it changed
+    auto config = rocsparselt_get_env_config();
+    layer_mode  = config->layer_mode;
+    log_bench   = config->log_bench;
+
+    // Open log file, the timeline and the binary trace have their own files
+    if(layer_mode & 0xff & ~rocsparselt_layer_mode_log_timeline
+       & ~rocsparselt_layer_mode_log_trace_binary)
     {
         log_trace_ofs = new std::ofstream();
         open_log_stream(&log_trace_os, log_trace_ofs, "HIPSPARSELT_LOG_FILE");
@@ -88,12 +173,19 @@ void _rocsparselt_handle::init()
         open_log_stream(&log_bench_os, log_bench_ofs, "HIPSPARSELT_LOG_BENCH_FILE");
     }
 
+    if(layer_mode & rocsparselt_layer_mode_log_timeline)
+        timeline = std::make_shared<_rocsparselt_timeline>();
+
+    if(layer_mode & rocsparselt_layer_mode_log_trace_binary)
+        binary_trace = std::make_shared<_rocsparselt_binary_trace>();
+
     // Default device is active device
     THROW_IF_HIP_ERROR(hipGetDevice(&device));
     log_trace(this, "handle::init", "hipGetDevice");
 
-    THROW_IF_HIP_ERROR(hipGetDeviceProperties(&properties, device));
-    log_trace(this, "handle::init", "hipGetDeviceProperties", device);
+    // The device properties are queried once per process
+    properties = rocsparselt_get_device_info(device).properties;
+    log_trace(this, "handle::init", "rocsparselt_get_device_info", device);
 
     // Device wavefront size
     wavefront_size = properties.warpSize;
@@ -108,11 +200,28 @@ void _rocsparselt_handle::init()
     is_init = (uintptr_t)(this);
 
     alg_selections = std::make_shared<std::vector<rocsparselt_matmul_alg_selection*>>();
+
+    if(config->workspace_arena)
+        workspace_arena = std::make_shared<_rocsparselt_workspace_arena>();
 }
 
 void _rocsparselt_handle::destroy()
 {
     is_init = 0;
+    // Release the workspace arena
+    std::atomic_store(&workspace_arena, std::shared_ptr<_rocsparselt_workspace_arena>());
+    // Write the timeline
+    if(timeline)
+    {
+        timeline->flush();
+        timeline.reset();
+    }
+    // Write the binary trace
+    if(binary_trace)
+    {
+        binary_trace->flush();
+        binary_trace.reset();
+    }
     // Close log files
     if(log_trace_ofs)
     {
@@ -130,6 +239,164 @@ void _rocsparselt_handle::destroy()
     }
 }
 
+rocsparselt_status
+    _rocsparselt_workspace_arena::acquire(hipStream_t stream, size_t size, void** workspace)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    requests++;
+
+    buffer& buf = buffers[stream];
+    if(buf.size < size)
+    {
+        // growing synchronizes the stream and allocates, a captured stream allows neither.
+        if(isCapturing(stream))
+            return rocsparselt_status_invalid_value;
+        size_t new_size = std::max(size, buf.size * 2);
+        if(buf.ptr != nullptr)
+        {
+            // the old buffer may still be in use by work queued on the stream.
+            RETURN_IF_HIP_ERROR(hipStreamSynchronize(stream));
+            RETURN_IF_HIP_ERROR(hipFree(buf.ptr));
+            current_bytes -= buf.size;
+            buf.ptr  = nullptr;
+            buf.size = 0;
+        }
+        RETURN_IF_HIP_ERROR(hipMalloc(&buf.ptr, new_size));
+        buf.size = new_size;
+        current_bytes += new_size;
+        high_water_bytes = std::max(high_water_bytes, current_bytes);
+        grow_events++;
+    }
+    *workspace = buf.ptr;
+    return rocsparselt_status_success;
+}
+
+_rocsparselt_matmul_plan_stats::_rocsparselt_matmul_plan_stats()
+{
+    char* str_interval;
+    if((str_interval = getenv("HIPSPARSELT_PLAN_STATS_SAMPLING")) != NULL)
+        sample_interval = std::max(atoi(str_interval), 0);
+}
+
+_rocsparselt_matmul_plan_stats::~_rocsparselt_matmul_plan_stats()
+{
+    if(start_event != nullptr)
+        PRINT_IF_HIP_ERROR_2(hipEventDestroy(start_event));
+    if(stop_event != nullptr)
+        PRINT_IF_HIP_ERROR_2(hipEventDestroy(stop_event));
+}
+
+int _rocsparselt_matmul_plan_stats::bucket(int64_t ns)
+{
+    int     b  = 0;
+    int64_t us = ns / 1000;
+    while(us > 0 && b < num_buckets - 1)
+    {
+        us >>= 1;
+        b++;
+    }
+    return b;
+}
+
+void _rocsparselt_matmul_plan_stats::collect()
+{
+    if(!pending || hipEventQuery(stop_event) != hipSuccess)
+        return;
+    float ms;
+    if(hipEventElapsedTime(&ms, start_event, stop_event) == hipSuccess)
+    {
+        int64_t ns = static_cast<int64_t>(ms * 1e6);
+        gpu_samples++;
+        gpu_time_ns += ns;
+        gpu_histogram[bucket(ns)]++;
+    }
+    pending = false;
+}
+
+bool _rocsparselt_matmul_plan_stats::gpu_sample_begin(hipStream_t stream)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    collect();
+    // skip the sample while the previous one is still in flight.
+    if(recording || pending)
+        return false;
+    if(start_event == nullptr)
+    {
+        if(hipEventCreate(&start_event) != hipSuccess)
+            return false;
+        if(hipEventCreate(&stop_event) != hipSuccess)
+        {
+            PRINT_IF_HIP_ERROR_2(hipEventDestroy(start_event));
+            start_event = nullptr;
+            return false;
+        }
+    }
+    if(hipEventRecord(start_event, stream) != hipSuccess)
+        return false;
+    recording = true;
+    return true;
+}
+
+void _rocsparselt_matmul_plan_stats::gpu_sample_end(hipStream_t stream)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    pending   = hipEventRecord(stop_event, stream) == hipSuccess;
+    recording = false;
+}
+
+void _rocsparselt_matmul_plan_stats::get_stats(rocsparselt_matmul_plan_stats* stats)
+{
+    stats->calls        = calls.load(std::memory_order_relaxed);
+    stats->host_time_ns = host_time_ns.load(std::memory_order_relaxed);
+    for(int i = 0; i < num_buckets; i++)
+        stats->host_histogram[i] = host_histogram[i].load(std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    collect();
+    stats->gpu_samples = gpu_samples;
+    stats->gpu_time_ns = gpu_time_ns;
+    for(int i = 0; i < num_buckets; i++)
+        stats->gpu_histogram[i] = gpu_histogram[i];
+}
+
+void _rocsparselt_matmul_plan_stats::reset()
+{
+    calls.store(0, std::memory_order_relaxed);
+    host_time_ns.store(0, std::memory_order_relaxed);
+    for(auto& h : host_histogram)
+        h.store(0, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    // a sample in flight belongs to the previous period.
+    pending     = false;
+    gpu_samples = 0;
+    gpu_time_ns = 0;
+    for(auto& h : gpu_histogram)
+        h = 0;
+}
+
+void _rocsparselt_workspace_arena::release()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for(auto& it : buffers)
+    {
+        if(it.second.ptr != nullptr)
+            PRINT_IF_HIP_ERROR_2(hipFree(it.second.ptr));
+    }
+    buffers.clear();
+    current_bytes = 0;
+}
+
+void _rocsparselt_workspace_arena::get_stats(rocsparselt_workspace_arena_stats* stats) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    stats->current_bytes    = current_bytes;
+    stats->high_water_bytes = high_water_bytes;
+    stats->grow_events      = grow_events;
+    stats->requests         = requests;
+    stats->num_streams      = buffers.size();
+}
+
 std::ostream& operator<<(std::ostream& stream, const _rocsparselt_mat_descr& t)
 {
     stream << "{"
@@ -161,7 +428,9 @@ std::ostream& operator<<(std::ostream& stream, const _rocsparselt_matmul_descr&
            << ", activation_tanh_beta=" << t.activation_tanh_beta
            << ", activation_gelu_scaling=" << t.activation_gelu_scaling
            << ", bias_pointer=" << t.bias_pointer << ", bias_stride=" << t.bias_stride
-           << ", bias_type=" << rocsparselt_datatype_to_string(t.bias_type) << ", m=" << t.m
+           << ", bias_type=" << rocsparselt_datatype_to_string(t.bias_type)
+           << ", output_scale_pointer=" << t.output_scale_pointer
+           << ", output_zero_point_pointer=" << t.output_zero_point_pointer << ", m=" << t.m
            << ", n=" << t.n << ", k=" << t.k << ", is_sparse_a=" << t.is_sparse_a << "}";
     return stream;
 }
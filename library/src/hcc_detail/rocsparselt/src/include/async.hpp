@@ -0,0 +1,105 @@
+/*! \file */
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+#ifndef ASYNC_HPP
+#define ASYNC_HPP
+
+#include "rocsparselt.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*******************************************************************************
+ * \brief _rocsparselt_async_state holds the result of one asynchronous call. It is
+ * shared by the token of the caller and the task running on the thread pool.
+ ******************************************************************************/
+struct _rocsparselt_async_state
+{
+    void               set(rocsparselt_status status);
+    rocsparselt_status wait();
+    bool               ready();
+
+    std::mutex              mutex;
+    std::condition_variable cv;
+    bool                    done   = false;
+    rocsparselt_status      status = rocsparselt_status_success;
+};
+
+/*******************************************************************************
+ * \brief _rocsparselt_async_token is the content of rocsparselt_async_token.
+ * It is constructed by the *_async functions and destructed by
+ * rocsparselt_async_token_wait().
+ ******************************************************************************/
+struct _rocsparselt_async_token
+{
+    bool isInit() const
+    {
+        return is_init != 0 && is_init == (uintptr_t)(this);
+    }
+
+    std::shared_ptr<_rocsparselt_async_state> state;
+    uintptr_t                                 is_init = 0;
+};
+
+static_assert(sizeof(_rocsparselt_async_token) <= sizeof(rocsparselt_async_token),
+              "rocsparselt_async_token is too small");
+
+/*******************************************************************************
+ * \brief _rocsparselt_thread_pool runs the asynchronous initializations. It is
+ * created at the first use with HIPSPARSELT_ASYNC_THREADS workers (default:
+ * the number of hardware threads, at most 8) and lives until the process exits.
+ ******************************************************************************/
+class _rocsparselt_thread_pool
+{
+public:
+    static _rocsparselt_thread_pool& instance();
+
+    ~_rocsparselt_thread_pool();
+
+    // run task on a worker, the returned status is stored into state.
+    void submit(std::shared_ptr<_rocsparselt_async_state> state,
+                std::function<rocsparselt_status()>       task);
+
+private:
+    explicit _rocsparselt_thread_pool(int num_threads);
+
+    void worker();
+
+    std::mutex                        mutex;
+    std::condition_variable           cv;
+    std::deque<std::function<void()>> tasks;
+    std::vector<std::thread>          threads;
+    bool                              stop = false;
+};
+
+#endif // ASYNC_HPP
@@ -0,0 +1,122 @@
+/*! \file */
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+#ifndef BINARY_TRACE_HPP
+#define BINARY_TRACE_HPP
+
+#include "binary_trace_format.h"
+#include "handle.h"
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+struct KernelInvocation;
+
+/*******************************************************************************
+ * \brief _rocsparselt_binary_trace records the kernel launches of a handle as
+ * fixed-size binary records when the layer mode
+ * rocsparselt_layer_mode_log_trace_binary is set, instead of formatting them as
+ * text. Every thread writes into its own buffer without locking and appends it
+ * to HIPSPARSELT_TRACE_FILE when it is full. Kernel names and argument layouts
+ * are interned, a thread only takes the lock the first time it sees one.
+ * rocsparselt-trace-decode renders the file in the text format of the trace
+ * layer.
+ ******************************************************************************/
+class _rocsparselt_binary_trace
+{
+public:
+    _rocsparselt_binary_trace();
+    ~_rocsparselt_binary_trace();
+
+    // args is kernel.args.data(), which the launch has already checked to be bound.
+    void record_launch(const KernelInvocation& kernel, const void* args);
+
+    // a launch whose arguments are only known as bytes, such as a Tensile kernel. The layout
+    // has a single argument of kind x.
+    void record_launch(const std::string& kernel_name,
+                       const dim3&        workgroup,
+                       const dim3&        grid,
+                       const dim3&        items,
+                       const void*        args,
+                       size_t             bytes);
+
+    // write the buffers of all threads, they must not be written concurrently.
+    void flush();
+
+private:
+    struct buffer
+    {
+        std::thread::id                             thread;
+        uint32_t                                    tid;
+        std::unique_ptr<rocsparselt_trace_record[]> records;
+        uint64_t                                    used = 0;
+
+        // the ids this thread has already seen, and those of its last launch
+        std::unordered_map<std::string, uint32_t>                names;
+        std::map<std::tuple<uint32_t, size_t, size_t>, uint32_t> layouts;
+        bool                                                     has_last = false;
+        std::string                                              last_kernel;
+        size_t                                                   last_size;
+        size_t                                                   last_count;
+        uint32_t                                                 last_name;
+        uint32_t                                                 last_layout;
+    };
+
+    buffer*                   get_buffer();
+    rocsparselt_trace_record* reserve(buffer* b, uint64_t count);
+    void                      write(buffer* b);
+    void     define(buffer* b, uint8_t type, uint32_t id, const void* data, size_t bytes);
+    uint32_t intern_name(buffer* b, const std::string& name);
+    // kernel is nullptr for a launch whose arguments are only known as bytes.
+    uint32_t intern_layout(buffer* b, uint32_t name, size_t bytes, const KernelInvocation* kernel);
+    void     append_launch(buffer*     b,
+                           const dim3& workgroup,
+                           const dim3& grid,
+                           const dim3& items,
+                           const void* args,
+                           size_t      bytes);
+
+    uint64_t                             id;
+    uint64_t                             capacity;
+    std::mutex                           mutex;
+    std::ofstream                        ofs;
+    std::vector<std::unique_ptr<buffer>> buffers;
+
+    // interned strings and layouts, guarded by mutex
+    std::unordered_map<std::string, uint32_t>                strings;
+    std::map<std::tuple<uint32_t, size_t, size_t>, uint32_t> layouts;
+};
+
+#endif // BINARY_TRACE_HPP
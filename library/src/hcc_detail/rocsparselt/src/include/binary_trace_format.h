@@ -0,0 +1,87 @@
+/*! \file */
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+#ifndef BINARY_TRACE_FORMAT_H
+#define BINARY_TRACE_FORMAT_H
+
+#include <cstdint>
+
+/*******************************************************************************
+ * \brief layout of the binary trace file written by the
+ * rocsparselt_layer_mode_log_trace_binary layer and read by
+ * rocsparselt-trace-decode. The file header is followed by 64 byte records, a
+ * record may be followed by \p chunks 64 byte records holding its payload.
+ * Strings and argument layouts are defined once and referred to by id, a
+ * definition may come after the records which refer to it.
+ ******************************************************************************/
+#define ROCSPARSELT_TRACE_MAGIC "RSLTTRC1"
+#define ROCSPARSELT_TRACE_VERSION 1
+
+struct rocsparselt_trace_file_header
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    int64_t  pid;
+    uint64_t handle_id;
+};
+
+typedef enum rocsparselt_trace_record_type_
+{
+    rocsparselt_trace_record_launch = 1, /**< a kernel launch, the payload is the arguments. */
+    rocsparselt_trace_record_string = 2, /**< a string, the payload is its characters. */
+    rocsparselt_trace_record_layout = 3, /**< an argument layout, the payload is its entries. */
+} rocsparselt_trace_record_type;
+
+struct rocsparselt_trace_record
+{
+    uint8_t  type;
+    uint8_t  reserved;
+    uint16_t chunks; // payload records which follow
+    uint32_t tid; // thread number within the handle
+    int64_t  time_ns; // system clock
+    uint32_t id; // kernel name of a launch, or the id which is defined
+    uint32_t layout; // argument layout of a launch
+    uint32_t bytes; // payload size
+    uint32_t workgroup[3];
+    uint32_t grid[3];
+    uint32_t items[3];
+};
+static_assert(sizeof(rocsparselt_trace_record) == 64, "trace records are 64 bytes");
+
+// one kernel argument of a layout, name is a string id, kind is
+// p(ointer), f(loat), h(alf), b(float16), i(nt), u(nsigned) or x (bytes only)
+struct rocsparselt_trace_arg
+{
+    uint32_t name;
+    uint32_t offset;
+    uint32_t size;
+    uint32_t kind;
+};
+
+#endif // BINARY_TRACE_FORMAT_H
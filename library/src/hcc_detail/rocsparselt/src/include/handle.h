@@ -28,12 +28,78 @@
 
 #include "rocsparselt.h"
 
+#include <atomic>
 #include <fstream>
 #include <hip/hip_runtime_api.h>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
+class _rocsparselt_timeline;
+class _rocsparselt_binary_trace;
+
+/********************************************************************************
+ * \brief _rocsparselt_workspace_arena holds one device buffer per stream which is
+ * used as workspace by rocsparselt_matmul() when the caller passes NULL. Work on a
+ * stream is serialized, so every plan running on that stream can share the buffer.
+ * A buffer only grows (at least doubling) and all of them are released with the handle.
+ *******************************************************************************/
+struct _rocsparselt_workspace_arena
+{
+    ~_rocsparselt_workspace_arena()
+    {
+        release();
+    }
+
+    rocsparselt_status acquire(hipStream_t stream, size_t size, void** workspace);
+    void               release();
+    void               get_stats(rocsparselt_workspace_arena_stats* stats) const;
+
+    struct buffer
+    {
+        void*  ptr  = nullptr;
+        size_t size = 0;
+    };
+
+    mutable std::mutex                      mutex;
+    std::unordered_map<hipStream_t, buffer> buffers;
+    size_t                                  current_bytes    = 0;
+    size_t                                  high_water_bytes = 0;
+    int64_t                                 grow_events      = 0;
+    int64_t                                 requests         = 0;
+};
+
+/********************************************************************************
+ * \brief _rocsparselt_device_info holds the properties and the architecture name of
+ * a device. They do not change while the process runs, so they are queried on the
+ * first use of the device and shared by all handles and kernel launchers.
+ *******************************************************************************/
+struct _rocsparselt_device_info
+{
+    hipDeviceProp_t properties;
+    // gcnArchName without the target features, e.g. gfx942.
+    std::string arch_name;
+};
+
+const _rocsparselt_device_info& rocsparselt_get_device_info(int device);
+
+/********************************************************************************
+ * \brief _rocsparselt_env_config holds the handle configuration read from the
+ * environment. It is parsed again only when one of the variables it is read from
+ * changes, and a handle keeps the snapshot it was created with.
+ *******************************************************************************/
+struct _rocsparselt_env_config
+{
+    int  layer_mode      = rocsparselt_layer_mode_none;
+    bool log_bench       = false;
+    bool workspace_arena = false;
+};
+
+std::shared_ptr<const _rocsparselt_env_config> rocsparselt_get_env_config();
+
 /********************************************************************************
  * \brief rocsparse_handle is a structure holding the rocsparselt library context.
  * It must be initialized using rocsparse_create_handle()
@@ -56,6 +122,13 @@ struct _rocsparselt_handle
         return is_init != 0 && is_init == (uintptr_t)(this);
     };
 
+    // the arena may be enabled or disabled while matmuls run on other threads, so it is only
+    // accessed through atomic loads and stores of the shared_ptr.
+    std::shared_ptr<_rocsparselt_workspace_arena> get_workspace_arena() const
+    {
+        return std::atomic_load(&workspace_arena);
+    }
+
     // device id
     int device;
     // device properties
@@ -84,6 +157,15 @@ struct _rocsparselt_handle
 
     // hold pointers to alg_selection objects for releasing algo configs inside them.
     std::shared_ptr<std::vector<rocsparselt_matmul_alg_selection*>> alg_selections;
+
+    // workspace arena, nullptr when disabled. See get_workspace_arena().
+    std::shared_ptr<_rocsparselt_workspace_arena> workspace_arena;
+
+    // timeline of the rocsparselt_layer_mode_log_timeline layer, nullptr when disabled.
+    std::shared_ptr<_rocsparselt_timeline> timeline;
+
+    // binary trace of the rocsparselt_layer_mode_log_trace_binary layer, nullptr when disabled.
+    std::shared_ptr<_rocsparselt_binary_trace> binary_trace;
 };
 
 /********************************************************************************
@@ -210,6 +292,8 @@ struct _rocsparselt_matmul_descr
         , bias_pointer(rhs.bias_pointer)
         , bias_stride(rhs.bias_stride)
         , bias_type(rhs.bias_type)
+        , output_scale_pointer(rhs.output_scale_pointer)
+        , output_zero_point_pointer(rhs.output_zero_point_pointer)
         , m(rhs.m)
         , n(rhs.n)
         , k(rhs.k)
@@ -270,10 +354,13 @@ struct _rocsparselt_matmul_descr
     float*               bias_pointer               = nullptr;
     int64_t              bias_stride                = 0;
     rocsparselt_datatype bias_type;
-    int64_t              m           = 0;
-    int64_t              n           = 0;
-    int64_t              k           = 0;
-    bool                 is_sparse_a = true;
+    // per row scales and zero points of the output quantization epilogue.
+    const float* output_scale_pointer      = nullptr;
+    const float* output_zero_point_pointer = nullptr;
+    int64_t      m                         = 0;
+    int64_t      n                         = 0;
+    int64_t      k                         = 0;
+    bool         is_sparse_a               = true;
 
 private:
     bool      is_reference = true;
@@ -331,6 +418,8 @@ struct _rocsparselt_matmul_alg_selection
     _rocsparselt_matmul_config configs[100];
 
     rocsparselt_matmul_alg alg;
+    // a quantized output runs quantized_spmm_kernel, configs[0] is its only config.
+    bool quantized_output = false;
     //data of rocsparselt_matmul_alg_attribute
     int       config_id         = 0;
     int       config_max_id     = 0;
@@ -338,6 +427,68 @@ struct _rocsparselt_matmul_alg_selection
     uintptr_t is_init           = 0;
 };
 
+/********************************************************************************
+ * \brief _rocsparselt_matmul_plan_stats holds the runtime counters of a plan.
+ * The call count and the host time histogram are relaxed atomics, so a call which
+ * is not sampled never takes a lock. A sampled call records a pair of events which
+ * is read back by the next sample or by get_stats() once the GPU has reached it.
+ *******************************************************************************/
+struct _rocsparselt_matmul_plan_stats
+{
+    static constexpr int num_buckets = 32;
+    static_assert(sizeof(rocsparselt_matmul_plan_stats::host_histogram)
+                      == num_buckets * sizeof(int64_t),
+                  "histogram size mismatch");
+
+    _rocsparselt_matmul_plan_stats();
+    ~_rocsparselt_matmul_plan_stats();
+
+    // returns the index of the call, used to decide the sampling.
+    int64_t begin_call()
+    {
+        return calls.fetch_add(1, std::memory_order_relaxed);
+    }
+    void end_call(int64_t host_ns)
+    {
+        host_time_ns.fetch_add(host_ns, std::memory_order_relaxed);
+        host_histogram[bucket(host_ns)].fetch_add(1, std::memory_order_relaxed);
+    }
+    bool is_sampled(int64_t call) const
+    {
+        int32_t interval = sample_interval.load(std::memory_order_relaxed);
+        return interval > 0 && call % interval == 0;
+    }
+
+    // time the work queued on stream between the two calls, false when skipped.
+    bool gpu_sample_begin(hipStream_t stream);
+    void gpu_sample_end(hipStream_t stream);
+
+    void get_stats(rocsparselt_matmul_plan_stats* stats);
+    void reset();
+
+    static int bucket(int64_t ns);
+
+    std::atomic<int32_t> sample_interval{0};
+    std::atomic<int64_t> calls{0};
+    std::atomic<int64_t> host_time_ns{0};
+    std::atomic<int64_t> host_histogram[num_buckets] = {};
+
+private:
+    // read back the pending sample if the GPU is done with it, mutex must be held.
+    void collect();
+
+    std::mutex mutex;
+    hipEvent_t start_event = nullptr;
+    hipEvent_t stop_event  = nullptr;
+    bool       recording   = false;
+    bool       pending     = false;
+
+    // sampled gpu time, guarded by mutex.
+    int64_t gpu_samples                = 0;
+    int64_t gpu_time_ns                = 0;
+    int64_t gpu_histogram[num_buckets] = {};
+};
+
 /********************************************************************************
  * \brief rocsparselt_matmul_plan holds the matrix multiplication execution plan,
  * namely all the information necessary to execute the rocsparselt_matmul() operation.
@@ -368,8 +519,10 @@ struct _rocsparselt_matmul_plan
     void clear()
     {
         delete matmul_descr;
+        delete stats;
         matmul_descr  = nullptr;
         alg_selection = nullptr;
+        stats         = nullptr;
         is_init       = 0;
     }
 
@@ -380,6 +533,8 @@ struct _rocsparselt_matmul_plan
     _rocsparselt_matmul_descr* matmul_descr = nullptr;
     //
     _rocsparselt_matmul_alg_selection* alg_selection = nullptr;
+    // runtime counters
+    _rocsparselt_matmul_plan_stats* stats = nullptr;
 
     //
     uintptr_t is_init = 0;
@@ -32,6 +32,7 @@
 
 #include <map>
 #include <mutex>
+#include <unordered_map>
 
 class SolutionAdapter
 {
@@ -74,13 +75,22 @@ public:
     size_t        getKernelCounts(std::string const& category);
     KernelParams* getKernelParams(std::string const& category);
 
+    // the code objects of a category referenced by a live plan stay loaded.
+    void       retainCategory(std::string const& category);
+    void       releaseCategory(std::string const& category);
+    void       getMemoryUsage(size_t* bytes, int* modules, int* plans);
+    hipError_t unloadUnusedModules(const _rocsparselt_handle* handle, size_t* freed_bytes);
+
 private:
     using function_table = std::map<std::string, void*>;
 
     hipError_t getKernel(hipFunction_t& rv, std::string const& name);
+    bool       isLoaded(std::string const& name);
     std::mutex m_access;
     std::unordered_map<std::string, hipModule_t>   m_modules;
     std::unordered_map<std::string, hipFunction_t> m_kernels;
+    std::unordered_map<std::string, size_t>        m_module_bytes;
+    std::unordered_map<std::string, int>           m_category_refs;
     std::string                                    m_name = "HipSolutionAdapter";
     std::vector<std::string>                       m_loadedModuleNames;
     std::vector<void*>                             m_lib_handles;
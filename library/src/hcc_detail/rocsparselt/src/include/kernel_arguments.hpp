@@ -55,6 +55,18 @@ public:
     void const* data() const;
     size_t      size() const;
 
+    // name, offset, size and kind (see rocsparselt_trace_arg) of the arguments in order, for
+    // the binary trace. It is empty without logging.
+    struct ArgLayout
+    {
+        std::string const* name;
+        size_t             offset;
+        size_t             size;
+        char               kind;
+    };
+    size_t                 count() const;
+    std::vector<ArgLayout> layout() const;
+
     friend std::ostream& operator<<(std::ostream& stream, const KernelArguments& t);
     friend class const_iterator;
 
@@ -93,9 +105,10 @@ private:
         ArgSize,
         ArgBound,
         ArgString,
+        ArgKind,
         NumArgFields
     };
-    using Arg = std::tuple<size_t, size_t, bool, std::string>;
+    using Arg = std::tuple<size_t, size_t, bool, std::string, char>;
     static_assert(std::tuple_size<Arg>::value == NumArgFields,
                   "Enum for fields of Arg tuple doesn't match size of tuple.");
 
@@ -107,6 +120,9 @@ private:
     template <typename T>
     std::string stringForValue(T value, bool bound);
 
+    template <typename T>
+    static constexpr char kindForValue();
+
     void appendRecord(std::string const& name, Arg info);
 
     template <typename T>
@@ -190,6 +206,22 @@ inline std::string KernelArguments::stringForValue(T value, bool bound)
     return msg.str();
 }
 
+template <typename T>
+constexpr char KernelArguments::kindForValue()
+{
+    if(std::is_pointer<T>{})
+        return 'p';
+    if(std::is_floating_point<T>{})
+        return 'f';
+    if(std::is_same<T, __half>{})
+        return 'h';
+    if(std::is_same<T, hip_bfloat16>{})
+        return 'b';
+    if(std::is_integral<T>{})
+        return std::is_signed<T>{} ? 'i' : 'u';
+    return 'x';
+}
+
 template <typename T>
 inline void KernelArguments::append(std::string const& name, T value, bool bound)
 {
@@ -201,7 +233,7 @@ inline void KernelArguments::append(std::string const& name, T value, bool bound
     if(m_log)
     {
         std::string valueString = stringForValue(value, bound);
-        appendRecord(name, Arg(offset, size, bound, valueString));
+        appendRecord(name, Arg(offset, size, bound, valueString, kindForValue<T>()));
     }
 
     m_data.insert(m_data.end(), sizeof(value), 0);
@@ -239,6 +271,29 @@ inline void KernelArguments::appendRecord(std::string const& name, KernelArgumen
     m_names.push_back(name);
 }
 
+inline size_t KernelArguments::count() const
+{
+    return m_names.size();
+}
+
+inline std::vector<KernelArguments::ArgLayout> KernelArguments::layout() const
+{
+    std::vector<ArgLayout> rv;
+    if(!m_log)
+        return rv;
+
+    rv.reserve(m_names.size());
+    for(auto const& name : m_names)
+    {
+        auto const& record = m_argRecords.at(name);
+        rv.push_back({&name,
+                      std::get<ArgOffset>(record),
+                      std::get<ArgSize>(record),
+                      std::get<ArgKind>(record)});
+    }
+    return rv;
+}
+
 template <typename T>
 KernelArguments::const_iterator::operator T() const
 {
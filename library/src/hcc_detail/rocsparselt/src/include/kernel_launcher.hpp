@@ -163,6 +163,10 @@ struct RocsparseltContractionProblem
     const void*                 bias_vector;
     int64_t                     bias_stride;
 
+    // per row scales and zero points of the output quantization, see quantized_spmm_kernel.
+    const float* scale_vector      = nullptr;
+    const float* zero_point_vector = nullptr;
+
     void *workspace;
     size_t workspaceSize;
 
@@ -498,7 +502,9 @@ struct RocsparseltContractionProblem
                             "activation_argument_1",
                             prob.act_arg1,
                             "bias_stride",
-                            prob.bias_stride));
+                            prob.bias_stride,
+                            "has_output_scale",
+                            prob.scale_vector != nullptr));
     };
 };
 
@@ -516,6 +522,18 @@ rocsparselt_status initSolutions(const _rocsparselt_handle* handle,
 template <typename Ti, typename To, typename Tc>
 std::string generate_kernel_category_str(rocsparselt_operation opA, rocsparselt_operation opB);
 
+/******************************************************************************
+ * Reference counts of the live plans keeping their code objects loaded, and  *
+ * the device memory held by the code objects of the device of a handle.      *
+ ******************************************************************************/
+void retainSolutions(const _rocsparselt_matmul_plan* plan);
+void releaseSolutions(const _rocsparselt_matmul_plan* plan);
+void getModuleMemoryUsage(const _rocsparselt_handle* handle,
+                          size_t*                    bytes,
+                          int*                       modules,
+                          int*                       plans);
+rocsparselt_status unloadUnusedModules(const _rocsparselt_handle* handle, size_t* freed_bytes);
+
 /***********************************************************************************
  * Whether Kernel Launcher has been initialized for at least one device (used for testing) *
  ***********************************************************************************/
@@ -0,0 +1,102 @@
+/*! \file */
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+#ifndef ROCSPARSELT_SHARD_HPP
+#define ROCSPARSELT_SHARD_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+/*******************************************************************************
+ * \brief split [0, extent) into numShards contiguous ranges proportional to
+ * weights (e.g. the CU count of each device). Every range starts at a multiple of
+ * granularity so that only the last non-empty range can be partial. The units left
+ * over by the integer division go to the shards with the largest remainders, ties
+ * go to the lower index. Pure host code, so the balancing can be checked with any
+ * mock set of device weights.
+ ******************************************************************************/
+inline bool rocsparselt_shard_partition(int            numShards,
+                                        const int*     weights,
+                                        int64_t        extent,
+                                        int64_t        granularity,
+                                        int64_t*       offsets,
+                                        int64_t*       sizes)
+{
+    if(numShards <= 0 || extent < 0 || granularity <= 0)
+        return false;
+
+    int64_t total_weight = 0;
+    for(int i = 0; i < numShards; i++)
+    {
+        if(weights[i] < 0)
+            return false;
+        total_weight += weights[i];
+    }
+    if(total_weight == 0)
+        return false;
+
+    int64_t units = (extent + granularity - 1) / granularity;
+
+    std::vector<int64_t> shard_units(numShards);
+    std::vector<int64_t> remainders(numShards);
+    int64_t              assigned = 0;
+    for(int i = 0; i < numShards; i++)
+    {
+        // units * weight may not fit in 64 bits for huge extents, so divide in two steps.
+        shard_units[i] = units / total_weight * weights[i]
+                         + (units % total_weight) * weights[i] / total_weight;
+        remainders[i]  = (units % total_weight) * weights[i] % total_weight;
+        assigned += shard_units[i];
+    }
+
+    std::vector<int> order(numShards);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return remainders[a] > remainders[b];
+    });
+    for(int i = 0; assigned < units; i = (i + 1) % numShards)
+    {
+        if(weights[order[i]] == 0)
+            continue;
+        shard_units[order[i]]++;
+        assigned++;
+    }
+
+    int64_t offset = 0;
+    for(int i = 0; i < numShards; i++)
+    {
+        offsets[i] = offset;
+        sizes[i]   = std::min(offset + shard_units[i] * granularity, extent) - offset;
+        offset += sizes[i];
+    }
+    return true;
+}
+
+#endif // ROCSPARSELT_SHARD_HPP
@@ -93,6 +93,62 @@ inline int64_t rocsparselt_metadata_offset_in_compressed_matrix(int64_t
     return offset;
 }
 
+/*******************************************************************************
+ * Dirty tile bitmap of the incremental prune/compress kernels.
+ * The prune (strip and tile) and compress kernels all work on 16x16 macro tiles,
+ * one bit covers one macro tile of the stored (column major) matrix:
+ *   bit = row_tile + col_tile * tiles_row + batch * tiles_row * tiles_col
+ * stride0/stride1 map the kernel's (wg0I, wg1J) onto (row_tile, col_tile).
+ ******************************************************************************/
+constexpr int64_t ROCSPARSELT_SMFMAC_TILE_SIZE = 16;
+
+struct rocsparselt_tile_mask
+{
+    const uint8_t* bits         = nullptr; // nullptr, all tiles are dirty.
+    int64_t        stride0      = 0;
+    int64_t        stride1      = 0;
+    int64_t        batch_stride = 0;
+
+    __device__ inline bool is_dirty(int64_t wg0I, int64_t wg1J, int64_t batchId) const
+    {
+        if(bits == nullptr)
+            return true;
+        int64_t bit = wg0I * stride0 + wg1J * stride1 + batchId * batch_stride;
+        return (bits[bit >> 3] >> (bit & 7)) & 0x01;
+    }
+};
+
+inline void rocsparselt_tile_mask_dims(const _rocsparselt_mat_descr* matrix,
+                                       int64_t&                      tiles_row,
+                                       int64_t&                      tiles_col,
+                                       int&                          num_batches)
+{
+    tiles_row   = (matrix->m + ROCSPARSELT_SMFMAC_TILE_SIZE - 1) / ROCSPARSELT_SMFMAC_TILE_SIZE;
+    tiles_col   = (matrix->n + ROCSPARSELT_SMFMAC_TILE_SIZE - 1) / ROCSPARSELT_SMFMAC_TILE_SIZE;
+    num_batches = matrix->batch_stride == 0 ? 1 : matrix->num_batches;
+}
+
+// stride0 is the element stride of the kernel's first dimension,
+// it is 1 when that dimension walks along the rows of the stored matrix.
+inline rocsparselt_tile_mask rocsparselt_make_tile_mask(const _rocsparselt_mat_descr* matrix,
+                                                        int64_t                       stride0,
+                                                        const void*                   d_tileMask)
+{
+    rocsparselt_tile_mask mask;
+    if(d_tileMask == nullptr)
+        return mask;
+
+    int64_t tiles_row, tiles_col;
+    int     num_batches;
+    rocsparselt_tile_mask_dims(matrix, tiles_row, tiles_col, num_batches);
+
+    mask.bits         = reinterpret_cast<const uint8_t*>(d_tileMask);
+    mask.stride0      = stride0 == 1 ? 1 : tiles_row;
+    mask.stride1      = stride0 == 1 ? tiles_row : 1;
+    mask.batch_stride = tiles_row * tiles_col;
+    return mask;
+}
+
 template <typename T>
 inline rocsparselt_status validateSetAttributeDataSize(size_t dataSize,
                                                        size_t expectedSize = sizeof(T))
@@ -362,6 +418,24 @@ inline rocsparselt_status validateMatmulDescrArgs(const _rocsparselt_handle* han
     return rocsparselt_status_success;
 }
 
+/*******************************************************************************
+ * The kernels have no per row alpha and no fp32 output. A quantized output is
+ * computed by quantized_spmm_kernel, which applies the scales and zero points
+ * to the int32 accumulators, with the single config 0 and no workspace.
+ ******************************************************************************/
+inline bool matmul_output_is_quantized(const _rocsparselt_matmul_descr* matmulDescr)
+{
+    return matmulDescr->output_scale_pointer != nullptr;
+}
+
+// workspace of the config of a plan.
+inline size_t matmul_workspace_size(const _rocsparselt_matmul_plan* plan, int config_id)
+{
+    auto algSelection = plan->alg_selection;
+    return algSelection->config_max_id == 0 ? 0
+                                            : algSelection->configs[config_id].max_workspace_bytes;
+}
+
 template <typename Ti, typename To, typename Tc>
 rocsparselt_status ConstructRocSparseLtProblem(const char*                                 caller,
                                                RocsparseltContractionProblem<Ti, To, Tc>** prob,
@@ -107,6 +107,10 @@ struct RocsparseltContractionProblem
     int64_t                     bias_stride;
     rocsparselt_datatype        bias_type;
 
+    // per row scales and zero points of the output quantization, see quantized_spmm_kernel.
+    const float* scale_vector      = nullptr;
+    const float* zero_point_vector = nullptr;
+
     void*  workspace;
     size_t workspaceSize;
 
@@ -460,7 +464,9 @@ struct RocsparseltContractionProblem
                             "bias_stride",
                             prob.bias_stride,
                             "bias_type",
-                            rocsparselt_datatype_to_string(prob.bias_type)));
+                            rocsparselt_datatype_to_string(prob.bias_type),
+                            "has_output_scale",
+                            prob.scale_vector != nullptr));
     };
 };
 
@@ -0,0 +1,179 @@
+/*! \file */
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+#ifndef TIMELINE_HPP
+#define TIMELINE_HPP
+
+#include "handle.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*******************************************************************************
+ * \brief kind of a span recorded by the timeline layer.
+ ******************************************************************************/
+typedef enum rocsparselt_timeline_kind_
+{
+    rocsparselt_timeline_kind_api,
+    rocsparselt_timeline_kind_plan_init,
+    rocsparselt_timeline_kind_code_object_load,
+    rocsparselt_timeline_kind_kernel_launch,
+    rocsparselt_timeline_kind_search,
+} rocsparselt_timeline_kind;
+
+/*******************************************************************************
+ * \brief one complete span of the timeline. \p name must be a string literal,
+ * anything else goes to \p detail.
+ ******************************************************************************/
+struct rocsparselt_timeline_event
+{
+    const char*               name;
+    rocsparselt_timeline_kind kind;
+    int32_t                   value;
+    int64_t                   begin_ns;
+    int64_t                   end_ns;
+    uint32_t                  grid[3];
+    uint32_t                  workgroup[3];
+    char                      detail[96];
+};
+
+/*******************************************************************************
+ * \brief _rocsparselt_timeline records the spans of a handle when the layer mode
+ * rocsparselt_layer_mode_log_timeline is set. Every thread writes into its own
+ * ring buffer without locking, the oldest spans are overwritten when a ring is
+ * full. The rings are written as a Chrome trace (chrome://tracing, Perfetto) to
+ * HIPSPARSELT_TIMELINE_FILE when the handle is destroyed.
+ ******************************************************************************/
+class _rocsparselt_timeline
+{
+public:
+    _rocsparselt_timeline();
+
+    void record(const rocsparselt_timeline_event& event);
+
+    // write the Chrome trace, rings must not be written concurrently.
+    void flush(std::ostream& os) const;
+    void flush() const;
+
+    static int64_t now_ns()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+private:
+    struct ring
+    {
+        std::thread::id                               thread;
+        uint32_t                                      tid;
+        std::unique_ptr<rocsparselt_timeline_event[]> events;
+        std::atomic<uint64_t>                         head{0};
+    };
+
+    ring* get_ring();
+
+    uint64_t                           id;
+    uint64_t                           capacity;
+    mutable std::mutex                 mutex;
+    std::vector<std::unique_ptr<ring>> rings;
+};
+
+/*******************************************************************************
+ * \brief rocsparselt_timeline_span records the lifetime of the object as one
+ * span of the timeline of \p handle, it does nothing when the timeline is off.
+ ******************************************************************************/
+class rocsparselt_timeline_span
+{
+public:
+    rocsparselt_timeline_span(const _rocsparselt_handle* handle,
+                              rocsparselt_timeline_kind  kind,
+                              const char*                name)
+        : timeline(handle != nullptr ? handle->timeline.get() : nullptr)
+    {
+        if(timeline)
+        {
+            event          = {};
+            event.name     = name;
+            event.kind     = kind;
+            event.value    = -1;
+            event.begin_ns = _rocsparselt_timeline::now_ns();
+        }
+    }
+
+    ~rocsparselt_timeline_span()
+    {
+        if(timeline)
+        {
+            event.end_ns = _rocsparselt_timeline::now_ns();
+            timeline->record(event);
+        }
+    }
+
+    rocsparselt_timeline_span(const rocsparselt_timeline_span&) = delete;
+    rocsparselt_timeline_span& operator=(const rocsparselt_timeline_span&) = delete;
+
+    bool active() const
+    {
+        return timeline != nullptr;
+    }
+
+    void set_value(int32_t value)
+    {
+        event.value = value;
+    }
+
+    void set_detail(const std::string& detail)
+    {
+        if(timeline)
+            detail.copy(event.detail, sizeof(event.detail) - 1);
+    }
+
+    void set_dims(const dim3& grid, const dim3& workgroup)
+    {
+        event.grid[0]      = grid.x;
+        event.grid[1]      = grid.y;
+        event.grid[2]      = grid.z;
+        event.workgroup[0] = workgroup.x;
+        event.workgroup[1] = workgroup.y;
+        event.workgroup[2] = workgroup.z;
+    }
+
+private:
+    _rocsparselt_timeline*     timeline;
+    rocsparselt_timeline_event event;
+};
+
+#endif // TIMELINE_HPP
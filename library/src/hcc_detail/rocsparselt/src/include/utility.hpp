@@ -52,6 +52,15 @@ inline bool isAligned(const void* pointer, size_t byte_count)
     return reinterpret_cast<uintptr_t>(pointer) % byte_count == 0;
 }
 
+// whether the work queued on stream is captured into a graph instead of run, a failed
+// query (the null stream while another stream is captured) counts as a capture.
+inline bool isCapturing(hipStream_t stream)
+{
+    hipStreamCaptureStatus status = hipStreamCaptureStatusNone;
+    return hipStreamIsCapturing(stream, &status) != hipSuccess
+           || status != hipStreamCaptureStatusNone;
+}
+
 // return precision string for rocsparselt_datatype
 constexpr const char* rocsparselt_datatype_string(rocsparselt_datatype type)
 {
@@ -192,10 +201,9 @@ void log_api(const _rocsparselt_handle* handle, const char* func, H head, Ts&&..
 // (handle->layer_mode & rocsparselt_layer_mode_log_bench) == true
 // then
 // log_bench will call log_arguments to log a string that
-// can be input to the executable rocsparselt-bench.
+// can be input to the executable hipsparselt-bench.
 template <typename H, typename... Ts>
-void log_bench(
-    const _rocsparselt_handle* handle, const char* func, H head, std::string precision, Ts&&... xs)
+void log_bench(const _rocsparselt_handle* handle, const char* func, H head, Ts&&... xs)
 {
     if(nullptr != handle && nullptr != handle->log_bench_os)
     {
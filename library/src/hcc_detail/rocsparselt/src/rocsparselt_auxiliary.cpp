@@ -24,6 +24,7 @@
  *
  *******************************************************************************/
 
+#include "async.hpp"
 #include "definitions.h"
 #include "handle.h"
 #if BUILD_WITH_TENSILE
@@ -34,6 +35,7 @@
 #include "rocsparselt.h"
 #include "rocsparselt_spmm_utils.hpp"
 #include "status.h"
+#include "timeline.hpp"
 #include "utility.hpp"
 
 #include <hip/hip_runtime_api.h>
@@ -109,6 +111,154 @@ rocsparselt_status rocsparselt_destroy(const rocsparselt_handle* handle)
     return rocsparselt_status_success;
 }
 
+/********************************************************************************
+ * \brief enable/disable the workspace arena of the handle
+ *******************************************************************************/
+rocsparselt_status rocsparselt_workspace_arena_set_enabled(const rocsparselt_handle* handle,
+                                                           int                       enable)
+{
+    // Check if handle is valid
+    if(handle == nullptr)
+    {
+        hipsparselt_cerr << "handle is a NULL pointer" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+    auto _handle = reinterpret_cast<_rocsparselt_handle*>(const_cast<rocsparselt_handle*>(handle));
+    if(!_handle->isInit())
+    {
+        hipsparselt_cerr << "handle did not initialized or already destroyed" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+
+    log_api(_handle, __func__, "handle[in]", _handle, "enable[in]", enable);
+
+    // matmuls running on other threads keep their own reference to a disabled arena.
+    if(enable)
+    {
+        std::shared_ptr<_rocsparselt_workspace_arena> none;
+        std::atomic_compare_exchange_strong(
+            &_handle->workspace_arena, &none, std::make_shared<_rocsparselt_workspace_arena>());
+    }
+    else
+        std::atomic_store(&_handle->workspace_arena,
+                          std::shared_ptr<_rocsparselt_workspace_arena>());
+    return rocsparselt_status_success;
+}
+
+/********************************************************************************
+ * \brief get the statistics of the workspace arena of the handle
+ *******************************************************************************/
+rocsparselt_status rocsparselt_workspace_arena_get_stats(const rocsparselt_handle*          handle,
+                                                         rocsparselt_workspace_arena_stats* stats)
+{
+    // Check if handle is valid
+    if(handle == nullptr)
+    {
+        hipsparselt_cerr << "handle is a NULL pointer" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+    auto _handle = reinterpret_cast<const _rocsparselt_handle*>(handle);
+    if(!_handle->isInit())
+    {
+        hipsparselt_cerr << "handle did not initialized or already destroyed" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+
+    if(stats == nullptr)
+    {
+        log_error(_handle, __func__, "stats is a NULL pointer");
+        return rocsparselt_status_invalid_pointer;
+    }
+
+    log_api(_handle, __func__, "handle[in]", _handle, "stats[out]", stats);
+
+    auto arena = _handle->get_workspace_arena();
+    if(arena == nullptr)
+        memset(stats, 0, sizeof(rocsparselt_workspace_arena_stats));
+    else
+        arena->get_stats(stats);
+    return rocsparselt_status_success;
+}
+
+/********************************************************************************
+ * \brief get the device memory held by the code objects and the workspace arena
+ *******************************************************************************/
+rocsparselt_status rocsparselt_get_device_memory_usage(const rocsparselt_handle*        handle,
+                                                       rocsparselt_device_memory_usage* usage)
+{
+    // Check if handle is valid
+    if(handle == nullptr)
+    {
+        hipsparselt_cerr << "handle is a NULL pointer" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+    auto _handle = reinterpret_cast<const _rocsparselt_handle*>(handle);
+    if(!_handle->isInit())
+    {
+        hipsparselt_cerr << "handle did not initialized or already destroyed" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+
+    if(usage == nullptr)
+    {
+        log_error(_handle, __func__, "usage is a NULL pointer");
+        return rocsparselt_status_invalid_pointer;
+    }
+
+    log_api(_handle, __func__, "handle[in]", _handle, "usage[out]", usage);
+
+    // Tensile owns its code objects and does not report their size, only the arena is accounted.
+    memset(usage, 0, sizeof(rocsparselt_device_memory_usage));
+#if !BUILD_WITH_TENSILE
+    getModuleMemoryUsage(_handle, &usage->module_bytes, &usage->modules, &usage->live_plans);
+    usage->modules_accounted = 1;
+#endif
+    auto arena = _handle->get_workspace_arena();
+    if(arena != nullptr)
+    {
+        rocsparselt_workspace_arena_stats stats;
+        arena->get_stats(&stats);
+        usage->workspace_arena_bytes = stats.current_bytes;
+    }
+    usage->total_bytes = usage->module_bytes + usage->workspace_arena_bytes;
+    return rocsparselt_status_success;
+}
+
+/********************************************************************************
+ * \brief unload the code objects of the device which no live plan uses
+ *******************************************************************************/
+rocsparselt_status rocsparselt_unload_unused_modules(const rocsparselt_handle* handle,
+                                                     size_t*                   freedBytes)
+{
+    // Check if handle is valid
+    if(handle == nullptr)
+    {
+        hipsparselt_cerr << "handle is a NULL pointer" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+    auto _handle = reinterpret_cast<const _rocsparselt_handle*>(handle);
+    if(!_handle->isInit())
+    {
+        hipsparselt_cerr << "handle did not initialized or already destroyed" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+
+    log_api(_handle, __func__, "handle[in]", _handle, "freedBytes[out]", freedBytes);
+
+#if BUILD_WITH_TENSILE
+    // Tensile keeps the code objects it loaded until the process exits.
+    log_error(_handle, __func__, "the code objects of Tensile cannot be unloaded");
+    return rocsparselt_status_not_implemented;
+#else
+    size_t freed = 0;
+    RETURN_IF_ROCSPARSELT_ERROR(unloadUnusedModules(_handle, &freed));
+    log_info(_handle, __func__, "freed bytes", freed);
+    if(freedBytes != nullptr)
+        *freedBytes = freed;
+    return rocsparselt_status_success;
+#endif
+}
+
 /********************************************************************************
  * \brief rocsparse_mat_descr is a structure holding the rocsparselt matrix
  * content. It must be initialized using rocsparselt_dense_descr_init() or
@@ -877,6 +1027,36 @@ rocsparselt_status
                 assign_data(&_matmulDescr->bias_type);
                 break;
             }
+            case rocsparselt_matmul_output_scale_pointer:
+            case rocsparselt_matmul_output_zero_point_pointer:
+            {
+                if((status = validateGetAttributeDataSize<void*>(dataSize))
+                   != rocsparselt_status_success)
+                {
+                    log_error(_handle, __func__, "dataSize is invalid");
+                    return status;
+                }
+                if(_matmulDescr->matrix_A->type != rocsparselt_datatype_i8_r
+                   || (_matmulDescr->matrix_D->type != rocsparselt_datatype_i8_r
+                       && _matmulDescr->matrix_D->type != rocsparselt_datatype_f16_r))
+                {
+                    hipsparselt_cerr << "The output quantization needs an int8 input and an int8 "
+                                        "or fp16 output"
+                                     << std::endl;
+                    log_error(_handle,
+                              __func__,
+                              "The output quantization needs an int8 input and an int8 or fp16 "
+                              "output");
+                    return rocsparselt_status_not_implemented;
+                }
+                memcpy(matmulAttribute == rocsparselt_matmul_output_scale_pointer
+                           ? &_matmulDescr->output_scale_pointer
+                           : &_matmulDescr->output_zero_point_pointer,
+                       data,
+                       sizeof(const float*));
+                status = rocsparselt_status_success;
+                break;
+            }
             default:
                 log_error(
                     _handle, __func__, "matmulAttribute", matmulAttribute, "is not implemented");
@@ -1016,6 +1196,21 @@ rocsparselt_status
                 retrive_data(_matmulDescr->bias_type);
                 break;
             }
+            case rocsparselt_matmul_output_scale_pointer:
+            case rocsparselt_matmul_output_zero_point_pointer:
+                if((status = validateGetAttributeDataSize<void*>(dataSize))
+                   != rocsparselt_status_success)
+                {
+                    log_error(_handle, __func__, "dataSize is invalid");
+                    return status;
+                }
+                memcpy(data,
+                       matmulAttribute == rocsparselt_matmul_output_scale_pointer
+                           ? &_matmulDescr->output_scale_pointer
+                           : &_matmulDescr->output_zero_point_pointer,
+                       sizeof(const float*));
+                status = rocsparselt_status_success;
+                break;
             default:
                 log_error(
                     _handle, __func__, "matmulAttribute", matmulAttribute, "is not implemented");
@@ -1065,6 +1260,8 @@ rocsparselt_status
         return rocsparselt_status_invalid_handle;
     }
 
+    rocsparselt_timeline_span span(_handle, rocsparselt_timeline_kind_plan_init, __func__);
+
     if(matmulDescr == nullptr)
     {
         log_error(_handle, __func__, "matmulDescr is a NULL pointer");
@@ -1091,9 +1288,10 @@ rocsparselt_status
 
             auto _algSelection = reinterpret_cast<_rocsparselt_matmul_alg_selection*>(algSelection);
 
-            auto in_type      = _matmulDescr->matrix_A->type;
-            auto out_type     = _matmulDescr->matrix_D->type;
-            auto compute_type = _matmulDescr->compute_type;
+            bool quantized_output = matmul_output_is_quantized(_matmulDescr);
+            auto in_type          = _matmulDescr->matrix_A->type;
+            auto out_type         = _matmulDescr->matrix_D->type;
+            auto compute_type     = _matmulDescr->compute_type;
 
             int                               config_max_id = 0;
             _rocsparselt_matmul_alg_selection tmpAlgSelection(_handle);
@@ -1103,7 +1301,13 @@ rocsparselt_status
 
             rocsparselt_status status = rocsparselt_status_success;
 
-            if(in_type == rocsparselt_datatype_f16_r && out_type == rocsparselt_datatype_f16_r
+            // a quantized output has the single config of quantized_spmm_kernel.
+            if(quantized_output)
+            {
+                tmpAlgSelection.configs[0].index = 0;
+                config_max_id                    = 1;
+            }
+            else if(in_type == rocsparselt_datatype_f16_r && out_type == rocsparselt_datatype_f16_r
                && compute_type == rocsparselt_compute_f32)
             {
                 status = findTopConfigs<__half, __half, float>(
@@ -1131,8 +1335,13 @@ rocsparselt_status
             if(status != rocsparselt_status_success)
                 return status;
 #else
-            if(in_type == rocsparselt_datatype_f16_r && out_type == rocsparselt_datatype_f16_r
-               && compute_type == rocsparselt_compute_f32)
+            if(quantized_output)
+            {
+                tmpAlgSelection.configs[0].index = 0;
+                config_max_id                    = 1;
+            }
+            else if(in_type == rocsparselt_datatype_f16_r && out_type == rocsparselt_datatype_f16_r
+                    && compute_type == rocsparselt_compute_f32)
                 initSolutions<__half, __half, float>(
                     _handle, _matmulDescr->op_A, _matmulDescr->op_B, &config_max_id);
             else if(in_type == rocsparselt_datatype_bf16_r
@@ -1156,8 +1365,9 @@ rocsparselt_status
                 return rocsparselt_status_not_implemented;
             }
             memcpy(_algSelection, &tmpAlgSelection, sizeof(_rocsparselt_matmul_alg_selection));
-            _algSelection->alg           = alg;
-            _algSelection->config_max_id = config_max_id;
+            _algSelection->alg              = alg;
+            _algSelection->config_max_id    = config_max_id;
+            _algSelection->quantized_output = quantized_output;
             log_api(_handle,
                     __func__,
                     "algSelection[out]",
@@ -1407,6 +1617,8 @@ rocsparselt_status
         return rocsparselt_status_invalid_handle;
     }
 
+    rocsparselt_timeline_span span(_handle, rocsparselt_timeline_kind_plan_init, __func__);
+
     if(matmulDescr == nullptr)
     {
         log_error(_handle, __func__, "matmulDescr is a NULL pointer");
@@ -1454,12 +1666,28 @@ rocsparselt_status
             return rocsparselt_status_invalid_size;
         }
 
+        if(_algSelection->quantized_output != matmul_output_is_quantized(_matmulDescr))
+        {
+            hipsparselt_cerr << "The output scale must be set before the algorithm selection is "
+                                "initialized"
+                             << std::endl;
+            log_error(_handle,
+                      __func__,
+                      "The output scale must be set before the algorithm selection is "
+                      "initialized");
+            return rocsparselt_status_invalid_value;
+        }
+
         auto                     _plan = reinterpret_cast<_rocsparselt_matmul_plan*>(plan);
         _rocsparselt_matmul_plan tmpPlan(_handle);
         memcpy(_plan, &tmpPlan, sizeof(_rocsparselt_matmul_plan));
 
         _plan->matmul_descr  = new _rocsparselt_matmul_descr(*_matmulDescr);
         _plan->alg_selection = const_cast<_rocsparselt_matmul_alg_selection*>(_algSelection);
+        _plan->stats         = new _rocsparselt_matmul_plan_stats();
+#if !BUILD_WITH_TENSILE
+        retainSolutions(_plan);
+#endif
         log_api(_handle,
                 __func__,
                 "plan[out]",
@@ -1500,6 +1728,9 @@ rocsparselt_status rocsparselt_matmul_plan_destroy(const rocsparselt_matmul_plan
     // Destruct
     try
     {
+#if !BUILD_WITH_TENSILE
+        releaseSolutions(_plan);
+#endif
         _plan->clear();
     }
     catch(const rocsparselt_status& status)
@@ -1510,6 +1741,274 @@ rocsparselt_status rocsparselt_matmul_plan_destroy(const rocsparselt_matmul_plan
     return rocsparselt_status_success;
 }
 
+namespace
+{
+    // check the handle and the plan of the plan stats functions.
+    rocsparselt_status plan_stats_check_args(const char*                      caller,
+                                             const rocsparselt_handle*        handle,
+                                             const rocsparselt_matmul_plan*   plan,
+                                             const _rocsparselt_handle**      _handle,
+                                             const _rocsparselt_matmul_plan** _plan)
+    {
+        if(handle == nullptr)
+        {
+            hipsparselt_cerr << "handle is a NULL pointer" << std::endl;
+            return rocsparselt_status_invalid_handle;
+        }
+        *_handle = reinterpret_cast<const _rocsparselt_handle*>(handle);
+        if(!(*_handle)->isInit())
+        {
+            hipsparselt_cerr << "handle did not initialized or already destroyed" << std::endl;
+            return rocsparselt_status_invalid_handle;
+        }
+
+        if(plan == nullptr)
+        {
+            log_error(*_handle, caller, "plan is a NULL pointer");
+            return rocsparselt_status_invalid_handle;
+        }
+        *_plan = reinterpret_cast<const _rocsparselt_matmul_plan*>(plan);
+        if(!(*_plan)->isInit() || (*_plan)->stats == nullptr)
+        {
+            log_error(*_handle, caller, "plan did not initialized or already destroyed");
+            return rocsparselt_status_invalid_handle;
+        }
+        return rocsparselt_status_success;
+    }
+}
+
+/********************************************************************************
+ * \brief set the GPU time sampling interval of a plan
+ *******************************************************************************/
+rocsparselt_status
+    rocsparselt_matmul_plan_set_stats_sampling(const rocsparselt_handle*      handle,
+                                               const rocsparselt_matmul_plan* plan,
+                                               int32_t                        interval)
+{
+    const _rocsparselt_handle*      _handle;
+    const _rocsparselt_matmul_plan* _plan;
+    RETURN_IF_ROCSPARSELT_ERROR(plan_stats_check_args(__func__, handle, plan, &_handle, &_plan));
+
+    if(interval < 0)
+    {
+        log_error(_handle, __func__, "interval should >= 0");
+        return rocsparselt_status_invalid_value;
+    }
+
+    log_api(_handle, __func__, "plan[in]", plan, "interval[in]", interval);
+    _plan->stats->sample_interval.store(interval, std::memory_order_relaxed);
+    return rocsparselt_status_success;
+}
+
+/********************************************************************************
+ * \brief retrieve the runtime statistics of a plan
+ *******************************************************************************/
+rocsparselt_status rocsparselt_matmul_plan_get_stats(const rocsparselt_handle*      handle,
+                                                     const rocsparselt_matmul_plan* plan,
+                                                     rocsparselt_matmul_plan_stats* stats)
+{
+    const _rocsparselt_handle*      _handle;
+    const _rocsparselt_matmul_plan* _plan;
+    RETURN_IF_ROCSPARSELT_ERROR(plan_stats_check_args(__func__, handle, plan, &_handle, &_plan));
+
+    if(stats == nullptr)
+    {
+        log_error(_handle, __func__, "stats is a NULL pointer");
+        return rocsparselt_status_invalid_pointer;
+    }
+
+    log_api(_handle, __func__, "plan[in]", plan, "stats[out]", stats);
+    _plan->stats->get_stats(stats);
+    return rocsparselt_status_success;
+}
+
+/********************************************************************************
+ * \brief reset the runtime statistics of a plan
+ *******************************************************************************/
+rocsparselt_status rocsparselt_matmul_plan_reset_stats(const rocsparselt_handle*      handle,
+                                                       const rocsparselt_matmul_plan* plan)
+{
+    const _rocsparselt_handle*      _handle;
+    const _rocsparselt_matmul_plan* _plan;
+    RETURN_IF_ROCSPARSELT_ERROR(plan_stats_check_args(__func__, handle, plan, &_handle, &_plan));
+
+    log_api(_handle, __func__, "plan[in]", plan);
+    _plan->stats->reset();
+    return rocsparselt_status_success;
+}
+
+/********************************************************************************
+ * \brief initialize the algorithm selection descriptor on the thread pool
+ *******************************************************************************/
+rocsparselt_status
+    rocsparselt_matmul_alg_selection_init_async(const rocsparselt_handle*         handle,
+                                                rocsparselt_matmul_alg_selection* algSelection,
+                                                const rocsparselt_matmul_descr*   matmulDescr,
+                                                rocsparselt_matmul_alg            alg,
+                                                rocsparselt_async_token*          token)
+{
+    // Check if handle is valid
+    if(handle == nullptr)
+    {
+        hipsparselt_cerr << "handle is a NULL pointer" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+    auto _handle = reinterpret_cast<const _rocsparselt_handle*>(handle);
+    if(!_handle->isInit())
+    {
+        hipsparselt_cerr << "handle did not initialized or already destroyed" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+
+    if(token == nullptr)
+    {
+        log_error(_handle, __func__, "token is a NULL pointer");
+        return rocsparselt_status_invalid_pointer;
+    }
+
+    log_api(_handle,
+            __func__,
+            "algSelection[out]",
+            algSelection,
+            "matmulDescr[in]",
+            matmulDescr,
+            "alg[in]",
+            alg,
+            "token[out]",
+            token);
+
+    auto _token     = new(token) _rocsparselt_async_token;
+    _token->state   = std::make_shared<_rocsparselt_async_state>();
+    _token->is_init = (uintptr_t)_token;
+
+    _rocsparselt_thread_pool::instance().submit(_token->state, [=] {
+        // the current device is per thread.
+        RETURN_IF_HIP_ERROR(hipSetDevice(_handle->device));
+        return rocsparselt_matmul_alg_selection_init(handle, algSelection, matmulDescr, alg);
+    });
+    return rocsparselt_status_success;
+}
+
+/********************************************************************************
+ * \brief initialize the matrix multiplication plan descriptor on the thread pool
+ *******************************************************************************/
+rocsparselt_status
+    rocsparselt_matmul_plan_init_async(const rocsparselt_handle*               handle,
+                                       rocsparselt_matmul_plan*                plan,
+                                       const rocsparselt_matmul_descr*         matmulDescr,
+                                       const rocsparselt_matmul_alg_selection* algSelection,
+                                       const rocsparselt_async_token*          algSelectionToken,
+                                       rocsparselt_async_token*                token)
+{
+    // Check if handle is valid
+    if(handle == nullptr)
+    {
+        hipsparselt_cerr << "handle is a NULL pointer" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+    auto _handle = reinterpret_cast<const _rocsparselt_handle*>(handle);
+    if(!_handle->isInit())
+    {
+        hipsparselt_cerr << "handle did not initialized or already destroyed" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+
+    std::shared_ptr<_rocsparselt_async_state> dependency;
+    if(algSelectionToken != nullptr)
+    {
+        auto _algSelectionToken
+            = reinterpret_cast<const _rocsparselt_async_token*>(algSelectionToken);
+        if(!_algSelectionToken->isInit())
+        {
+            log_error(_handle, __func__, "algSelectionToken did not initialized or already waited");
+            return rocsparselt_status_invalid_handle;
+        }
+        dependency = _algSelectionToken->state;
+    }
+
+    if(token == nullptr)
+    {
+        log_error(_handle, __func__, "token is a NULL pointer");
+        return rocsparselt_status_invalid_pointer;
+    }
+
+    log_api(_handle,
+            __func__,
+            "plan[out]",
+            plan,
+            "matmulDescr[in]",
+            matmulDescr,
+            "algSelection[in]",
+            algSelection,
+            "algSelectionToken[in]",
+            algSelectionToken,
+            "token[out]",
+            token);
+
+    auto _token     = new(token) _rocsparselt_async_token;
+    _token->state   = std::make_shared<_rocsparselt_async_state>();
+    _token->is_init = (uintptr_t)_token;
+
+    _rocsparselt_thread_pool::instance().submit(_token->state, [=] {
+        if(dependency != nullptr)
+            RETURN_IF_ROCSPARSELT_ERROR(dependency->wait());
+        // the plan loads its code objects on the current device, which is per thread.
+        RETURN_IF_HIP_ERROR(hipSetDevice(_handle->device));
+        return rocsparselt_matmul_plan_init(handle, plan, matmulDescr, algSelection);
+    });
+    return rocsparselt_status_success;
+}
+
+/********************************************************************************
+ * \brief check if an asynchronous call has completed
+ *******************************************************************************/
+rocsparselt_status rocsparselt_async_token_query(const rocsparselt_async_token* token, int* done)
+{
+    if(token == nullptr)
+    {
+        hipsparselt_cerr << "token is a NULL pointer" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+    auto _token = reinterpret_cast<const _rocsparselt_async_token*>(token);
+    if(!_token->isInit())
+    {
+        hipsparselt_cerr << "token did not initialized or already waited" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+
+    if(done == nullptr)
+    {
+        hipsparselt_cerr << "done is a NULL pointer" << std::endl;
+        return rocsparselt_status_invalid_pointer;
+    }
+
+    *done = _token->state->ready() ? 1 : 0;
+    return rocsparselt_status_success;
+}
+
+/********************************************************************************
+ * \brief wait an asynchronous call and release its token
+ *******************************************************************************/
+rocsparselt_status rocsparselt_async_token_wait(rocsparselt_async_token* token)
+{
+    if(token == nullptr)
+    {
+        hipsparselt_cerr << "token is a NULL pointer" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+    auto _token = reinterpret_cast<_rocsparselt_async_token*>(token);
+    if(!_token->isInit())
+    {
+        hipsparselt_cerr << "token did not initialized or already waited" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+
+    rocsparselt_status status = _token->state->wait();
+    _token->~_rocsparselt_async_token();
+    memset(token, 0, sizeof(rocsparselt_async_token));
+    return status;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -1517,23 +2016,10 @@ rocsparselt_status rocsparselt_matmul_plan_destroy(const rocsparselt_matmul_plan
 /*******************************************************************************
  * GPU architecture-related functions
  ******************************************************************************/
-struct ArchName
-{
-    std::string operator()(const hipDeviceProp_t& prop) const
-    {
-        // strip out xnack/ecc from name
-        std::string gcnArchName(prop.gcnArchName);
-        std::string gcnArch = gcnArchName.substr(0, gcnArchName.find(":"));
-        return gcnArch;
-    }
-};
-
 //Get architecture name
 std::string rocsparselt_internal_get_arch_name()
 {
     int deviceId;
     THROW_IF_HIP_ERROR(hipGetDevice(&deviceId));
-    hipDeviceProp_t deviceProperties;
-    THROW_IF_HIP_ERROR(hipGetDeviceProperties(&deviceProperties, deviceId));
-    return ArchName{}(deviceProperties);
+    return rocsparselt_get_device_info(deviceId).arch_name;
 }
@@ -27,12 +27,18 @@
 #include <hip/hip_ext.h>
 #include <hip/hip_runtime.h>
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <dlfcn.h>
+#include <elf.h>
+#include <unordered_set>
 
+#include "binary_trace.hpp"
 #include "definitions.h"
 #include "hip_solution_adapter.hpp"
 #include "hipsparselt_ostream.hpp"
+#include "timeline.hpp"
 #include "utility.hpp"
 
 #define HIP_CHECK_RETURN(expr)                \
@@ -115,6 +121,59 @@ hipError_t SolutionAdapter::loadLibrary(std::string const& path)
     return hipSuccess;
 }
 
+namespace
+{
+    // span of the loadable segments of an ELF code object, 0 when image is not one.
+    size_t elf_load_bytes(const unsigned char* image)
+    {
+        Elf64_Ehdr ehdr;
+        memcpy(&ehdr, image, sizeof(ehdr));
+        if(memcmp(ehdr.e_ident, ELFMAG, SELFMAG) != 0 || ehdr.e_ident[EI_CLASS] != ELFCLASS64)
+            return 0;
+
+        uint64_t first = UINT64_MAX, last = 0;
+        for(int i = 0; i < ehdr.e_phnum; i++)
+        {
+            Elf64_Phdr phdr;
+            memcpy(&phdr, image + ehdr.e_phoff + i * ehdr.e_phentsize, sizeof(phdr));
+            if(phdr.p_type != PT_LOAD)
+                continue;
+            first = std::min(first, phdr.p_vaddr);
+            last  = std::max(last, phdr.p_vaddr + phdr.p_memsz);
+        }
+        return last > first ? last - first : 0;
+    }
+
+    // device bytes of a code object, the largest one of an offload bundle.
+    size_t code_object_bytes(const void* image)
+    {
+        static constexpr char bundle_magic[] = "__CLANG_OFFLOAD_BUNDLE__";
+        constexpr size_t      magic_size     = sizeof(bundle_magic) - 1;
+
+        auto bytes = static_cast<const unsigned char*>(image);
+        if(memcmp(bytes, bundle_magic, magic_size) != 0)
+            return elf_load_bytes(bytes);
+
+        // magic, number of entries, then per entry: offset, size, triple size and triple.
+        uint64_t entries;
+        memcpy(&entries, bytes + magic_size, sizeof(entries));
+        const unsigned char* entry = bytes + magic_size + sizeof(entries);
+
+        size_t max_bytes = 0;
+        for(uint64_t i = 0; i < entries; i++)
+        {
+            uint64_t offset, size, triple_size;
+            memcpy(&offset, entry, sizeof(offset));
+            memcpy(&size, entry + 8, sizeof(size));
+            memcpy(&triple_size, entry + 16, sizeof(triple_size));
+            if(size >= sizeof(Elf64_Ehdr))
+                max_bytes = std::max(max_bytes, elf_load_bytes(bytes + offset));
+            entry += 24 + triple_size;
+        }
+        return max_bytes;
+    }
+} // namespace
+
 hipError_t SolutionAdapter::loadCodeObjectBytes(const _rocsparselt_handle*  handle,
                                                 std::vector<uint8_t> const& bytes,
                                                 std::string const&          name)
@@ -125,8 +184,8 @@ hipError_t SolutionAdapter::loadCodeObjectBytes(const _rocsparselt_handle*  hand
 hipError_t SolutionAdapter::loadCodeObject(const _rocsparselt_handle* handle,
                                            std::string const&         name)
 {
-    //check if the module already exist.
-    if(m_modules.find(name) != m_modules.end())
+    //check if the module already exist, it may be unloaded by another thread.
+    if(isLoaded(name))
         return hipSuccess;
 
     for(auto& fucs : m_lib_functions)
@@ -155,14 +214,24 @@ hipError_t SolutionAdapter::loadCodeObject(const _rocsparselt_handle* handle,
     auto                        it = m_modules.find(name);
     if(it == m_modules.end())
     {
+        rocsparselt_timeline_span span(
+            handle, rocsparselt_timeline_kind_code_object_load, "hipModuleLoadData");
+        span.set_detail(name);
         hipModule_t module;
         HIP_CHECK_RETURN(hipModuleLoadData(&module, image));
         //hipsparselt_cout << "load module " << name << " success" << std::endl;
-        m_modules[name] = module;
+        m_modules[name]      = module;
+        m_module_bytes[name] = code_object_bytes(image);
     }
     return hipSuccess;
 }
 
+bool SolutionAdapter::isLoaded(std::string const& name)
+{
+    std::lock_guard<std::mutex> guard(m_access);
+    return m_modules.find(name) != m_modules.end();
+}
+
 hipError_t SolutionAdapter::initKernel(std::string const& name)
 {
     hipFunction_t function;
@@ -199,7 +268,8 @@ hipError_t SolutionAdapter::getKernel(hipFunction_t& rv, std::string const& name
             return err;
         }
     }
-    return err;
+    // the module is not loaded, or was unloaded by unloadUnusedModules.
+    return hipErrorNotFound;
 }
 
 hipError_t SolutionAdapter::launchKernel(const _rocsparselt_handle* handle,
@@ -215,7 +285,8 @@ hipError_t SolutionAdapter::launchKernel(const _rocsparselt_handle* handle,
                                          hipEvent_t                 stopEvent,
                                          int                        iter)
 {
-    if(handle->layer_mode & rocsparselt_layer_mode_log_trace)
+    // the binary trace below replaces the text trace of the launch, it formats nothing.
+    if(!handle->binary_trace && (handle->layer_mode & rocsparselt_layer_mode_log_trace))
     {
         std::ostringstream stream;
         stream << "Kernel " << kernel.kernelName << "\n"
@@ -232,7 +303,16 @@ hipError_t SolutionAdapter::launchKernel(const _rocsparselt_handle* handle,
         log_trace(handle, __func__, stream.str());
     }
 
-    HIP_CHECK_RETURN(loadCodeObject(handle, kernel.kernelName));
+    // plan init loads the modules, a captured stream does not allow to load one here.
+    if(!isLoaded(kernel.kernelName))
+    {
+        if(isCapturing(stream))
+        {
+            log_error(handle, __func__, "module", kernel.kernelName, "is not loaded");
+            return hipErrorStreamCaptureUnsupported;
+        }
+        HIP_CHECK_RETURN(loadCodeObject(handle, kernel.kernelName));
+    }
 
     hipFunction_t function;
     HIP_CHECK_RETURN(getKernel(function, kernel.kernelName));
@@ -240,12 +320,24 @@ hipError_t SolutionAdapter::launchKernel(const _rocsparselt_handle* handle,
     void*  kernelArgs = const_cast<void*>(kernel.args.data());
     size_t argsSize   = kernel.args.size();
 
+    if(handle->binary_trace)
+        handle->binary_trace->record_launch(kernel, kernelArgs);
+
     void* hipLaunchParams[] = {HIP_LAUNCH_PARAM_BUFFER_POINTER,
                                kernelArgs,
                                HIP_LAUNCH_PARAM_BUFFER_SIZE,
                                &argsSize,
                                HIP_LAUNCH_PARAM_END};
 
+    rocsparselt_timeline_span span(
+        handle, rocsparselt_timeline_kind_kernel_launch, "hipExtModuleLaunchKernel");
+    if(span.active())
+    {
+        span.set_detail(kernel.kernelName);
+        span.set_dims(kernel.numWorkGroups, kernel.workGroupSize);
+        span.set_value(iter);
+    }
+
     if(startEvent != nullptr)
         HIP_CHECK_RETURN(hipEventRecord(startEvent, stream));
     for(int i = 0; i < iter; i++)
@@ -354,6 +446,74 @@ KernelParams* SolutionAdapter::getKernelParams(std::string const& category)
     return nullptr;
 }
 
+void SolutionAdapter::retainCategory(std::string const& category)
+{
+    std::lock_guard<std::mutex> guard(m_access);
+    m_category_refs[category]++;
+}
+
+void SolutionAdapter::releaseCategory(std::string const& category)
+{
+    std::lock_guard<std::mutex> guard(m_access);
+    auto                        it = m_category_refs.find(category);
+    if(it != m_category_refs.end() && --it->second <= 0)
+        m_category_refs.erase(it);
+}
+
+void SolutionAdapter::getMemoryUsage(size_t* bytes, int* modules, int* plans)
+{
+    std::lock_guard<std::mutex> guard(m_access);
+    *bytes = 0;
+    for(auto const& it : m_module_bytes)
+        *bytes += it.second;
+    *modules = m_modules.size();
+    *plans   = 0;
+    for(auto const& it : m_category_refs)
+        *plans += it.second;
+}
+
+hipError_t SolutionAdapter::unloadUnusedModules(const _rocsparselt_handle* handle,
+                                                size_t*                    freed_bytes)
+{
+    std::lock_guard<std::mutex> guard(m_access);
+
+    std::unordered_set<std::string> used;
+    for(auto const& it : m_category_refs)
+    {
+        size_t        counts   = getKernelCounts(it.first);
+        KernelParams* solution = getKernelParams(it.first);
+        for(size_t i = 0; i < counts; i++)
+            used.insert(solution[i].SolutionNameMin);
+    }
+
+    *freed_bytes = 0;
+    bool synced  = false;
+    for(auto it = m_modules.begin(); it != m_modules.end();)
+    {
+        if(used.count(it->first))
+        {
+            it++;
+            continue;
+        }
+        // kernels of the module may still be queued on any stream of the device.
+        if(!synced)
+        {
+            HIP_CHECK_RETURN(hipDeviceSynchronize());
+            synced = true;
+        }
+        HIP_CHECK_RETURN(hipModuleUnload(it->second));
+        m_kernels.erase(it->first);
+        auto bytes = m_module_bytes.find(it->first);
+        if(bytes != m_module_bytes.end())
+        {
+            *freed_bytes += bytes->second;
+            m_module_bytes.erase(bytes);
+        }
+        it = m_modules.erase(it);
+    }
+    return hipSuccess;
+}
+
 std::ostream& operator<<(std::ostream& stream, SolutionAdapter const& adapter)
 {
     stream << "hip::SolutionAdapter";
@@ -31,7 +31,9 @@
 #include "hipsparselt_ostream.hpp"
 #include "rocsparselt-types.h"
 #include "rocsparselt.h"
+#include "rocsparselt_spmm_utils.hpp"
 #include "status.h"
+#include "timeline.hpp"
 #include "utility.hpp"
 
 #include <atomic>
@@ -533,11 +535,8 @@ namespace
                       << std::endl;
             }
 
-            hipDeviceProp_t prop;
-
-            THROW_IF_HIP_ERROR(hipGetDeviceProperties(&prop, deviceId));
-
-            m_deviceProp = std::make_shared<hipDeviceProp_t>(prop);
+            m_deviceProp = std::make_shared<hipDeviceProp_t>(
+                rocsparselt_get_device_info(deviceId).properties);
         }
     };
 
@@ -672,6 +671,9 @@ rocsparselt_status runContractionProblem(const RocsparseltContractionProblem<Ti,
                 RETURN_IF_HIP_ERROR(hipEventCreate(&stopEvent));
                 for(int id = 0; id < max_cid; id++)
                 {
+                    rocsparselt_timeline_span span(
+                        prob.handle, rocsparselt_timeline_kind_search, "search iteration");
+                    span.set_value(id);
                     auto ki = ConstructKernelInvoke<Ti, To, Tc>(prob, solution[id]);
                     //warm up
                     RETURN_IF_HIP_ERROR(
@@ -779,3 +781,82 @@ std::atomic_bool& rocsparselt_internal_kl_is_initialized()
 GENERATE_DEFINITIONS(__half, __half, float, "4_4_0")
 GENERATE_DEFINITIONS(hip_bfloat16, hip_bfloat16, float, "7_7_0")
 GENERATE_DEFINITIONS(int8_t, int8_t, float, "8_8_0")
+
+namespace
+{
+    // The category of the solutions of a matmul, empty when there are none.
+    std::string matmul_kernel_category(const _rocsparselt_matmul_descr* matmulDescr)
+    {
+        auto in_type      = matmulDescr->matrix_A->type;
+        auto out_type     = matmulDescr->matrix_D->type;
+        auto compute_type = matmulDescr->compute_type;
+        auto opA          = matmulDescr->op_A;
+        auto opB          = matmulDescr->op_B;
+
+        // a quantized output runs quantized_spmm_kernel, which is not in a module.
+        if(matmul_output_is_quantized(matmulDescr))
+            return "";
+        if(in_type == rocsparselt_datatype_f16_r && out_type == rocsparselt_datatype_f16_r
+           && compute_type == rocsparselt_compute_f32)
+            return generate_kernel_category_str<__half, __half, float>(opA, opB);
+        else if(in_type == rocsparselt_datatype_bf16_r && out_type == rocsparselt_datatype_bf16_r
+                && compute_type == rocsparselt_compute_f32)
+            return generate_kernel_category_str<hip_bfloat16, hip_bfloat16, float>(opA, opB);
+        else if(in_type == rocsparselt_datatype_i8_r && out_type == rocsparselt_datatype_i8_r
+                && compute_type == rocsparselt_compute_i32)
+            return generate_kernel_category_str<int8_t, int8_t, float>(opA, opB);
+        return "";
+    }
+} // namespace
+
+/******************************************************************************
+ * retainSolutions/releaseSolutions count the live plans of each category of  *
+ * solutions, unloadUnusedModules keeps the code objects of those categories. *
+ ******************************************************************************/
+void retainSolutions(const _rocsparselt_matmul_plan* plan)
+{
+    std::string category = matmul_kernel_category(plan->matmul_descr);
+    if(category.empty())
+        return;
+
+    // load the modules again if they were unloaded since the algorithm selection, so that
+    // the matmuls of the plan never load one, they may be captured into a graph.
+    auto& adapter = get_adapter(nullptr, plan->handle->device);
+    adapter.retainCategory(category);
+    size_t        counts   = adapter.getKernelCounts(category);
+    KernelParams* solution = adapter.getKernelParams(category);
+    for(size_t i = 0; i < counts; i++)
+        PRINT_IF_HIP_ERROR(plan->handle,
+                           adapter.loadCodeObject(plan->handle, solution[i].SolutionNameMin));
+}
+
+void releaseSolutions(const _rocsparselt_matmul_plan* plan)
+{
+    std::string category = matmul_kernel_category(plan->matmul_descr);
+    if(!category.empty())
+        get_adapter(nullptr, plan->handle->device).releaseCategory(category);
+}
+
+void getModuleMemoryUsage(const _rocsparselt_handle* handle,
+                          size_t*                    bytes,
+                          int*                       modules,
+                          int*                       plans)
+{
+    get_adapter(nullptr, handle->device).getMemoryUsage(bytes, modules, plans);
+}
+
+rocsparselt_status unloadUnusedModules(const _rocsparselt_handle* handle, size_t* freed_bytes)
+{
+    auto& adapter = get_adapter(nullptr, handle->device);
+
+    // the device is synchronized before the first unload, the current device is per thread.
+    int device;
+    RETURN_IF_HIP_ERROR(hipGetDevice(&device));
+    if(device != handle->device)
+        RETURN_IF_HIP_ERROR(hipSetDevice(handle->device));
+    hipError_t err = adapter.unloadUnusedModules(handle, freed_bytes);
+    if(device != handle->device)
+        RETURN_IF_HIP_ERROR(hipSetDevice(device));
+    RETURN_IF_HIP_ERROR(err);
+    return rocsparselt_status_success;
+}
@@ -29,29 +29,31 @@
 #include "hipsparselt_ostream.hpp"
 #include "rocsparselt.h"
 #include "rocsparselt_spmm_utils.hpp"
+#include "timeline.hpp"
 #include "utility.hpp"
 
 #include <hip/hip_runtime_api.h>
 
 template <typename Ti, int SG0I, int SG1J, int TT0I, int TT1J>
-__global__ void compress_kernel(const Ti*      in,
-                                Ti*            out,
-                                unsigned char* metadata,
-                                int64_t        m,
-                                int64_t        n,
-                                int64_t        stride1,
-                                int64_t        stride2,
-                                int64_t        batch_stride,
-                                int64_t        c_stride1,
-                                int64_t        c_stride2,
-                                int64_t        c_batch_stride,
-                                int64_t        m_stride1,
-                                int64_t        m_stride2,
-                                int64_t        m_batch_stride,
-                                int            num_batches,
-                                int64_t        sizes,
-                                int64_t        c_sizes,
-                                int64_t        m_sizes)
+__global__ void compress_kernel(const Ti*             in,
+                                Ti*                   out,
+                                unsigned char*        metadata,
+                                int64_t               m,
+                                int64_t               n,
+                                int64_t               stride1,
+                                int64_t               stride2,
+                                int64_t               batch_stride,
+                                int64_t               c_stride1,
+                                int64_t               c_stride2,
+                                int64_t               c_batch_stride,
+                                int64_t               m_stride1,
+                                int64_t               m_stride2,
+                                int64_t               m_batch_stride,
+                                int                   num_batches,
+                                int64_t               sizes,
+                                int64_t               c_sizes,
+                                int64_t               m_sizes,
+                                rocsparselt_tile_mask mask)
 {
     constexpr int metadata_tiles_y = 8;
     constexpr int tiles_y          = 4;
@@ -67,6 +69,9 @@ __global__ void compress_kernel(const Ti*      in,
     unsigned int wg1J    = hc_get_group_id(1); // N / MT0J
     unsigned int batchId = hc_get_group_id(2);
 
+    if(!mask.is_dirty(wg0I, wg1J, batchId))
+        return;
+
     if((MT1J * wg1J + sg1J * TT1J) >= n || (MT0I * wg0I + sg0I * TT0I) >= m)
         return;
 
@@ -142,24 +147,25 @@ __global__ void compress_kernel(const Ti*      in,
 }
 
 template <typename Ti>
-rocsparselt_status rocsparselt_smfmac_compress_template(const _rocsparselt_handle* handle,
-                                                        int64_t                    m,
-                                                        int64_t                    n,
-                                                        int64_t                    stride0,
-                                                        int64_t                    stride1,
-                                                        int                        batch_stride,
-                                                        int64_t                    c_stride0,
-                                                        int64_t                    c_stride1,
-                                                        int                        c_batch_stride,
-                                                        int64_t                    m_stride0,
-                                                        int64_t                    m_stride1,
-                                                        int64_t                    m_batch_stride,
-                                                        int                        num_batches,
-                                                        rocsparselt_order          order,
-                                                        const Ti*                  d_in,
-                                                        Ti*                        d_out,
-                                                        unsigned char*             d_metadata,
-                                                        hipStream_t                stream)
+rocsparselt_status rocsparselt_smfmac_compress_template(const _rocsparselt_handle*   handle,
+                                                        int64_t                      m,
+                                                        int64_t                      n,
+                                                        int64_t                      stride0,
+                                                        int64_t                      stride1,
+                                                        int                          batch_stride,
+                                                        int64_t                      c_stride0,
+                                                        int64_t                      c_stride1,
+                                                        int                          c_batch_stride,
+                                                        int64_t                      m_stride0,
+                                                        int64_t                      m_stride1,
+                                                        int64_t                      m_batch_stride,
+                                                        int                          num_batches,
+                                                        rocsparselt_order            order,
+                                                        const Ti*                    d_in,
+                                                        Ti*                          d_out,
+                                                        unsigned char*               d_metadata,
+                                                        hipStream_t                  stream,
+                                                        const rocsparselt_tile_mask& mask)
 {
     constexpr int SG0I = 16;
     constexpr int SG1J = 2;
@@ -192,7 +198,8 @@ rocsparselt_status rocsparselt_smfmac_compress_template(const _rocsparselt_handl
                        num_batches,
                        num_batches * batch_stride,
                        num_batches * c_batch_stride,
-                       num_batches * m_batch_stride);
+                       num_batches * m_batch_stride,
+                       mask);
     return rocsparselt_status_success;
 }
 
@@ -212,8 +219,10 @@ rocsparselt_status rocsparselt_smfmac_compress_impl(const _rocsparselt_handle*
                                                     const void*                   d_in,
                                                     void*                         d_out,
                                                     void*                         d_ws,
-                                                    hipStream_t                   stream)
+                                                    hipStream_t                   stream,
+                                                    const void*                   d_tileMask = nullptr)
 {
+    rocsparselt_timeline_span span(handle, rocsparselt_timeline_kind_api, __func__);
 
     rocsparselt_order    order = matrix->order;
     rocsparselt_datatype type  = matrix->type;
@@ -231,10 +240,12 @@ rocsparselt_status rocsparselt_smfmac_compress_impl(const _rocsparselt_handle*
                                 + rocsparselt_metadata_offset_in_compressed_matrix(
                                     matrix->c_n, matrix->c_ld, num_batches, type);
 
+    rocsparselt_tile_mask mask = rocsparselt_make_tile_mask(matrix, stride0, d_tileMask);
+
 #define COMPRESS_PARAMS(T)                                                                         \
     handle, m, n, stride0, stride1, batch_stride, c_stride0, c_stride1, c_batch_stride, m_stride0, \
         m_stride1, m_batch_stride, num_batches, order, reinterpret_cast<const T*>(d_in),           \
-        reinterpret_cast<T*>(d_out), d_metadata, stream
+        reinterpret_cast<T*>(d_out), d_metadata, stream, mask
 
     switch(type)
     {
@@ -660,6 +671,186 @@ rocsparselt_status rocsparselt_smfmac_compress2(const rocsparselt_handle*    han
                                             stream);
 }
 
+/********************************************************************************
+ * \brief
+ *******************************************************************************/
+rocsparselt_status rocsparselt_smfmac_tile_mask_size(const rocsparselt_handle*    handle,
+                                                     const rocsparselt_mat_descr* sparseMatDescr,
+                                                     int64_t*                     tileSize,
+                                                     size_t*                      tileMaskSize)
+{
+    // Check if handle is valid
+    if(handle == nullptr)
+    {
+        hipsparselt_cerr << "handle is a NULL pointer" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+    auto _handle = reinterpret_cast<const _rocsparselt_handle*>(handle);
+    if(!_handle->isInit())
+    {
+        hipsparselt_cerr << "handle did not initialized or already destroyed" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+
+    if(sparseMatDescr == nullptr)
+    {
+        log_error(_handle, __func__, "sparseMatDescr is a NULL pointer");
+        return rocsparselt_status_invalid_handle;
+    }
+    auto _sparseMatDescr = reinterpret_cast<const _rocsparselt_mat_descr*>(sparseMatDescr);
+    if(!_sparseMatDescr->isInit())
+    {
+        log_error(_handle, __func__, "sparseMatDescr did not initialized or already destroyed");
+        return rocsparselt_status_invalid_handle;
+    }
+
+    // Check if pointer is valid
+    if(tileSize == nullptr)
+    {
+        log_error(_handle, __func__, "tileSize is a NULL pointer");
+        return rocsparselt_status_invalid_pointer;
+    }
+    if(tileMaskSize == nullptr)
+    {
+        log_error(_handle, __func__, "tileMaskSize is a NULL pointer");
+        return rocsparselt_status_invalid_pointer;
+    }
+
+    log_api(_handle,
+            __func__,
+            "sparseMatDescr[in]",
+            *_sparseMatDescr,
+            "tileSize[out]",
+            tileSize,
+            "tileMaskSize[out]",
+            tileMaskSize);
+
+    int64_t tiles_row, tiles_col;
+    int     num_batches;
+    rocsparselt_tile_mask_dims(_sparseMatDescr, tiles_row, tiles_col, num_batches);
+
+    *tileSize     = ROCSPARSELT_SMFMAC_TILE_SIZE;
+    *tileMaskSize = (tiles_row * tiles_col * num_batches + 7) / 8;
+    return rocsparselt_status_success;
+}
+
+/********************************************************************************
+ * \brief
+ *******************************************************************************/
+rocsparselt_status rocsparselt_smfmac_compress_tiles(const rocsparselt_handle*    handle,
+                                                     const rocsparselt_mat_descr* sparseMatDescr,
+                                                     int                          isSparseA,
+                                                     rocsparselt_operation        op,
+                                                     const void*                  d_dense,
+                                                     void*                        d_compressed,
+                                                     void*                        d_compressBuffer,
+                                                     const void*                  d_tileMask,
+                                                     hipStream_t                  stream)
+
+{
+    // Check if handle is valid
+    if(handle == nullptr)
+    {
+        hipsparselt_cerr << "handle is a NULL pointer" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+    auto _handle = reinterpret_cast<const _rocsparselt_handle*>(handle);
+    if(!_handle->isInit())
+    {
+        hipsparselt_cerr << "handle did not initialized or already destroyed" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+
+    if(sparseMatDescr == nullptr)
+    {
+        log_error(_handle, __func__, "sparseMatDescr is a NULL pointer");
+        return rocsparselt_status_invalid_handle;
+    }
+    auto _sparseMatDescr = reinterpret_cast<_rocsparselt_mat_descr*>(
+        const_cast<rocsparselt_mat_descr*>(sparseMatDescr));
+    if(!_sparseMatDescr->isInit())
+    {
+        log_error(_handle, __func__, "sparseMatDescr did not initialized or already destroyed");
+        return rocsparselt_status_invalid_handle;
+    }
+
+    if(op != rocsparselt_operation_none && op != rocsparselt_operation_transpose)
+    {
+        log_error(_handle, __func__, "op is invalid");
+        return rocsparselt_status_invalid_value;
+    }
+
+    // Check if pointer is valid
+    if(d_dense == nullptr)
+    {
+        log_error(_handle, __func__, "d_dense is a NULL pointer");
+        return rocsparselt_status_invalid_pointer;
+    }
+
+    if(d_compressed == nullptr)
+    {
+        log_error(_handle, __func__, "d_compressed is a NULL pointer");
+        return rocsparselt_status_invalid_pointer;
+    }
+
+    if(d_tileMask == nullptr)
+    {
+        log_error(_handle, __func__, "d_tileMask is a NULL pointer");
+        return rocsparselt_status_invalid_pointer;
+    }
+
+    // Check if matrix A is a structured matrix
+    if(_sparseMatDescr->m_type != rocsparselt_matrix_type_structured)
+    {
+        log_error(_handle, __func__, "Matrix is not a structured matrix");
+        return rocsparselt_status_not_implemented;
+    }
+
+    log_api(_handle,
+            __func__,
+            "sparseMatDescr[in]",
+            *_sparseMatDescr,
+            "isSparseA[in]",
+            isSparseA,
+            "op[in]",
+            rocsparselt_operation_to_string(op),
+            "d_dense[in]",
+            d_dense,
+            "d_compressed[out]",
+            d_compressed,
+            "d_compressBuffer[out]",
+            d_compressBuffer,
+            "d_tileMask[in]",
+            d_tileMask,
+            "stream[in]",
+            stream);
+
+    auto ld = _sparseMatDescr->ld;
+    int64_t m, n, stride0, stride1, c_stride0, c_stride1;
+    auto m_stride0 = _sparseMatDescr->c_k / 4;
+    auto m_stride1 = 1;
+    get_compress_matrix_size(isSparseA, op, _sparseMatDescr, m, n, stride0, stride1, c_stride0, c_stride1);
+
+    return rocsparselt_smfmac_compress_impl(_handle,
+                                            _sparseMatDescr,
+                                            m,
+                                            n,
+                                            stride0,
+                                            stride1,
+                                            ld,
+                                            c_stride0,
+                                            c_stride1,
+                                            m_stride0,
+                                            m_stride1,
+                                            _sparseMatDescr->c_ld * _sparseMatDescr->c_n,
+                                            _sparseMatDescr->c_ld * _sparseMatDescr->c_n / 4,
+                                            d_dense,
+                                            d_compressed,
+                                            d_compressBuffer,
+                                            stream,
+                                            d_tileMask);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,7 +27,9 @@
 #include "definitions.h"
 #include "handle.h"
 #include "rocsparselt.h"
+#include "rocsparselt_spmm_utils.hpp"
 #include "status.h"
+#include "timeline.hpp"
 #include "utility.hpp"
 
 #include "hipsparselt_ostream.hpp"
@@ -136,15 +138,16 @@ __host__ __device__ inline void prune_if(bool prune, T* a, T b)
 }
 
 template <typename Ti, typename Tc, int SG0I, int SG1J, int TT0I, int TT1J, bool InPlace>
-__global__ void prune_strip_kernel(const Ti* in,
-                                   Ti*       out,
-                                   int64_t   m,
-                                   int64_t   n,
-                                   int64_t   stride1,
-                                   int64_t   stride2,
-                                   int       num_batches,
-                                   int64_t   batch_stride,
-                                   int64_t   sizes)
+__global__ void prune_strip_kernel(const Ti*             in,
+                                   Ti*                   out,
+                                   int64_t               m,
+                                   int64_t               n,
+                                   int64_t               stride1,
+                                   int64_t               stride2,
+                                   int                   num_batches,
+                                   int64_t               batch_stride,
+                                   int64_t               sizes,
+                                   rocsparselt_tile_mask mask)
 {
     constexpr unsigned int MT0I = SG0I * TT0I;
     constexpr unsigned int MT1J = SG1J * TT1J;
@@ -158,6 +161,9 @@ __global__ void prune_strip_kernel(const Ti* in,
     unsigned int wg1J    = hc_get_group_id(1);
     unsigned int batchId = hc_get_group_id(2);
 
+    if(!mask.is_dirty(wg0I, wg1J, batchId))
+        return;
+
     if((MT1J * wg1J + sg1J * TT1J) >= n || (MT0I * wg0I + sg0I * TT0I) >= m)
         return;
 
@@ -217,15 +223,16 @@ template <typename Ti,
           int  PATTERNS_PER_THREAD,
           bool InPlace>
 __global__
-    __launch_bounds__(SG0I* SG1J* THREADS_PER_SG) void prune_tile_kernel(const Ti* in,
-                                                                         Ti*       out,
-                                                                         int64_t   m,
-                                                                         int64_t   n,
-                                                                         int64_t   stride1,
-                                                                         int64_t   stride2,
-                                                                         int       num_batches,
-                                                                         int64_t   batch_stride,
-                                                                         int64_t   sizes)
+    __launch_bounds__(SG0I* SG1J* THREADS_PER_SG) void prune_tile_kernel(const Ti*             in,
+                                                                         Ti*                   out,
+                                                                         int64_t               m,
+                                                                         int64_t               n,
+                                                                         int64_t               stride1,
+                                                                         int64_t               stride2,
+                                                                         int                   num_batches,
+                                                                         int64_t               batch_stride,
+                                                                         int64_t               sizes,
+                                                                         rocsparselt_tile_mask mask)
 {
     constexpr int  PAD = 0;
     __shared__ Tc  value_abs[(16 + PAD) * SG0I * SG1J];
@@ -276,6 +283,10 @@ __global__
     const unsigned int wg1J    = hc_get_group_id(1);
     const unsigned int batchId = hc_get_group_id(2);
 
+    // the whole workgroup leaves together, so no __syncthreads() below is left waiting.
+    if(!mask.is_dirty(wg0I, wg1J, batchId))
+        return;
+
     const int64_t wg_pos_x = MT0I * wg0I + sg0I * TT0I;
     const int64_t wg_pos_y = MT1J * wg1J + sg1J * TT1J;
     if((wg_pos_y) >= n || (wg_pos_x) >= m)
@@ -385,18 +396,19 @@ void get_prune_matrix_size(bool is_sparse_a, rocsparselt_operation op,  _rocspar
     }
 }
 template <typename Ti, typename Tc>
-rocsparselt_status rocsparselt_smfmac_prune_template(const _rocsparselt_handle* handle,
-                                                     int64_t                    m,
-                                                     int64_t                    n,
-                                                     int64_t                    stride0,
-                                                     int64_t                    stride1,
-                                                     int                        num_batches,
-                                                     int64_t                    batch_stride,
-                                                     rocsparselt_order          order,
-                                                     const Ti*                  d_in,
-                                                     Ti*                        d_out,
-                                                     rocsparselt_prune_alg      pruneAlg,
-                                                     hipStream_t                stream)
+rocsparselt_status rocsparselt_smfmac_prune_template(const _rocsparselt_handle*   handle,
+                                                     int64_t                      m,
+                                                     int64_t                      n,
+                                                     int64_t                      stride0,
+                                                     int64_t                      stride1,
+                                                     int                          num_batches,
+                                                     int64_t                      batch_stride,
+                                                     rocsparselt_order            order,
+                                                     const Ti*                    d_in,
+                                                     Ti*                          d_out,
+                                                     rocsparselt_prune_alg        pruneAlg,
+                                                     hipStream_t                  stream,
+                                                     const rocsparselt_tile_mask& mask)
 {
     if(pruneAlg == rocsparselt_prune_smfmac_strip)
     {
@@ -410,15 +422,16 @@ rocsparselt_status rocsparselt_smfmac_prune_template(const _rocsparselt_handle*
         int block_x = m / MT0I + (m % MT0I > 0 ? 1 : 0);
         int block_y = n / MT1J + (n % MT1J > 0 ? 1 : 0);
 
-        void (*func)(const Ti* in,
-                     Ti*       out,
-                     int64_t   m,
-                     int64_t   n,
-                     int64_t   stride1,
-                     int64_t   stride2,
-                     int       num_batches,
-                     int64_t   batch_stride,
-                     int64_t   sizes);
+        void (*func)(const Ti*             in,
+                     Ti*                   out,
+                     int64_t               m,
+                     int64_t               n,
+                     int64_t               stride1,
+                     int64_t               stride2,
+                     int                   num_batches,
+                     int64_t               batch_stride,
+                     int64_t               sizes,
+                     rocsparselt_tile_mask mask);
         if(d_in == d_out)
             func = prune_strip_kernel<Ti, Tc, SG0I, SG1J, TT0I, TT1J, true>;
         else
@@ -436,7 +449,8 @@ rocsparselt_status rocsparselt_smfmac_prune_template(const _rocsparselt_handle*
                            stride1,
                            num_batches,
                            batch_stride,
-                           num_batches * batch_stride);
+                           num_batches * batch_stride,
+                           mask);
         return rocsparselt_status_success;
     }
     else if(pruneAlg == rocsparselt_prune_smfmac_tile)
@@ -455,15 +469,16 @@ rocsparselt_status rocsparselt_smfmac_prune_template(const _rocsparselt_handle*
         int block_x = m / MT0I + (m % MT0I > 0 ? 1 : 0);
         int block_y = n / MT1J + (n % MT1J > 0 ? 1 : 0);
 
-        void (*func)(const Ti* in,
-                     Ti*       out,
-                     int64_t   m,
-                     int64_t   n,
-                     int64_t   stride1,
-                     int64_t   stride2,
-                     int       num_batches,
-                     int64_t   batch_stride,
-                     int64_t   sizes);
+        void (*func)(const Ti*             in,
+                     Ti*                   out,
+                     int64_t               m,
+                     int64_t               n,
+                     int64_t               stride1,
+                     int64_t               stride2,
+                     int                   num_batches,
+                     int64_t               batch_stride,
+                     int64_t               sizes,
+                     rocsparselt_tile_mask mask);
         if(d_in == d_out)
             func = prune_tile_kernel<Ti,
                                      Tc,
@@ -499,7 +514,8 @@ rocsparselt_status rocsparselt_smfmac_prune_template(const _rocsparselt_handle*
                            stride1,
                            num_batches,
                            batch_stride,
-                           num_batches * batch_stride);
+                           num_batches * batch_stride,
+                           mask);
         return rocsparselt_status_success;
     }
     return rocsparselt_status_not_implemented;
@@ -560,8 +576,10 @@ rocsparselt_status rocsparselt_smfmac_prune_impl(const _rocsparselt_handle*    h
                                                  const void*                   d_in,
                                                  void*                         d_out,
                                                  rocsparselt_prune_alg         pruneAlg,
-                                                 hipStream_t                   stream)
+                                                 hipStream_t                   stream,
+                                                 const void*                   d_tileMask = nullptr)
 {
+    rocsparselt_timeline_span span(handle, rocsparselt_timeline_kind_api, __func__);
 
     rocsparselt_order    order = matrix->order;
     rocsparselt_datatype type  = matrix->type;
@@ -576,9 +594,11 @@ rocsparselt_status rocsparselt_smfmac_prune_impl(const _rocsparselt_handle*    h
         batch_stride = matrix->n * ld;
     }
 
-#define PRUNE_PARAMS(T)                                               \
-    handle, m, n, stride0, stride1, num_batches, batch_stride, order, \
-        reinterpret_cast<const T*>(d_in), reinterpret_cast<T*>(d_out), pruneAlg, stream
+    rocsparselt_tile_mask mask = rocsparselt_make_tile_mask(matrix, stride0, d_tileMask);
+
+#define PRUNE_PARAMS(T)                                                                     \
+    handle, m, n, stride0, stride1, num_batches, batch_stride, order,                       \
+        reinterpret_cast<const T*>(d_in), reinterpret_cast<T*>(d_out), pruneAlg, stream, mask
 
     switch(type)
     {
@@ -829,6 +849,121 @@ rocsparselt_status rocsparselt_smfmac_prune2(const rocsparselt_handle*    handle
         _handle, _sparseMatDescr, m, n, stride0, stride1, ld, d_in, d_out, pruneAlg, stream);
 }
 
+/********************************************************************************
+ * \brief prunes the dirty tiles of a dense matrix according to the specified algorithm.
+ *******************************************************************************/
+rocsparselt_status rocsparselt_smfmac_prune_tiles(const rocsparselt_handle*    handle,
+                                                  const rocsparselt_mat_descr* sparseMatDescr,
+                                                  int                          isSparseA,
+                                                  rocsparselt_operation        op,
+                                                  const void*                  d_in,
+                                                  void*                        d_out,
+                                                  rocsparselt_prune_alg        pruneAlg,
+                                                  const void*                  d_tileMask,
+                                                  hipStream_t                  stream)
+{
+    // Check if handle is valid
+    if(handle == nullptr)
+    {
+        hipsparselt_cerr << "handle is a NULL pointer" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+    auto _handle = reinterpret_cast<const _rocsparselt_handle*>(handle);
+    if(!_handle->isInit())
+    {
+        hipsparselt_cerr << "handle did not initialized or already destroyed" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+
+    if(sparseMatDescr == nullptr)
+    {
+        log_error(_handle, __func__, "sparseMatDescr is a NULL pointer");
+        return rocsparselt_status_invalid_handle;
+    }
+    auto _sparseMatDescr = reinterpret_cast<_rocsparselt_mat_descr*>(
+        const_cast<rocsparselt_mat_descr*>(sparseMatDescr));
+    if(!_sparseMatDescr->isInit())
+    {
+        log_error(_handle, __func__, "sparseMatDescr did not initialized or already destroyed");
+        return rocsparselt_status_invalid_handle;
+    }
+
+    if(op != rocsparselt_operation_none && op != rocsparselt_operation_transpose)
+    {
+        log_error(_handle, __func__, "op is invalid");
+        return rocsparselt_status_invalid_value;
+    }
+
+    // Check if pointer is valid
+    if(d_in == nullptr)
+    {
+        log_error(_handle, __func__, "d_in is a NULL pointer");
+        return rocsparselt_status_invalid_pointer;
+    }
+
+    if(d_out == nullptr)
+    {
+        log_error(_handle, __func__, "d_out is a NULL pointer");
+        return rocsparselt_status_invalid_pointer;
+    }
+
+    if(d_tileMask == nullptr)
+    {
+        log_error(_handle, __func__, "d_tileMask is a NULL pointer");
+        return rocsparselt_status_invalid_pointer;
+    }
+
+    // Check if prune alg is valid
+    if(pruneAlg != rocsparselt_prune_smfmac_strip && pruneAlg != rocsparselt_prune_smfmac_tile)
+    {
+        log_error(_handle, __func__, "pruneAlg", pruneAlg, "is not supported");
+        return rocsparselt_status_not_implemented;
+    }
+
+    // Check if matrix A is a structured matrix
+    if(_sparseMatDescr->m_type != rocsparselt_matrix_type_structured)
+    {
+        log_error(_handle, __func__, "Matrix is not a structured matrix");
+        return rocsparselt_status_not_implemented;
+    }
+
+    log_api(_handle,
+            __func__,
+            "sparseMatDescr[in]",
+            *_sparseMatDescr,
+            "isSparseA[in]",
+            isSparseA,
+            "op[in]",
+            rocsparselt_operation_to_string(op),
+            "d_in[in]",
+            d_in,
+            "d_out[out]",
+            d_out,
+            "pruneAlg[in]",
+            pruneAlg,
+            "d_tileMask[in]",
+            d_tileMask,
+            "stream[in]",
+            stream);
+
+    int64_t m, n, stride0, stride1;
+    int64_t ld = _sparseMatDescr->ld;
+    get_prune_matrix_size(isSparseA, op, _sparseMatDescr, m, n, stride0, stride1);
+
+    return rocsparselt_smfmac_prune_impl(_handle,
+                                         _sparseMatDescr,
+                                         m,
+                                         n,
+                                         stride0,
+                                         stride1,
+                                         ld,
+                                         d_in,
+                                         d_out,
+                                         pruneAlg,
+                                         stream,
+                                         d_tileMask);
+}
+
 /********************************************************************************
  * \brief
  *******************************************************************************/
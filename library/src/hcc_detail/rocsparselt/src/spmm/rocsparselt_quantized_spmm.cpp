@@ -0,0 +1,335 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "definitions.h"
+#include "handle.h"
+#include "rocsparselt.h"
+#include "rocsparselt_spmm.hpp"
+#include "status.h"
+#include "timeline.hpp"
+#include "utility.hpp"
+
+#include <hip/hip_runtime_api.h>
+#include <type_traits>
+
+namespace
+{
+    // a block computes a QUANTIZED_MT x QUANTIZED_NT tile of D, 4 x 4 elements per thread, and
+    // steps over k by QUANTIZED_KT, 4 metadata bytes of each row of the sparse matrix.
+    constexpr int QUANTIZED_MT      = 64;
+    constexpr int QUANTIZED_NT      = 64;
+    constexpr int QUANTIZED_KT      = 32;
+    constexpr int QUANTIZED_THREADS = 256;
+
+    template <typename To, typename Tbias>
+    struct quantized_spmm_args
+    {
+        int64_t                     m;
+        int64_t                     n;
+        int64_t                     k;
+        float                       alpha;
+        float                       beta;
+        const int8_t*               a;
+        int64_t                     lda;
+        int64_t                     batch_stride_a;
+        bool                        trans_a;
+        const int8_t*               b;
+        int64_t                     ldb;
+        int64_t                     batch_stride_b;
+        bool                        trans_b;
+        const unsigned char*        metadata;
+        int64_t                     batch_stride_metadata;
+        const To*                   c;
+        int64_t                     ldc;
+        int64_t                     batch_stride_c;
+        To*                         d;
+        int64_t                     ldd;
+        int64_t                     batch_stride_d;
+        const Tbias*                bias;
+        int64_t                     bias_stride;
+        hipsparselt_activation_type act_type;
+        float                       act_arg0;
+        float                       act_arg1;
+        const float*                scale;
+        const float*                zero_point;
+    };
+
+    template <typename T>
+    __device__ inline T quantized_saturate(float value);
+
+    // rounded to the nearest even like the host reference.
+    template <>
+    __device__ inline int8_t quantized_saturate<int8_t>(float value)
+    {
+        return static_cast<int8_t>(fminf(fmaxf(rintf(value), -128.0f), 127.0f));
+    }
+
+    template <>
+    __device__ inline __half quantized_saturate<__half>(float value)
+    {
+        return __float2half(fminf(fmaxf(value, -65504.0f), 65504.0f));
+    }
+
+    // the activations of the Tensile kernels, in fp32.
+    __device__ inline float quantized_activation(hipsparselt_activation_type act_type,
+                                                 float                       in,
+                                                 float                       arg0,
+                                                 float                       arg1)
+    {
+        switch(act_type)
+        {
+        case hipsparselt_activation_type::abs:
+            return fabsf(in);
+        case hipsparselt_activation_type::clippedrelu:
+            return in > arg0 ? fminf(in, arg1) : 0.0f;
+        case hipsparselt_activation_type::gelu:
+        {
+            constexpr float k0 = 0.7978845608028654f;
+            constexpr float k1 = 0.044715f;
+            return 0.5f * (in * (1.0f + tanhf(k0 * (in * (1.0f + k1 * (in * in)))))) * arg0;
+        }
+        case hipsparselt_activation_type::leakyrelu:
+            return in > 0.0f ? in : in * arg0;
+        case hipsparselt_activation_type::relu:
+            return fmaxf(in, 0.0f);
+        case hipsparselt_activation_type::sigmoid:
+            return 1.0f / (1.0f + expf(-in));
+        case hipsparselt_activation_type::tanh:
+            return tanhf(in * arg0) * arg1;
+        default:
+            return in;
+        }
+    }
+
+    // element (row, col) of a column major matrix or of the transpose of one.
+    __device__ inline int32_t
+        quantized_load(const int8_t* p, int64_t row, int64_t col, int64_t ld, bool trans)
+    {
+        return p[trans ? col + row * ld : row + col * ld];
+    }
+
+    // The sparse matrix is A, or B when SPARSE_A is false. Its values keep 2 of each 4 k, the
+    // metadata byte of 8 k holds the index in its group of 4 of each of the 4 values, see the
+    // compress kernel. The tiles are expanded to dense int8 in shared memory, the products are
+    // accumulated in int32 and the epilogue is applied to the accumulators before D is written.
+    template <bool SPARSE_A, typename To, typename Tbias>
+    __global__ void __launch_bounds__(QUANTIZED_THREADS)
+        quantized_spmm_kernel(quantized_spmm_args<To, Tbias> args)
+    {
+        __shared__ int32_t tile_a[QUANTIZED_KT][QUANTIZED_MT];
+        __shared__ int32_t tile_b[QUANTIZED_KT][QUANTIZED_NT];
+
+        int     t     = threadIdx.x;
+        int64_t m0    = int64_t(blockIdx.x) * QUANTIZED_MT;
+        int64_t n0    = int64_t(blockIdx.y) * QUANTIZED_NT;
+        int64_t batch = blockIdx.z;
+
+        const int8_t*        a        = args.a + batch * args.batch_stride_a;
+        const int8_t*        b        = args.b + batch * args.batch_stride_b;
+        const unsigned char* metadata = args.metadata + batch * args.batch_stride_metadata;
+        int64_t              ld_meta  = args.k / 2 / 4;
+
+        int32_t (*sparse)[QUANTIZED_MT] = SPARSE_A ? tile_a : tile_b;
+        int64_t sparse_rows             = SPARSE_A ? args.m : args.n;
+        int64_t sparse_row              = (SPARSE_A ? m0 : n0) + t % QUANTIZED_MT;
+        int     group                   = t / QUANTIZED_MT;
+
+        int32_t acc[4][4] = {};
+        for(int64_t k0 = 0; k0 < args.k; k0 += QUANTIZED_KT)
+        {
+            // each thread expands one metadata byte, 8 k of a row of the sparse matrix.
+            int64_t k8 = k0 + 8 * group;
+            for(int i = 0; i < 8; i++)
+                sparse[8 * group + i][t % QUANTIZED_MT] = 0;
+            if(sparse_row < sparse_rows && k8 < args.k)
+            {
+                unsigned char md = metadata[sparse_row * ld_meta + k8 / 8];
+                for(int s = 0; s < 4; s++)
+                {
+                    int64_t ck    = k8 / 2 + s;
+                    int     index = 8 * group + (s / 2) * 4 + ((md >> (2 * s)) & 0x03);
+                    sparse[index][t % QUANTIZED_MT]
+                        = SPARSE_A ? quantized_load(a, sparse_row, ck, args.lda, args.trans_a)
+                                   : quantized_load(b, ck, sparse_row, args.ldb, args.trans_b);
+                }
+            }
+
+            // the dense tile, 8 elements per thread with consecutive threads along ld.
+            for(int q = 0; q < QUANTIZED_KT * QUANTIZED_MT / QUANTIZED_THREADS; q++)
+            {
+                int e = t + q * QUANTIZED_THREADS;
+                if constexpr(SPARSE_A)
+                {
+                    int64_t kk = e % QUANTIZED_KT, col = n0 + e / QUANTIZED_KT;
+                    tile_b[kk][e / QUANTIZED_KT]
+                        = col < args.n && k0 + kk < args.k
+                              ? quantized_load(b, k0 + kk, col, args.ldb, args.trans_b)
+                              : 0;
+                }
+                else
+                {
+                    int64_t kk = e / QUANTIZED_MT, row = m0 + e % QUANTIZED_MT;
+                    tile_a[kk][e % QUANTIZED_MT]
+                        = row < args.m && k0 + kk < args.k
+                              ? quantized_load(a, row, k0 + kk, args.lda, args.trans_a)
+                              : 0;
+                }
+            }
+            __syncthreads();
+
+            for(int kk = 0; kk < QUANTIZED_KT; kk++)
+                for(int i = 0; i < 4; i++)
+                    for(int j = 0; j < 4; j++)
+                        acc[i][j] += tile_a[kk][t % 16 + 16 * i] * tile_b[kk][t / 16 + 16 * j];
+            __syncthreads();
+        }
+
+        for(int i = 0; i < 4; i++)
+        {
+            int64_t row = m0 + t % 16 + 16 * i;
+            if(row >= args.m)
+                continue;
+
+            float bias  = args.bias == nullptr
+                              ? 0.0f
+                              : static_cast<float>(args.bias[batch * args.bias_stride + row]);
+            float scale = args.scale[row];
+            float zero  = args.zero_point == nullptr ? 0.0f : args.zero_point[row];
+            for(int j = 0; j < 4; j++)
+            {
+                int64_t col = n0 + t / 16 + 16 * j;
+                if(col >= args.n)
+                    continue;
+
+                float value = args.alpha * static_cast<float>(acc[i][j]);
+                if(args.c != nullptr)
+                    value += args.beta
+                             * static_cast<float>(
+                                 args.c[batch * args.batch_stride_c + row + col * args.ldc]);
+                value = quantized_activation(
+                    args.act_type, value + bias, args.act_arg0, args.act_arg1);
+                args.d[batch * args.batch_stride_d + row + col * args.ldd]
+                    = quantized_saturate<To>(value * scale + zero);
+            }
+        }
+    }
+}
+
+template <typename To>
+rocsparselt_status rocsparselt_quantized_spmm_template(
+    const RocsparseltContractionProblem<int8_t, To, float>& prob, rocsparselt_datatype bias_type)
+{
+    if(prob.m == 0 || prob.n == 0)
+        return rocsparselt_status_success;
+
+    // a D without batch stride is the same for every batch.
+    int64_t     num_batches = prob.batch_stride_d == 0 ? 1 : prob.batch_count;
+    hipStream_t stream      = prob.numStreams > 0 ? prob.streams[0] : nullptr;
+    dim3        grid((prob.m + QUANTIZED_MT - 1) / QUANTIZED_MT,
+              (prob.n + QUANTIZED_NT - 1) / QUANTIZED_NT,
+              num_batches);
+
+    rocsparselt_timeline_span span(
+        prob.handle, rocsparselt_timeline_kind_kernel_launch, "quantized_spmm_kernel");
+    if(span.active())
+        span.set_dims(grid, dim3(QUANTIZED_THREADS));
+
+    auto launch = [&](auto bias) {
+        using Tbias = std::remove_const_t<std::remove_pointer_t<decltype(bias)>>;
+
+        quantized_spmm_args<To, Tbias> args;
+        args.m                     = prob.m;
+        args.n                     = prob.n;
+        args.k                     = prob.k;
+        args.alpha                 = prob.k ? *prob.alpha : 0.0f;
+        args.beta                  = *prob.beta;
+        args.a                     = prob.A;
+        args.lda                   = prob.col_stride_a;
+        args.batch_stride_a        = prob.batch_stride_a;
+        args.trans_a               = prob.trans_a == rocsparselt_operation_transpose;
+        args.b                     = prob.B;
+        args.ldb                   = prob.col_stride_b;
+        args.batch_stride_b        = prob.batch_stride_b;
+        args.trans_b               = prob.trans_b == rocsparselt_operation_transpose;
+        args.metadata              = prob.metadata;
+        args.batch_stride_metadata = (prob.sparseA ? prob.batch_stride_a : prob.batch_stride_b) / 4;
+        args.c                     = args.beta == 0 ? nullptr : prob.C;
+        args.ldc                   = prob.col_stride_c;
+        args.batch_stride_c        = prob.batch_stride_c;
+        args.d                     = prob.D;
+        args.ldd                   = prob.col_stride_d;
+        args.batch_stride_d        = prob.batch_stride_d;
+        args.bias                  = static_cast<const Tbias*>(bias);
+        args.bias_stride           = prob.bias_stride;
+        args.act_type              = prob.act_type;
+        args.act_arg0              = prob.act_arg0;
+        args.act_arg1              = prob.act_arg1;
+        args.scale                 = prob.scale_vector;
+        args.zero_point            = prob.zero_point_vector;
+
+        if(prob.sparseA)
+            hipLaunchKernelGGL((quantized_spmm_kernel<true, To, Tbias>), /* compute kernel*/
+                               grid,
+                               dim3(QUANTIZED_THREADS),
+                               0 /*dynamic shared*/,
+                               stream,
+                               args);
+        else
+            hipLaunchKernelGGL((quantized_spmm_kernel<false, To, Tbias>), /* compute kernel*/
+                               grid,
+                               dim3(QUANTIZED_THREADS),
+                               0 /*dynamic shared*/,
+                               stream,
+                               args);
+        return rocsparselt_status_success;
+    };
+
+    switch(prob.bias_vector == nullptr ? rocsparselt_datatype_f32_r : bias_type)
+    {
+    case rocsparselt_datatype_f32_r:
+        return launch(static_cast<const float*>(prob.bias_vector));
+    case rocsparselt_datatype_f16_r:
+        return launch(static_cast<const __half*>(prob.bias_vector));
+    case rocsparselt_datatype_bf16_r:
+        return launch(static_cast<const hip_bfloat16*>(prob.bias_vector));
+    default:
+        log_error(prob.handle,
+                  __func__,
+                  "bias_type",
+                  rocsparselt_datatype_to_string(bias_type),
+                  "is not supported by the output quantization");
+        return rocsparselt_status_not_implemented;
+    }
+}
+
+#define GENERATE_DEFINITIONS(To)                                              \
+    template rocsparselt_status rocsparselt_quantized_spmm_template<To>(      \
+        const RocsparseltContractionProblem<int8_t, To, float>&, rocsparselt_datatype);
+
+GENERATE_DEFINITIONS(int8_t)
+GENERATE_DEFINITIONS(__half)
+
+#undef GENERATE_DEFINITIONS
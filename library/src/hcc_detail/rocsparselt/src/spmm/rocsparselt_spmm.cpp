@@ -27,9 +27,13 @@
 #include "rocsparselt_spmm.hpp"
 #include "definitions.h"
 #include "handle.h"
+#include "rocsparselt_shard.hpp"
 #include "rocsparselt_spmm_utils.hpp"
+#include "timeline.hpp"
 #include "utility.hpp"
 
+#include <chrono>
+#include <sstream>
 #include <hip/hip_runtime_api.h>
 
 #ifdef __cplusplus
@@ -77,14 +81,187 @@ rocsparselt_status rocsparselt_matmul_get_workspace(const rocsparselt_handle*
     }
 
     {
-        if(_plan->alg_selection->config_max_id == 0)
-            *workspaceSize = 0;
-        else
+        *workspaceSize = matmul_workspace_size(_plan, _plan->alg_selection->config_id);
+        log_api(_handle, __func__, *workspaceSize);
+        return rocsparselt_status_success;
+    }
+}
+
+namespace
+{
+    int64_t elapsed_ns(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - start)
+            .count();
+    }
+
+    // translate the activation attributes of the matmul descr into the kernel arguments.
+    hipsparselt_activation_type matmul_activation(const _rocsparselt_matmul_descr* matmul_descr,
+                                                  float                            act_args[2])
+    {
+        hipsparselt_activation_type act_type = hipsparselt_activation_type::none;
+        if(matmul_descr->activation == rocsparselt_matmul_activation_relu)
         {
-            *workspaceSize = _plan->alg_selection->configs[_plan->alg_selection->config_id]
-                                 .max_workspace_bytes;
+            act_args[0] = matmul_descr->activation_relu_threshold;
+            act_args[1] = matmul_descr->activation_relu_upperbound;
+            if(act_args[0] == 0 && act_args[1] == std::numeric_limits<float>::infinity())
+                act_type = hipsparselt_activation_type::relu;
+            else
+                act_type = hipsparselt_activation_type::clippedrelu;
+        }
+        else if(matmul_descr->activation == rocsparselt_matmul_activation_gelu)
+        {
+            act_type    = hipsparselt_activation_type::gelu;
+            act_args[0] = matmul_descr->activation_gelu_scaling;
+        }
+        else if(matmul_descr->activation == rocsparselt_matmul_activation_abs)
+            act_type = hipsparselt_activation_type::abs;
+        else if(matmul_descr->activation == rocsparselt_matmul_activation_leakyrelu)
+        {
+            act_type    = hipsparselt_activation_type::leakyrelu;
+            act_args[0] = matmul_descr->activation_leakyrelu_alpha;
+        }
+        else if(matmul_descr->activation == rocsparselt_matmul_activation_sigmoid)
+            act_type = hipsparselt_activation_type::sigmoid;
+        else if(matmul_descr->activation == rocsparselt_matmul_activation_tanh)
+        {
+            act_type    = hipsparselt_activation_type::tanh;
+            act_args[0] = matmul_descr->activation_tanh_alpha;
+            act_args[1] = matmul_descr->activation_tanh_beta;
+        }
+        return act_type;
+    }
+
+    // write the hipsparselt-bench command line which replays this matmul to the bench log.
+    void log_bench_matmul(const char*                     caller,
+                          const _rocsparselt_handle*      handle,
+                          const _rocsparselt_matmul_plan* plan,
+                          const void*                     alpha,
+                          const void*                     beta,
+                          const void*                     d_C,
+                          const void*                     d_D)
+    {
+        if(!handle->log_bench || handle->log_bench_os == nullptr)
+            return;
+
+        auto  matmul_descr = plan->matmul_descr;
+        auto  matA         = matmul_descr->matrix_A;
+        auto  matB         = matmul_descr->matrix_B;
+        auto  matC         = matmul_descr->matrix_C;
+        auto  matD         = matmul_descr->matrix_D;
+        int   num_batches  = matA->num_batches;
+        bool  batched      = num_batches > 1;
+        float act_args[2]  = {0.0f, 0.0f};
+        auto  act_type     = matmul_activation(matmul_descr, act_args);
+
+        std::ostringstream cmd;
+        cmd << "hipsparselt-bench -f " << (batched ? "spmm_strided_batched" : "spmm")
+            << " --a_type " << rocsparselt_datatype_string(matA->type) << " --b_type "
+            << rocsparselt_datatype_string(matB->type) << " --c_type "
+            << rocsparselt_datatype_string(matC->type) << " --d_type "
+            << rocsparselt_datatype_string(matD->type) << " --compute_type "
+            << rocsparselt_compute_type_string(matmul_descr->compute_type) << " --transposeA "
+            << rocsparselt_transpose_letter(matmul_descr->op_A) << " --transposeB "
+            << rocsparselt_transpose_letter(matmul_descr->op_B) << " -m " << matmul_descr->m
+            << " -n " << matmul_descr->n << " -k " << matmul_descr->k << " --lda " << matA->ld
+            << " --ldb " << matB->ld << " --ldc " << matC->ld << " --ldd " << matD->ld
+            << " --alpha " << *reinterpret_cast<const float*>(alpha) << " --beta "
+            << *reinterpret_cast<const float*>(beta);
+        if(batched)
+            cmd << " --batch_count " << num_batches << " --stride_a " << matA->batch_stride
+                << " --stride_b " << matB->batch_stride << " --stride_c " << matC->batch_stride
+                << " --stride_d " << matD->batch_stride;
+        if(act_type != hipsparselt_activation_type::none)
+            cmd << " --activation_type " << hipsparselt_activation_type_to_string(act_type);
+        // the activations without arguments ignore act_args, relu only has the defaults.
+        if(act_type == hipsparselt_activation_type::clippedrelu
+           || act_type == hipsparselt_activation_type::gelu
+           || act_type == hipsparselt_activation_type::leakyrelu
+           || act_type == hipsparselt_activation_type::tanh)
+            cmd << " --activation_arg1 " << act_args[0];
+        if(act_type == hipsparselt_activation_type::clippedrelu
+           || act_type == hipsparselt_activation_type::tanh)
+            cmd << " --activation_arg2 " << act_args[1];
+        if(matmul_descr->bias_pointer != nullptr)
+            cmd << " --bias_vector --bias_stride " << matmul_descr->bias_stride << " --bias_type "
+                << rocsparselt_datatype_string(matmul_descr->bias_type);
+        if(matmul_descr->output_scale_pointer != nullptr)
+            cmd << " --output_scale";
+        if(!matmul_descr->is_sparse_a)
+            cmd << " --sparse_b";
+        if(d_C != d_D)
+            cmd << " --c_noalias_d";
+        cmd << " --config_id " << plan->alg_selection->config_id;
+
+        log_bench(handle, caller, cmd.str());
+    }
+
+    // check the plan and the pointers of one matmul.
+    rocsparselt_status matmul_check_args(const char*                    caller,
+                                         const _rocsparselt_handle*     _handle,
+                                         const rocsparselt_matmul_plan* plan,
+                                         const void*                    alpha,
+                                         const void*                    d_A,
+                                         const void*                    d_B,
+                                         const void*                    beta,
+                                         const void*                    d_C,
+                                         void*                          d_D)
+    {
+        if(plan == nullptr)
+        {
+            log_error(_handle, caller, "plan is a NULL pointer");
+            return rocsparselt_status_invalid_handle;
+        }
+        auto _plan = reinterpret_cast<const _rocsparselt_matmul_plan*>(plan);
+        if(!_plan->isInit())
+        {
+            log_error(_handle, caller, "plan did not initialized or already destroyed");
+            return rocsparselt_status_invalid_handle;
+        }
+        // the arena, logging and device of the call are the ones of the plan's handle.
+        if(_plan->handle != _handle)
+        {
+            log_error(_handle, caller, "plan is not created by handle");
+            return rocsparselt_status_invalid_handle;
+        }
+
+        // Check if pointer is valid
+        if(alpha == nullptr)
+        {
+            log_error(_handle, caller, "alpha is a NULL pointer");
+            return rocsparselt_status_invalid_pointer;
+        }
+
+        if(d_A == nullptr)
+        {
+            log_error(_handle, caller, "d_A is a NULL pointer");
+            return rocsparselt_status_invalid_pointer;
+        }
+
+        if(d_B == nullptr)
+        {
+            log_error(_handle, caller, "d_B is a NULL pointer");
+            return rocsparselt_status_invalid_pointer;
+        }
+
+        if(beta == nullptr)
+        {
+            log_error(_handle, caller, "beta is a NULL pointer");
+            return rocsparselt_status_invalid_pointer;
+        }
+
+        if(d_C == nullptr)
+        {
+            log_error(_handle, caller, "d_C is a NULL pointer");
+            return rocsparselt_status_invalid_pointer;
+        }
+
+        if(d_D == nullptr)
+        {
+            log_error(_handle, caller, "d_D is a NULL pointer");
+            return rocsparselt_status_invalid_pointer;
         }
-        log_api(_handle, __func__, *workspaceSize);
         return rocsparselt_status_success;
     }
 }
@@ -103,6 +280,8 @@ rocsparselt_status rocsparselt_matmul_impl(const char*                    caller
                                            int32_t                        numStreams,
                                            bool                           search = false)
 {
+    auto host_start = std::chrono::steady_clock::now();
+
     // Check if handle is valid
     if(handle == nullptr)
     {
@@ -116,67 +295,13 @@ rocsparselt_status rocsparselt_matmul_impl(const char*                    caller
         return rocsparselt_status_invalid_handle;
     }
 
-    if(plan == nullptr)
-    {
-        log_error(_handle, caller, "plan is a NULL pointer");
-        return rocsparselt_status_invalid_handle;
-    }
-    auto _plan = reinterpret_cast<const _rocsparselt_matmul_plan*>(plan);
-    if(!_plan->isInit())
-    {
-        log_error(_handle, caller, "plan did not initialized or already destroyed");
-        return rocsparselt_status_invalid_handle;
-    }
+    rocsparselt_timeline_span span(_handle, rocsparselt_timeline_kind_api, caller);
 
-    // Check if pointer is valid
-    if(alpha == nullptr)
-    {
-        log_error(_handle, caller, "alpha is a NULL pointer");
-        return rocsparselt_status_invalid_pointer;
-    }
-
-    if(d_A == nullptr)
-    {
-        log_error(_handle, caller, "d_A is a NULL pointer");
-        return rocsparselt_status_invalid_pointer;
-    }
-
-    if(d_B == nullptr)
-    {
-        log_error(_handle, caller, "d_B is a NULL pointer");
-        return rocsparselt_status_invalid_pointer;
-    }
-
-    if(beta == nullptr)
-    {
-        log_error(_handle, caller, "beta is a NULL pointer");
-        return rocsparselt_status_invalid_pointer;
-    }
-
-    if(d_C == nullptr)
-    {
-        log_error(_handle, caller, "d_C is a NULL pointer");
-        return rocsparselt_status_invalid_pointer;
-    }
-
-    if(d_D == nullptr)
-    {
-        log_error(_handle, caller, "d_D is a NULL pointer");
-        return rocsparselt_status_invalid_pointer;
-    }
+    RETURN_IF_ROCSPARSELT_ERROR(
+        matmul_check_args(caller, _handle, plan, alpha, d_A, d_B, beta, d_C, d_D));
+    auto _plan = reinterpret_cast<const _rocsparselt_matmul_plan*>(plan);
 
-    size_t workspaceSize
-        = _plan->alg_selection->config_max_id == 0
-              ? 0
-              : _plan->alg_selection->configs[_plan->alg_selection->config_id].max_workspace_bytes;
-    if(workspace == nullptr && workspaceSize != 0)
-    {
-        hipsparselt_cerr << "The parameter number 9 (workspace) had an illegal value "
-                            "expected a device memroy with "
-                         << workspaceSize << " bytes, but current is nullptr" << std::endl;
-        log_error(_handle, caller, "expected workspace is not a NULL pointer");
-        return rocsparselt_status_invalid_value;
-    }
+    size_t workspaceSize = matmul_workspace_size(_plan, _plan->alg_selection->config_id);
 
     if(numStreams < 0)
     {
@@ -195,6 +320,36 @@ rocsparselt_status rocsparselt_matmul_impl(const char*                    caller
         return rocsparselt_status_invalid_value;
     }
 
+    // take the workspace from the handle's arena, search may try every config.
+    auto arena = workspace == nullptr ? _handle->get_workspace_arena() : nullptr;
+    if(arena != nullptr)
+    {
+        size_t arenaSize = workspaceSize;
+        if(search)
+            for(int i = 0; i < _plan->alg_selection->config_max_id; i++)
+                arenaSize = std::max(arenaSize, matmul_workspace_size(_plan, i));
+        if(arenaSize != 0)
+        {
+            // a graph keeps the workspace it was captured with, which a later matmul may free.
+            hipStream_t arenaStream = numStreams > 0 ? streams[0] : nullptr;
+            if(isCapturing(arenaStream))
+            {
+                log_error(_handle, caller, "a captured matmul needs an explicit workspace");
+                return rocsparselt_status_invalid_value;
+            }
+            RETURN_IF_ROCSPARSELT_ERROR(arena->acquire(arenaStream, arenaSize, &workspace));
+        }
+    }
+
+    if(workspace == nullptr && workspaceSize != 0)
+    {
+        hipsparselt_cerr << "The parameter number 9 (workspace) had an illegal value "
+                            "expected a device memroy with "
+                         << workspaceSize << " bytes, but current is nullptr" << std::endl;
+        log_error(_handle, caller, "expected workspace is not a NULL pointer");
+        return rocsparselt_status_invalid_value;
+    }
+
     // algorithm selection
     int config_id         = _plan->alg_selection->config_id;
     int config_max_id     = _plan->alg_selection->config_max_id;
@@ -228,8 +383,32 @@ rocsparselt_status rocsparselt_matmul_impl(const char*                    caller
             streams,
             "numStreams[in]",
             numStreams);
+    if(!search)
+        log_bench_matmul(caller, _handle, _plan, alpha, beta, d_C, d_D);
+
+    // runtime counters of the plan, a search is not counted.
+    _rocsparselt_matmul_plan_stats* stats   = search ? nullptr : _plan->stats;
+    hipStream_t                     stream  = numStreams > 0 ? streams[0] : nullptr;
+    bool                            sampled = false;
+
+    // the search waits for its events, which a captured stream does not allow.
+    if(search && isCapturing(stream))
+    {
+        log_error(_handle, caller, "a search cannot be captured into a graph");
+        return rocsparselt_status_not_implemented;
+    }
+
+    // a captured call is counted, but not timed, its events are never recorded.
+    if(stats != nullptr)
+        sampled = stats->is_sampled(stats->begin_call()) && !isCapturing(stream)
+                  && stats->gpu_sample_begin(stream);
 
     rocsparselt_status status = rocsparselt_spmm_template(EX_PARM);
+    if(sampled)
+        stats->gpu_sample_end(stream);
+    if(stats != nullptr)
+        stats->end_call(elapsed_ns(host_start));
+
     if(search && status == rocsparselt_status_success)
     {
         log_info(_handle, caller, "found the best config_id", config_id);
@@ -288,6 +467,628 @@ rocsparselt_status rocsparselt_matmul_search(const rocsparselt_handle* handle,
                                    numStreams,
                                    true);
 }
+
+/********************************************************************************
+ * \brief
+ *******************************************************************************/
+rocsparselt_status rocsparselt_matmul_multiple(const rocsparselt_handle*        handle,
+                                               const rocsparselt_matmul_launch* launches,
+                                               int32_t                          numLaunches,
+                                               hipStream_t*                     streams,
+                                               int32_t                          numStreams)
+{
+    // Check if handle is valid
+    if(handle == nullptr)
+    {
+        hipsparselt_cerr << "handle is a NULL pointer" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+    auto _handle = reinterpret_cast<const _rocsparselt_handle*>(handle);
+    if(!_handle->isInit())
+    {
+        hipsparselt_cerr << "handle did not initialized or already destroyed" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+
+    rocsparselt_timeline_span span(_handle, rocsparselt_timeline_kind_api, __func__);
+
+    if(launches == nullptr)
+    {
+        log_error(_handle, __func__, "launches is a NULL pointer");
+        return rocsparselt_status_invalid_pointer;
+    }
+
+    if(numLaunches < 0)
+    {
+        log_error(_handle, __func__, "numLaunches should >= 0");
+        return rocsparselt_status_invalid_value;
+    }
+
+    if(numStreams < 0)
+    {
+        log_error(_handle, __func__, "numStreams should >= 0");
+        return rocsparselt_status_invalid_value;
+    }
+    else if(streams == nullptr && numStreams > 0)
+    {
+        log_error(_handle,
+                  __func__,
+                  "streams should not be a NULL pointer because the numStreams is not 0");
+        return rocsparselt_status_invalid_value;
+    }
+
+    // validate everything before the first launch.
+    auto                arena = _handle->get_workspace_arena();
+    std::vector<void*>  workspaces(numLaunches);
+    std::vector<size_t> arenaSizes(std::max(numStreams, 1), 0);
+    for(int i = 0; i < numLaunches; i++)
+    {
+        auto& l = launches[i];
+        RETURN_IF_ROCSPARSELT_ERROR(matmul_check_args(
+            __func__, _handle, l.plan, l.alpha, l.d_A, l.d_B, l.beta, l.d_C, l.d_D));
+
+        auto   _plan         = reinterpret_cast<const _rocsparselt_matmul_plan*>(l.plan);
+        size_t workspaceSize = matmul_workspace_size(_plan, _plan->alg_selection->config_id);
+        workspaces[i]        = l.workspace;
+        if(l.workspace == nullptr && workspaceSize != 0)
+        {
+            // as in matmul_impl, a graph must not keep a buffer of the arena.
+            int s = numStreams > 0 ? i % numStreams : 0;
+            if(arena == nullptr || isCapturing(numStreams > 0 ? streams[s] : nullptr))
+            {
+                log_error(_handle,
+                          __func__,
+                          "expected workspace of launch ",
+                          i,
+                          " is not a NULL pointer");
+                return rocsparselt_status_invalid_value;
+            }
+            arenaSizes[s] = std::max(arenaSizes[s], workspaceSize);
+        }
+    }
+
+    log_api(_handle,
+            __func__,
+            "launches[in]",
+            launches,
+            "numLaunches[in]",
+            numLaunches,
+            "streams[in]",
+            streams,
+            "numStreams[in]",
+            numStreams);
+
+    // the matmuls sharing a stream are serialized, so they can share one arena buffer.
+    std::vector<void*> arenaBuffers(arenaSizes.size(), nullptr);
+    for(size_t s = 0; s < arenaSizes.size(); s++)
+        if(arenaSizes[s] != 0)
+            RETURN_IF_ROCSPARSELT_ERROR(arena->acquire(
+                numStreams > 0 ? streams[s] : nullptr, arenaSizes[s], &arenaBuffers[s]));
+
+    for(int i = 0; i < numLaunches; i++)
+    {
+        auto        launch_start = std::chrono::steady_clock::now();
+        auto&       l            = launches[i];
+        auto        _plan        = reinterpret_cast<const _rocsparselt_matmul_plan*>(l.plan);
+        auto        stats        = _plan->stats;
+        int         s            = numStreams > 0 ? i % numStreams : 0;
+        hipStream_t stream       = numStreams > 0 ? streams[s] : nullptr;
+        void*       ws           = workspaces[i] != nullptr ? workspaces[i] : arenaBuffers[s];
+        int         config_id    = _plan->alg_selection->config_id;
+        bool        sampled      = false;
+        if(stats != nullptr)
+            sampled = stats->is_sampled(stats->begin_call()) && !isCapturing(stream)
+                      && stats->gpu_sample_begin(stream);
+        log_bench_matmul(__func__, _handle, _plan, l.alpha, l.beta, l.d_C, l.d_D);
+
+        rocsparselt_status status
+            = rocsparselt_spmm_template(__func__,
+                                        _handle,
+                                        _plan,
+                                        l.alpha,
+                                        l.beta,
+                                        l.d_A,
+                                        l.d_B,
+                                        l.d_C,
+                                        l.d_D,
+                                        ws,
+                                        numStreams > 0 ? &streams[s] : nullptr,
+                                        numStreams > 0 ? 1 : 0,
+                                        &config_id,
+                                        _plan->alg_selection->config_max_id,
+                                        0);
+        if(sampled)
+            stats->gpu_sample_end(stream);
+        if(stats != nullptr)
+            stats->end_call(elapsed_ns(launch_start));
+        RETURN_IF_ROCSPARSELT_ERROR(status);
+    }
+    return rocsparselt_status_success;
+}
+
+namespace
+{
+    // capture the launches on stream into a graph, nullptr when a launch fails.
+    rocsparselt_status matmul_graph_capture(const rocsparselt_handle*        handle,
+                                            const rocsparselt_matmul_launch* launches,
+                                            int32_t                          numLaunches,
+                                            hipStream_t                      stream,
+                                            hipGraph_t*                      graph)
+    {
+        auto        _handle       = reinterpret_cast<const _rocsparselt_handle*>(handle);
+        hipStream_t captureStream = stream;
+        *graph                    = nullptr;
+        if(stream == nullptr)
+            RETURN_IF_HIP_ERROR(hipStreamCreateWithFlags(&captureStream, hipStreamNonBlocking));
+
+        // thread local, the other threads of the process may keep using HIP meanwhile.
+        rocsparselt_status status = get_rocsparselt_status_for_hip_status(
+            hipStreamBeginCapture(captureStream, hipStreamCaptureModeThreadLocal));
+        if(status == rocsparselt_status_success)
+        {
+            status = rocsparselt_matmul_multiple(handle, launches, numLaunches, &captureStream, 1);
+
+            // end the capture even when a launch failed, the stream must not stay captured.
+            hipError_t err = hipStreamEndCapture(captureStream, graph);
+            if(status == rocsparselt_status_success && err != hipSuccess)
+            {
+                log_error(_handle, __func__, "the capture failed:", hipGetErrorName(err));
+                status = get_rocsparselt_status_for_hip_status(err);
+            }
+            if(status != rocsparselt_status_success && *graph != nullptr)
+            {
+                PRINT_IF_HIP_ERROR(_handle, hipGraphDestroy(*graph));
+                *graph = nullptr;
+            }
+        }
+
+        if(stream == nullptr)
+            PRINT_IF_HIP_ERROR(_handle, hipStreamDestroy(captureStream));
+        return status;
+    }
+}
+
+/********************************************************************************
+ * \brief
+ *******************************************************************************/
+rocsparselt_status rocsparselt_matmul_graph_create(const rocsparselt_handle*        handle,
+                                                   const rocsparselt_matmul_launch* launches,
+                                                   int32_t                          numLaunches,
+                                                   hipStream_t                      stream,
+                                                   hipGraphExec_t*                  graphExec)
+{
+    // Check if handle is valid
+    if(handle == nullptr)
+    {
+        hipsparselt_cerr << "handle is a NULL pointer" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+    auto _handle = reinterpret_cast<const _rocsparselt_handle*>(handle);
+    if(!_handle->isInit())
+    {
+        hipsparselt_cerr << "handle did not initialized or already destroyed" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+
+    rocsparselt_timeline_span span(_handle, rocsparselt_timeline_kind_api, __func__);
+
+    if(graphExec == nullptr)
+    {
+        log_error(_handle, __func__, "graphExec is a NULL pointer");
+        return rocsparselt_status_invalid_pointer;
+    }
+
+    log_api(_handle,
+            __func__,
+            "launches[in]",
+            launches,
+            "numLaunches[in]",
+            numLaunches,
+            "stream[in]",
+            stream,
+            "graphExec[out]",
+            graphExec);
+
+    hipGraph_t graph;
+    RETURN_IF_ROCSPARSELT_ERROR(
+        matmul_graph_capture(handle, launches, numLaunches, stream, &graph));
+    hipError_t err = hipGraphInstantiate(graphExec, graph, nullptr, nullptr, 0);
+    PRINT_IF_HIP_ERROR(_handle, hipGraphDestroy(graph));
+    RETURN_IF_HIP_ERROR(err);
+    return rocsparselt_status_success;
+}
+
+/********************************************************************************
+ * \brief
+ *******************************************************************************/
+rocsparselt_status rocsparselt_matmul_graph_update(const rocsparselt_handle*        handle,
+                                                   const rocsparselt_matmul_launch* launches,
+                                                   int32_t                          numLaunches,
+                                                   hipStream_t                      stream,
+                                                   hipGraphExec_t                   graphExec)
+{
+    // Check if handle is valid
+    if(handle == nullptr)
+    {
+        hipsparselt_cerr << "handle is a NULL pointer" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+    auto _handle = reinterpret_cast<const _rocsparselt_handle*>(handle);
+    if(!_handle->isInit())
+    {
+        hipsparselt_cerr << "handle did not initialized or already destroyed" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+
+    rocsparselt_timeline_span span(_handle, rocsparselt_timeline_kind_api, __func__);
+
+    if(graphExec == nullptr)
+    {
+        log_error(_handle, __func__, "graphExec is a NULL pointer");
+        return rocsparselt_status_invalid_pointer;
+    }
+
+    log_api(_handle,
+            __func__,
+            "launches[in]",
+            launches,
+            "numLaunches[in]",
+            numLaunches,
+            "stream[in]",
+            stream,
+            "graphExec[in]",
+            graphExec);
+
+    hipGraph_t graph;
+    RETURN_IF_ROCSPARSELT_ERROR(
+        matmul_graph_capture(handle, launches, numLaunches, stream, &graph));
+
+    // only the kernel arguments may differ, the nodes must be the same.
+    hipGraphNode_t           errorNode;
+    hipGraphExecUpdateResult result;
+    hipError_t               err = hipGraphExecUpdate(graphExec, graph, &errorNode, &result);
+    PRINT_IF_HIP_ERROR(_handle, hipGraphDestroy(graph));
+    if(err != hipSuccess || result != hipGraphExecUpdateSuccess)
+    {
+        log_error(_handle, __func__, "the launches do not match the graph, result", result);
+        return rocsparselt_status_invalid_value;
+    }
+    return rocsparselt_status_success;
+}
+
+/********************************************************************************
+ * \brief
+ *******************************************************************************/
+rocsparselt_status rocsparselt_matmul_shard_partition(int        numShards,
+                                                      const int* weights,
+                                                      int64_t    extent,
+                                                      int64_t    granularity,
+                                                      int64_t*   offsets,
+                                                      int64_t*   sizes)
+{
+    if(weights == nullptr || offsets == nullptr || sizes == nullptr)
+    {
+        hipsparselt_cerr << "weights, offsets or sizes is a NULL pointer" << std::endl;
+        return rocsparselt_status_invalid_pointer;
+    }
+
+    if(!rocsparselt_shard_partition(numShards, weights, extent, granularity, offsets, sizes))
+    {
+        hipsparselt_cerr << "invalid shard partition, numShards=" << numShards
+                         << " extent=" << extent << " granularity=" << granularity
+                         << ", weights must be non-negative and not all 0" << std::endl;
+        return rocsparselt_status_invalid_value;
+    }
+    return rocsparselt_status_success;
+}
+
+namespace
+{
+    // copy D of one shard into its place in the gathered matrix.
+    rocsparselt_status gather_shard(const _rocsparselt_mat_descr* shard,
+                                    const _rocsparselt_mat_descr* gather,
+                                    rocsparselt_shard_dim         dim,
+                                    int64_t                       offset,
+                                    const void*                   d_shard,
+                                    void*                         d_gather,
+                                    hipStream_t                   stream)
+    {
+        auto datatype_bpe = [&] {
+            switch(shard->type)
+            {
+            case rocsparselt_datatype_f32_r:
+                return 4;
+            case rocsparselt_datatype_f16_r:
+            case rocsparselt_datatype_bf16_r:
+                return 2;
+            default:
+                return 1;
+            }
+        };
+        size_t bpe = datatype_bpe();
+
+        bool    col_major = shard->order == rocsparselt_order_column;
+        size_t  width     = (col_major ? shard->m : shard->n) * bpe;
+        size_t  height    = col_major ? shard->n : shard->m;
+        int64_t dst_off   = 0;
+        int64_t batch_off = 0;
+        if(dim == rocsparselt_shard_dim_n)
+            dst_off = col_major ? offset * gather->ld : offset;
+        else
+            batch_off = offset;
+
+        for(int b = 0; b < shard->num_batches; b++)
+        {
+            auto src = reinterpret_cast<const char*>(d_shard) + b * shard->batch_stride * bpe;
+            auto dst = reinterpret_cast<char*>(d_gather)
+                       + ((b + batch_off) * gather->batch_stride + dst_off) * bpe;
+            RETURN_IF_HIP_ERROR(hipMemcpy2DAsync(dst,
+                                                 gather->ld * bpe,
+                                                 src,
+                                                 shard->ld * bpe,
+                                                 width,
+                                                 height,
+                                                 hipMemcpyDeviceToDevice,
+                                                 stream));
+        }
+        return rocsparselt_status_success;
+    }
+
+    // the gather device reads D of every shard, give it peer access to their devices.
+    rocsparselt_status enable_gather_peer_access(const rocsparselt_handle* const*      handles,
+                                                 const rocsparselt_matmul_plan* const* plans,
+                                                 int                                   numShards)
+    {
+        auto gather = reinterpret_cast<const _rocsparselt_handle*>(handles[0]);
+        for(int i = 1; i < numShards; i++)
+        {
+            int device = reinterpret_cast<const _rocsparselt_handle*>(handles[i])->device;
+            if(plans[i] == nullptr || device == gather->device)
+                continue;
+            int canAccess = 0;
+            RETURN_IF_HIP_ERROR(hipDeviceCanAccessPeer(&canAccess, gather->device, device));
+            if(!canAccess)
+            {
+                log_error(gather,
+                          "rocsparselt_matmul_sharded",
+                          "device ",
+                          gather->device,
+                          " of handles[0] can not access device ",
+                          device,
+                          " of handles[",
+                          i,
+                          "]");
+                return rocsparselt_status_not_implemented;
+            }
+            RETURN_IF_HIP_ERROR(hipSetDevice(gather->device));
+            hipError_t err = hipDeviceEnablePeerAccess(device, 0);
+            if(err == hipErrorPeerAccessAlreadyEnabled)
+                (void)hipGetLastError();
+            else
+                RETURN_IF_HIP_ERROR(err);
+        }
+        return rocsparselt_status_success;
+    }
+
+    rocsparselt_status matmul_sharded_impl(const rocsparselt_handle* const*      handles,
+                                           const rocsparselt_matmul_plan* const* plans,
+                                           int                                   numShards,
+                                           rocsparselt_shard_dim                 dim,
+                                           const void*                           alpha,
+                                           const void* const*                    d_A,
+                                           const void* const*                    d_B,
+                                           const void*                           beta,
+                                           const void* const*                    d_C,
+                                           void* const*                          d_D,
+                                           void* const*                          workspaces,
+                                           hipStream_t*                          streams,
+                                           const _rocsparselt_mat_descr*         gather,
+                                           void*                                 d_gather)
+    {
+        // launch every shard first so that they run concurrently.
+        for(int i = 0; i < numShards; i++)
+        {
+            if(plans[i] == nullptr)
+                continue;
+            auto _handle = reinterpret_cast<const _rocsparselt_handle*>(handles[i]);
+            RETURN_IF_HIP_ERROR(hipSetDevice(_handle->device));
+            RETURN_IF_ROCSPARSELT_ERROR(
+                rocsparselt_matmul_impl("rocsparselt_matmul_sharded",
+                                        handles[i],
+                                        plans[i],
+                                        alpha,
+                                        d_A[i],
+                                        d_B[i],
+                                        beta,
+                                        d_C[i],
+                                        d_D[i],
+                                        workspaces == nullptr ? nullptr : workspaces[i],
+                                        streams == nullptr ? nullptr : &streams[i],
+                                        streams == nullptr ? 0 : 1));
+        }
+
+        if(d_gather == nullptr)
+            return rocsparselt_status_success;
+
+        int64_t     offset       = 0;
+        int         gatherDevice = reinterpret_cast<const _rocsparselt_handle*>(handles[0])->device;
+        hipStream_t gatherStream = streams == nullptr ? nullptr : streams[0];
+        for(int i = 0; i < numShards; i++)
+        {
+            if(plans[i] == nullptr)
+                continue;
+            auto _handle = reinterpret_cast<const _rocsparselt_handle*>(handles[i]);
+            auto _plan   = reinterpret_cast<const _rocsparselt_matmul_plan*>(plans[i]);
+            auto shard   = _plan->matmul_descr->matrix_D;
+
+            if(i != 0)
+            {
+                // make the gather stream wait for the shard.
+                hipEvent_t event;
+                RETURN_IF_HIP_ERROR(hipSetDevice(_handle->device));
+                RETURN_IF_HIP_ERROR(hipEventCreateWithFlags(&event, hipEventDisableTiming));
+                RETURN_IF_HIP_ERROR(
+                    hipEventRecord(event, streams == nullptr ? nullptr : streams[i]));
+                RETURN_IF_HIP_ERROR(hipSetDevice(gatherDevice));
+                RETURN_IF_HIP_ERROR(hipStreamWaitEvent(gatherStream, event, 0));
+                RETURN_IF_HIP_ERROR(hipEventDestroy(event));
+            }
+            RETURN_IF_HIP_ERROR(hipSetDevice(gatherDevice));
+            RETURN_IF_ROCSPARSELT_ERROR(
+                gather_shard(shard, gather, dim, offset, d_D[i], d_gather, gatherStream));
+            offset += dim == rocsparselt_shard_dim_n ? shard->n : shard->num_batches;
+        }
+        return rocsparselt_status_success;
+    }
+}
+
+/********************************************************************************
+ * \brief
+ *******************************************************************************/
+rocsparselt_status rocsparselt_matmul_sharded(const rocsparselt_handle* const*      handles,
+                                              const rocsparselt_matmul_plan* const* plans,
+                                              int                                   numShards,
+                                              rocsparselt_shard_dim                 dim,
+                                              const void*                           alpha,
+                                              const void* const*                    d_A,
+                                              const void* const*                    d_B,
+                                              const void*                           beta,
+                                              const void* const*                    d_C,
+                                              void* const*                          d_D,
+                                              void* const*                          workspaces,
+                                              hipStream_t*                          streams,
+                                              const rocsparselt_mat_descr*          gatherDescr,
+                                              void*                                 d_gather)
+{
+    if(handles == nullptr || plans == nullptr)
+    {
+        hipsparselt_cerr << "handles or plans is a NULL pointer" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+
+    if(numShards <= 0)
+    {
+        hipsparselt_cerr << "The parameter number 3 (numShards) had an illegal value: "
+                         << numShards << std::endl;
+        return rocsparselt_status_invalid_value;
+    }
+
+    if(dim != rocsparselt_shard_dim_n && dim != rocsparselt_shard_dim_batch)
+    {
+        hipsparselt_cerr << "The parameter number 4 (dim) had an illegal value: " << dim
+                         << std::endl;
+        return rocsparselt_status_invalid_value;
+    }
+
+    for(int i = 0; i < numShards; i++)
+    {
+        if(handles[i] == nullptr)
+        {
+            hipsparselt_cerr << "handles[" << i << "] is a NULL pointer" << std::endl;
+            return rocsparselt_status_invalid_handle;
+        }
+        auto _handle = reinterpret_cast<const _rocsparselt_handle*>(handles[i]);
+        if(!_handle->isInit())
+        {
+            hipsparselt_cerr << "handles[" << i << "] did not initialized or already destroyed"
+                             << std::endl;
+            return rocsparselt_status_invalid_handle;
+        }
+        auto _plan = reinterpret_cast<const _rocsparselt_matmul_plan*>(plans[i]);
+        if(_plan != nullptr && _plan->handle != _handle)
+        {
+            log_error(_handle, __func__, "plans[", i, "] is not created by handles[", i, "]");
+            return rocsparselt_status_invalid_handle;
+        }
+    }
+
+    if(d_A == nullptr || d_B == nullptr || d_C == nullptr || d_D == nullptr)
+    {
+        hipsparselt_cerr << "d_A, d_B, d_C or d_D is a NULL pointer" << std::endl;
+        return rocsparselt_status_invalid_pointer;
+    }
+
+    auto _handle = reinterpret_cast<const _rocsparselt_handle*>(handles[0]);
+    const _rocsparselt_mat_descr* _gather = nullptr;
+    if(d_gather != nullptr)
+    {
+        if(gatherDescr == nullptr)
+        {
+            log_error(_handle, __func__, "gatherDescr is a NULL pointer");
+            return rocsparselt_status_invalid_handle;
+        }
+        _gather = reinterpret_cast<const _rocsparselt_mat_descr*>(gatherDescr);
+        if(!_gather->isInit() || _gather->handle != _handle)
+        {
+            log_error(_handle,
+                      __func__,
+                      "gatherDescr did not initialized or not created by handles[0]");
+            return rocsparselt_status_invalid_handle;
+        }
+
+        // the shards must tile the gathered matrix exactly.
+        int64_t extent = 0;
+        for(int i = 0; i < numShards; i++)
+        {
+            if(plans[i] == nullptr)
+                continue;
+            auto _plan = reinterpret_cast<const _rocsparselt_matmul_plan*>(plans[i]);
+            auto shard = _plan->matmul_descr->matrix_D;
+            bool same_n = dim == rocsparselt_shard_dim_n || shard->n == _gather->n;
+            bool same_batches
+                = dim == rocsparselt_shard_dim_batch || shard->num_batches == _gather->num_batches;
+            if(shard->type != _gather->type || shard->order != _gather->order
+               || shard->m != _gather->m || !same_n || !same_batches)
+            {
+                log_error(_handle, __func__, "D of shard ", i, " does not match gatherDescr");
+                return rocsparselt_status_invalid_value;
+            }
+            extent += dim == rocsparselt_shard_dim_n ? shard->n : shard->num_batches;
+        }
+        if(extent != (dim == rocsparselt_shard_dim_n ? _gather->n : _gather->num_batches))
+        {
+            log_error(_handle, __func__, "the shards do not cover gatherDescr");
+            return rocsparselt_status_invalid_value;
+        }
+    }
+
+    log_api(_handle,
+            __func__,
+            "numShards[in]",
+            numShards,
+            "dim[in]",
+            dim,
+            "gatherDescr[in]",
+            gatherDescr,
+            "d_gather[in]",
+            d_gather);
+
+    int device;
+    RETURN_IF_HIP_ERROR(hipGetDevice(&device));
+    auto status = d_gather == nullptr ? rocsparselt_status_success
+                                      : enable_gather_peer_access(handles, plans, numShards);
+    if(status != rocsparselt_status_success)
+    {
+        RETURN_IF_HIP_ERROR(hipSetDevice(device));
+        return status;
+    }
+    status = matmul_sharded_impl(handles,
+                                 plans,
+                                 numShards,
+                                 dim,
+                                 alpha,
+                                 d_A,
+                                 d_B,
+                                 beta,
+                                 d_C,
+                                 d_D,
+                                 workspaces,
+                                 streams,
+                                 _gather,
+                                 d_gather);
+    RETURN_IF_HIP_ERROR(hipSetDevice(device));
+    return status;
+}
 #ifdef __cplusplus
 }
 #endif
@@ -374,38 +1175,8 @@ rocsparselt_status ConstructRocSparseLtProblem(const char*
     batch_stride_d         = matmul_descr->matrix_D->batch_stride;
 
     // activation
-    hipsparselt_activation_type act_type    = hipsparselt_activation_type::none;
     float                       act_args[2] = {0.0f, 0.0f};
-
-    if(matmul_descr->activation == rocsparselt_matmul_activation_relu)
-    {
-        act_args[0] = matmul_descr->activation_relu_threshold;
-        act_args[1] = matmul_descr->activation_relu_upperbound;
-        if(act_args[0] == 0 && act_args[1] == std::numeric_limits<float>::infinity())
-            act_type = hipsparselt_activation_type::relu;
-        else
-            act_type = hipsparselt_activation_type::clippedrelu;
-    }
-    else if(matmul_descr->activation == rocsparselt_matmul_activation_gelu)
-    {
-        act_type    = hipsparselt_activation_type::gelu;
-        act_args[0] = matmul_descr->activation_gelu_scaling;
-    }
-    else if(matmul_descr->activation == rocsparselt_matmul_activation_abs)
-        act_type = hipsparselt_activation_type::abs;
-    else if(matmul_descr->activation == rocsparselt_matmul_activation_leakyrelu)
-    {
-        act_type    = hipsparselt_activation_type::leakyrelu;
-        act_args[0] = matmul_descr->activation_leakyrelu_alpha;
-    }
-    else if(matmul_descr->activation == rocsparselt_matmul_activation_sigmoid)
-        act_type = hipsparselt_activation_type::sigmoid;
-    else if(matmul_descr->activation == rocsparselt_matmul_activation_tanh)
-    {
-        act_type    = hipsparselt_activation_type::tanh;
-        act_args[0] = matmul_descr->activation_tanh_alpha;
-        act_args[1] = matmul_descr->activation_tanh_beta;
-    }
+    hipsparselt_activation_type act_type    = matmul_activation(matmul_descr, act_args);
 
     float*  bias_vector = matmul_descr->bias_pointer;
     int64_t bias_stride = matmul_descr->bias_stride;
@@ -452,6 +1223,8 @@ rocsparselt_status ConstructRocSparseLtProblem(const char*
                                                             workspaceSize,
                                                             streams,
                                                             numStreams);
+    (*prob)->scale_vector      = matmul_descr->output_scale_pointer;
+    (*prob)->zero_point_vector = matmul_descr->output_zero_point_pointer;
     return rocsparselt_status_success;
 }
 
@@ -475,5 +1248,6 @@ rocsparselt_status ConstructRocSparseLtProblem(const char*
 GENERATE_DEFINITIONS(__half, __half, float)
 GENERATE_DEFINITIONS(hip_bfloat16, hip_bfloat16, float)
 GENERATE_DEFINITIONS(int8_t, int8_t, float)
+GENERATE_DEFINITIONS(int8_t, __half, float)
 
 #undef GENERATE_DEFINITIONS
@@ -30,8 +30,10 @@
 
 //#include "gemm_tensile.hpp"
 
+#include "definitions.h"
 #include "handle.h"
 #include "hipsparselt_ostream.hpp"
+#include "rocsparselt_spmm_utils.hpp"
 #include "utility.hpp"
 #if BUILD_WITH_TENSILE
 #include "tensile_host.hpp"
@@ -39,6 +41,15 @@
 #include "kernel_launcher.hpp"
 #endif
 
+/*******************************************************************************
+ * The matmul of an output quantization, see matmul_output_is_quantized. The
+ * int32 accumulators are scaled by alpha, beta * C and the bias are added, the
+ * activation is applied and D = saturate(scale[row] * value + zero_point[row]).
+ ******************************************************************************/
+template <typename To>
+rocsparselt_status rocsparselt_quantized_spmm_template(
+    const RocsparseltContractionProblem<int8_t, To, float>& prob, rocsparselt_datatype bias_type);
+
 template <typename Ti, typename To = Ti, typename Tc = To>
 rocsparselt_status spmm_typecasting(const char*                     caller,
                                     const _rocsparselt_handle*      handle,
@@ -87,6 +98,16 @@ rocsparselt_status spmm_typecasting(const char*                     caller,
     if(status != rocsparselt_status_success)
         return status;
 
+    if constexpr(std::is_same<Ti, int8_t>{} && std::is_same<Tc, float>{})
+    {
+        if(problem->scale_vector != nullptr)
+        {
+            status = rocsparselt_quantized_spmm_template(*problem, plan->matmul_descr->bias_type);
+            delete problem;
+            return status;
+        }
+    }
+
     status = runContractionProblem<Ti, To, Tc>(*problem,
 #if BUILD_WITH_TENSILE
                                                &plan->alg_selection->configs[0],
@@ -28,9 +28,11 @@
 
 #include "tensile_host.hpp"
 #include "activation.hpp"
+#include "binary_trace.hpp"
 #include "definitions.h"
 #include "rocsparselt_spmm_utils.hpp"
 #include "status.h"
+#include "timeline.hpp"
 #include "utility.hpp"
 /*****************************************************************************
  * This is the only file in rocsparselt which should #include Tensile headers    *
@@ -638,19 +640,19 @@ namespace
                 //rocsparselt_abort();
             }
 
-            hipDeviceProp_t prop;
-            THROW_IF_HIP_ERROR(hipGetDeviceProperties(&prop, deviceId));
-
-            m_deviceProp = std::make_shared<hipDeviceProp_t>(prop);
+            m_deviceProp = std::make_shared<hipDeviceProp_t>(
+                rocsparselt_get_device_info(deviceId).properties);
         }
     };
 
-    // Return the library and adapter for the current HIP device
+    // Return the library and adapter for the current HIP device, the code objects
+    // loaded by the first call of a device are a span of the timeline of handle.
     auto& get_library_and_adapter(
         std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblemGemm>>* library
         = nullptr,
         std::shared_ptr<hipDeviceProp_t>* deviceProp = nullptr,
-        int                               device     = -1)
+        int                               device     = -1,
+        const _rocsparselt_handle*        handle     = nullptr)
     try
     {
         // TensileHost is initialized on the first call
@@ -677,6 +679,9 @@ namespace
                 adapter = new Tensile::hip::SolutionAdapter;
 
                 // Initialize the adapter and possibly the library
+                rocsparselt_timeline_span span(
+                    handle, rocsparselt_timeline_kind_code_object_load, "loadCodeObjectFile");
+                span.set_value(device);
                 host.initialize(*adapter, device);
 
                 // Atomically change the adapter stored for this device ID
@@ -727,6 +732,36 @@ namespace
             hipsparselt_cerr << msg << std::endl;
     }
 
+    /**************************************************************************
+    * Launch the kernels of a solution as one span of the timeline of handle *
+    * and record each of them in its binary trace                            *
+    **************************************************************************/
+    hipError_t launch_kernels(const _rocsparselt_handle*                    handle,
+                              Tensile::hip::SolutionAdapter&                adapter,
+                              std::vector<Tensile::KernelInvocation> const& kernels,
+                              hipStream_t                                   stream,
+                              hipEvent_t                                    startEvent,
+                              hipEvent_t                                    stopEvent)
+    {
+        rocsparselt_timeline_span span(
+            handle, rocsparselt_timeline_kind_kernel_launch, "SolutionAdapter::launchKernels");
+        if(span.active() && !kernels.empty())
+        {
+            span.set_detail(kernels.back().kernelName);
+            span.set_dims(kernels.back().numWorkGroups, kernels.back().workGroupSize);
+            span.set_value(static_cast<int32_t>(kernels.size()));
+        }
+        if(handle->binary_trace)
+            for(auto const& kernel : kernels)
+                handle->binary_trace->record_launch(kernel.kernelName,
+                                                    kernel.workGroupSize,
+                                                    kernel.numWorkGroups,
+                                                    kernel.numWorkItems,
+                                                    kernel.args.data(),
+                                                    kernel.args.size());
+        return adapter.launchKernels(kernels, stream, startEvent, stopEvent);
+    }
+
 } // namespace
 
 /******************************************************************************
@@ -749,7 +784,10 @@ rocsparselt_status runContractionProblem(const RocsparseltContractionProblem<Ti,
         std::shared_ptr<hipDeviceProp_t>                                                 deviceProp;
         std::shared_ptr<Tensile::Hardware>                                               hardware;
 
-        auto& adapter = get_library_and_adapter(&library, &deviceProp, prob.handle->device);
+        // the configs come from getBestSolutions, which created the adapter of the device and
+        // loaded all of its code objects, so a launch on a captured stream loads none.
+        auto& adapter
+            = get_library_and_adapter(&library, &deviceProp, prob.handle->device, prob.handle);
 
         hardware = Tensile::hip::GetDevice(*deviceProp);
 
@@ -786,10 +824,12 @@ rocsparselt_status runContractionProblem(const RocsparseltContractionProblem<Ti,
                 }
 
                 RETURN_IF_HIP_ERROR(
-                    adapter.launchKernels(solution->solve(tensile_prob, tensile_inputs, *hardware),
-                                          prob.streams[0],
-                                          nullptr,
-                                          nullptr));
+                    launch_kernels(prob.handle,
+                                   adapter,
+                                   solution->solve(tensile_prob, tensile_inputs, *hardware),
+                                   prob.streams[0],
+                                   nullptr,
+                                   nullptr));
             }
             else
             {
@@ -800,6 +840,9 @@ rocsparselt_status runContractionProblem(const RocsparseltContractionProblem<Ti,
                 RETURN_IF_HIP_ERROR(hipEventCreate(&stopEvent));
                 for(int id = 0; id < config_max_id; id++)
                 {
+                    rocsparselt_timeline_span span(
+                        prob.handle, rocsparselt_timeline_kind_search, "search iteration");
+                    span.set_value(id);
                     if(configs[id].max_workspace_bytes > prob.workspaceSize
                        || (configs[id].max_workspace_bytes > 0 && prob.workspace == nullptr))
                     {
@@ -819,20 +862,24 @@ rocsparselt_status runContractionProblem(const RocsparseltContractionProblem<Ti,
                     }
 
                     //warm up
-                    RETURN_IF_HIP_ERROR(adapter.launchKernels(
-                        solution->solve(tensile_prob, tensile_inputs, *hardware),
-                        prob.streams[0],
-                        nullptr,
-                        nullptr));
+                    RETURN_IF_HIP_ERROR(
+                        launch_kernels(prob.handle,
+                                       adapter,
+                                       solution->solve(tensile_prob, tensile_inputs, *hardware),
+                                       prob.streams[0],
+                                       nullptr,
+                                       nullptr));
 
                     sum_ms = 0.0f;
                     for(int i = 0; i < search_iterations; i++)
                     {
-                        RETURN_IF_HIP_ERROR(adapter.launchKernels(
-                            solution->solve(tensile_prob, tensile_inputs, *hardware),
-                            prob.streams[0],
-                            startEvent,
-                            stopEvent));
+                        RETURN_IF_HIP_ERROR(
+                            launch_kernels(prob.handle,
+                                           adapter,
+                                           solution->solve(tensile_prob, tensile_inputs, *hardware),
+                                           prob.streams[0],
+                                           startEvent,
+                                           stopEvent));
                         RETURN_IF_HIP_ERROR(hipEventSynchronize(stopEvent));
                         RETURN_IF_HIP_ERROR(hipEventElapsedTime(&ms, startEvent, stopEvent));
                         sum_ms += ms;
@@ -885,7 +932,7 @@ rocsparselt_status getBestSolutions(const RocsparseltContractionProblem<Ti, To,
     std::shared_ptr<Tensile::Hardware>                                               hardware;
 
     // auto &adapter =
-    get_library_and_adapter(&library, &deviceProp, prob.handle->device);
+    get_library_and_adapter(&library, &deviceProp, prob.handle->device, prob.handle);
 
     hardware          = Tensile::hip::GetDevice(*deviceProp);
     auto tensile_prob = ConstructTensileProblem(prob);
@@ -0,0 +1,193 @@
+/*! \file */
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "timeline.hpp"
+#include "hipsparselt_ostream.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <unistd.h>
+
+namespace
+{
+    std::atomic<uint64_t> timeline_count{0};
+
+    const char* timeline_kind2string(rocsparselt_timeline_kind kind)
+    {
+        switch(kind)
+        {
+        case rocsparselt_timeline_kind_api:
+            return "api";
+        case rocsparselt_timeline_kind_plan_init:
+            return "plan_init";
+        case rocsparselt_timeline_kind_code_object_load:
+            return "code_object_load";
+        case rocsparselt_timeline_kind_kernel_launch:
+            return "kernel_launch";
+        case rocsparselt_timeline_kind_search:
+            return "search";
+        }
+        return "unknown";
+    }
+
+    // kernel names and file names only need quotes and backslashes escaped.
+    void write_json_string(std::ostream& os, const char* str)
+    {
+        os << '"';
+        for(; *str; str++)
+        {
+            if(*str == '"' || *str == '\\')
+                os << '\\';
+            if(static_cast<unsigned char>(*str) >= 0x20)
+                os << *str;
+        }
+        os << '"';
+    }
+}
+
+_rocsparselt_timeline::_rocsparselt_timeline()
+    : id(timeline_count++)
+{
+    // events per thread, rounded up to a power of two.
+    uint64_t events = 16384;
+    char*    str_events;
+    if((str_events = getenv("HIPSPARSELT_TIMELINE_EVENTS")) != NULL && atoll(str_events) > 0)
+        events = atoll(str_events);
+    capacity = 1;
+    while(capacity < events)
+        capacity <<= 1;
+}
+
+_rocsparselt_timeline::ring* _rocsparselt_timeline::get_ring()
+{
+    // the ring of the last timeline used by this thread, ids are never reused.
+    thread_local struct
+    {
+        uint64_t id = UINT64_MAX;
+        ring*    r  = nullptr;
+    } cache;
+
+    if(cache.id == id)
+        return cache.r;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto                        thread = std::this_thread::get_id();
+    ring*                       r      = nullptr;
+    for(auto& it : rings)
+        if(it->thread == thread)
+            r = it.get();
+    if(r == nullptr)
+    {
+        rings.push_back(std::make_unique<ring>());
+        r         = rings.back().get();
+        r->thread = thread;
+        r->tid    = rings.size();
+        r->events.reset(new rocsparselt_timeline_event[capacity]);
+    }
+    cache.id = id;
+    cache.r  = r;
+    return r;
+}
+
+void _rocsparselt_timeline::record(const rocsparselt_timeline_event& event)
+{
+    ring*    r    = get_ring();
+    uint64_t head = r->head.load(std::memory_order_relaxed);
+    r->events[head & (capacity - 1)] = event;
+    r->head.store(head + 1, std::memory_order_release);
+}
+
+void _rocsparselt_timeline::flush(std::ostream& os) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto    pid     = getpid();
+    int64_t dropped = 0;
+    // chrome trace timestamps are in microseconds.
+    os << std::fixed << std::setprecision(3);
+    os << "{\"traceEvents\":[\n";
+    os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+       << ",\"args\":{\"name\":\"hipSPARSELt handle " << id << "\"}}";
+
+    for(auto& r : rings)
+    {
+        uint64_t head  = r->head.load(std::memory_order_acquire);
+        uint64_t first = head > capacity ? head - capacity : 0;
+        dropped += first;
+        for(uint64_t i = first; i < head; i++)
+        {
+            auto& e = r->events[i & (capacity - 1)];
+            os << ",\n{\"name\":";
+            write_json_string(os, e.name);
+            os << ",\"cat\":\"" << timeline_kind2string(e.kind) << "\",\"ph\":\"X\",\"ts\":"
+               << e.begin_ns / 1e3 << ",\"dur\":" << (e.end_ns - e.begin_ns) / 1e3
+               << ",\"pid\":" << pid << ",\"tid\":" << r->tid << ",\"args\":{";
+            const char* delim = "";
+            if(e.detail[0])
+            {
+                os << "\"detail\":";
+                write_json_string(os, e.detail);
+                delim = ",";
+            }
+            if(e.value >= 0)
+            {
+                os << delim << "\"value\":" << e.value;
+                delim = ",";
+            }
+            if(e.kind == rocsparselt_timeline_kind_kernel_launch)
+                os << delim << "\"grid\":[" << e.grid[0] << ',' << e.grid[1] << ',' << e.grid[2]
+                   << "],\"workgroup\":[" << e.workgroup[0] << ',' << e.workgroup[1] << ','
+                   << e.workgroup[2] << ']';
+            os << "}}";
+        }
+    }
+    os << "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped_events\":" << dropped
+       << "}}" << std::endl;
+}
+
+void _rocsparselt_timeline::flush() const
+{
+    // %i is replaced by the process id and %h by the timeline number.
+    std::string path = "hipsparselt_timeline_%i_%h.json";
+    char*       str_path;
+    if((str_path = getenv("HIPSPARSELT_TIMELINE_FILE")) != NULL)
+        path = str_path;
+    size_t pos;
+    if((pos = path.find("%i")) != std::string::npos)
+        path.replace(pos, 2, std::to_string(getpid()));
+    if((pos = path.find("%h")) != std::string::npos)
+        path.replace(pos, 2, std::to_string(id));
+
+    std::ofstream ofs(path);
+    if(!ofs.is_open())
+    {
+        hipsparselt_cerr << "failed to open timeline file: " << path << std::endl;
+        return;
+    }
+    flush(ofs);
+}
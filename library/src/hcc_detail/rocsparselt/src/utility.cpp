@@ -140,6 +140,10 @@ const char* rocsparselt_layer_mode2string(rocsparselt_layer_mode layer_mode)
         return "Info";
     case rocsparselt_layer_mode_log_api:
         return "Api";
+    case rocsparselt_layer_mode_log_timeline:
+        return "Timeline";
+    case rocsparselt_layer_mode_log_trace_binary:
+        return "TraceBinary";
     default:
         return "Invalid";
     }
@@ -0,0 +1,242 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// rocsparselt-trace-decode renders the binary trace written by the
+// rocsparselt_layer_mode_log_trace_binary layer in the text format of the
+// trace layer. usage: rocsparselt-trace-decode trace.bin [output.log]
+
+#include "../src/include/binary_trace_format.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+using namespace std;
+
+struct launch
+{
+    rocsparselt_trace_record record;
+    vector<uint8_t>          args;
+};
+
+float half_to_float(uint16_t h)
+{
+    int   exponent = (h >> 10) & 0x1f;
+    int   mantissa = h & 0x3ff;
+    float value    = exponent == 0    ? ldexp(float(mantissa), -24)
+                     : exponent == 31 ? (mantissa ? NAN : INFINITY)
+                                      : ldexp(float(mantissa | 0x400), exponent - 25);
+    return h & 0x8000 ? -value : value;
+}
+
+// the value of an argument as KernelArguments formats it
+string format_value(const uint8_t* bytes, const rocsparselt_trace_arg& arg)
+{
+    ostringstream os;
+    uint64_t      raw = 0;
+    memcpy(&raw, bytes, min<size_t>(arg.size, sizeof(raw)));
+    switch(arg.kind)
+    {
+    case 'p':
+        os << reinterpret_cast<void const*>(raw);
+        break;
+    case 'f':
+        if(arg.size == sizeof(float))
+        {
+            float value;
+            memcpy(&value, bytes, sizeof(value));
+            os << value;
+        }
+        else
+        {
+            double value;
+            memcpy(&value, bytes, sizeof(value));
+            os << value;
+        }
+        break;
+    case 'h':
+        os << half_to_float(uint16_t(raw));
+        break;
+    case 'b':
+    {
+        uint32_t bits = uint32_t(raw) << 16;
+        float    value;
+        memcpy(&value, &bits, sizeof(value));
+        os << value;
+        break;
+    }
+    case 'i':
+        if(arg.size == 1)
+            os << int8_t(raw);
+        else if(arg.size == 2)
+            os << int16_t(raw);
+        else if(arg.size == 4)
+            os << int32_t(raw);
+        else
+            os << int64_t(raw);
+        break;
+    case 'u':
+        if(arg.size == 1)
+            os << uint8_t(raw);
+        else
+            os << raw;
+        break;
+    default:
+        return "";
+    }
+    return " (" + os.str() + ")";
+}
+
+int main(int argc, char* argv[])
+{
+    if(argc < 2)
+    {
+        cerr << "usage: " << argv[0] << " trace.bin [output.log]" << endl;
+        return 1;
+    }
+
+    ifstream infile(argv[1], ios_base::binary);
+    if(!infile)
+    {
+        cerr << "Failed to open: " << argv[1] << endl;
+        return 1;
+    }
+
+    rocsparselt_trace_file_header header;
+    if(!infile.read(reinterpret_cast<char*>(&header), sizeof(header))
+       || memcmp(header.magic, ROCSPARSELT_TRACE_MAGIC, sizeof(header.magic))
+       || header.version != ROCSPARSELT_TRACE_VERSION
+       || header.record_size != sizeof(rocsparselt_trace_record))
+    {
+        cerr << "Not a hipSPARSELt binary trace of version " << ROCSPARSELT_TRACE_VERSION << ": "
+             << argv[1] << endl;
+        return 1;
+    }
+
+    // definitions may follow the records which use them, so read everything first.
+    map<uint32_t, string>                        strings;
+    map<uint32_t, vector<rocsparselt_trace_arg>> layouts;
+    vector<launch>                               launches;
+
+    rocsparselt_trace_record record;
+    while(infile.read(reinterpret_cast<char*>(&record), sizeof(record)))
+    {
+        vector<uint8_t> payload(size_t(record.chunks) * sizeof(record));
+        if(!infile.read(reinterpret_cast<char*>(payload.data()), payload.size())
+           || record.bytes > payload.size())
+        {
+            cerr << "Truncated record in " << argv[1] << endl;
+            break;
+        }
+        payload.resize(record.bytes);
+
+        if(record.type == rocsparselt_trace_record_string)
+            strings[record.id].assign(payload.begin(), payload.end());
+        else if(record.type == rocsparselt_trace_record_layout)
+        {
+            auto& args = layouts[record.id];
+            args.resize(payload.size() / sizeof(rocsparselt_trace_arg));
+            memcpy(args.data(), payload.data(), args.size() * sizeof(rocsparselt_trace_arg));
+        }
+        else if(record.type == rocsparselt_trace_record_launch)
+            launches.push_back({record, move(payload)});
+    }
+
+    // the records of each thread are in order, merge the threads by time.
+    stable_sort(launches.begin(), launches.end(), [](const launch& a, const launch& b) {
+        return a.record.time_ns < b.record.time_ns;
+    });
+
+    ofstream outfile;
+    if(argc > 2)
+    {
+        outfile.open(argv[2]);
+        if(!outfile)
+        {
+            cerr << "Failed to open: " << argv[2] << endl;
+            return 1;
+        }
+    }
+    ostream& os = argc > 2 ? outfile : cout;
+
+    for(auto& l : launches)
+    {
+        const auto& r = l.record;
+
+        char   prefix[256];
+        time_t now   = time_t(r.time_ns / 1000000000);
+        tm*    local = localtime(&now);
+        snprintf(prefix,
+                 sizeof(prefix),
+                 "[%d-%02d-%02d %02d:%02d:%02d][HIPSPARSELT][%lu][%s][%s]",
+                 1900 + local->tm_year,
+                 1 + local->tm_mon,
+                 local->tm_mday,
+                 local->tm_hour,
+                 local->tm_min,
+                 local->tm_sec,
+                 (unsigned long)header.pid,
+                 "Trace",
+                 "launchKernel");
+
+        os << prefix << " Kernel " << strings[r.id] << "\n"
+           << " l"
+           << " (" << r.workgroup[0] << ", " << r.workgroup[1] << ". " << r.workgroup[2] << ")"
+           << " x g"
+           << " (" << r.grid[0] << ", " << r.grid[1] << ". " << r.grid[2] << ")"
+           << " = "
+           << "(" << r.items[0] << ", " << r.items[1] << ". " << r.items[2] << ") \n";
+
+        size_t prevOffset = 0;
+        for(auto const& arg : layouts[r.layout])
+        {
+            if(arg.offset + arg.size > l.args.size())
+                break;
+            if(prevOffset != arg.offset)
+                os << "[" << prevOffset << ".." << arg.offset - 1 << "] <padding>" << endl;
+
+            os << "[" << arg.offset << ".." << arg.offset + arg.size - 1 << "] "
+               << strings[arg.name] << ":";
+            os << hex;
+            for(size_t i = arg.offset; i < arg.offset + arg.size; i++)
+                os << " " << setfill('0') << setw(2) << static_cast<uint32_t>(l.args[i]);
+            os << dec << setfill(' ');
+            os << format_value(&l.args[arg.offset], arg) << endl;
+
+            prevOffset = arg.offset + arg.size;
+        }
+        os << endl << "\n";
+    }
+    return 0;
+}
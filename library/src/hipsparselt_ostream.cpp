@@ -26,6 +26,9 @@ static void hipsparselt_abort_once [[noreturn]] ();
 
 #include "hipsparselt_ostream.hpp"
 
+#include <algorithm>
+#include <cerrno>
+#include <climits>
 #include <csignal>
 #include <fcntl.h>
 #include <iostream>
@@ -40,6 +43,8 @@ static void hipsparselt_abort_once [[noreturn]] ();
 #define OPEN(A) _open(A, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_APPEND, _S_IREAD | _S_IWRITE);
 #define CLOSE(A) _close(A)
 #else
+#include <sys/uio.h>
+
 #define FDOPEN(A, B) fdopen(A, B)
 #define OPEN(A) open(A, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644);
 #define CLOSE(A) close(A)
@@ -233,17 +238,21 @@ void hipsparselt_internal_ostream::worker::send(std::string str)
     bool empty_string = str.empty();
 #endif
 
-    // task_t consists of string and promise
-    // std::move transfers ownership of str and promise to task
-    task_t worker_task(std::move(str), std::move(promise));
+    // node_t consists of string and promise
+    // std::move transfers ownership of str and promise to the node
+    node_t* node = new node_t{task_t(std::move(str), std::move(promise))};
+
+    // Submit the task to the worker assigned to this device/inode without a lock: claim the tail,
+    // then link the previous tail to the node. The worker waits for the link if it sees the tail
+    // move before the link is stored.
+    node_t* prev = m_tail.exchange(node);
+    prev->m_next.store(node, std::memory_order_release);
 
-    // Submit the task to the worker assigned to this device/inode
-    // Hold mutex for as short as possible, to reduce contention
+    // The worker sets m_sleeping before it checks the tail again under the mutex, so either it
+    // sees the node or the notification is sent after it started waiting
+    if(m_sleeping.load())
     {
         std::lock_guard<std::mutex> lock(m_mutex);
-        m_queue.push(std::move(worker_task));
-
-        // no lock needed for notification but keeping here
         m_cond.notify_one();
     }
 
@@ -260,53 +269,118 @@ void hipsparselt_internal_ostream::worker::send(std::string str)
 #endif
 }
 
+// Take up to max messages off the queue, only called by the worker thread
+void hipsparselt_internal_ostream::worker::pop(size_t max)
+{
+    while(m_batch.size() < max)
+    {
+        node_t* next = m_head->m_next.load(std::memory_order_acquire);
+        if(!next)
+        {
+            // A sender which claimed the tail but has not linked its node yet is waited for,
+            // otherwise the queue is empty
+            if(m_tail.load() == m_head)
+                break;
+            std::this_thread::yield();
+            continue;
+        }
+
+        // The consumed node becomes the new placeholder
+        m_batch.push_back(std::move(next->m_task));
+        delete m_head;
+        m_head = next;
+    }
+}
+
+// Write the first count messages of the batch with as few system calls as possible
+bool hipsparselt_internal_ostream::worker::write_batch(size_t count)
+{
+#ifndef WIN32
+    std::vector<iovec> iov(count);
+    for(size_t i = 0; i < count; ++i)
+        iov[i] = {const_cast<char*>(m_batch[i].data()), m_batch[i].size()};
+
+    // writev may write only a part of the data, continue after the last byte written
+    int    fd    = fileno(m_file);
+    size_t first = 0;
+    while(first < count)
+    {
+        ssize_t written = writev(fd, &iov[first], std::min<size_t>(count - first, IOV_MAX));
+        if(written < 0)
+        {
+            if(errno == EINTR)
+                continue;
+            return false;
+        }
+        for(; first < count && size_t(written) >= iov[first].iov_len; ++first)
+            written -= iov[first].iov_len;
+        if(first < count)
+        {
+            iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + written;
+            iov[first].iov_len -= written;
+        }
+    }
+    return true;
+#else
+    for(size_t i = 0; i < count; ++i)
+        fwrite(m_batch[i].data(), 1, m_batch[i].size(), m_file);
+
+    // Detect any error and flush the C FILE stream
+    return !ferror(m_file) && !fflush(m_file);
+#endif
+}
+
 // Worker thread which serializes data to be written to a device/inode
 void hipsparselt_internal_ostream::worker::thread_function()
 {
     // Clear any errors in the FILE
     clearerr(m_file);
 
-    // Lock the mutex in preparation for cond.wait
-    std::unique_lock<std::mutex> lock(m_mutex);
+    // After a write error the messages are dropped, but their senders are still woken up
+    bool failed = false;
 
     while(true)
     {
-        // Wait for any data, ignoring spurious wakeups, locks lock on continue
-        m_cond.wait(lock, [&] { return !m_queue.empty(); });
-
-        // With the mutex locked, get and pop data from the front of queue
-        task_t task = std::move(m_queue.front());
-        m_queue.pop();
+        // Take the pending messages, bounded to limit the wait of the first sender
+        pop(1024);
 
-        // Temporarily unlock queue mutex, unblocking other threads
-        lock.unlock();
-
-        // An empty message indicates the closing of the stream
-        if(!task.size())
+        if(m_batch.empty())
         {
-            // Tell future to wake up
-            task.set_value();
-            break;
+            // Announce the wait before checking the queue again, see send()
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_sleeping.store(true);
+            m_cond.wait(lock, [&] { return m_tail.load() != m_head; });
+            m_sleeping.store(false);
+            continue;
         }
 
-        // Write the data
-        fwrite(task.data(), 1, task.size(), m_file);
+        // An empty message indicates the closing of the stream, the messages before it are
+        // written first
+        auto   stop  = std::find_if(
+            m_batch.begin(), m_batch.end(), [](const task_t& task) { return !task.size(); });
+        size_t count = stop - m_batch.begin();
 
-        // Detect any error and flush the C FILE stream
-        if(ferror(m_file) || fflush(m_file))
+        // Write the data
+        if(count && !failed && !write_batch(count))
         {
             perror("Error writing log file");
-
-            // Tell future to wake up
-            task.set_value();
-            break;
+            failed = true;
         }
 
         // Promise that the data has been written
-        task.set_value();
+        for(size_t i = 0; i < count; ++i)
+            m_batch[i].set_value();
 
-        // Re-lock the mutex in preparation for cond.wait
-        lock.lock();
+        if(stop != m_batch.end())
+        {
+            // The worker may be destroyed as soon as the closing task is woken up, so it is
+            // moved out of the worker first
+            task_t task = std::move(*stop);
+            m_batch.clear();
+            task.set_value();
+            break;
+        }
+        m_batch.clear();
     }
 }
 
@@ -327,6 +401,10 @@ hipsparselt_internal_ostream::worker::worker(int fd)
         hipsparselt_abort();
     }
 
+    // The queue starts with an empty placeholder
+    m_head = new node_t{task_t({}, {})};
+    m_tail.store(m_head);
+
     // Create a worker thread, capturing *this
     m_thread = std::thread([=] { thread_function(); });
 
@@ -339,6 +417,9 @@ hipsparselt_internal_ostream::worker::~worker()
     // Tell worker thread to exit, by sending it an empty string
     send({});
 
+    // The placeholder left by the worker thread
+    delete m_head;
+
     // Close the FILE
     if(m_file)
         fclose(m_file);
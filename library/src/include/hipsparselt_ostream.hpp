@@ -6,6 +6,7 @@
 
 #include "activation.hpp"
 #include "auxiliary.hpp"
+#include <atomic>
 #include <cmath>
 #include <complex>
 #include <condition_variable>
@@ -19,12 +20,12 @@
 #include <memory>
 #include <mutex>
 #include <ostream>
-#include <queue>
 #include <sstream>
 #include <string>
 #include <sys/stat.h>
 #include <thread>
 #include <utility>
+#include <vector>
 #ifdef WIN32
 #include <io.h>
 #include <iostream>
@@ -62,6 +63,9 @@ class HIPSPARSELT_EXPORT hipsparselt_internal_ostream
     /**************************************************************************
      * The worker class sets up a worker thread for writing to log files. Two *
      * files are considered the same if they have the same device ID / inode. *
+     * Messages are pushed on a lock-free multiple producer, single consumer  *
+     * queue and the worker writes all pending messages with one vectored    *
+     * write, so threads logging to the same file do not contend on a lock.  *
      **************************************************************************/
     class worker
     {
@@ -98,20 +102,38 @@ class HIPSPARSELT_EXPORT hipsparselt_internal_ostream
             }
         };
 
+        // node_t links a task into the queue
+        struct node_t
+        {
+            task_t               m_task;
+            std::atomic<node_t*> m_next{nullptr};
+        };
+
         // FILE is used for safety in the presence of signals
         FILE* m_file = nullptr;
 
         // This worker's thread
         std::thread m_thread;
 
-        // Condition variable for worker notification
+        // The producers append at the tail, the worker thread consumes after the head. The head
+        // is a placeholder whose successor holds the oldest message.
+        std::atomic<node_t*> m_tail;
+        node_t*              m_head;
+
+        // Set while the worker thread waits for messages, so that senders only take the mutex
+        // to notify it when it is asleep
+        std::atomic<bool>       m_sleeping{false};
         std::condition_variable m_cond;
+        std::mutex              m_mutex;
+
+        // Messages of the batch being written, reused between batches
+        std::vector<task_t> m_batch;
 
-        // Mutex for this thread's queue
-        std::mutex m_mutex;
+        // Take up to max messages off the queue into m_batch
+        void pop(size_t max);
 
-        // Queue of tasks
-        std::queue<task_t> m_queue;
+        // Write the first count messages of m_batch, returns false on an error
+        bool write_batch(size_t count);
 
         // Worker thread which waits for and handles tasks sequentially
         void thread_function();
@@ -524,6 +524,30 @@ hipsparseStatus_t hipsparseLtDestroy(const hipsparseLtHandle_t* handle)
     return hipCUSPARSEStatusToHIPStatus(cusparseLtDestroy((const cusparseLtHandle_t*)handle));
 }
 
+hipsparseStatus_t hipsparseLtWorkspaceArenaSetEnabled(const hipsparseLtHandle_t* handle,
+                                                      int                        enable)
+{
+    return HIPSPARSE_STATUS_NOT_SUPPORTED;
+}
+
+hipsparseStatus_t hipsparseLtWorkspaceArenaGetStats(const hipsparseLtHandle_t*        handle,
+                                                    hipsparseLtWorkspaceArenaStats_t* stats)
+{
+    return HIPSPARSE_STATUS_NOT_SUPPORTED;
+}
+
+hipsparseStatus_t hipsparseLtGetDeviceMemoryUsage(const hipsparseLtHandle_t*      handle,
+                                                  hipsparseLtDeviceMemoryUsage_t* usage)
+{
+    return HIPSPARSE_STATUS_NOT_SUPPORTED;
+}
+
+hipsparseStatus_t hipsparseLtUnloadUnusedModules(const hipsparseLtHandle_t* handle,
+                                                 size_t*                    freedBytes)
+{
+    return HIPSPARSE_STATUS_NOT_SUPPORTED;
+}
+
 hipsparseStatus_t hipsparseLtGetVersion(const hipsparseLtHandle_t* handle, int* version)
 {
     return hipCUSPARSEStatusToHIPStatus(
@@ -738,6 +762,57 @@ hipsparseStatus_t hipsparseLtMatmulPlanDestroy(const hipsparseLtMatmulPlan_t* pl
         cusparseLtMatmulPlanDestroy((const cusparseLtMatmulPlan_t*)plan));
 }
 
+hipsparseStatus_t hipsparseLtMatmulPlanSetStatsSampling(const hipsparseLtHandle_t*     handle,
+                                                        const hipsparseLtMatmulPlan_t* plan,
+                                                        int32_t                        interval)
+{
+    return HIPSPARSE_STATUS_NOT_SUPPORTED;
+}
+
+hipsparseStatus_t hipsparseLtMatmulPlanGetStats(const hipsparseLtHandle_t*     handle,
+                                                const hipsparseLtMatmulPlan_t* plan,
+                                                hipsparseLtMatmulPlanStats_t*  stats)
+{
+    return HIPSPARSE_STATUS_NOT_SUPPORTED;
+}
+
+hipsparseStatus_t hipsparseLtMatmulPlanResetStats(const hipsparseLtHandle_t*     handle,
+                                                  const hipsparseLtMatmulPlan_t* plan)
+{
+    return HIPSPARSE_STATUS_NOT_SUPPORTED;
+}
+
+hipsparseStatus_t
+    hipsparseLtMatmulAlgSelectionInitAsync(const hipsparseLtHandle_t*           handle,
+                                           hipsparseLtMatmulAlgSelection_t*     algSelection,
+                                           const hipsparseLtMatmulDescriptor_t* matmulDescr,
+                                           hipsparseLtMatmulAlg_t               alg,
+                                           hipsparseLtAsyncToken_t*             token)
+{
+    return HIPSPARSE_STATUS_NOT_SUPPORTED;
+}
+
+hipsparseStatus_t
+    hipsparseLtMatmulPlanInitAsync(const hipsparseLtHandle_t*             handle,
+                                   hipsparseLtMatmulPlan_t*               plan,
+                                   const hipsparseLtMatmulDescriptor_t*   matmulDescr,
+                                   const hipsparseLtMatmulAlgSelection_t* algSelection,
+                                   const hipsparseLtAsyncToken_t*         algSelectionToken,
+                                   hipsparseLtAsyncToken_t*               token)
+{
+    return HIPSPARSE_STATUS_NOT_SUPPORTED;
+}
+
+hipsparseStatus_t hipsparseLtAsyncTokenQuery(const hipsparseLtAsyncToken_t* token, int* done)
+{
+    return HIPSPARSE_STATUS_NOT_SUPPORTED;
+}
+
+hipsparseStatus_t hipsparseLtAsyncTokenWait(hipsparseLtAsyncToken_t* token)
+{
+    return HIPSPARSE_STATUS_NOT_SUPPORTED;
+}
+
 /* matmul execution */
 hipsparseStatus_t hipsparseLtMatmul(const hipsparseLtHandle_t*     handle,
                                     const hipsparseLtMatmulPlan_t* plan,
@@ -789,6 +864,140 @@ hipsparseStatus_t hipsparseLtMatmulSearch(const hipsparseLtHandle_t* handle,
                                                                numStreams));
 }
 
+hipsparseStatus_t hipsparseLtMatmulMultiple(const hipsparseLtHandle_t*       handle,
+                                            const hipsparseLtMatmulLaunch_t* launches,
+                                            int32_t                          numLaunches,
+                                            hipStream_t*                     streams,
+                                            int32_t                          numStreams)
+{
+    if(launches == nullptr || numLaunches < 0 || numStreams < 0
+       || (streams == nullptr && numStreams > 0))
+        return HIPSPARSE_STATUS_INVALID_VALUE;
+
+    for(int32_t i = 0; i < numLaunches; i++)
+    {
+        auto&             l      = launches[i];
+        hipsparseStatus_t status = hipCUSPARSEStatusToHIPStatus(
+            cusparseLtMatmul((const cusparseLtHandle_t*)handle,
+                             (const cusparseLtMatmulPlan_t*)l.plan,
+                             l.alpha,
+                             l.d_A,
+                             l.d_B,
+                             l.beta,
+                             l.d_C,
+                             l.d_D,
+                             l.workspace,
+                             numStreams > 0 ? &streams[i % numStreams] : nullptr,
+                             numStreams > 0 ? 1 : 0));
+        if(status != HIPSPARSE_STATUS_SUCCESS)
+            return status;
+    }
+    return HIPSPARSE_STATUS_SUCCESS;
+}
+
+namespace
+{
+    // capture the launches on stream into a graph, nullptr when a launch fails.
+    hipsparseStatus_t matmul_graph_capture(const hipsparseLtHandle_t*       handle,
+                                           const hipsparseLtMatmulLaunch_t* launches,
+                                           int32_t                          numLaunches,
+                                           hipStream_t                      stream,
+                                           hipGraph_t*                      graph)
+    {
+        hipStream_t captureStream = stream;
+        *graph                    = nullptr;
+        if(stream == nullptr
+           && hipStreamCreateWithFlags(&captureStream, hipStreamNonBlocking) != hipSuccess)
+            return HIPSPARSE_STATUS_INTERNAL_ERROR;
+
+        hipsparseStatus_t status = HIPSPARSE_STATUS_INTERNAL_ERROR;
+        if(hipStreamBeginCapture(captureStream, hipStreamCaptureModeThreadLocal) == hipSuccess)
+        {
+            status = hipsparseLtMatmulMultiple(handle, launches, numLaunches, &captureStream, 1);
+            if(hipStreamEndCapture(captureStream, graph) != hipSuccess
+               && status == HIPSPARSE_STATUS_SUCCESS)
+                status = HIPSPARSE_STATUS_INTERNAL_ERROR;
+            if(status != HIPSPARSE_STATUS_SUCCESS && *graph != nullptr)
+            {
+                hipGraphDestroy(*graph);
+                *graph = nullptr;
+            }
+        }
+
+        if(stream == nullptr)
+            hipStreamDestroy(captureStream);
+        return status;
+    }
+}
+
+hipsparseStatus_t hipsparseLtMatmulGraphCreate(const hipsparseLtHandle_t*       handle,
+                                               const hipsparseLtMatmulLaunch_t* launches,
+                                               int32_t                          numLaunches,
+                                               hipStream_t                      stream,
+                                               hipGraphExec_t*                  graphExec)
+{
+    if(graphExec == nullptr)
+        return HIPSPARSE_STATUS_INVALID_VALUE;
+
+    hipGraph_t        graph;
+    hipsparseStatus_t status = matmul_graph_capture(handle, launches, numLaunches, stream, &graph);
+    if(status != HIPSPARSE_STATUS_SUCCESS)
+        return status;
+    hipError_t err = hipGraphInstantiate(graphExec, graph, nullptr, nullptr, 0);
+    hipGraphDestroy(graph);
+    return err == hipSuccess ? HIPSPARSE_STATUS_SUCCESS : HIPSPARSE_STATUS_INTERNAL_ERROR;
+}
+
+hipsparseStatus_t hipsparseLtMatmulGraphUpdate(const hipsparseLtHandle_t*       handle,
+                                               const hipsparseLtMatmulLaunch_t* launches,
+                                               int32_t                          numLaunches,
+                                               hipStream_t                      stream,
+                                               hipGraphExec_t                   graphExec)
+{
+    if(graphExec == nullptr)
+        return HIPSPARSE_STATUS_INVALID_VALUE;
+
+    hipGraph_t        graph;
+    hipsparseStatus_t status = matmul_graph_capture(handle, launches, numLaunches, stream, &graph);
+    if(status != HIPSPARSE_STATUS_SUCCESS)
+        return status;
+    hipGraphNode_t           errorNode;
+    hipGraphExecUpdateResult result;
+    hipError_t               err = hipGraphExecUpdate(graphExec, graph, &errorNode, &result);
+    hipGraphDestroy(graph);
+    return err == hipSuccess && result == hipGraphExecUpdateSuccess
+               ? HIPSPARSE_STATUS_SUCCESS
+               : HIPSPARSE_STATUS_INVALID_VALUE;
+}
+
+hipsparseStatus_t hipsparseLtMatmulShardPartition(int        numShards,
+                                                  const int* weights,
+                                                  int64_t    extent,
+                                                  int64_t    granularity,
+                                                  int64_t*   offsets,
+                                                  int64_t*   sizes)
+{
+    return HIPSPARSE_STATUS_NOT_SUPPORTED;
+}
+
+hipsparseStatus_t hipsparseLtMatmulSharded(const hipsparseLtHandle_t* const*     handles,
+                                           const hipsparseLtMatmulPlan_t* const* plans,
+                                           int                                   numShards,
+                                           hipsparseLtShardDim_t                 dim,
+                                           const void*                           alpha,
+                                           const void* const*                    d_A,
+                                           const void* const*                    d_B,
+                                           const void*                           beta,
+                                           const void* const*                    d_C,
+                                           void* const*                          d_D,
+                                           void* const*                          workspaces,
+                                           hipStream_t*                          streams,
+                                           const hipsparseLtMatDescriptor_t*     gatherDescr,
+                                           void*                                 d_gather)
+{
+    return HIPSPARSE_STATUS_NOT_SUPPORTED;
+}
+
 /* helper */
 // prune
 hipsparseStatus_t hipsparseLtSpMMAPrune(const hipsparseLtHandle_t*           handle,
@@ -842,6 +1051,20 @@ hipsparseStatus_t hipsparseLtSpMMAPrune2(const hipsparseLtHandle_t*        handl
                               stream));
 }
 
+hipsparseStatus_t hipsparseLtSpMMAPruneTiles(const hipsparseLtHandle_t*        handle,
+                                             const hipsparseLtMatDescriptor_t* sparseMatDescr,
+                                             int                               isSparseA,
+                                             hipsparseOperation_t              op,
+                                             const void*                       d_in,
+                                             void*                             d_out,
+                                             hipsparseLtPruneAlg_t             pruneAlg,
+                                             const void*                       d_tileMask,
+                                             hipStream_t                       stream)
+{
+    // cuSPARSELt has no tile granular pruning.
+    return HIPSPARSE_STATUS_NOT_SUPPORTED;
+}
+
 hipsparseStatus_t hipsparseLtSpMMAPruneCheck2(const hipsparseLtHandle_t*        handle,
                                               const hipsparseLtMatDescriptor_t* sparseMatDescr,
                                               int                               isSparseA,
@@ -920,6 +1143,28 @@ hipsparseStatus_t hipsparseLtSpMMACompress2(const hipsparseLtHandle_t*        ha
                                  stream));
 }
 
+hipsparseStatus_t hipsparseLtSpMMATileMaskSize(const hipsparseLtHandle_t*        handle,
+                                               const hipsparseLtMatDescriptor_t* sparseMatDescr,
+                                               int64_t*                          tileSize,
+                                               size_t*                           tileMaskSize)
+{
+    return HIPSPARSE_STATUS_NOT_SUPPORTED;
+}
+
+hipsparseStatus_t hipsparseLtSpMMACompressTiles(const hipsparseLtHandle_t*        handle,
+                                                const hipsparseLtMatDescriptor_t* sparseMatDescr,
+                                                int                               isSparseA,
+                                                hipsparseOperation_t              op,
+                                                const void*                       d_dense,
+                                                void*                             d_compressed,
+                                                void*                             d_compressBuffer,
+                                                const void*                       d_tileMask,
+                                                hipStream_t                       stream)
+{
+    // cuSPARSELt has no tile granular compression.
+    return HIPSPARSE_STATUS_NOT_SUPPORTED;
+}
+
 void hipsparseLtInitialize() {}
 
 hipsparseStatus_t hipsparseLtGetGitRevision(hipsparseLtHandle_t handle, char* rev)